@@ -84,6 +84,13 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
 
+/* 调试开关：ESP8266任务报告剩余栈（LOG_D，需 LOG_COMPILE_LEVEL 为 DEBUG），
+用于在硬件上核对任务栈大小，发布版本不编译栈水位查询 */
+#ifndef DEBUG_STACK_CHECK
+	#define DEBUG_STACK_CHECK			0
+#endif
+#define INCLUDE_uxTaskGetStackHighWaterMark	DEBUG_STACK_CHECK
+
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
 	/* __BVIC_PRIO_BITS will be specified when CMSIS is being used. */
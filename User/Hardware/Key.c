@@ -1,67 +1,216 @@
 #include "Key.h"
+#include "debug.h"
+#include <timers.h>
+
+// ==================================
+// 驱动状态
+// ==================================
+
+static const uint16_t key_pins[KEY_COUNT] = {KEY1_PIN, KEY2_PIN, KEY3_PIN, KEY4_PIN};
+
+static TimerHandle_t key_timer = NULL;              // 消抖/长按/连发共用的单次定时器
+static key_event_cb_t key_callback = NULL;          // 事件回调
+static uint8_t key_repeat_mask = KEY_REPEAT_DEFAULT;// 允许连发的按键
+static uint8_t key_stable = 0;                      // 消抖后的按下状态（位掩码）
+static uint8_t key_long_sent = 0;                   // 已发出长按事件的按键
+static TickType_t key_press_tick[KEY_COUNT];        // 按下时刻
+static TickType_t key_next_repeat[KEY_COUNT];       // 下一次连发时刻
+
+/**
+  * 函    数：读取当前按下的按键
+  * 返 回 值：位掩码，bit0~bit3 对应 KEY1~KEY4，1表示按下
+  */
+static uint8_t Key_Read(void)
+{
+	uint16_t level = GPIO_ReadInputData(GPIOB);
+	uint8_t pressed = 0;
+
+	for (uint8_t i = 0; i < KEY_COUNT; i++)
+	{
+		if ((level & key_pins[i]) == 0)
+		{
+			pressed |= (uint8_t)(1U << i);
+		}
+	}
+	return pressed;
+}
+
+static void Key_Emit(uint8_t index, key_action_t action, TickType_t tick)
+{
+	if (key_callback != NULL)
+	{
+		key_callback(index + 1, action, tick);
+	}
+}
+
+/**
+  * 函    数：定时器回调（定时器任务上下文）
+  * 说    明：边沿中断后延时 KEY_DEBOUNCE_MS 采样一次得到稳定状态；
+  *           有按键按住时按最近的长按/连发时刻重新启动定时器，全部松开后停止
+  */
+static void Key_Timer_Callback(TimerHandle_t timer)
+{
+	TickType_t now = xTaskGetTickCount();
+	TickType_t next = portMAX_DELAY;
+	uint8_t pressed = Key_Read();
+	uint8_t changed = pressed ^ key_stable;
+
+	for (uint8_t i = 0; i < KEY_COUNT; i++)
+	{
+		uint8_t bit = (uint8_t)(1U << i);
+
+		if (changed & bit)
+		{
+			if (pressed & bit)
+			{
+				key_press_tick[i] = now;
+				key_long_sent &= (uint8_t)~bit;
+				Key_Emit(i, KEY_ACTION_PRESS, now);
+			}
+			else
+			{
+				Key_Emit(i, KEY_ACTION_RELEASE, now);
+			}
+		}
+
+		if (!(pressed & bit))
+		{
+			continue;
+		}
+
+		// 按住中：长按判定
+		if (!(key_long_sent & bit))
+		{
+			TickType_t held = now - key_press_tick[i];
+			if (held >= pdMS_TO_TICKS(KEY_LONG_PRESS_MS))
+			{
+				key_long_sent |= bit;
+				key_next_repeat[i] = now + pdMS_TO_TICKS(KEY_REPEAT_MS);
+				Key_Emit(i, KEY_ACTION_LONG, now);
+			}
+			else
+			{
+				TickType_t left = pdMS_TO_TICKS(KEY_LONG_PRESS_MS) - held;
+				if (left < next)
+					next = left;
+				continue;
+			}
+		}
+
+		// 长按后连发
+		if (key_repeat_mask & bit)
+		{
+			if ((int32_t)(now - key_next_repeat[i]) >= 0)
+			{
+				key_next_repeat[i] = now + pdMS_TO_TICKS(KEY_REPEAT_MS);
+				Key_Emit(i, KEY_ACTION_REPEAT, now);
+			}
+			TickType_t left = key_next_repeat[i] - now;
+			if (left < next)
+				next = left;
+		}
+	}
+
+	key_stable = pressed;
+
+	if (next != portMAX_DELAY)
+	{
+		xTimerChangePeriod(timer, next > 0 ? next : 1, 0);
+	}
+}
+
 /**
   * 函    数：按键初始化
   * 参    数：无
   * 返 回 值：无
+  * 说    明：PB12~PB15 上拉输入，双边沿触发EXTI，消抖与长按由软件定时器完成
+  *           需在调度器启动后、定时器任务可用时调用
   */
 void Key_Init(void)
 {
 	/*开启时钟*/
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);		//开启GPIOB的时钟
-	
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO, ENABLE);	//开启GPIOB和AFIO的时钟
+
 	/*GPIO初始化*/
 	GPIO_InitTypeDef GPIO_InitStructure;
 	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
 	GPIO_InitStructure.GPIO_Pin = KEY1_PIN | KEY2_PIN|KEY3_PIN|KEY4_PIN;
 	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-	GPIO_Init(GPIOB, &GPIO_InitStructure);						
+	GPIO_Init(GPIOB, &GPIO_InitStructure);
+
+	key_timer = xTimerCreate("Key", pdMS_TO_TICKS(KEY_DEBOUNCE_MS), pdFALSE, NULL, Key_Timer_Callback);
+	if (key_timer == NULL)
+	{
+		printf("Key: timer create failed\r\n");
+		return;
+	}
+	key_stable = Key_Read();
+
+	/*EXTI线映射到PB12~PB15*/
+	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource12);
+	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource13);
+	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource14);
+	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource15);
+
+	EXTI_InitTypeDef EXTI_InitStructure;
+	EXTI_InitStructure.EXTI_Line = EXTI_Line12 | EXTI_Line13 | EXTI_Line14 | EXTI_Line15;
+	EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+	EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Rising_Falling;
+	EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+	EXTI_ClearITPendingBit(EXTI_InitStructure.EXTI_Line);
+	EXTI_Init(&EXTI_InitStructure);
+
+	/*中断优先级需低于 configMAX_SYSCALL_INTERRUPT_PRIORITY，中断中调用 FromISR 接口*/
+	NVIC_InitTypeDef NVIC_InitStructure;
+	NVIC_InitStructure.NVIC_IRQChannel = EXTI15_10_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 7;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
 }
 
 /**
-  * 函    数：按键获取键码
-  * 参    数：无
-  * 返 回 值：按下按键的键码值，范围：0~2，返回0代表没有按键按下
-  * 注意事项：此函数是阻塞式操作，当按键按住不放时，函数会卡住，直到按键松手
+  * 函    数：注册按键事件回调
+  * 参    数：callback 回调函数，NULL表示丢弃事件
   */
-uint8_t Key_GetNum(void)
+void Key_SetEventCallback(key_event_cb_t callback)
 {
-	uint8_t KeyNum = 0;		//定义变量，默认键码值为0
-	
-	if (KEY1 == 0)			//读PB1输入寄存器的状态，如果为0，则代表按键1按下
-	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY1 == 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 1;												//置键码为1
-	}
-	
-	if (KEY2 == 0)			//读PB11输入寄存器的状态，如果为0，则代表按键2按下
-	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY2== 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 2;												//置键码为2
-	}
+	key_callback = callback;
+}
 
-	if (KEY3 == 0)			//读PB11输入寄存器的状态，如果为0，则代表按键2按下
-	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY3== 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 3;												//置键码为2
-	}
+/**
+  * 函    数：设置允许长按连发的按键
+  * 参    数：mask KEY_MASK(n) 组合，默认 KEY_REPEAT_DEFAULT
+  */
+void Key_SetRepeatMask(uint8_t mask)
+{
+	key_repeat_mask = mask;
+}
 
-	if (KEY4 == 0)			//读PB11输入寄存器的状态，如果为0，则代表按键2按下
-	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY4== 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 4;												//置键码为2
-	}
-	
-	return KeyNum;			//返回键码值，如果没有按键按下，所有if都不成立，则键码为默认值0
+/**
+  * 函    数：获取消抖后的按键状态
+  * 返 回 值：位掩码，bit0~bit3 对应 KEY1~KEY4，1表示按下
+  */
+uint8_t Key_GetState(void)
+{
+	return key_stable;
 }
-uint8_t KEY_Get(void)
+
+/**
+  * 函    数：EXTI10~15中断，任一按键边沿都重新开始消抖计时
+  */
+void EXTI15_10_IRQHandler(void)
 {
-	return Key_GetNum();
+	BaseType_t woken = pdFALSE;
+	uint32_t lines = EXTI_Line12 | EXTI_Line13 | EXTI_Line14 | EXTI_Line15;
+
+	if (EXTI->PR & lines)
+	{
+		EXTI_ClearITPendingBit(lines);
+		if (key_timer != NULL)
+		{
+			xTimerChangePeriodFromISR(key_timer, pdMS_TO_TICKS(KEY_DEBOUNCE_MS), &woken);
+		}
+	}
+	portYIELD_FROM_ISR(woken);
 }
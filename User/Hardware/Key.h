@@ -8,9 +8,32 @@
 // 按键按键常量定义
 // ==================================
 
+#define KEY_COUNT           4       // 按键数量，键码1~4对应PB12~PB15
+#define KEY_DEBOUNCE_MS     20      // 消抖时间(ms)
+#define KEY_LONG_PRESS_MS   600     // 长按判定时间(ms)
+#define KEY_REPEAT_MS       100     // 长按后连发间隔(ms)
 
+#define KEY_MASK(key)       (1U << ((key) - 1))                 // 键码转位掩码
+#define KEY_REPEAT_DEFAULT  (KEY_MASK(1) | KEY_MASK(2))         // 默认连发：KEY1(上) KEY2(下)
+
+// 按键动作
+typedef enum {
+	KEY_ACTION_PRESS = 0,   // 按下（消抖后）
+	KEY_ACTION_RELEASE,     // 松开
+	KEY_ACTION_LONG,        // 长按（按住 KEY_LONG_PRESS_MS 后一次）
+	KEY_ACTION_REPEAT       // 连发（长按后每 KEY_REPEAT_MS 一次）
+} key_action_t;
+
+/**
+  * @brief 按键事件回调，在FreeRTOS定时器任务中执行，不能长时间阻塞
+  * @param key 键码(1~4)
+  * @param action 按键动作
+  * @param tick 事件发生时的系统节拍
+  */
+typedef void (*key_event_cb_t)(uint8_t key, key_action_t action, TickType_t tick);
 
 void Key_Init(void);
-uint8_t Key_GetNum(void);
-uint8_t KEY_Get(void);
+void Key_SetEventCallback(key_event_cb_t callback);
+void Key_SetRepeatMask(uint8_t mask);
+uint8_t Key_GetState(void);
 #endif
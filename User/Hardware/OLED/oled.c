@@ -1,10 +1,73 @@
 #include "oled.h"
 #include "stdlib.h"
+#include "string.h"
 #include "oledfont.h"
+#include "perf.h"
 
-static uint8_t OLED_GRAM[144][8];
+// 显存按页优先排列：OLED_GRAM[page][x]，同一页的一段列在内存中连续，可直接memset/整段发送
+static uint8_t OLED_GRAM[8][128];
+// 脏区域按页记录列范围：dirty_x1[page] > dirty_x2[page] 表示该页干净
+// 不同页上互不相邻的小块改动各自只刷新自己的列，不会合并成一个大矩形
+static uint8_t dirty_x1[8] = {127, 127, 127, 127, 127, 127, 127, 127};
+static uint8_t dirty_x2[8] = {0};
 static uint8_t dirty_flag = 0;
-static uint8_t dirty_x1 = 127, dirty_y1 = 63, dirty_x2 = 0, dirty_y2 = 0;
+static uint8_t flush_hold = 0; // 1:暂停向屏幕刷新（硬件滚动/切换动画期间）
+
+// 把显存第page页的[x1,x2]列写入屏幕对应位置
+static void OLED_Write_Page(uint8_t page, uint8_t x1, uint8_t x2)
+{
+	OLED_WR_Byte(0xb0 + page, OLED_CMD);			// 设置页地址
+	OLED_WR_Byte(x1 & 0x0f, OLED_CMD);			// 低列地址
+	OLED_WR_Byte(0x10 | (x1 >> 4), OLED_CMD);		// 高列地址
+	OLED_Send_Bytes(0x3c, 0x40, x2 - x1 + 1, &OLED_GRAM[page][x1]);
+}
+
+// 对第page页[x1,x2]列中mask选中的位执行mode操作
+// mask为0xFF且不是反色时整段memset，否则逐字节按位操作
+static void OLED_Span_Apply(uint8_t page, uint8_t x1, uint8_t x2, uint8_t mask, uint8_t mode)
+{
+	uint8_t *p = &OLED_GRAM[page][x1];
+	uint8_t n = x2 - x1 + 1;
+
+	if (mask == 0xFF && mode != OLED_PIXEL_INVERT)
+	{
+		memset(p, (mode == OLED_PIXEL_SET) ? 0xFF : 0x00, n);
+		return;
+	}
+
+	switch (mode)
+	{
+	case OLED_PIXEL_CLEAR:
+		while (n--)
+			*p++ &= (uint8_t)~mask;
+		break;
+	case OLED_PIXEL_SET:
+		while (n--)
+			*p++ |= mask;
+		break;
+	default:
+		while (n--)
+			*p++ ^= mask;
+		break;
+	}
+}
+
+// 对已裁剪的闭区间矩形(x1,y1)~(x2,y2)逐页执行mode操作
+static void OLED_Fill_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode)
+{
+	uint8_t page, mask;
+	uint8_t page1 = y1 >> 3, page2 = y2 >> 3;
+
+	for (page = page1; page <= page2; page++)
+	{
+		mask = 0xFF;
+		if (page == page1)
+			mask &= (uint8_t)(0xFF << (y1 & 7));
+		if (page == page2)
+			mask &= (uint8_t)(0xFF >> (7 - (y2 & 7)));
+		OLED_Span_Apply(page, x1, x2, mask, mode);
+	}
+}
 
 // 发送一个字节
 // mode:数据/命令标志 0,表示命令;1,表示数据;
@@ -13,9 +76,7 @@ void OLED_WR_Byte(uint8_t dat, uint8_t mode)
 	
 	if (mode)
 	{
-		printf("OLED_Send_Byte satrt ->\n");
 		OLED_Send_Byte(0x3c, 0x40, dat); 
-		printf("<- OLED_Send_Byte end\n");
 	}
 	else
 	{
@@ -71,27 +132,26 @@ void OLED_DisPlay_Off(void)
 // 更新显存到OLED,更新后显示的才是你配置后的内容
 void OLED_Refresh(void)
 {
-	uint8_t i, n;
-	uint8_t data[128];
-	for (i = 0; i < 8; i++)
+	uint8_t i;
+
+	if (flush_hold)
 	{
-		for (n = 0; n < 128; n++)
-		{
-			data[n] = OLED_GRAM[n][i];
-		}
+		OLED_Set_Dirty_Area(0, 0, 127, 63); // 暂停期间只记录，恢复后补刷
+		return;
+	}
 
-		OLED_WR_Byte(0xb0 + i, OLED_CMD); // 设置行起始地址
-		OLED_WR_Byte(0x00, OLED_CMD);	  // 设置低列起始地址
-		OLED_WR_Byte(0x10, OLED_CMD);	  // 设置高列起始地址
-		OLED_Send_Bytes(0x3c, 0x40, 128, data);
+	uint32_t t0 = Perf_Stamp();
+	for (i = 0; i < 8; i++)
+	{
+		OLED_Write_Page(i, 0, 127);
 	}
+	Perf_Flush_Done(t0, sizeof(OLED_GRAM));
 }
 
 // 局部刷新函数，只刷新指定区域 (x1,y1) 到 (x2,y2)
 void OLED_Refresh_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
 {
-	uint8_t i, n, start_page, end_page, start_col, end_col;
-	uint8_t data[128];
+	uint8_t i, start_page, end_page;
 	
 	// 参数检查和修正
 	if (x1 > x2) { uint8_t temp = x1; x1 = x2; x2 = temp; }
@@ -102,39 +162,31 @@ void OLED_Refresh_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
 	if (x2 >= 128) x2 = 127;
 	if (y1 >= 64) y1 = 63;
 	if (y2 >= 64) y2 = 63;
+
+	if (flush_hold)
+	{
+		OLED_Set_Dirty_Area(x1, y1, x2, y2);
+		return;
+	}
 	
 	// 计算页面范围（每页8行）
 	start_page = y1 / 8;
 	end_page = y2 / 8;
 	
-	// 计算列范围
-	start_col = x1;
-	end_col = x2;
-	
-	// 刷新指定区域
+	// 刷新指定区域，只发送指定的列范围
+	uint32_t t0 = Perf_Stamp();
 	for (i = start_page; i <= end_page; i++)
 	{
-		// 设置页面地址
-		OLED_WR_Byte(0xb0 + i, OLED_CMD);
-		
-		// 只刷新指定的列范围
-		for (n = start_col; n <= end_col; n++)
-		{
-			data[n - start_col] = OLED_GRAM[n][i];
-		}
-		
-		// 设置列地址
-		OLED_WR_Byte(start_col & 0x0f, OLED_CMD);        // 低列地址
-		OLED_WR_Byte(0x10 | (start_col >> 4), OLED_CMD); // 高列地址
-		
-		// 发送数据
-		OLED_Send_Bytes(0x3c, 0x40, end_col - start_col + 1, data);
+		OLED_Write_Page(i, x1, x2);
 	}
+	Perf_Flush_Done(t0, (uint16_t)((end_page - start_page + 1) * (x2 - x1 + 1)));
 }
 
 // 标记脏区域，用于自动局部刷新
 void OLED_Set_Dirty_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
 {
+	uint8_t page;
+
 	// 参数检查和修正
 	if (x1 > x2) { uint8_t temp = x1; x1 = x2; x2 = temp; }
 	if (y1 > y2) { uint8_t temp = y1; y1 = y2; y2 = temp; }
@@ -145,111 +197,205 @@ void OLED_Set_Dirty_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
 	if (y1 >= 64) y1 = 63;
 	if (y2 >= 64) y2 = 63;
 	
-	// 更新脏区域
-	if (!dirty_flag) {
-		dirty_x1 = x1; dirty_y1 = y1; dirty_x2 = x2; dirty_y2 = y2;
-		dirty_flag = 1;
-	} else {
-		if (x1 < dirty_x1) dirty_x1 = x1;
-		if (y1 < dirty_y1) dirty_y1 = y1;
-		if (x2 > dirty_x2) dirty_x2 = x2;
-		if (y2 > dirty_y2) dirty_y2 = y2;
+	// 按页合并列范围
+	for (page = y1 / 8; page <= y2 / 8; page++)
+	{
+		if (x1 < dirty_x1[page]) dirty_x1[page] = x1;
+		if (x2 > dirty_x2[page]) dirty_x2[page] = x2;
 	}
+	dirty_flag = 1;
 }
 
-// 刷新脏区域
+// 刷新脏区域，每个脏页只发送改动过的列
 void OLED_Refresh_Dirty(void)
 {
-	if (dirty_flag) {
-		OLED_Refresh_Area(dirty_x1, dirty_y1, dirty_x2, dirty_y2);
-		dirty_flag = 0;
-		dirty_x1 = 127; dirty_y1 = 63; dirty_x2 = 0; dirty_y2 = 0;
+	uint8_t page;
+	uint16_t bytes = 0;
+
+	if (!dirty_flag || flush_hold)
+		return;
+
+	uint32_t t0 = Perf_Stamp();
+	for (page = 0; page < 8; page++)
+	{
+		if (dirty_x1[page] <= dirty_x2[page])
+		{
+			OLED_Write_Page(page, dirty_x1[page], dirty_x2[page]);
+			bytes += dirty_x2[page] - dirty_x1[page] + 1;
+		}
 	}
+	OLED_Discard_Dirty();
+	Perf_Flush_Done(t0, bytes);
 }
-// 清屏函数
-void OLED_Clear(void)
+// 丢弃已记录的脏区域（显存内容将由调用者整体上传时使用）
+void OLED_Discard_Dirty(void)
 {
-	uint8_t i, n;
-	for (i = 0; i < 8; i++)
+	memset(dirty_x1, 127, sizeof(dirty_x1));
+	memset(dirty_x2, 0, sizeof(dirty_x2));
+	dirty_flag = 0;
+}
+
+// 暂停/恢复向屏幕刷新
+// hold:1 暂停，期间的刷新请求只累积到脏区域；0 恢复
+void OLED_Flush_Hold(uint8_t hold)
+{
+	flush_hold = hold;
+}
+
+uint8_t OLED_Is_Flush_Held(void)
+{
+	return flush_hold;
+}
+
+// 无视暂停标志，把显存第page页整页写入屏幕（切换动画逐页上传用）
+void OLED_Refresh_Page(uint8_t page)
+{
+	if (page < 8)
 	{
-		for (n = 0; n < 128; n++)
-		{
-			OLED_GRAM[n][i] = 0; // 清除所有数据
-		}
+		uint32_t t0 = Perf_Stamp();
+		OLED_Write_Page(page, 0, 127);
+		Perf_Flush_Done(t0, 128);
 	}
+}
+
+// 设置显示起始行(0~63)，屏幕第r行显示GDDRAM第(r+line)%64行
+void OLED_Set_Start_Line(uint8_t line)
+{
+	OLED_WR_Byte(0x40 | (line & 0x3F), OLED_CMD);
+}
+
+// 清屏函数
+void OLED_Clear(void)
+{
+	memset(OLED_GRAM, 0, sizeof(OLED_GRAM)); // 清除所有数据
 	OLED_Refresh(); // 更新显示
 }
 
 // 画点
 // x:0~127
-// y:0~63
+// y:0~63 超出屏幕的点直接忽略
 // t:1 填充 0,清空
 void OLED_DrawPoint(uint8_t x, uint8_t y, uint8_t t)
 {
-	uint8_t i, m, n;
-	i = y / 8;
-	m = y % 8;
-	n = 1 << m;
+	uint8_t i, n;
+
+	if (x >= 128 || y >= 64)
+		return;
+
+	i = y >> 3;
+	n = 1 << (y & 7);
 	if (t)
 	{
-		OLED_GRAM[x][i] |= n;
+		OLED_GRAM[i][x] |= n;
 	}
 	else
 	{
-		OLED_GRAM[x][i] = ~OLED_GRAM[x][i];
-		OLED_GRAM[x][i] |= n;
-		OLED_GRAM[x][i] = ~OLED_GRAM[x][i];
+		OLED_GRAM[i][x] &= (uint8_t)~n;
+	}
+}
+
+// 画水平线
+// x,y:起点坐标 w:长度(像素)
+// mode:0 清空 1 填充 2 反色
+void OLED_DrawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t mode)
+{
+	OLED_FillRect(x, y, w, 1, mode);
+}
+
+// 画垂直线
+// x,y:起点坐标 h:长度(像素)
+// mode:0 清空 1 填充 2 反色
+void OLED_DrawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t mode)
+{
+	OLED_FillRect(x, y, 1, h, mode);
+}
+
+// 填充矩形，按页生成字节掩码，整页部分直接memset
+// x,y:左上角坐标 w,h:宽高，超出屏幕的部分被裁剪
+// mode:0 清空 1 填充 2 反色
+void OLED_FillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t mode)
+{
+	uint16_t x2, y2;
+
+	if (w == 0 || h == 0 || x >= 128 || y >= 64)
+		return;
+
+	x2 = (uint16_t)x + w - 1;
+	y2 = (uint16_t)y + h - 1;
+	if (x2 > 127)
+		x2 = 127;
+	if (y2 > 63)
+		y2 = 63;
+
+	OLED_Fill_Area(x, y, (uint8_t)x2, (uint8_t)y2, mode);
+}
+
+// 画矩形边框
+// x,y:左上角坐标 w,h:宽高
+// mode:0 清空 1 填充 2 反色
+void OLED_DrawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t mode)
+{
+	if (w == 0 || h == 0)
+		return;
+
+	OLED_DrawHLine(x, y, w, mode);
+	if (h > 1)
+		OLED_DrawHLine(x, y + h - 1, w, mode);
+	if (h > 2)
+	{
+		OLED_DrawVLine(x, y + 1, h - 2, mode);
+		if (w > 1)
+			OLED_DrawVLine(x + w - 1, y + 1, h - 2, mode);
 	}
 }
 
-// 画线
+// 反色矩形区域（用于选中高亮）
+void OLED_InvertRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+	OLED_FillRect(x, y, w, h, OLED_PIXEL_INVERT);
+}
+
+// 画线（Bresenham），水平/垂直线走按页填充
 // x1,y1:起点坐标
 // x2,y2:结束坐标
+// mode:0 清空 1 填充
 void OLED_DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode)
 {
-	uint16_t t;
-	int xerr = 0, yerr = 0, delta_x, delta_y, distance;
-	int incx, incy, uRow, uCol;
-	delta_x = x2 - x1; // 计算坐标增量
-	delta_y = y2 - y1;
-	uRow = x1; // 画线起点坐标
-	uCol = y1;
-	if (delta_x > 0)
-		incx = 1; // 设置单步方向
-	else if (delta_x == 0)
-		incx = 0; // 垂直线
-	else
+	int16_t dx, dy, sx, sy, err, e2;
+	int16_t x = x1, y = y1;
+
+	if (y1 == y2)
 	{
-		incx = -1;
-		delta_x = -delta_x;
+		OLED_DrawHLine(x1 < x2 ? x1 : x2, y1, (uint8_t)abs(x2 - x1) + 1, mode);
+		return;
 	}
-	if (delta_y > 0)
-		incy = 1;
-	else if (delta_y == 0)
-		incy = 0; // 水平线
-	else
+	if (x1 == x2)
 	{
-		incy = -1;
-		delta_y = -delta_x;
+		OLED_DrawVLine(x1, y1 < y2 ? y1 : y2, (uint8_t)abs(y2 - y1) + 1, mode);
+		return;
 	}
-	if (delta_x > delta_y)
-		distance = delta_x; // 选取基本增量坐标轴
-	else
-		distance = delta_y;
-	for (t = 0; t < distance + 1; t++)
+
+	dx = abs(x2 - x1);
+	dy = -abs(y2 - y1);
+	sx = (x1 < x2) ? 1 : -1;
+	sy = (y1 < y2) ? 1 : -1;
+	err = dx + dy;
+
+	while (1)
 	{
-		OLED_DrawPoint(uRow, uCol, mode); // 画点
-		xerr += delta_x;
-		yerr += delta_y;
-		if (xerr > distance)
+		OLED_DrawPoint((uint8_t)x, (uint8_t)y, mode);
+		if (x == x2 && y == y2)
+			break;
+		e2 = 2 * err;
+		if (e2 >= dy) // 沿x方向前进
 		{
-			xerr -= distance;
-			uRow += incx;
+			err += dy;
+			x += sx;
 		}
-		if (yerr > distance)
+		if (e2 <= dx) // 沿y方向前进
 		{
-			yerr -= distance;
-			uCol += incy;
+			err += dx;
+			y += sy;
 		}
 	}
 }
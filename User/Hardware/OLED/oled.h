@@ -3,14 +3,19 @@
 
 #include "stm32f10x.h"
 
-/************************************ЩҪ㲹ȫ************************************** */
+/************************************这些宏需要你补全************************************** */
 #include "soft_i2c.h"
 #define OLED_I2C_Init()									Soft_I2C_Init()
 #define OLED_Send_Byte(dev_addr, reg_addr, data) 		Soft_I2C_Write_Byte(dev_addr, reg_addr, data)
 #define OLED_Send_Bytes(dev_addr, reg_addr, len, pdata) Soft_I2C_Write_Bytes(dev_addr, reg_addr, len, pdata)
 /****************************************end********************************************** */
-#define OLED_CMD 0  // д
-#define OLED_DATA 1 // д
+#define OLED_CMD 0  // 写命令
+#define OLED_DATA 1 // 写数据
+
+// 区域绘制模式（OLED_FillRect/OLED_DrawRect/OLED_DrawHLine/OLED_DrawVLine）
+#define OLED_PIXEL_CLEAR  0 // 清空
+#define OLED_PIXEL_SET    1 // 填充
+#define OLED_PIXEL_INVERT 2 // 反色
 void OLED_ClearPoint(uint8_t x, uint8_t y);
 void OLED_ColorTurn(uint8_t i);
 void OLED_DisplayTurn(uint8_t i);
@@ -21,9 +26,19 @@ void OLED_Refresh(void);
 void OLED_Refresh_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
 void OLED_Set_Dirty_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
 void OLED_Refresh_Dirty(void);
+void OLED_Discard_Dirty(void);
+void OLED_Flush_Hold(uint8_t hold);
+uint8_t OLED_Is_Flush_Held(void);
+void OLED_Refresh_Page(uint8_t page);
+void OLED_Set_Start_Line(uint8_t line);
 void OLED_Clear(void);
 void OLED_DrawPoint(uint8_t x, uint8_t y, uint8_t t);
 void OLED_DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode);
+void OLED_DrawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t mode);
+void OLED_DrawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t mode);
+void OLED_FillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t mode);
+void OLED_DrawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t mode);
+void OLED_InvertRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
 void OLED_DrawCircle(uint8_t x, uint8_t y, uint8_t r);
 void OLED_ShowChar(uint8_t x, uint8_t y, uint8_t chr, uint8_t size1, uint8_t mode);
 void OLED_ShowString(uint8_t x, uint8_t y, uint8_t *chr, uint8_t size1, uint8_t mode);
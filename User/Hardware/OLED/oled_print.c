@@ -13,11 +13,7 @@ void OLED_Printf(uint8_t x, uint8_t y, const char *format, ...)
 
     // 格式化字符串
     vsnprintf(oled_buffer, sizeof(oled_buffer), format, args);
- OLED_Clear_Rect(x,y,127,y+OLED_LINE_HEIGHT);
-    // 显示字符串
-    OLED_ShowString(x, y, (uint8_t *)oled_buffer, 12, 1);
-// OLED_Set_Dirty_Area(0, y, 127, y + OLED_LINE_HEIGHT - 1);
-    
+    OLED_Puts(x, y, oled_buffer);
 
     va_end(args);
 }
@@ -33,20 +29,9 @@ void OLED_Printf_Line(uint8_t line, const char *format, ...)
     va_list args;
     va_start(args, format);
 
-    // 计算Y坐标
-    uint8_t y = line * OLED_LINE_HEIGHT;
-
     // 格式化字符串
     vsnprintf(oled_buffer, sizeof(oled_buffer), format, args);
-
-    // 清除该行
-    OLED_Clear_Line(line);
-
-    // 显示字符串
-    OLED_ShowString(0, y, (uint8_t *)oled_buffer, 12, 1);
-
-    // 标记该行为脏区域，用于局部刷新
-    OLED_Set_Dirty_Area(0, y, strlen(format)*12, y + OLED_LINE_HEIGHT - 1);
+    OLED_Puts_Line(line, oled_buffer);
 
     va_end(args);
 }
@@ -62,22 +47,58 @@ void OLED_Printf_Line_32(uint8_t line, const char *format, ...)
     va_list args;
     va_start(args, format);
 
-    // 计算Y坐标
-    uint8_t y = line * OLED_LINE_HEIGHT;
-
     // 格式化字符串
     vsnprintf(oled_buffer, sizeof(oled_buffer), format, args);
+    OLED_Puts_Line_32(line, oled_buffer);
+
+    va_end(args);
+}
+
+/**
+ * @brief OLED字符串显示 - 在指定位置显示已格式化好的字符串（12号字体）
+ */
+void OLED_Puts(uint8_t x, uint8_t y, const char *str)
+{
+    // 清除到行尾（同时标记为脏区域）
+    OLED_Clear_Rect(x, y, 127, y + OLED_LINE_HEIGHT - 1);
+
+    // 显示字符串
+    OLED_ShowString(x, y, (uint8_t *)str, 12, 1);
+}
+
+/**
+ * @brief OLED行字符串显示 - 在指定行显示已格式化好的字符串
+ */
+void OLED_Puts_Line(uint8_t line, const char *str)
+{
+    if (line >= OLED_MAX_LINES)
+        return; // 防止越界
+
+    // 清除该行（同时标记为脏区域，用于局部刷新）
+    OLED_Clear_Line(line);
+
+    // 显示字符串
+    OLED_ShowString(0, line * OLED_LINE_HEIGHT, (uint8_t *)str, 12, 1);
+}
+
+/**
+ * @brief OLED行字符串显示32px - 在指定行显示已格式化好的字符串（24号字体）
+ */
+void OLED_Puts_Line_32(uint8_t line, const char *str)
+{
+    if (line >= OLED_MAX_LINES)
+        return; // 防止越界
+
+    uint8_t y = line * OLED_LINE_HEIGHT;
 
     // 清除该行
     OLED_Clear_Line(line);
 
     // 显示字符串
-    OLED_ShowString(0, y, (uint8_t *)oled_buffer, 24, 1);
+    OLED_ShowString(0, y, (uint8_t *)str, 24, 1);
 
     // 标记该行为脏区域，用于局部刷新
     OLED_Set_Dirty_Area(0, y, 127, y + (OLED_LINE_HEIGHT * 2) - 1);
-
-    va_end(args);
 }
 
 /**
@@ -131,16 +152,29 @@ void OLED_Display_Sensor(const char *sensor_name, float data1, float data2, cons
     OLED_Clear();
 
     // 第一行显示传感器名称
-    OLED_Printf_Line(0, "%s", sensor_name);
+    OLED_Puts_Line(0, sensor_name);
+
+    char line_buf[24];
+    fmt_buf_t f;
 
     // 第二行显示数据1
-    OLED_Printf_Line(1, "Data1: %.2f %s", data1, unit);
+    fmt_init(&f, line_buf, sizeof(line_buf));
+    fmt_str(&f, "Data1: ");
+    fmt_fixed(&f, fmt_to_fixed(data1, 2), 2, 0);
+    fmt_char(&f, ' ');
+    fmt_str(&f, unit);
+    OLED_Puts_Line(1, line_buf);
 
     // 第三行显示数据2
-    OLED_Printf_Line(2, "Data2: %.2f %s", data2, unit);
+    fmt_init(&f, line_buf, sizeof(line_buf));
+    fmt_str(&f, "Data2: ");
+    fmt_fixed(&f, fmt_to_fixed(data2, 2), 2, 0);
+    fmt_char(&f, ' ');
+    fmt_str(&f, unit);
+    OLED_Puts_Line(2, line_buf);
 
     // 第四行显示状态
-    OLED_Printf_Line(3, "Status: Active");
+    OLED_Puts_Line(3, "Status: Active");
 }
 // 清除指定矩形区域（x1,y1）→（x2,y2），并标记为脏区
 
@@ -167,14 +201,8 @@ void OLED_Clear_Rect(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
     if (y2 >= 64)
         y2 = 63;
 
-    // 按像素逐点清除（保守但安全）
-    for (uint8_t x = x1; x <= x2; x++)
-    {
-        for (uint8_t y = y1; y <= y2; y++)
-        {
-            OLED_DrawPoint(x, y, 0); // 0 = 清空点
-        }
-    }
+    // 按页掩码整段清除
+    OLED_FillRect(x1, y1, x2 - x1 + 1, y2 - y1 + 1, OLED_PIXEL_CLEAR);
 
     // 标记脏区
     OLED_Set_Dirty_Area(x1, y1, x2, y2);
@@ -223,71 +251,44 @@ void OLED_DrawProgressBar(
     // 画边框（可选）
     if (show_border)
     {
-        // 上边
-        for (uint8_t i = 0; i < width; i++)
-        {
-            OLED_DrawPoint(x + i, y, 1);
-        }
-        // 下边
-        for (uint8_t i = 0; i < width; i++)
-        {
-            OLED_DrawPoint(x + i, y + height - 1, 1);
-        }
-        // 左边
-        for (uint8_t i = 0; i < height; i++)
-        {
-            OLED_DrawPoint(x, y + i, 1);
-        }
-        // 右边
-        for (uint8_t i = 0; i < height; i++)
-        {
-            OLED_DrawPoint(x + width - 1, y + i, 1);
-        }
+        OLED_DrawRect(x, y, width, height, OLED_PIXEL_SET);
     }
 
     // 填充内部（可选）
     if (fill_mode)
     {
+        uint8_t b = show_border ? 1 : 0;
+        int16_t in_x1 = x + b, in_x2 = x + width - b;   // 内部区域 [in_x1, in_x2)
+        int16_t in_y1 = y + b, in_y2 = y + height - b;  // 内部区域 [in_y1, in_y2)
+        int16_t fx2 = in_x2, fy1 = in_y1;               // 填充区域右边界/上边界
 
-        if (point_mode==0)
+        if (width > height)
         {
-            OLED_DrawProgressBar(x,y,width,height,max_val,min_val,max_val,show_border,fill_mode,1);
+            // 横向：从左向右填充
+            fx2 = x + (int16_t)fill_w - b;
+            if (fx2 > in_x2)
+                fx2 = in_x2;
         }
-        
-        if (width > height)
+        else
         {
-            uint8_t x_fill_end = x + fill_w;
-            if (x_fill_end > x + width)
-                x_fill_end = x + width;
-            for (uint8_t xx = x + (show_border ? 1 : 0);
-                 xx < x_fill_end - (show_border ? 1 : 0);
-                 xx++)
-            {
-                for (uint8_t yy = y + (show_border ? 1 : 0);
-                     yy < y + height - (show_border ? 1 : 0);
-                     yy++)
-                {
-                    OLED_DrawPoint(xx, yy, (point_mode?1:0));
-                }
-            }
-        }else{
-             // 计算填充的起始Y坐标（从底部开始）
-            uint8_t y_fill_start = y + height - fill_h;
-            if (y_fill_start < y)
-                y_fill_start = y;
-            
-            for (uint8_t yy = y_fill_start + (show_border ? 1 : 0);
-                 yy < y + height - (show_border ? 1 : 0);
-                 yy++)
+            // 纵向：从底部向上填充
+            fy1 = y + height - (int16_t)fill_h + b;
+        }
+
+        if (point_mode == 0)
+        {
+            // 反色模式：先填满内部，再清除数值对应部分
+            if (in_x2 > in_x1 && in_y2 > in_y1)
             {
-                for (uint8_t xx = x + (show_border ? 1 : 0);
-                     xx < x + width - (show_border ? 1 : 0);
-                     xx++)
-                {
-                    OLED_DrawPoint(xx, yy, (point_mode?1:0));
-                }
+                OLED_FillRect(in_x1, in_y1, in_x2 - in_x1, in_y2 - in_y1, OLED_PIXEL_SET);
             }
         }
+
+        if (fx2 > in_x1 && in_y2 > fy1)
+        {
+            OLED_FillRect(in_x1, fy1, fx2 - in_x1, in_y2 - fy1,
+                          point_mode ? OLED_PIXEL_SET : OLED_PIXEL_CLEAR);
+        }
     }
 
     // 无需重复调用 OLED_Set_Dirty_Area()
@@ -8,6 +8,7 @@
 #include <string.h>
 #include "logo.h"
 #include "Delay.h"
+#include "strfmt.h"
 // OLED显示区域定义
 #define OLED_LINE_HEIGHT 16  // 每行高度（像素）
 #define OLED_MAX_LINES   4   // 最大行数（128x64像素屏幕）
@@ -32,6 +33,29 @@ void OLED_Printf(uint8_t x, uint8_t y, const char* format, ...);
  */
 void OLED_Printf_Line(uint8_t line, const char* format, ...);
 
+/**
+ * @brief OLED字符串显示 - 显示已格式化好的字符串，不经过vsnprintf
+ * @param x 起始X坐标（0-127）
+ * @param y 起始Y坐标（0-63）
+ * @param str 字符串
+ * @note 与OLED_Printf相同：12号字体，清除到行尾并标记脏区域
+ */
+void OLED_Puts(uint8_t x, uint8_t y, const char* str);
+
+/**
+ * @brief OLED行字符串显示 - 在指定行显示已格式化好的字符串
+ * @param line 行号（0-3）
+ * @param str 字符串
+ */
+void OLED_Puts_Line(uint8_t line, const char* str);
+
+/**
+ * @brief OLED行字符串显示32px - 24号字体，占两行
+ * @param line 起始行号（0-3）
+ * @param str 字符串
+ */
+void OLED_Puts_Line_32(uint8_t line, const char* str);
+
 /**
  * @brief OLED清屏指定行
  * @param line 行号（0-3）
@@ -0,0 +1,179 @@
+/**
+ * @file oled_transition.c
+ * @brief SSD1306 硬件辅助的页面切换动画实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "oled_transition.h"
+#include "oled.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ui_anim.h"
+
+// ==================================
+// 动画状态
+// ==================================
+
+typedef struct {
+    oled_transition_t type;     // 当前动画类型
+    uint8_t armed;              // 已开始但新画面尚未绘制
+    uint8_t step;               // 纵向滑动已完成的页数(0~8)
+    TickType_t last_tick;       // 纵向滑动的起始时间
+} oled_trans_state_t;
+
+static oled_trans_state_t trans = {OLED_TRANS_NONE, 0, 0, 0};
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief 纵向滑动一步：偏移起始行并上传即将露出的那一页
+ */
+static void OLED_Transition_Slide_Step(void)
+{
+    uint8_t page;
+
+    if (trans.type == OLED_TRANS_SLIDE_UP)
+    {
+        // 起始行下移8行，第step页被移到屏幕底部，写入新内容
+        page = trans.step;
+        OLED_Set_Start_Line((uint8_t)((page + 1) * 8));
+    }
+    else
+    {
+        // 起始行上移8行，第(7-step)页被移到屏幕顶部，写入新内容
+        page = 7 - trans.step;
+        OLED_Set_Start_Line((uint8_t)(page * 8));
+    }
+    OLED_Refresh_Page(page);
+    trans.step++;
+}
+
+/**
+ * @brief 结束动画，恢复刷新
+ * @param full 1-整屏重写 0-只补刷动画期间的脏区域
+ */
+static void OLED_Transition_End(uint8_t full)
+{
+    OLED_Set_Start_Line(0);
+
+    trans.type = OLED_TRANS_NONE;
+    trans.armed = 0;
+    OLED_Flush_Hold(0);
+
+    if (full)
+    {
+        OLED_Discard_Dirty();
+        OLED_Refresh();
+    }
+    else
+    {
+        OLED_Refresh_Dirty();
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+void OLED_Transition_Begin(oled_transition_t type)
+{
+    // 上一个动画还没结束，直接跳到终点
+    if (trans.type != OLED_TRANS_NONE)
+    {
+        OLED_Transition_Finish();
+    }
+
+    if (type == OLED_TRANS_NONE)
+    {
+        return;
+    }
+
+    trans.type = type;
+    trans.armed = 1;
+    trans.step = 0;
+    trans.last_tick = xTaskGetTickCount();
+    OLED_Flush_Hold(1);
+}
+
+uint8_t OLED_Transition_Poll(void)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    switch (trans.type)
+    {
+    case OLED_TRANS_SLIDE_UP:
+    case OLED_TRANS_SLIDE_DOWN:
+        if (trans.armed)
+        {
+            // 新画面已完整绘制到显存，每一页都会在滑动中上传一次
+            trans.armed = 0;
+            OLED_Discard_Dirty();
+            OLED_Transition_Slide_Step();
+            trans.last_tick = now;
+        }
+        else
+        {
+            // 按经过时间计算应到达的页数（先快后慢），轮询来晚时一次补齐
+            TickType_t total = pdMS_TO_TICKS(OLED_TRANS_STEP_MS * 8);
+            TickType_t elapsed = now - trans.last_tick;
+            uint8_t target = 8;
+
+            if (elapsed < total)
+            {
+                uint16_t p = (uint16_t)(((uint32_t)elapsed << 15) / total);
+                target = (uint8_t)(((uint32_t)ui_ease(UI_EASE_OUT_QUAD, p) * 8 + UI_ANIM_ONE - 1) >> 15);
+            }
+            while (trans.step < target && trans.step < 8)
+            {
+                OLED_Transition_Slide_Step();
+            }
+        }
+
+        if (trans.step >= 8)
+        {
+            // 只补刷滑动过程中页面又改动过的区域
+            OLED_Transition_End(0);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return trans.type != OLED_TRANS_NONE;
+}
+
+void OLED_Transition_Finish(void)
+{
+    if (trans.type != OLED_TRANS_NONE)
+    {
+        OLED_Transition_End(1);
+    }
+}
+
+uint8_t OLED_Transition_Active(void)
+{
+    return trans.type != OLED_TRANS_NONE;
+}
+
+uint8_t OLED_Transition_Accepts_Frame(void)
+{
+    return trans.type == OLED_TRANS_NONE || trans.armed;
+}
+
+oled_transition_t OLED_Transition_Reverse(oled_transition_t type)
+{
+    switch (type)
+    {
+    case OLED_TRANS_SLIDE_UP:
+        return OLED_TRANS_SLIDE_DOWN;
+    case OLED_TRANS_SLIDE_DOWN:
+        return OLED_TRANS_SLIDE_UP;
+    default:
+        return OLED_TRANS_NONE;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file oled_transition.h
+ * @brief SSD1306 硬件辅助的页面切换动画
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 纵向滑动：利用显示起始行(0x40~0x7F)让控制器整体平移画面，每步只上传
+ *           刚被移出屏幕、即将以新内容露出的那一页（128字节），整个切换共1KB。
+ * SSD1306 的连续水平滚动会把移出的列卷回另一侧，停止后还须重写整个滚动区域，
+ * 无法逐步露出新内容，因此不提供横向切换；首页左右平移由页面自行逐步重绘。
+ *
+ * 动画期间 OLED_Refresh* 被暂停，页面照常绘制到显存，由本模块负责上传。
+ */
+
+#ifndef __OLED_TRANSITION_H
+#define __OLED_TRANSITION_H
+
+#include "stm32f10x.h"
+
+typedef enum {
+    OLED_TRANS_NONE = 0,        // 无动画
+    OLED_TRANS_SLIDE_UP,        // 新画面自下而上推入
+    OLED_TRANS_SLIDE_DOWN       // 新画面自上而下推入
+} oled_transition_t;
+
+#define OLED_TRANS_STEP_MS      16      // 纵向滑动平均每页(8行)用时(ms)，全程按时间缓动
+
+/**
+ * @brief 开始一次切换动画
+ * @param type 动画类型
+ * @note 调用后应立即把新画面绘制到显存，再周期调用 OLED_Transition_Poll
+ */
+void OLED_Transition_Begin(oled_transition_t type);
+
+/**
+ * @brief 推进切换动画（新画面已绘制到显存后调用）
+ * @return 1-动画仍在进行 0-已结束
+ */
+uint8_t OLED_Transition_Poll(void);
+
+/**
+ * @brief 立即结束当前动画并整屏同步
+ */
+void OLED_Transition_Finish(void);
+
+/**
+ * @brief 查询是否有切换动画在进行
+ * @return 1-进行中 0-空闲
+ */
+uint8_t OLED_Transition_Active(void);
+
+/**
+ * @brief 当前是否应当绘制新帧
+ * @return 1-无动画或新画面尚未绘制 0-动画播放中，无需重绘
+ * @note 动画播放中继续绘制只会产生需要补刷的脏区域，调用者可据此跳过重绘
+ */
+uint8_t OLED_Transition_Accepts_Frame(void);
+
+/**
+ * @brief 获取反向动画（用于返回上一级）
+ * @param type 动画类型
+ * @return 反向动画类型
+ */
+oled_transition_t OLED_Transition_Reverse(oled_transition_t type);
+
+#endif // __OLED_TRANSITION_H
@@ -95,7 +95,7 @@ const unsigned char asc2_0806[][6] =
         {0x00, 0x44, 0x64, 0x54, 0x4C, 0x44}, // z
         {0x14, 0x14, 0x14, 0x14, 0x14, 0x14}, // horiz lines
 };
-// 12*12 ASCIIַ
+// 12*12 ASCII字符集点阵
 const unsigned char asc2_1206[95][12] = {
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*" ",0*/
     {0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00}, /*"!",1*/
@@ -193,7 +193,7 @@ const unsigned char asc2_1206[95][12] = {
     {0x00, 0x02, 0xDE, 0x20, 0x00, 0x00, 0x00, 0x04, 0x07, 0x00, 0x00, 0x00}, /*"}",93*/
     {0x02, 0x01, 0x02, 0x04, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*"~",94*/
 };
-// 16*16 ASCIIַ
+// 16*16 ASCII字符集点阵
 const unsigned char asc2_1608[][16] = {
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*" ",0*/
     {0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x30, 0x00, 0x00, 0x00}, /*"!",1*/
@@ -291,7 +291,7 @@ const unsigned char asc2_1608[][16] = {
     {0x00, 0x02, 0x02, 0x7C, 0x80, 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x3F, 0x00, 0x00, 0x00, 0x00}, /*"}",93*/
     {0x00, 0x06, 0x01, 0x01, 0x02, 0x02, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*"~",94*/
 };
-// 24*24 ASICIIַ
+// 24*24 ASICII字符集点阵
 const unsigned char asc2_2412[][36] = {
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*" ",0*/
     {0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x7F, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00}, /*"!",1*/
@@ -391,28 +391,28 @@ const unsigned char asc2_2412[][36] = {
 
 };
 
-// // 16*16
+// // 16*16字体
 // const unsigned char Hzk1[][32] = {
-//     {0x00, 0x00, 0xF8, 0x08, 0x08, 0x08, 0x08, 0x09, 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x80, 0x60, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*"",0*/
-//     {0x00, 0xE0, 0x00, 0xFF, 0x00, 0x20, 0xC0, 0x00, 0xFE, 0x00, 0x20, 0xC0, 0x00, 0xFF, 0x00, 0x00, 0x81, 0x40, 0x30, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00}, /*"",1*/
-//     {0x00, 0x00, 0xFE, 0x02, 0x96, 0x5A, 0x33, 0xFE, 0x32, 0x5A, 0x96, 0x02, 0xFE, 0x00, 0x00, 0x00, 0x04, 0x04, 0x05, 0x1D, 0x15, 0x15, 0x15, 0x15, 0x15, 0x55, 0x95, 0x55, 0x35, 0x04, 0x04, 0x00}, /*"",2*/
-//     {0x80, 0x80, 0xEE, 0x88, 0x88, 0x88, 0xE8, 0x8F, 0x08, 0x88, 0x78, 0x48, 0x4E, 0x40, 0xC0, 0x00, 0x00, 0x00, 0x7F, 0x24, 0x24, 0x24, 0x7F, 0x00, 0x81, 0x40, 0x30, 0x0F, 0x30, 0x41, 0x80, 0x00}, /*"Ƕ",3*/
-//     {0x40, 0x42, 0xCC, 0x00, 0x00, 0xE2, 0x22, 0x2A, 0x2A, 0xF2, 0x2A, 0x26, 0x22, 0xE0, 0x00, 0x00, 0x80, 0x40, 0x3F, 0x40, 0x80, 0xFF, 0x89, 0x89, 0x89, 0xBF, 0x89, 0xA9, 0xC9, 0xBF, 0x80, 0x00}, /*"ͨ",4*/
-//     {0x00, 0x80, 0x60, 0xF8, 0x07, 0x00, 0x04, 0x24, 0x24, 0x25, 0x26, 0x24, 0x24, 0x24, 0x04, 0x00, 0x01, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xF9, 0x49, 0x49, 0x49, 0x49, 0x49, 0xF9, 0x00, 0x00}, /*"",5*/
-//     {0x00, 0x00, 0xFE, 0x22, 0x22, 0xFE, 0x40, 0xA0, 0x9E, 0x82, 0x82, 0x82, 0x9E, 0xA0, 0x20, 0x00, 0x80, 0x60, 0x1F, 0x42, 0x82, 0x7F, 0x80, 0x80, 0x43, 0x2C, 0x10, 0x28, 0x44, 0x83, 0x80, 0x00}, /*"",6*/
-//     {0x00, 0x80, 0x60, 0xF8, 0x07, 0x80, 0x40, 0xB0, 0x8E, 0x80, 0x80, 0x87, 0x98, 0x60, 0x80, 0x00, 0x01, 0x00, 0x00, 0xFF, 0x00, 0x80, 0x40, 0x30, 0x0F, 0x00, 0x40, 0x80, 0x7F, 0x00, 0x00, 0x00}, /*"",7*/
-//     {0x04, 0x04, 0x04, 0x84, 0xE4, 0x3C, 0x27, 0x24, 0x24, 0x24, 0x24, 0xE4, 0x04, 0x04, 0x04, 0x00, 0x04, 0x02, 0x01, 0x00, 0xFF, 0x09, 0x09, 0x09, 0x09, 0x49, 0x89, 0x7F, 0x00, 0x00, 0x00, 0x00}, /*"",8*/
-//     {0x00, 0xFE, 0x22, 0x5A, 0x86, 0x00, 0xFE, 0x92, 0x92, 0x92, 0x92, 0x92, 0xFE, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x04, 0x08, 0x07, 0x00, 0xFF, 0x40, 0x20, 0x03, 0x0C, 0x14, 0x22, 0x41, 0x40, 0x00}, /*"",9*/
-//     {0x00, 0x80, 0x40, 0x20, 0x18, 0x06, 0x80, 0x00, 0x07, 0x18, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x20, 0x70, 0x28, 0x26, 0x21, 0x20, 0x20, 0x24, 0x38, 0x60, 0x00, 0x01, 0x01, 0x00}, /*"",10*/
-//     {0x00, 0x10, 0x12, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x12, 0x12, 0x02, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x10, 0x10, 0x10, 0x10, 0x3F, 0x00, 0x40, 0x80, 0x7F, 0x00, 0x00, 0x00}, /*"˾",11*/
-// 		{0x20,0x10,0x08,0xFC,0x23,0x10,0x88,0x67,0x04,0xF4,0x04,0x24,0x54,0x8C,0x00,0x00,0x40,0x30,0x00,0x77,0x80,0x81,0x88,0xB2,0x84,0x83,0x80,0xE0,0x00,0x11,0x60,0x00},/*"",12*/
-// 		{0x10,0x10,0xF0,0x1F,0x10,0xF0,0x00,0x80,0x82,0x82,0xE2,0x92,0x8A,0x86,0x80,0x00,0x40,0x22,0x15,0x08,0x16,0x61,0x00,0x00,0x40,0x80,0x7F,0x00,0x00,0x00,0x00,0x00},/*"",13*/
-// 		{0x00,0x00,0xF0,0x10,0x10,0x10,0x10,0xFF,0x10,0x10,0x10,0x10,0xF0,0x00,0x00,0x00,0x00,0x00,0x0F,0x04,0x04,0x04,0x04,0xFF,0x04,0x04,0x04,0x04,0x0F,0x00,0x00,0x00},/*"",14*/
-// 		{0x00,0xFE,0x02,0x12,0x92,0x92,0x92,0xF2,0x92,0x92,0x92,0x12,0x02,0xFE,0x00,0x00,0x00,0xFF,0x40,0x48,0x48,0x48,0x48,0x4F,0x48,0x4A,0x4C,0x48,0x40,0xFF,0x00,0x00},/*"",15*/
+//     {0x00, 0x00, 0xF8, 0x08, 0x08, 0x08, 0x08, 0x09, 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x80, 0x60, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*"广",0*/
+//     {0x00, 0xE0, 0x00, 0xFF, 0x00, 0x20, 0xC0, 0x00, 0xFE, 0x00, 0x20, 0xC0, 0x00, 0xFF, 0x00, 0x00, 0x81, 0x40, 0x30, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00}, /*"州",1*/
+//     {0x00, 0x00, 0xFE, 0x02, 0x96, 0x5A, 0x33, 0xFE, 0x32, 0x5A, 0x96, 0x02, 0xFE, 0x00, 0x00, 0x00, 0x04, 0x04, 0x05, 0x1D, 0x15, 0x15, 0x15, 0x15, 0x15, 0x55, 0x95, 0x55, 0x35, 0x04, 0x04, 0x00}, /*"粤",2*/
+//     {0x80, 0x80, 0xEE, 0x88, 0x88, 0x88, 0xE8, 0x8F, 0x08, 0x88, 0x78, 0x48, 0x4E, 0x40, 0xC0, 0x00, 0x00, 0x00, 0x7F, 0x24, 0x24, 0x24, 0x7F, 0x00, 0x81, 0x40, 0x30, 0x0F, 0x30, 0x41, 0x80, 0x00}, /*"嵌",3*/
+//     {0x40, 0x42, 0xCC, 0x00, 0x00, 0xE2, 0x22, 0x2A, 0x2A, 0xF2, 0x2A, 0x26, 0x22, 0xE0, 0x00, 0x00, 0x80, 0x40, 0x3F, 0x40, 0x80, 0xFF, 0x89, 0x89, 0x89, 0xBF, 0x89, 0xA9, 0xC9, 0xBF, 0x80, 0x00}, /*"通",4*/
+//     {0x00, 0x80, 0x60, 0xF8, 0x07, 0x00, 0x04, 0x24, 0x24, 0x25, 0x26, 0x24, 0x24, 0x24, 0x04, 0x00, 0x01, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xF9, 0x49, 0x49, 0x49, 0x49, 0x49, 0xF9, 0x00, 0x00}, /*"信",5*/
+//     {0x00, 0x00, 0xFE, 0x22, 0x22, 0xFE, 0x40, 0xA0, 0x9E, 0x82, 0x82, 0x82, 0x9E, 0xA0, 0x20, 0x00, 0x80, 0x60, 0x1F, 0x42, 0x82, 0x7F, 0x80, 0x80, 0x43, 0x2C, 0x10, 0x28, 0x44, 0x83, 0x80, 0x00}, /*"股",6*/
+//     {0x00, 0x80, 0x60, 0xF8, 0x07, 0x80, 0x40, 0xB0, 0x8E, 0x80, 0x80, 0x87, 0x98, 0x60, 0x80, 0x00, 0x01, 0x00, 0x00, 0xFF, 0x00, 0x80, 0x40, 0x30, 0x0F, 0x00, 0x40, 0x80, 0x7F, 0x00, 0x00, 0x00}, /*"份",7*/
+//     {0x04, 0x04, 0x04, 0x84, 0xE4, 0x3C, 0x27, 0x24, 0x24, 0x24, 0x24, 0xE4, 0x04, 0x04, 0x04, 0x00, 0x04, 0x02, 0x01, 0x00, 0xFF, 0x09, 0x09, 0x09, 0x09, 0x49, 0x89, 0x7F, 0x00, 0x00, 0x00, 0x00}, /*"有",8*/
+//     {0x00, 0xFE, 0x22, 0x5A, 0x86, 0x00, 0xFE, 0x92, 0x92, 0x92, 0x92, 0x92, 0xFE, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x04, 0x08, 0x07, 0x00, 0xFF, 0x40, 0x20, 0x03, 0x0C, 0x14, 0x22, 0x41, 0x40, 0x00}, /*"限",9*/
+//     {0x00, 0x80, 0x40, 0x20, 0x18, 0x06, 0x80, 0x00, 0x07, 0x18, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x20, 0x70, 0x28, 0x26, 0x21, 0x20, 0x20, 0x24, 0x38, 0x60, 0x00, 0x01, 0x01, 0x00}, /*"公",10*/
+//     {0x00, 0x10, 0x12, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x12, 0x12, 0x02, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x10, 0x10, 0x10, 0x10, 0x3F, 0x00, 0x40, 0x80, 0x7F, 0x00, 0x00, 0x00}, /*"司",11*/
+// 		{0x20,0x10,0x08,0xFC,0x23,0x10,0x88,0x67,0x04,0xF4,0x04,0x24,0x54,0x8C,0x00,0x00,0x40,0x30,0x00,0x77,0x80,0x81,0x88,0xB2,0x84,0x83,0x80,0xE0,0x00,0x11,0x60,0x00},/*"您",12*/
+// 		{0x10,0x10,0xF0,0x1F,0x10,0xF0,0x00,0x80,0x82,0x82,0xE2,0x92,0x8A,0x86,0x80,0x00,0x40,0x22,0x15,0x08,0x16,0x61,0x00,0x00,0x40,0x80,0x7F,0x00,0x00,0x00,0x00,0x00},/*"好",13*/
+// 		{0x00,0x00,0xF0,0x10,0x10,0x10,0x10,0xFF,0x10,0x10,0x10,0x10,0xF0,0x00,0x00,0x00,0x00,0x00,0x0F,0x04,0x04,0x04,0x04,0xFF,0x04,0x04,0x04,0x04,0x0F,0x00,0x00,0x00},/*"中",14*/
+// 		{0x00,0xFE,0x02,0x12,0x92,0x92,0x92,0xF2,0x92,0x92,0x92,0x12,0x02,0xFE,0x00,0x00,0x00,0xFF,0x40,0x48,0x48,0x48,0x48,0x4F,0x48,0x4A,0x4C,0x48,0x40,0xFF,0x00,0x00},/*"国",15*/
 			
 // };
 
-// // 24*24
+// // 24*24字体
 // const unsigned char Hzk2[][72] = {
 
 //     {0x00, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0x08, 0x88, 0xA8, 0xCC, 0x8A, 0xF8, 0x88, 0xC8,
@@ -420,11 +420,11 @@ const unsigned char asc2_2412[][36] = {
 //      0xBF, 0xBF, 0x98, 0x98, 0x94, 0x93, 0x91, 0x9F, 0x91, 0x92, 0x92, 0x96, 0x9C, 0x90,
 //      0xBF, 0x80, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06,
 //      0x03, 0x02, 0x02, 0x02, 0x02, 0x22, 0x22, 0x62, 0x62, 0x3E, 0x0E, 0x00, 0x00, 0x00,
-//      0x00, 0x00}, /*"",0*/
+//      0x00, 0x00}, /*"粤",0*/
 
 // };
 
-// // 32*32
+// // 32*32字体
 // const unsigned char Hzk3[][128] = {
 //     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xE0, 0x20, 0x20, 0xA0, 0xA0, 0x30, 0x2C,
 //      0x28, 0xA0, 0xA0, 0x20, 0x20, 0x20, 0xA0, 0x20, 0x20, 0x20, 0xF0, 0xE0, 0x20, 0x00,
@@ -435,11 +435,11 @@ const unsigned char asc2_2412[][36] = {
 //      0x92, 0x93, 0x92, 0x92, 0xD7, 0x93, 0x18, 0x1C, 0x18, 0x10, 0x00, 0x00, 0x00, 0x00,
 //      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
 //      0x00, 0x10, 0x10, 0x30, 0x70, 0x70, 0x38, 0x1F, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00,
-//      0x00, 0x00}, /*"",0*/
+//      0x00, 0x00}, /*"粤",0*/
 
 // };
 
-// 64*64
+// 64*64字体
 // const unsigned char Hzk4[][512] = {
 //     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00,
 //      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xF8, 0xFC, 0x38,
@@ -477,7 +477,7 @@ const unsigned char asc2_2412[][36] = {
 //      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 //      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x1F,
 //      0x0F, 0x0F, 0x0F, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-//      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*"",0*/
+//      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /*"粤",0*/
 
 // };
 #endif
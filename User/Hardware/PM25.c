@@ -25,9 +25,6 @@ void PM25_Init(void)
     // 1. 使能时钟
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOC | RCC_APB2Periph_ADC2, ENABLE);
     
-    // 延时确保时钟稳定
-    Delay_ms(100);
-    
     // 配置ADC时钟为12MHz (72MHz/6)，确保不超过14MHz限制
     RCC_ADCCLKConfig(RCC_PCLK2_Div6);
     
@@ -99,19 +96,14 @@ float PM25_GetVoltage(void)
 }
 
 /**
-  * @brief  读取PM2.5浓度值
+  * @brief  按传感器时序点亮LED采样一次ADC
   * @param  无
-  * @retval PM2.5浓度 (μg/m³)
-  * @note   参考公式：PM2.5(μg/m³) = (0.17 * Vout - 0.1) * 1000
-  *         简化后：PM2.5 = 170 * Vout - 100
+  * @retval ADC原始值(0-4095)
   */
-float PM25_ReadPM25(void)
+uint16_t PM25_ReadRaw(void)
 {
-    float voltage = 0.0f;
-    float pm25 = 0.0f;
-    uint16_t adc_raw = 0;
-    
-    // 根据参考代码修改的驱动时序：
+    uint16_t adc_raw;
+
     // 1. 开启LED (低电平有效)
     GPIO_ResetBits(PM25_LED_PORT, PM25_LED_PIN);
     
@@ -120,10 +112,28 @@ float PM25_ReadPM25(void)
     
     // 3. 读取ADC值
     adc_raw = PM25_GetRawValue();
-    voltage = ((float)adc_raw / 4095.0f) * 5.0f;
     
     // 4. 关闭LED (高电平)
     GPIO_SetBits(PM25_LED_PORT, PM25_LED_PIN);
+    return adc_raw;
+}
+
+/**
+  * @brief  读取PM2.5浓度值
+  * @param  无
+  * @retval PM2.5浓度 (μg/m³)
+  * @note   参考公式：PM2.5(μg/m³) = (0.17 * Vout - 0.1) * 1000
+  *         简化后：PM2.5 = 170 * Vout - 100
+  */
+float PM25_ReadPM25(void)
+{
+    float voltage = 0.0f;
+    float pm25 = 0.0f;
+    uint16_t adc_raw = 0;
+    
+    // 根据参考代码修改的驱动时序：LED脉冲期间采样
+    adc_raw = PM25_ReadRaw();
+    voltage = ((float)adc_raw / 4095.0f) * 5.0f;
     
     // 调试信息
     // printf("PM25 DEBUG: ADC Raw=%d, Voltage=%.3fV\n", adc_raw, voltage);
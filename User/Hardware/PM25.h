@@ -22,6 +22,7 @@ typedef struct {
 // 函数声明
 void PM25_Init(void);
 uint16_t PM25_GetRawValue(void);
+uint16_t PM25_ReadRaw(void);
 float PM25_GetVoltage(void);
 float PM25_ReadPM25(void);
 uint8_t PM25_GetLevel(void);
@@ -1,24 +1,46 @@
 #include "debug.h"
 #include "FreeRTOS.h"
 #include "task.h"
-//7USARTжϷʵݽպͷ͡
+#include <string.h>
+
+static uint8_t debug_tx_ring[DEBUG_TX_RING_SIZE];   // USART1发送环形缓冲
+static uint16_t debug_tx_head = 0;                  // 写指针（自由递增，取模使用）
+static volatile uint16_t debug_tx_tail = 0;         // 已发送位置（中断中推进）
+static volatile uint16_t debug_tx_busy = 0;         // 当前DMA传输长度，0-空闲
+static volatile uint32_t debug_tx_drops = 0;        // 缓冲区满丢弃的字节数
+static void (*debug_rx_callback)(uint8_t byte) = NULL; // 接收字节回调
+
+// printf 行缓冲：各任务的输出先拼成整行，再一次放入发送缓冲区
+typedef struct
+{
+    TaskHandle_t owner;             // 正在拼行的任务
+    uint8_t len;                    // 0-空闲
+    char buf[DEBUG_LINE_MAX];
+} debug_line_t;
+
+static debug_line_t debug_lines[DEBUG_LINE_SLOTS];
+static volatile uint32_t debug_line_drops = 0;     // 缓冲区满丢弃的 printf 行数
+
+//7）在USART接收中断服务函数实现数据接收和发送。
 void USART1_IRQHandler(void)
 {   
-    uint16_t  temp = 0;        
-    //жϽձ־λǷ1
+    uint8_t temp = 0;
+    //判断接收标志位是否置1
     if(USART_GetITStatus(USART1, USART_IT_RXNE) == SET)
     {
-        USART_ClearITPendingBit(USART1, USART_IT_RXNE); //ձ־λ
+        USART_ClearITPendingBit(USART1, USART_IT_RXNE); //清除接收标志位
         
-        temp = USART_ReceiveData(USART1);    // ȡݣһֽڣ
-        if (temp == '1')
-		{
-			GPIO_ResetBits(GPIOB, GPIO_Pin_3);
-			vTaskDelay(200);
-			GPIO_SetBits(GPIOB, GPIO_Pin_3);
-		}
-	
-        USART_SendData(USART1, temp);        // ݷͻȥ
+        temp = (uint8_t)USART_ReceiveData(USART1);    // 读取数据（读一个字节）
+
+        if (debug_rx_callback != NULL)
+        {
+            // 接收用于遥测订阅等命令，不回显，避免混入二进制帧流
+            debug_rx_callback(temp);
+        }
+        else
+        {
+            Debug_TX_Write(&temp, 1);        // 将读到的数据发送回去
+        }
     }
 }
 
@@ -28,81 +50,282 @@ void debug_init(void)
     GPIO_InitTypeDef GPIO_InitStruct;
     USART_InitTypeDef USART_InitStruct;
     NVIC_InitTypeDef NVIC_InitStruct;
+    DMA_InitTypeDef DMA_InitStruct;
     
-    // 1ʹRXTXGPIOʱӺUSARTʱӣ
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);    // GPIOʱ
+    // 1）使能RX和TX引脚GPIO时钟和USART时钟；
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);    // GPIO时钟
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1, ENABLE); //for USART1 and USART6 
 
-    // 2ʼGPIOGPIOõUSART
+    // 2）初始化GPIO，并将GPIO复用到USART上
     GPIO_InitStruct.GPIO_Pin = GPIO_Pin_9 | GPIO_Pin_10;
-    GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;      // ģʽ
-    GPIO_InitStruct.GPIO_Speed = GPIO_Speed_50MHz; // 
+    GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;      // 复用推挽输出模式
+    GPIO_InitStruct.GPIO_Speed = GPIO_Speed_50MHz; // 高速
  
     GPIO_Init(GPIOA, &GPIO_InitStruct);
     
 //    GPIO_PinAFConfig(GPIOA, GPIO_PinSource9, GPIO_AF_USART1);
 //    GPIO_PinAFConfig(GPIOA, GPIO_PinSource10, GPIO_AF_USART1);
 
-    // 3USART
-    USART_InitStruct.USART_BaudRate = 115200;                        // 
-    USART_InitStruct.USART_WordLength = USART_WordLength_8b;        // 8λЧλ
-    USART_InitStruct.USART_StopBits = USART_StopBits_1;              // 1λֹͣλ
-    USART_InitStruct.USART_Parity = USART_Parity_No;                // У
-    USART_InitStruct.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;    // պͷģʽ
-    USART_InitStruct.USART_HardwareFlowControl = USART_HardwareFlowControl_None; // Ӳ
+    // 3）配置USART参数；
+    USART_InitStruct.USART_BaudRate = DEBUG_BAUDRATE;                // 波特率
+    USART_InitStruct.USART_WordLength = USART_WordLength_8b;        // 8位有效数据位
+    USART_InitStruct.USART_StopBits = USART_StopBits_1;              // 1位停止位
+    USART_InitStruct.USART_Parity = USART_Parity_No;                // 无校验
+    USART_InitStruct.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;    // 接收和发送数据模式
+    USART_InitStruct.USART_HardwareFlowControl = USART_HardwareFlowControl_None; // 无硬件控制流
     USART_Init(USART1, &USART_InitStruct);
 
-    // 4жϿʹUSARTж
+    // 4）配置中断控制器并使能USART接收中断
     USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);
 
-    // 5жȼҪжϲҪ裩
-    NVIC_InitStruct.NVIC_IRQChannel = USART1_IRQn;         // жͨ(жԴ)
-    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 1;
+    // 5）设置中断优先级（如果需要开启串口中断才需要这个步骤）
+    NVIC_InitStruct.NVIC_IRQChannel = USART1_IRQn;         // 中断通道(中断源)
+    // 中断中写发送缓冲区，优先级须在FreeRTOS可管理范围内
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 6;
     NVIC_InitStruct.NVIC_IRQChannelSubPriority = 2;
     NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStruct);
+
+    // 发送DMA：USART1_TX对应DMA1_Channel4，单次模式，每段重新装载
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+    DMA_DeInit(DMA1_Channel4);
+    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t)&USART1->DR;
+    DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)debug_tx_ring;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralDST;                // 数据方向：内存->外设
+    DMA_InitStruct.DMA_BufferSize = 1;                             // 每次启动时重新设置
+    DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStruct.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStruct.DMA_Priority = DMA_Priority_Low;
+    DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel4, &DMA_InitStruct);
+
+    DMA_ITConfig(DMA1_Channel4, DMA_IT_TC, ENABLE);
+    NVIC_InitStruct.NVIC_IRQChannel = DMA1_Channel4_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 7;
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    USART_DMACmd(USART1, USART_DMAReq_Tx, ENABLE);
     
-    // 6ʹUSART
+    // 6）使能USART；
     USART_Cmd(USART1, ENABLE);
 }
 
-// ͨ1Ƭַ
+// ==================================
+// DMA发送
+// ==================================
+
+/**
+ * @brief  发送缓冲区中还有数据且DMA空闲时，启动下一段连续数据的传输
+ * @note   在临界区或DMA中断中调用
+ */
+static void Debug_TX_Kick(void)
+{
+    uint16_t pending = (uint16_t)(debug_tx_head - debug_tx_tail);
+    uint16_t offset = debug_tx_tail & DEBUG_TX_RING_MASK;
+    uint16_t len;
+
+    if (debug_tx_busy != 0 || pending == 0)
+    {
+        return;
+    }
+
+    // 数据回绕时先发送到缓冲区末尾，剩余部分在传输完成中断中继续
+    len = DEBUG_TX_RING_SIZE - offset;
+    if (len > pending)
+    {
+        len = pending;
+    }
+
+    debug_tx_busy = len;
+    DMA_Cmd(DMA1_Channel4, DISABLE);
+    DMA1_Channel4->CMAR = (uint32_t)&debug_tx_ring[offset];
+    DMA_SetCurrDataCounter(DMA1_Channel4, len);
+    DMA_Cmd(DMA1_Channel4, ENABLE);
+}
+
+/**
+ * @brief  DMA1通道4中断服务函数（USART1发送完成一段）
+ */
+void DMA1_Channel4_IRQHandler(void)
+{
+    if (DMA_GetITStatus(DMA1_IT_TC4) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC4);
+
+        debug_tx_tail += debug_tx_busy;
+        debug_tx_busy = 0;
+        Debug_TX_Kick();
+    }
+}
+
+int8_t Debug_TX_Writev(const uart2_iov_t *iov, uint8_t count)
+{
+    uint16_t total = 0;
+    uint16_t head;
+    uint8_t i;
+    UBaseType_t mask;
+
+    for (i = 0; i < count; i++)
+    {
+        total += iov[i].len;
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    // 只屏蔽可管理的中断，调度器启动前和中断中都可使用；拷贝量小，屏蔽时间为微秒级
+    mask = taskENTER_CRITICAL_FROM_ISR();
+    if ((uint16_t)(DEBUG_TX_RING_SIZE - (uint16_t)(debug_tx_head - debug_tx_tail)) < total)
+    {
+        debug_tx_drops += total;
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+        return -1;
+    }
+
+    head = debug_tx_head;
+    for (i = 0; i < count; i++)
+    {
+        const uint8_t *src = (const uint8_t *)iov[i].data;
+        uint16_t left = iov[i].len;
+
+        while (left > 0)
+        {
+            uint16_t offset = head & DEBUG_TX_RING_MASK;
+            uint16_t n = DEBUG_TX_RING_SIZE - offset;
+            if (n > left)
+            {
+                n = left;
+            }
+            memcpy(&debug_tx_ring[offset], src, n);
+            src += n;
+            left -= n;
+            head += n;
+        }
+    }
+    debug_tx_head = head;
+    Debug_TX_Kick();
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    return 0;
+}
+
+int8_t Debug_TX_Write(const void *data, uint16_t len)
+{
+    uart2_iov_t iov;
+
+    iov.data = data;
+    iov.len = len;
+    return Debug_TX_Writev(&iov, 1);
+}
+
+void Debug_SetRxCallback(void (*callback)(uint8_t byte))
+{
+    debug_rx_callback = callback;
+}
+
+uint16_t Debug_TX_Pending(void)
+{
+    return (uint16_t)(debug_tx_head - debug_tx_tail);
+}
+
+uint32_t Debug_TX_Drops(void)
+{
+    return debug_tx_drops;
+}
+
+uint32_t Debug_Line_Drops(void)
+{
+    return debug_line_drops;
+}
+
+// 通过串口1，单片机发送字符串（放入发送缓冲区，不等待）
 void Usart1_Send_Sring(char *string)
 {
-    
-    while(*string != '\0')
+    Debug_TX_Write(string, (uint16_t)strlen(string));
+}
+
+/**
+ * @brief  整行放入发送缓冲区，空间不足时整行丢弃并计数
+ */
+static void Debug_Line_Flush(debug_line_t *line)
+{
+    if (Debug_TX_Write(line->buf, line->len) != 0)
     {
-        USART_SendData(USART1, *string++);	// ⺯
-        // ȴݼĴ
-        while(USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
+        debug_line_drops++;
     }
-    // ȴ
-    while(USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET);
+    line->len = 0;
 }
 
-//ضc⺯printfڣضʹprintf
+//重定向c库函数printf到串口，重定向后可使用printf函数
 int fputc(int ch, FILE *f)
 {
-    /* һֽݵ */
-    USART_SendData(USART1, (uint8_t) ch);
+    TaskHandle_t self;
+    debug_line_t *line = NULL;
+    UBaseType_t mask;
+    uint8_t i;
 
-    /* ȴ */
-    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
+    if (xPortIsInsideInterrupt())
+    {
+        // 中断中不拼行，直接放入发送缓冲区
+        uint8_t c = (uint8_t)ch;
+        Debug_TX_Write(&c, 1);
+        return (ch);
+    }
+
+    // 本任务正在拼的行：非空槽只由其所属任务修改，无需加锁
+    self = xTaskGetCurrentTaskHandle();
+    for (i = 0; i < DEBUG_LINE_SLOTS; i++)
+    {
+        if (debug_lines[i].len != 0 && debug_lines[i].owner == self)
+        {
+            line = &debug_lines[i];
+            line->buf[line->len++] = (char)ch;
+            break;
+        }
+    }
+
+    if (line == NULL)
+    {
+        // 新的一行：占用空槽并写入首字符，两步在临界区内完成
+        mask = taskENTER_CRITICAL_FROM_ISR();
+        for (i = 0; i < DEBUG_LINE_SLOTS; i++)
+        {
+            if (debug_lines[i].len == 0)
+            {
+                line = &debug_lines[i];
+                line->owner = self;
+                line->buf[0] = (char)ch;
+                line->len = 1;
+                break;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+
+        if (line == NULL)
+        {
+            // 同时拼行的任务多于槽数，整行无法保证，计为丢弃
+            debug_line_drops += (ch == '\n');
+            return (ch);
+        }
+    }
+
+    /* 行结束或行缓冲满时整行放入发送缓冲区由DMA发出，缓冲区满时整行丢弃，不阻塞调用任务 */
+    if (ch == '\n' || line->len >= DEBUG_LINE_MAX)
+    {
+        Debug_Line_Flush(line);
+    }
 
     return (ch);
 }
 
-// USART1ֽ麯
+// USART1发送字节数组函数（整体放入发送缓冲区，不等待）
 void Usart1_send_bytes(uint8_t *buf, uint16_t len)
 {
-    uint16_t i;
-    for(i = 0; i < len; i++) {
-        /* һֽݵ */
-        USART_SendData(USART1, buf[i]);
-        
-        /* ȴͼĴ */
-        while(USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-    }
-    /* ȴ */
-    while(USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET);
+    Debug_TX_Write(buf, len);
 }
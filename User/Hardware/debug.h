@@ -2,10 +2,42 @@
 #define DEBUG_H
 
 #include "stm32f10x.h"                  // Device header
+#include "uart2.h"
 #include <stdio.h>
 
+// 波特率：日志与二进制遥测共用USART1，全速遥测时可改为921600（72MHz下误差0.16%）
+#ifndef DEBUG_BAUDRATE
+#define DEBUG_BAUDRATE 115200
+#endif
+
+// USART1发送环形缓冲（DMA1通道4后台发送），大小必须为2的幂
+#define DEBUG_TX_RING_SIZE 512
+#define DEBUG_TX_RING_MASK (DEBUG_TX_RING_SIZE - 1)
+
+// printf 行缓冲：同时拼行的任务数上限与单行最大长度（超长的行分段发出）
+#define DEBUG_LINE_SLOTS 3
+#define DEBUG_LINE_MAX 96
+
 void debug_init(void);
 void Usart1_Send_Sring(char *string);
 void Usart1_send_bytes(uint8_t *buf, uint16_t len);
 
+/**
+ * @brief 将多个片段作为一个整体放入USART1发送缓冲区，由DMA后台发出
+ * @return 0-成功 -1-空间不足（整体丢弃，不等待）
+ * @note 任务和中断中均可调用（中断优先级不得高于 configMAX_SYSCALL_INTERRUPT_PRIORITY）
+ */
+int8_t Debug_TX_Writev(const uart2_iov_t *iov, uint8_t count);
+int8_t Debug_TX_Write(const void *data, uint16_t len);
+
+// 设置接收字节回调（在USART1中断中调用，只能使用FromISR接口），设置后接收的字节不再回显
+void Debug_SetRxCallback(void (*callback)(uint8_t byte));
+
+// 发送缓冲区中尚未发出的字节数
+uint16_t Debug_TX_Pending(void);
+// 因缓冲区满丢弃的字节数
+uint32_t Debug_TX_Drops(void);
+// 因缓冲区满整行丢弃的 printf 行数
+uint32_t Debug_Line_Drops(void);
+
 #endif
@@ -1,171 +1,447 @@
 #include "uart2.h"
+#include "FreeRTOS.h"
+#include "task.h"
 #include <stdio.h>
+#include <string.h>
 
-uint8_t uart2_buffer[UART2_BUF_SIZE];// uart2ջ
-uint8_t uart2_rx_len;                  // uart2ճ
+static uint8_t uart2_rx_ring[UART2_RX_RING_SIZE];   // uart2接收环形缓冲
+static uint16_t uart2_rx_tail = 0;                  // 读指针（仅消费者修改）
+static uint32_t uart2_rx_read = 0;                  // 累计读取字节数
+static volatile uint32_t uart2_rx_written = 0;      // 累计写入字节数（中断中更新）
+static uint16_t uart2_rx_last_head = 0;             // 上次中断时的写指针
+static uint16_t uart2_rx_overruns = 0;              // 溢出次数
+static void (*uart2_rx_callback)(uint8_t event) = NULL; // 接收事件回调
+
+static uint8_t uart2_tx_ring[UART2_TX_RING_SIZE];   // uart2发送环形缓冲
+static uint16_t uart2_tx_head = 0;                  // 写指针（自由递增，取模使用）
+static volatile uint16_t uart2_tx_tail = 0;         // 已发送位置（中断中推进）
+static volatile uint16_t uart2_tx_busy = 0;         // 当前DMA传输长度，0-空闲
+static void (*uart2_tx_callback)(void) = NULL;      // 发送完成回调
+
+// DMA写指针：计数器从缓冲区大小递减，回绕时自动重装
+#define UART2_RX_HEAD() ((uint16_t)(UART2_RX_RING_SIZE - DMA_GetCurrDataCounter(DMA1_Channel6)) & UART2_RX_RING_MASK)
 
 /**
- * @brief  GPIOʼPA2=TX2PA3=RX2
+ * @brief  GPIO初始化（PA2=TX2，PA3=RX2）
  */
 void UART2_GPIO_Init(void)
 {
     GPIO_InitTypeDef GPIO_InitStruct;
     
-    // ʹGPIOAʱ
+    // 使能GPIOA时钟
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
     
-    // PA2(TX2) 츴
+    // PA2(TX2) 推挽复用输出
     GPIO_InitStruct.GPIO_Pin = GPIO_Pin_2;
     GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;
     GPIO_InitStruct.GPIO_Speed = GPIO_Speed_50MHz;
     GPIO_Init(GPIOA, &GPIO_InitStruct);
     
-    // PA3(RX2) 
+    // PA3(RX2) 浮空输入
     GPIO_InitStruct.GPIO_Pin = GPIO_Pin_3;
     GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IN_FLOATING;
     GPIO_Init(GPIOA, &GPIO_InitStruct);
 }
 
 /**
- * @brief  UART2ʼжʹܣ
- * @param  baudrate: ʣ9600115200
+ * @brief  UART2初始化（含空闲中断使能）
+ * @param  baudrate: 波特率（如9600、115200）
  */
 void UART2_Init(uint32_t baudrate)
 {
     USART_InitTypeDef USART_InitStruct;
     NVIC_InitTypeDef NVIC_InitStruct;
     
-    // 1. ʹUART2ʱ
+    // 1. 使能UART2时钟
     RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART2, ENABLE);
     
-    // 2. UART
+    // 2. UART配置
     USART_InitStruct.USART_BaudRate = baudrate;
-    USART_InitStruct.USART_WordLength = USART_WordLength_8b; // 8λλ
-    USART_InitStruct.USART_StopBits = USART_StopBits_1;      // 1λֹͣλ
-    USART_InitStruct.USART_Parity = USART_Parity_No;         // У
-    USART_InitStruct.USART_HardwareFlowControl = USART_HardwareFlowControl_None; // Ӳ
-    USART_InitStruct.USART_Mode = USART_Mode_Rx | USART_Mode_Tx; // շģʽ
+    USART_InitStruct.USART_WordLength = USART_WordLength_8b; // 8位数据位
+    USART_InitStruct.USART_StopBits = USART_StopBits_1;      // 1位停止位
+    USART_InitStruct.USART_Parity = USART_Parity_No;         // 无校验
+    USART_InitStruct.USART_HardwareFlowControl = USART_HardwareFlowControl_None; // 无硬件流控
+    USART_InitStruct.USART_Mode = USART_Mode_Rx | USART_Mode_Tx; // 收发模式
     USART_Init(USART2, &USART_InitStruct);
     
-    // 3. ʹUART2ж
+    // 3. 使能UART2空闲中断
     USART_ITConfig(USART2, USART_IT_IDLE, ENABLE);
     
-    // 4. UART2жȼNVIC
+    // 4. 配置UART2中断优先级（NVIC），与DMA接收中断同级，二者不会相互打断
     NVIC_InitStruct.NVIC_IRQChannel = USART2_IRQn;
-    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 6; // ռȼ6
-    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;        // ȼ0
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 6; // 抢占优先级6
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;        // 子优先级0
     NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStruct);
     
-    // 5. ʹUART2
+    // 5. 使能UART2
     USART_Cmd(USART2, ENABLE);
 }
 
 /**
- * @brief  DMAʼUART2_RX -> ѭģʽ
+ * @brief  DMA初始化（UART2_RX -> 缓冲区，循环模式）
  */
 void UART2_DMA_Init(void)
 {
     DMA_InitTypeDef DMA_InitStruct;
+    NVIC_InitTypeDef NVIC_InitStruct;
     
-    // 1. ʹDMA1ʱӣUART2_RXӦDMA1_Channel6
+    // 1. 使能DMA1时钟（UART2_RX对应DMA1_Channel6）
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
     
-    // 2. λDMA1_Channel6ã
+    // 2. 复位DMA1_Channel6（避免残留配置）
     DMA_DeInit(DMA1_Channel6);
     
-    // 3. DMA
-    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t)&USART2->DR; // ַUART2ݼĴ
-    DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)uart2_buffer;    // ڴַջ
-    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralSRC;                // ݷ->ڴ
-    DMA_InitStruct.DMA_BufferSize = UART2_BUF_SIZE;                // С128ֽ
-    DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;  // ַ
-    DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;           // ڴַ
-    DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte; // ݿȣֽ
-    DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;   // ڴݿȣֽ
-    DMA_InitStruct.DMA_Mode = DMA_Mode_Circular;                   // ѭģʽظˣ
-    DMA_InitStruct.DMA_Priority = DMA_Priority_Medium;             // еȼ
-    DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;                      // ڴ浽ڴ
+    // 3. DMA配置
+    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t)&USART2->DR; // 外设地址：UART2数据寄存器
+    DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)uart2_rx_ring;   // 内存地址：接收环形缓冲区
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralSRC;                // 数据方向：外设->内存
+    DMA_InitStruct.DMA_BufferSize = UART2_RX_RING_SIZE;            // 缓冲区大小：512字节
+    DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;  // 外设地址不递增
+    DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;           // 内存地址递增
+    DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte; // 外设数据宽度：字节
+    DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;   // 内存数据宽度：字节
+    DMA_InitStruct.DMA_Mode = DMA_Mode_Circular;                   // 循环模式（重复搬运）
+    DMA_InitStruct.DMA_Priority = DMA_Priority_Medium;             // 中等优先级
+    DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;                      // 禁用内存到内存
     
     DMA_Init(DMA1_Channel6, &DMA_InitStruct);
-    
-    // 4. ʹDMA1_Channel6
+
+    // 4. 半满/全满中断：连续数据流没有空闲间隙时，每半个缓冲区唤醒一次消费者
+    DMA_ITConfig(DMA1_Channel6, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    NVIC_InitStruct.NVIC_IRQChannel = DMA1_Channel6_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 6;
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    uart2_rx_tail = 0;
+    uart2_rx_read = 0;
+    uart2_rx_written = 0;
+    uart2_rx_last_head = 0;
+
+    // 使能DMA1_Channel6
     DMA_Cmd(DMA1_Channel6, ENABLE);
     
-    // 5. ʹUART2DMA
+    // 5. 使能UART2的DMA接收请求
     USART_DMACmd(USART2, USART_DMAReq_Rx, ENABLE);
 }
 
 /**
- * @brief  UART2жϷжϣ
+ * @brief  记录写指针推进量并通知消费者（中断中调用）
+ * @note   半满/全满中断保证两次记录之间写入不超过半个缓冲区，累计值不会漏计
+ */
+static void UART2_RX_Event(uint8_t event)
+{
+    uint16_t head = UART2_RX_HEAD();
+
+    uart2_rx_written += (uint16_t)(head - uart2_rx_last_head) & UART2_RX_RING_MASK;
+    uart2_rx_last_head = head;
+
+    if (uart2_rx_callback != NULL)
+    {
+        uart2_rx_callback(event);
+    }
+}
+
+/**
+ * @brief  UART2中断服务函数（处理空闲中断）
  */
 void USART2_IRQHandler(void)
 {
     uint32_t temp;
     
-    // Ƿǿж
+    // 检查是否是空闲中断
     if(USART_GetITStatus(USART2, USART_IT_IDLE) != RESET)
     {
-        // ȡSRDRĴжϱ־׼bugֶ壩
+        // 必须读取SR和DR寄存器清除空闲中断标志（标准库bug，需手动清）
         temp = USART2->SR;
         temp = USART2->DR;
-        (void)temp; // δʹñ
-        
-        // ֹͣDMA䣨ʱ
-        DMA_Cmd(DMA1_Channel6, DISABLE);
-        
-        // յݳ
-        uart2_rx_len = UART2_BUF_SIZE - DMA_GetCurrDataCounter(DMA1_Channel6);
-        // printf("len=%d, uart2_buffer=", rx_len);
-        // for(uint16_t i=0; i<rx_len; i++)
-        // {
-        //     printf("%c", uart2_buffer[i]);
-        // }
-        
-        
-        // DMAСָDMA䣨ѭգ
-        DMA_SetCurrDataCounter(DMA1_Channel6, UART2_BUF_SIZE);
-        DMA_Cmd(DMA1_Channel6, ENABLE);
+        (void)temp; // 避免未使用变量警告
+
+        // DMA不停止，数据留在环形缓冲区中由消费者按读指针取走
+        UART2_RX_Event(UART2_RX_EVT_IDLE);
+    }
+}
+
+/**
+ * @brief  DMA1通道6中断服务函数（UART2接收半满/全满）
+ */
+void DMA1_Channel6_IRQHandler(void)
+{
+    uint8_t event = 0;
+
+    if (DMA_GetITStatus(DMA1_IT_HT6) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_HT6);
+        event |= UART2_RX_EVT_HALF;
+    }
+    if (DMA_GetITStatus(DMA1_IT_TC6) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC6);
+        event |= UART2_RX_EVT_FULL;
+    }
+    if (event != 0)
+    {
+        UART2_RX_Event(event);
+    }
+}
+
+void UART2_SetRxCallback(void (*callback)(uint8_t event))
+{
+    uart2_rx_callback = callback;
+}
+
+uint16_t UART2_RX_Peek(const uint8_t **data)
+{
+    uint16_t head = UART2_RX_HEAD();
+    int32_t pending = (int32_t)(uart2_rx_written - uart2_rx_read);
+
+    // 消费者落后超过一整圈，旧数据已被覆盖，直接跳到写指针处
+    if (pending > UART2_RX_RING_SIZE)
+    {
+        uart2_rx_tail = head;
+        uart2_rx_read = uart2_rx_written;
+        uart2_rx_overruns++;
+        return 0;
+    }
+
+    *data = &uart2_rx_ring[uart2_rx_tail];
+    if (head == uart2_rx_tail && pending == UART2_RX_RING_SIZE)
+    {
+        // 恰好写满一整圈，读写指针重合
+        return UART2_RX_RING_SIZE - uart2_rx_tail;
+    }
+    if (head >= uart2_rx_tail)
+    {
+        return head - uart2_rx_tail;
+    }
+    // 数据回绕，先返回到缓冲区末尾的一段
+    return UART2_RX_RING_SIZE - uart2_rx_tail;
+}
+
+void UART2_RX_Consume(uint16_t len)
+{
+    uart2_rx_tail = (uart2_rx_tail + len) & UART2_RX_RING_MASK;
+    uart2_rx_read += len;
+}
+
+void UART2_RX_Flush(void)
+{
+    const uint8_t *data;
+    uint16_t len;
+
+    while ((len = UART2_RX_Peek(&data)) > 0)
+    {
+        UART2_RX_Consume(len);
     }
 }
 
+uint16_t UART2_RX_Overruns(void)
+{
+    return uart2_rx_overruns;
+}
+
+/**
+ * @brief  DMA初始化（发送缓冲区 -> UART2_TX，单次模式，每段重新装载）
+ */
+void UART2_DMA_TX_Init(void)
+{
+    DMA_InitTypeDef DMA_InitStruct;
+    NVIC_InitTypeDef NVIC_InitStruct;
+
+    // UART2_TX对应DMA1_Channel7
+    DMA_DeInit(DMA1_Channel7);
+
+    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t)&USART2->DR;
+    DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)uart2_tx_ring;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralDST;                // 数据方向：内存->外设
+    DMA_InitStruct.DMA_BufferSize = 1;                             // 每次启动时重新设置
+    DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStruct.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStruct.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel7, &DMA_InitStruct);
+
+    DMA_ITConfig(DMA1_Channel7, DMA_IT_TC, ENABLE);
+    NVIC_InitStruct.NVIC_IRQChannel = DMA1_Channel7_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 6;
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    uart2_tx_head = 0;
+    uart2_tx_tail = 0;
+    uart2_tx_busy = 0;
+
+    USART_DMACmd(USART2, USART_DMAReq_Tx, ENABLE);
+}
+
 /**
- * @brief  ʼ
+ * @brief  初始化总入口
  */
 void UART2_DMA_RX_Init(uint32_t baudrate)
 {
-    UART2_GPIO_Init();    // GPIOʼ
-    UART2_Init(baudrate); // UARTʼжϣ
-    UART2_DMA_Init();     // DMAʼ
+    UART2_GPIO_Init();    // GPIO初始化
+    UART2_Init(baudrate); // UART初始化（含空闲中断）
+    UART2_DMA_Init();     // 接收DMA初始化
+    UART2_DMA_TX_Init();  // 发送DMA初始化
+}
+
+/**
+ * @brief  运行中切换波特率，接收/发送DMA保持运行
+ * @param  baudrate: 新波特率（APB1为36MHz时最高2.25Mbps）
+ * @note   在任务中调用；先等待已排队的数据以原波特率发完
+ */
+void UART2_SetBaudrate(uint32_t baudrate)
+{
+    USART_InitTypeDef USART_InitStruct;
+    uint8_t wait = 0;
+
+    while ((UART2_TX_Pending() > 0 || USART_GetFlagStatus(USART2, USART_FLAG_TC) == RESET) && wait++ < 50)
+    {
+        vTaskDelay(1);
+    }
+
+    // USART_Init 只改写帧格式和波特率，空闲中断和DMA请求使能位保持不变
+    USART_InitStruct.USART_BaudRate = baudrate;
+    USART_InitStruct.USART_WordLength = USART_WordLength_8b;
+    USART_InitStruct.USART_StopBits = USART_StopBits_1;
+    USART_InitStruct.USART_Parity = USART_Parity_No;
+    USART_InitStruct.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStruct.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    USART_Cmd(USART2, DISABLE);
+    USART_Init(USART2, &USART_InitStruct);
+    USART_Cmd(USART2, ENABLE);
 }
 
 
+// ==================================
+// DMA发送
+// ==================================
+
 /**
- * @brief  ѯʽUART2ݸWiFiģ飨򵥿ɿʺ϶ݣ
- * @param  data: ͵ݻָ
- * @param  len:  ݵĳȣֽڣ
- * @retval 0: ɹ1: 
+ * @brief  发送缓冲区中还有数据且DMA空闲时，启动下一段连续数据的传输
+ * @note   在临界区或DMA中断中调用
  */
-uint8_t UART2_SendDataToWiFi_Poll(uint8_t *data, uint16_t len)
+static void UART2_TX_Kick(void)
 {
-    // У
-    if(data == NULL || len == 0 || len > UART2_BUF_SIZE)
+    uint16_t pending = (uint16_t)(uart2_tx_head - uart2_tx_tail);
+    uint16_t offset = uart2_tx_tail & UART2_TX_RING_MASK;
+    uint16_t len;
+
+    if (uart2_tx_busy != 0 || pending == 0)
     {
-        return 1;
+        return;
     }
-    
-    // ѯÿֽ
-    for(uint16_t i = 0; i < len; i++)
+
+    // 数据回绕时先发送到缓冲区末尾，剩余部分在传输完成中断中继续
+    len = UART2_TX_RING_SIZE - offset;
+    if (len > pending)
     {
-        // ȴͻΪգTXE־λ
-        while(USART_GetFlagStatus(USART2, USART_FLAG_TXE) == RESET);
-        // ͵ֽ
-        USART_SendData(USART2, data[i]);
+        len = pending;
     }
-    
-    // ȴһֽڷɣTC־λȷȫ
-    while(USART_GetFlagStatus(USART2, USART_FLAG_TC) == RESET);
-    
+
+    uart2_tx_busy = len;
+    DMA_Cmd(DMA1_Channel7, DISABLE);
+    DMA1_Channel7->CMAR = (uint32_t)&uart2_tx_ring[offset];
+    DMA_SetCurrDataCounter(DMA1_Channel7, len);
+    DMA_Cmd(DMA1_Channel7, ENABLE);
+}
+
+/**
+ * @brief  DMA1通道7中断服务函数（UART2发送完成一段）
+ */
+void DMA1_Channel7_IRQHandler(void)
+{
+    if (DMA_GetITStatus(DMA1_IT_TC7) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC7);
+
+        uart2_tx_tail += uart2_tx_busy;
+        uart2_tx_busy = 0;
+        UART2_TX_Kick();
+
+        // 缓冲区发空，通知发送方
+        if (uart2_tx_busy == 0 && uart2_tx_callback != NULL)
+        {
+            uart2_tx_callback();
+        }
+    }
+}
+
+int8_t UART2_TX_Writev(const uart2_iov_t *iov, uint8_t count)
+{
+    uint16_t total = 0;
+    uint16_t head;
+    uint8_t i;
+
+    if (iov == NULL || count == 0)
+    {
+        return -1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        total += iov[i].len;
+    }
+    if (total == 0 || total > UART2_TX_RING_SIZE)
+    {
+        return -1;
+    }
+
+    // 拷贝总量不超过缓冲区大小，关中断时间为微秒级
+    taskENTER_CRITICAL();
+    if ((uint16_t)(UART2_TX_RING_SIZE - (uint16_t)(uart2_tx_head - uart2_tx_tail)) < total)
+    {
+        taskEXIT_CRITICAL();
+        return -1;
+    }
+
+    head = uart2_tx_head;
+    for (i = 0; i < count; i++)
+    {
+        const uint8_t *src = (const uint8_t *)iov[i].data;
+        uint16_t left = iov[i].len;
+
+        while (left > 0)
+        {
+            uint16_t offset = head & UART2_TX_RING_MASK;
+            uint16_t n = UART2_TX_RING_SIZE - offset;
+            if (n > left)
+            {
+                n = left;
+            }
+            memcpy(&uart2_tx_ring[offset], src, n);
+            src += n;
+            left -= n;
+            head += n;
+        }
+    }
+    uart2_tx_head = head;
+    UART2_TX_Kick();
+    taskEXIT_CRITICAL();
+
     return 0;
 }
- 
+
+int8_t UART2_TX_Write(const void *data, uint16_t len)
+{
+    uart2_iov_t iov;
+
+    iov.data = data;
+    iov.len = len;
+    return UART2_TX_Writev(&iov, 1);
+}
+
+uint16_t UART2_TX_Pending(void)
+{
+    return (uint16_t)(uart2_tx_head - uart2_tx_tail);
+}
+
+void UART2_SetTxCallback(void (*callback)(void))
+{
+    uart2_tx_callback = callback;
+}
@@ -1,8 +1,57 @@
 #ifndef UART2_H
 #define UART2_H
 #include "stm32f10x.h"
-// UART2ջ128ֽڣ
-#define UART2_BUF_SIZE 128
+// 接收环形缓冲区（必须为2的幂），DMA循环写入，从不停止
+#define UART2_RX_RING_SIZE 512
+#define UART2_RX_RING_MASK (UART2_RX_RING_SIZE - 1)
+
+// 接收事件（回调参数）
+#define UART2_RX_EVT_HALF  0x01 // 环形缓冲区前半满
+#define UART2_RX_EVT_FULL  0x02 // 环形缓冲区后半满（回绕）
+#define UART2_RX_EVT_IDLE  0x04 // 线路空闲，一段输出结束
+
+// 发送环形缓冲区（必须为2的幂），DMA1通道7从中取数据发送
+#define UART2_TX_RING_SIZE 256
+#define UART2_TX_RING_MASK (UART2_TX_RING_SIZE - 1)
+
+// 发送片段（分散/聚集发送）
+typedef struct
+{
+    const void *data;
+    uint16_t len;
+} uart2_iov_t;
+
+// 初始化UART2及收发DMA
 void UART2_DMA_RX_Init(uint32_t baudrate);
-uint8_t UART2_SendDataToWiFi_Poll(uint8_t *data, uint16_t len);
+// 运行中切换波特率（等待发送完成后重新配置，收发DMA不停止）
+void UART2_SetBaudrate(uint32_t baudrate);
+// 设置接收回调（在中断中调用，只能使用FromISR接口，如任务通知）
+void UART2_SetRxCallback(void (*callback)(uint8_t event));
+
+/**
+ * @brief  取得从读指针开始的一段连续已接收数据（零拷贝）
+ * @param  data: 输出数据起始地址（指向环形缓冲区内部）
+ * @retval 连续可读的字节数，数据回绕时需再次调用取得第二段
+ */
+uint16_t UART2_RX_Peek(const uint8_t **data);
+// 释放已处理的数据，移动读指针
+void UART2_RX_Consume(uint16_t len);
+// 丢弃全部未读数据
+void UART2_RX_Flush(void);
+// 读取溢出（未及时读取被覆盖）次数
+uint16_t UART2_RX_Overruns(void);
+
+/**
+ * @brief  将若干片段依次放入发送缓冲区并启动DMA发送，不等待发送完成
+ * @param  iov: 片段数组（如 命令头/uid/主题/数据），调用返回后即可释放
+ * @param  count: 片段个数
+ * @retval 0: 成功；-1: 参数错误或缓冲区空间不足（全部片段都不放入）
+ */
+int8_t UART2_TX_Writev(const uart2_iov_t *iov, uint8_t count);
+// 发送单段数据
+int8_t UART2_TX_Write(const void *data, uint16_t len);
+// 尚未发送完的字节数
+uint16_t UART2_TX_Pending(void);
+// 设置发送完成回调（缓冲区发空时在中断中调用）
+void UART2_SetTxCallback(void (*callback)(void));
 #endif
@@ -3,8 +3,11 @@
 #include "Delay.h"
 #include "stm32f10x_rcc.h"
 #include "stm32f10x_gpio.h"
+#include "boot.h"
 
 static TaskHandle_t sensordate_handle = NULL;
+static void (*sensordata_update_callback)(void) = NULL; // 每轮采样完成后回调
+static volatile uint32_t sensordata_sample_count = 0;   // 已完成的采样轮数
 uint8_t DHT11_ON = 1;
 uint8_t Light_ON = 1;
 uint8_t PM25_ON = 1;
@@ -25,8 +28,9 @@ static void SensorData_Task(void *pvParameters)
 {
     printf("SensorData_Task start ->\n");
 
-    // 初始延时，确保系统稳定
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    // 传感器外设在本任务中初始化，与显示/网络初始化并发进行
+    SensorData_Init();
+    Boot_Mark(BOOT_PHASE_SENSORS);
 
     while (1)
     {
@@ -108,11 +112,42 @@ static void SensorData_Task(void *pvParameters)
         //            SensorData.pm25_data.pm25_value, SensorData.pm25_data.level);
         // printf("-------------\r\n");
 
-        // 每3秒读取一次传感器数据
-        vTaskDelay(pdMS_TO_TICKS(Sensordata_delaytime));
+        if (!Boot_IsDone(BOOT_EVT_FIRST_SAMPLE))
+        {
+            Boot_Mark(BOOT_PHASE_FIRST_SAMPLE);
+        }
+
+        sensordata_sample_count++;
+
+        // 通知显示等订阅者有新数据
+        if (sensordata_update_callback != NULL)
+        {
+            sensordata_update_callback();
+        }
+
+        // 按采样间隔等待，间隔修改时由 SensorData_Wake() 提前唤醒
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Sensordata_delaytime));
+    }
+}
+
+void SensorData_SetUpdateCallback(void (*callback)(void))
+{
+    sensordata_update_callback = callback;
+}
+
+void SensorData_Wake(void)
+{
+    if (sensordate_handle != NULL)
+    {
+        xTaskNotifyGive(sensordate_handle);
     }
 }
 
+uint32_t SensorData_GetSampleCount(void)
+{
+    return sensordata_sample_count;
+}
+
 void SensorData_CreateTask(void)
 {
     xTaskCreate((TaskFunction_t)SensorData_Task,     /* 任务函数 */
@@ -31,6 +31,12 @@ extern uint8_t PM25_ERR;
 
 void SensorData_Init(void);
 void SensorData_CreateTask(void);
+// 注册采样完成回调（在传感器任务上下文中调用）
+void SensorData_SetUpdateCallback(void (*callback)(void));
+// 结束本轮采样等待，立即按新的采样间隔开始下一轮（如间隔被修改后）
+void SensorData_Wake(void);
+// 已完成的采样轮数，每轮采样后加1（界面据此判断是否有新采样）
+uint32_t SensorData_GetSampleCount(void);
 
 
 #endif
@@ -0,0 +1,307 @@
+/**
+ * @file telemetry.c
+ * @brief 传感器二进制遥测流实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "telemetry.h"
+#include "sensordata.h"
+#include "debug.h"
+#include "log.h"
+#include "uart2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include <string.h>
+#if TLM_MOTION
+#include "MPU6050.h"
+#endif
+
+#define TLM_HEADER_LEN      9       // 同步2 + 通道1 + 长度1 + 序号1 + 时间戳4
+#define TLM_CMD_MAX         16      // 订阅命令行最大长度
+
+// ==================================
+// 静态变量
+// ==================================
+
+static TimerHandle_t tlm_timer = NULL;
+static volatile uint16_t tlm_period[TLM_CH_MAX];   // 各通道周期，0-关闭
+static uint16_t tlm_elapsed[TLM_CH_MAX];
+static uint8_t tlm_seq = 0;
+
+static char tlm_cmd[TLM_CMD_MAX];
+static uint8_t tlm_cmd_len = 0;
+
+// ==================================
+// 帧
+// ==================================
+
+/**
+ * @brief CRC-16/CCITT-FALSE（多项式0x1021，初值0xFFFF）
+ */
+static uint16_t Telemetry_CRC16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    while (len--)
+    {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 组帧后整帧放入USART1发送缓冲区，空间不足时丢弃
+ */
+static void Telemetry_Send(tlm_channel_t ch, const void *payload, uint8_t len)
+{
+    uint8_t header[TLM_HEADER_LEN];
+    uint8_t crc_bytes[2];
+    uint32_t ts = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    uint16_t crc;
+    uart2_iov_t iov[3];
+
+    header[0] = 0x00;
+    header[1] = 0x5A;
+    header[2] = (uint8_t)ch;
+    header[3] = len;
+    header[4] = tlm_seq++;
+    memcpy(&header[5], &ts, sizeof(ts));
+
+    crc = Telemetry_CRC16(0xFFFF, &header[2], TLM_HEADER_LEN - 2);
+    crc = Telemetry_CRC16(crc, (const uint8_t *)payload, len);
+    crc_bytes[0] = (uint8_t)crc;
+    crc_bytes[1] = (uint8_t)(crc >> 8);
+
+    iov[0].data = header;
+    iov[0].len = TLM_HEADER_LEN;
+    iov[1].data = payload;
+    iov[1].len = len;
+    iov[2].data = crc_bytes;
+    iov[2].len = 2;
+    Debug_TX_Writev(iov, 3);
+}
+
+// ==================================
+// 通道采样
+// ==================================
+
+static void Telemetry_Sample_Raw(void)
+{
+    tlm_raw_t raw;
+
+    // ADC与传感器任务共用，整个采样过程不可被打断
+    taskENTER_CRITICAL();
+    ADC_RegularChannelConfig(ADC1, ADC_Channel_1, 1, ADC_SampleTime_55Cycles5);
+    raw.light_adc = Light_ADC_GetValue();
+    raw.pm25_adc = PM25_ReadRaw();
+    taskEXIT_CRITICAL();
+
+    Telemetry_Send(TLM_CH_RAW, &raw, sizeof(raw));
+}
+
+static void Telemetry_Sample_Values(void)
+{
+    tlm_values_t v;
+
+    taskENTER_CRITICAL();
+    v.temp_x10 = (int16_t)(SensorData.dht11_data.temp_int * 10 + SensorData.dht11_data.temp_deci);
+    v.humi = SensorData.dht11_data.humi_int;
+    v.lux = SensorData.light_data.lux;
+    v.pm25_x10 = (uint16_t)(SensorData.pm25_data.pm25_value * 10.0f + 0.5f);
+    v.pm25_level = SensorData.pm25_data.level;
+    taskEXIT_CRITICAL();
+
+    Telemetry_Send(TLM_CH_VALUES, &v, sizeof(v));
+}
+
+#if TLM_MOTION
+static void Telemetry_Sample_Motion(void)
+{
+    tlm_motion_t m;
+
+    if (MPU_Get_Accelerometer(&m.accel[0], &m.accel[1], &m.accel[2]) == 0 &&
+        MPU_Get_Gyroscope(&m.gyro[0], &m.gyro[1], &m.gyro[2]) == 0)
+    {
+        Telemetry_Send(TLM_CH_MOTION, &m, sizeof(m));
+    }
+}
+#endif
+
+static void Telemetry_Sample_Stats(void)
+{
+    tlm_stats_t s;
+
+    s.samples = SensorData_GetSampleCount();
+    s.log_drops = Log_Dropped();
+    s.tx_drops = Debug_TX_Drops();
+    s.heap_free = (uint16_t)xPortGetFreeHeapSize();
+    s.uart2_overruns = UART2_RX_Overruns();
+
+    Telemetry_Send(TLM_CH_STATS, &s, sizeof(s));
+}
+
+/**
+ * @brief 调度定时器回调（定时器任务中执行），到期的通道各发一帧
+ */
+static void Telemetry_Timer_Callback(TimerHandle_t timer)
+{
+    uint8_t active = 0;
+
+    for (uint8_t ch = TLM_CH_RAW; ch < TLM_CH_MAX; ch++)
+    {
+        if (tlm_period[ch] == 0)
+        {
+            continue;
+        }
+        active = 1;
+        tlm_elapsed[ch] += TLM_TICK_MS;
+        if (tlm_elapsed[ch] < tlm_period[ch])
+        {
+            continue;
+        }
+        tlm_elapsed[ch] = 0;
+
+        switch (ch)
+        {
+        case TLM_CH_RAW:
+            Telemetry_Sample_Raw();
+            break;
+        case TLM_CH_VALUES:
+            Telemetry_Sample_Values();
+            break;
+#if TLM_MOTION
+        case TLM_CH_MOTION:
+            Telemetry_Sample_Motion();
+            break;
+#endif
+        case TLM_CH_STATS:
+            Telemetry_Sample_Stats();
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 全部通道关闭后停止调度，不再周期唤醒定时器任务
+    if (!active)
+    {
+        xTimerStop(tlm_timer, 0);
+    }
+}
+
+// ==================================
+// 订阅命令
+// ==================================
+
+/**
+ * @brief 解析 "tlm <通道号> <周期ms>"
+ */
+static void Telemetry_Parse_Cmd(const char *cmd)
+{
+    uint32_t ch = 0, period = 0;
+    const char *p = cmd + 4;
+
+    if (strncmp(cmd, "tlm ", 4) != 0)
+    {
+        return;
+    }
+    while (*p >= '0' && *p <= '9')
+    {
+        ch = ch * 10 + (uint32_t)(*p++ - '0');
+    }
+    if (*p++ != ' ')
+    {
+        return;
+    }
+    while (*p >= '0' && *p <= '9' && period <= 0xFFFF)
+    {
+        period = period * 10 + (uint32_t)(*p++ - '0');
+    }
+    if (*p == '\0' && ch < TLM_CH_MAX && period <= 0xFFFF)
+    {
+        Telemetry_Enable((tlm_channel_t)ch, (uint16_t)period);
+    }
+}
+
+/**
+ * @brief USART1接收字节（中断中执行），按行组装订阅命令
+ */
+static void Telemetry_On_Rx(uint8_t byte)
+{
+    if (byte == '\r' || byte == '\n')
+    {
+        if (tlm_cmd_len > 0)
+        {
+            tlm_cmd[tlm_cmd_len] = '\0';
+            Telemetry_Parse_Cmd(tlm_cmd);
+            tlm_cmd_len = 0;
+        }
+        return;
+    }
+    if (tlm_cmd_len < TLM_CMD_MAX - 1)
+    {
+        tlm_cmd[tlm_cmd_len++] = (char)byte;
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+int8_t Telemetry_Init(void)
+{
+    if (tlm_timer != NULL)
+    {
+        return 0;
+    }
+
+    tlm_timer = xTimerCreate("Tlm", pdMS_TO_TICKS(TLM_TICK_MS), pdTRUE, NULL, Telemetry_Timer_Callback);
+    if (tlm_timer == NULL)
+    {
+        LOG_E(LOG_MOD_SENSOR, "telemetry timer create failed");
+        return -1;
+    }
+    Debug_SetRxCallback(Telemetry_On_Rx);
+    return 0;
+}
+
+int8_t Telemetry_Enable(tlm_channel_t ch, uint16_t period_ms)
+{
+    if (ch < TLM_CH_RAW || ch >= TLM_CH_MAX || tlm_timer == NULL)
+    {
+        return -1;
+    }
+#if !TLM_MOTION
+    if (ch == TLM_CH_MOTION)
+    {
+        return -1;
+    }
+#endif
+
+    if (period_ms != 0 && period_ms < TLM_PERIOD_MIN_MS)
+    {
+        period_ms = TLM_PERIOD_MIN_MS;
+    }
+    tlm_elapsed[ch] = 0;
+    tlm_period[ch] = period_ms;
+
+    if (period_ms != 0)
+    {
+        if (xPortIsInsideInterrupt())
+        {
+            BaseType_t woken = pdFALSE;
+            xTimerStartFromISR(tlm_timer, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+        else
+        {
+            xTimerStart(tlm_timer, 0);
+        }
+    }
+    return 0;
+}
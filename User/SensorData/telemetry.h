@@ -0,0 +1,102 @@
+/**
+ * @file telemetry.h
+ * @brief 传感器二进制遥测流（USART1，不经WiFi）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 各通道按订阅的周期采样，打包为二进制帧放入USART1发送缓冲区由DMA发出，
+ * 与日志共用串口，缓冲区满时整帧丢弃（帧序号可看出丢帧）。
+ * 帧格式（小端）：
+ *   0x00 0x5A   同步字节（文本日志中不会出现0x00）
+ *   通道号      1字节 TLM_CH_xxx
+ *   负载长度    1字节
+ *   帧序号      1字节，每帧加1
+ *   时间戳      4字节，系统节拍（ms）
+ *   负载        见各通道结构体
+ *   CRC16       2字节，CRC-16/CCITT-FALSE，覆盖通道号到负载末尾
+ * 订阅：主机通过USART1发送一行 "tlm <通道号> <周期ms>\n"，周期为0表示关闭。
+ */
+
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include "stm32f10x.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define TLM_TICK_MS             5       // 调度粒度，通道周期按此取整
+#define TLM_PERIOD_MIN_MS       10      // 最短周期（PM2.5传感器LED脉冲间隔不得小于10ms）
+
+#ifndef TLM_MOTION
+#define TLM_MOTION              0       // 1-启用运动通道（需先初始化MPU6050）
+#endif
+
+/**
+ * @brief 通道
+ */
+typedef enum
+{
+    TLM_CH_RAW = 1,             // ADC原始值，实时采样
+    TLM_CH_VALUES,              // 传感器任务最近一次换算后的数值
+    TLM_CH_MOTION,              // MPU6050加速度/角速度原始值
+    TLM_CH_STATS,               // 内部运行统计
+    TLM_CH_MAX
+} tlm_channel_t;
+
+// TLM_CH_RAW 负载
+typedef struct
+{
+    uint16_t light_adc;         // 光敏电阻ADC（0~4095）
+    uint16_t pm25_adc;          // PM2.5 ADC（LED脉冲采样，0~4095）
+} tlm_raw_t;
+
+// TLM_CH_VALUES 负载
+typedef struct
+{
+    int16_t temp_x10;           // 温度，0.1℃
+    uint16_t lux;               // 光照
+    uint16_t pm25_x10;          // PM2.5，0.1 μg/m³
+    uint8_t humi;               // 湿度 %
+    uint8_t pm25_level;         // 污染等级
+} tlm_values_t;
+
+// TLM_CH_MOTION 负载
+typedef struct
+{
+    int16_t accel[3];
+    int16_t gyro[3];
+} tlm_motion_t;
+
+// TLM_CH_STATS 负载
+typedef struct
+{
+    uint32_t samples;           // 传感器采样轮数
+    uint32_t log_drops;         // 日志丢弃条数
+    uint32_t tx_drops;          // USART1发送缓冲区丢弃字节数
+    uint16_t heap_free;         // 剩余堆
+    uint16_t uart2_overruns;    // ESP8266接收溢出次数
+} tlm_stats_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 创建调度定时器并挂接USART1接收
+ * @return 0-成功 -1-失败
+ */
+int8_t Telemetry_Init(void);
+
+/**
+ * @brief 订阅或关闭一个通道
+ * @param ch 通道
+ * @param period_ms 周期，0-关闭，小于 TLM_PERIOD_MIN_MS 时按最短周期
+ * @return 0-成功 -1-通道无效
+ * @note 任务和中断中均可调用
+ */
+int8_t Telemetry_Enable(tlm_channel_t ch, uint16_t period_ms);
+
+#endif // __TELEMETRY_H
@@ -0,0 +1,127 @@
+/**
+ * @file boot.c
+ * @brief 并行启动流程实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "boot.h"
+#include "debug.h"
+#include "rtc_date.h"
+#include "log.h"
+
+// ==================================
+// 静态变量
+// ==================================
+
+static EventGroupHandle_t boot_events = NULL;
+static TickType_t boot_phase_tick[BOOT_PHASE_COUNT];
+static uint8_t boot_reported = 0;
+
+static const char *const boot_phase_name[BOOT_PHASE_COUNT] = {
+    "display",
+    "input",
+    "menu",
+    "sensors",
+    "first sample",
+    "ui ready",
+    "uart2",
+    "rtc",
+};
+
+// ==================================
+// 启动任务
+// ==================================
+
+/**
+ * @brief RTC初始化任务：LSE起振最长需要数秒，放到最低优先级单独等待
+ */
+static void Boot_RTC_Task(void *pvParameters)
+{
+    MyRTC_Init();
+    Boot_Mark(BOOT_PHASE_RTC);
+    vTaskDelete(NULL);
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+int8_t Boot_Init(void)
+{
+    boot_events = xEventGroupCreate();
+    if (boot_events == NULL)
+    {
+        LOG_E(LOG_MOD_SYS, "Boot: event group create failed");
+        return -1;
+    }
+
+    if (xTaskCreate(Boot_RTC_Task, "BootRTC", 192, NULL, 1, NULL) != pdPASS)
+    {
+        LOG_E(LOG_MOD_SYS, "Boot: RTC task create failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+void Boot_Mark(boot_phase_t phase)
+{
+    uint8_t all_done = 0;
+
+    if (phase >= BOOT_PHASE_COUNT || boot_events == NULL)
+    {
+        return;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    boot_phase_tick[phase] = now;
+    taskEXIT_CRITICAL();
+
+    EventBits_t bits = xEventGroupSetBits(boot_events, BOOT_EVT(phase));
+    LOG_I(LOG_MOD_SYS, "[BOOT] +%lums %s", (unsigned long)now, boot_phase_name[phase]);
+
+    taskENTER_CRITICAL();
+    if ((bits & BOOT_EVT_ALL) == BOOT_EVT_ALL && !boot_reported)
+    {
+        boot_reported = 1;
+        all_done = 1;
+    }
+    taskEXIT_CRITICAL();
+
+    if (all_done)
+    {
+        Boot_Report();
+    }
+}
+
+uint8_t Boot_IsDone(EventBits_t bits)
+{
+    if (boot_events == NULL)
+    {
+        return 0;
+    }
+    return (xEventGroupGetBits(boot_events) & bits) == bits;
+}
+
+void Boot_Report(void)
+{
+    EventBits_t bits = (boot_events != NULL) ? xEventGroupGetBits(boot_events) : 0;
+
+    printf("\r\n======== boot report (ms since scheduler start) ========\r\n");
+    for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++)
+    {
+        if (bits & BOOT_EVT(i))
+        {
+            printf("  %-14s %6lu\r\n", boot_phase_name[i], (unsigned long)boot_phase_tick[i]);
+        }
+        else
+        {
+            printf("  %-14s pending\r\n", boot_phase_name[i]);
+        }
+    }
+    printf("========================================================\r\n");
+}
@@ -0,0 +1,82 @@
+/**
+ * @file boot.h
+ * @brief 并行启动流程 - 启动阶段事件与耗时统计
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * main() 只做时钟/延时定时器/调试串口等最小初始化后立即启动调度器，
+ * 其余外设初始化分散到各自的任务前导中并发执行，各阶段完成时置位
+ * 启动事件组，其他任务非阻塞地查询（例如启动画面在首次采样完成后提前结束）。
+ */
+
+#ifndef __BOOT_H
+#define __BOOT_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+// ==================================
+// 启动阶段定义
+// ==================================
+
+typedef enum {
+    BOOT_PHASE_DISPLAY = 0,     // OLED 初始化完成
+    BOOT_PHASE_INPUT,           // 按键/蜂鸣器初始化完成
+    BOOT_PHASE_MENU,            // 菜单树构建完成
+    BOOT_PHASE_SENSORS,         // 传感器外设初始化完成
+    BOOT_PHASE_FIRST_SAMPLE,    // 第一次传感器采样完成
+    BOOT_PHASE_UI_READY,        // 首页可交互
+    BOOT_PHASE_UART2,           // ESP8266 串口就绪
+    BOOT_PHASE_RTC,             // RTC 时钟源就绪
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+// 事件位与阶段一一对应
+#define BOOT_EVT(phase)         ((EventBits_t)1 << (phase))
+#define BOOT_EVT_DISPLAY        BOOT_EVT(BOOT_PHASE_DISPLAY)
+#define BOOT_EVT_INPUT          BOOT_EVT(BOOT_PHASE_INPUT)
+#define BOOT_EVT_MENU           BOOT_EVT(BOOT_PHASE_MENU)
+#define BOOT_EVT_SENSORS        BOOT_EVT(BOOT_PHASE_SENSORS)
+#define BOOT_EVT_FIRST_SAMPLE   BOOT_EVT(BOOT_PHASE_FIRST_SAMPLE)
+#define BOOT_EVT_UI_READY       BOOT_EVT(BOOT_PHASE_UI_READY)
+#define BOOT_EVT_UART2          BOOT_EVT(BOOT_PHASE_UART2)
+#define BOOT_EVT_RTC            BOOT_EVT(BOOT_PHASE_RTC)
+#define BOOT_EVT_ALL            (BOOT_EVT(BOOT_PHASE_COUNT) - 1)
+
+// 启动画面最多播放的帧数（遇到首次采样完成即提前结束）
+#define BOOT_SPLASH_MAX_FRAMES  8
+#define BOOT_SPLASH_FRAME_MS    15
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 创建启动事件组及RTC初始化任务（调度器启动前调用）
+ * @return 0-成功 -1-失败
+ */
+int8_t Boot_Init(void);
+
+/**
+ * @brief 标记启动阶段完成，记录耗时并置位对应事件
+ * @param phase 启动阶段
+ * @note 所有阶段完成后由最后一个调用者打印启动耗时报告
+ */
+void Boot_Mark(boot_phase_t phase);
+
+/**
+ * @brief 查询启动阶段是否已完成（非阻塞）
+ * @param bits 事件位
+ * @return 1-全部完成 0-未完成
+ */
+uint8_t Boot_IsDone(EventBits_t bits);
+
+/**
+ * @brief 打印启动阶段耗时报告
+ */
+void Boot_Report(void);
+
+#endif // __BOOT_H
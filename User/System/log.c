@@ -0,0 +1,221 @@
+/**
+ * @file log.c
+ * @brief 分级日志实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "log.h"
+#include "debug.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// ==================================
+// 静态变量
+// ==================================
+
+static uint8_t log_levels[LOG_MOD_COUNT] = {
+    LOG_COMPILE_LEVEL, LOG_COMPILE_LEVEL, LOG_COMPILE_LEVEL, LOG_COMPILE_LEVEL, LOG_COMPILE_LEVEL,
+};
+static volatile uint32_t log_dropped = 0;
+
+#if !LOG_DEFERRED
+static const char *const log_module_names[LOG_MOD_COUNT] = {
+    "sys", "menu", "wifi", "sensor", "oled",
+};
+static const char log_level_chars[] = "-EWID";
+#endif
+
+// ==================================
+// 延迟格式化
+// ==================================
+
+#if LOG_DEFERRED
+/**
+ * 帧格式（小端）：
+ *   0x00 0xA5            同步字节（文本日志中不会出现0x00）
+ *   模块<<4 | 级别       1字节
+ *   参数个数             1字节
+ *   格式串地址           4字节，主机在固件符号表中查找格式串
+ *   参数                 整数/字符为4字节，浮点转为float的4字节，
+ *                        字符串为1字节长度加内容（最长32字节，NULL记为长度0），
+ *                        宽度/精度写作 '*' 时对应的int参数按出现顺序各占4字节
+ */
+#define LOG_FRAME_MAX   (8 + LOG_ARGS_MAX * 33)
+#define LOG_STR_MAX     32
+
+static void Log_Put_U32(uint8_t *buf, uint16_t *len, uint32_t v)
+{
+    buf[(*len)++] = (uint8_t)v;
+    buf[(*len)++] = (uint8_t)(v >> 8);
+    buf[(*len)++] = (uint8_t)(v >> 16);
+    buf[(*len)++] = (uint8_t)(v >> 24);
+}
+
+static void Log_Write_Deferred(log_module_t mod, uint8_t level, const char *fmt, va_list ap)
+{
+    uint8_t buf[LOG_FRAME_MAX];
+    uint16_t len = 8;
+    uint8_t argc = 0;
+    const char *p = fmt;
+
+    // 按格式串中的转换说明取出参数，不做格式化
+    while (*p != '\0' && argc < LOG_ARGS_MAX)
+    {
+        uint8_t longs = 0;
+        int prec = -1;          // 精度，-1表示未指定
+
+        if (*p++ != '%')
+        {
+            continue;
+        }
+        while (*p != '\0' && strchr("-+ #0123456789.*", *p) != NULL)
+        {
+            if (*p == '.')
+            {
+                prec = 0;
+            }
+            else if (*p == '*')
+            {
+                // 宽度/精度由参数给出，同样写入帧中供主机还原
+                int v = va_arg(ap, int);
+                if (prec == 0)
+                {
+                    prec = (v < 0) ? -1 : v;
+                }
+                Log_Put_U32(buf, &len, (uint32_t)v);
+                if (++argc >= LOG_ARGS_MAX)
+                {
+                    break;
+                }
+            }
+            else if (prec >= 0 && *p >= '0' && *p <= '9')
+            {
+                prec = prec * 10 + (*p - '0');
+            }
+            p++;
+        }
+        if (argc >= LOG_ARGS_MAX)
+        {
+            break;
+        }
+        while (*p == 'l' || *p == 'h')
+        {
+            longs += (*p++ == 'l');
+        }
+
+        switch (*p)
+        {
+        case '\0':
+            continue;
+        case '%':
+            break;
+        case 's':
+        {
+            const char *s = va_arg(ap, const char *);
+            uint8_t n = 0;
+            while (s != NULL && s[n] != '\0' && n < LOG_STR_MAX && (prec < 0 || n < prec))
+            {
+                n++;
+            }
+            buf[len++] = n;
+            memcpy(&buf[len], s, n);
+            len += n;
+            argc++;
+            break;
+        }
+        case 'f':
+        case 'e':
+        case 'g':
+        {
+            float f = (float)va_arg(ap, double);
+            uint32_t bits;
+            memcpy(&bits, &f, sizeof(bits));
+            Log_Put_U32(buf, &len, bits);
+            argc++;
+            break;
+        }
+        default:
+            Log_Put_U32(buf, &len, (longs >= 2) ? (uint32_t)va_arg(ap, unsigned long long)
+                                                : (uint32_t)va_arg(ap, unsigned int));
+            argc++;
+            break;
+        }
+        p++;
+    }
+
+    buf[0] = 0x00;
+    buf[1] = 0xA5;
+    buf[2] = (uint8_t)((mod << 4) | level);
+    buf[3] = argc;
+    {
+        uint16_t hdr = 4;
+        Log_Put_U32(buf, &hdr, (uint32_t)fmt);
+    }
+
+    if (Debug_TX_Write(buf, len) != 0)
+    {
+        log_dropped++;
+    }
+}
+#endif // LOG_DEFERRED
+
+// ==================================
+// 接口实现
+// ==================================
+
+void Log_SetLevel(log_module_t mod, uint8_t level)
+{
+    uint8_t i;
+
+    for (i = 0; i < LOG_MOD_COUNT; i++)
+    {
+        if (mod == LOG_MOD_COUNT || mod == i)
+        {
+            log_levels[i] = level;
+        }
+    }
+}
+
+uint8_t Log_Enabled(log_module_t mod, uint8_t level)
+{
+    return (mod < LOG_MOD_COUNT && level <= log_levels[mod]) ? 1 : 0;
+}
+
+void Log_Write(log_module_t mod, uint8_t level, const char *fmt, ...)
+{
+    va_list ap;
+
+    if (!Log_Enabled(mod, level))
+    {
+        return;
+    }
+
+    va_start(ap, fmt);
+#if LOG_DEFERRED
+    Log_Write_Deferred(mod, level, fmt, ap);
+#else
+    {
+        // 整条格式化后一次放入发送缓冲区，多任务输出不会交错
+        char line[LOG_LINE_MAX + 2];
+        int n = snprintf(line, LOG_LINE_MAX, "%c/%s: ", log_level_chars[level], log_module_names[mod]);
+        int m = vsnprintf(line + n, LOG_LINE_MAX - n, fmt, ap);
+
+        n = (m < 0) ? n : (m >= LOG_LINE_MAX - n) ? LOG_LINE_MAX - 1 : n + m;
+        line[n++] = '\r';
+        line[n++] = '\n';
+        if (Debug_TX_Write(line, (uint16_t)n) != 0)
+        {
+            log_dropped++;
+        }
+    }
+#endif
+    va_end(ap);
+}
+
+uint32_t Log_Dropped(void)
+{
+    return log_dropped + Debug_Line_Drops();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file log.h
+ * @brief 分级日志 - 编译期/运行期级别、按模块过滤、异步发送
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 日志记录格式化后整条放入USART1发送环形缓冲，由DMA1通道4后台发出，
+ * 调用者不等待串口；缓冲区满时整条丢弃并计数，不阻塞。
+ *   - 编译期级别 LOG_COMPILE_LEVEL 以下的调用整体编译掉，不占代码和时间；
+ *   - 运行期每个模块有各自的级别，Log_SetLevel() 调整；
+ *   - LOG_DEFERRED 为1时不在单片机上格式化，只发送格式串地址和原始参数，
+ *     由主机按固件映像中的格式串还原（帧格式见 log.c，
+ *     tools/tlm_decode.py -e <工程.axf> 解码）。
+ * printf 仍可使用：按任务拼成整行后放入发送缓冲区，满时整行丢弃并计入 Log_Dropped()，
+ * 但不受级别和模块过滤，固件模块的输出应使用 LOG_x。
+ */
+
+#ifndef __LOG_H
+#define __LOG_H
+
+#include "stm32f10x.h"
+
+// ==================================
+// 配置
+// ==================================
+
+// 级别
+#define LOG_LEVEL_NONE          0
+#define LOG_LEVEL_ERROR         1
+#define LOG_LEVEL_WARN          2
+#define LOG_LEVEL_INFO          3
+#define LOG_LEVEL_DEBUG         4
+
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL       LOG_LEVEL_INFO  // 高于此级别的调用不编译
+#endif
+
+#ifndef LOG_DEFERRED
+#define LOG_DEFERRED            0       // 1-发送格式串地址和原始参数，由主机格式化
+#endif
+
+#define LOG_LINE_MAX            96      // 单条文本日志最大长度（超出截断）
+#define LOG_ARGS_MAX            6       // 延迟格式化模式下单条最多参数个数
+
+/**
+ * @brief 模块
+ */
+typedef enum
+{
+    LOG_MOD_SYS = 0,
+    LOG_MOD_MENU,
+    LOG_MOD_WIFI,
+    LOG_MOD_SENSOR,
+    LOG_MOD_OLED,
+    LOG_MOD_COUNT
+} log_module_t;
+
+// ==================================
+// 日志宏
+// ==================================
+
+#define LOG_AT(level, mod, ...) \
+    do \
+    { \
+        if ((level) <= LOG_COMPILE_LEVEL && Log_Enabled((mod), (level))) \
+        { \
+            Log_Write((mod), (level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_E(mod, ...)         LOG_AT(LOG_LEVEL_ERROR, mod, __VA_ARGS__)
+#define LOG_W(mod, ...)         LOG_AT(LOG_LEVEL_WARN, mod, __VA_ARGS__)
+#define LOG_I(mod, ...)         LOG_AT(LOG_LEVEL_INFO, mod, __VA_ARGS__)
+#define LOG_D(mod, ...)         LOG_AT(LOG_LEVEL_DEBUG, mod, __VA_ARGS__)
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 设置模块的运行期级别
+ * @param mod 模块，LOG_MOD_COUNT 表示全部模块
+ * @param level LOG_LEVEL_xxx
+ */
+void Log_SetLevel(log_module_t mod, uint8_t level);
+
+/**
+ * @brief 模块在该级别是否输出
+ */
+uint8_t Log_Enabled(log_module_t mod, uint8_t level);
+
+/**
+ * @brief 写一条日志（一般通过 LOG_x 宏调用）
+ * @note 任务和中断中均可调用，不阻塞
+ */
+void Log_Write(log_module_t mod, uint8_t level, const char *fmt, ...);
+
+/**
+ * @brief 因发送缓冲区满丢弃的日志条数（含 printf 整行丢弃的行数）
+ */
+uint32_t Log_Dropped(void);
+
+#endif // __LOG_H
@@ -0,0 +1,314 @@
+/**
+ * @file param.c
+ * @brief 运行参数表实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "param.h"
+#include "timers.h"
+#include "strfmt.h"
+#include "esp8266.h"
+#include "sensordata.h"
+#include "stm32f10x_flash.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+// Flash记录：半字0为 标志(高字节)|参数号，半字1为值；先写值再写半字0，半字0有效才算写完
+#define PARAM_REC_MAGIC         0xA500
+#define PARAM_REC_SLOTS         (PARAM_FLASH_PAGE_SIZE / 4)
+#define PARAM_REC_ADDR(i)       (PARAM_FLASH_ADDR + (uint32_t)(i) * 4)
+#define PARAM_REC_KEY(i)        (*(volatile const uint16_t *)PARAM_REC_ADDR(i))
+#define PARAM_REC_VALUE(i)      (*(volatile const uint16_t *)(PARAM_REC_ADDR(i) + 2))
+
+// 程序映像（含RW段初值）在Flash中的结束地址，由链接器生成
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION)
+extern const uint8_t Load$$LR$$LR_IROM1$$Limit[];
+#define PARAM_IMAGE_END         ((uint32_t)Load$$LR$$LR_IROM1$$Limit)
+#endif
+
+// ==================================
+// 变更回调
+// ==================================
+
+static void Param_Apply_Publish(uint16_t value)
+{
+    // ESP8266任务每轮比较发布间隔，离线缓存定时器也直接读取该变量
+    publish_delaytime = value;
+}
+
+static void Param_Apply_Sample(uint16_t value)
+{
+    Sensordata_delaytime = (uint16_t)(value * 1000);
+    SensorData_Wake(); // 结束本轮等待，按新间隔采样
+}
+
+static void Param_Apply_DHT11(uint16_t value)
+{
+    DHT11_ON = (uint8_t)value;
+}
+
+static void Param_Apply_Light(uint16_t value)
+{
+    Light_ON = (uint8_t)value;
+}
+
+static void Param_Apply_PM25(uint16_t value)
+{
+    PM25_ON = (uint8_t)value;
+}
+
+// ==================================
+// 参数表
+// ==================================
+
+static const param_def_t param_table[PARAM_COUNT] = {
+    [PARAM_PUBLISH_S] = {"pub", PARAM_TYPE_U16, 5, 60, 15, Param_Apply_Publish},
+    [PARAM_SAMPLE_S] = {"rate", PARAM_TYPE_U16, 1, 10, 3, Param_Apply_Sample},
+    [PARAM_DHT11_ON] = {"dht11", PARAM_TYPE_BOOL, 0, 1, 1, Param_Apply_DHT11},
+    [PARAM_LIGHT_ON] = {"light", PARAM_TYPE_BOOL, 0, 1, 1, Param_Apply_Light},
+    [PARAM_PM25_ON] = {"pm25", PARAM_TYPE_BOOL, 0, 1, 1, Param_Apply_PM25},
+};
+
+// ==================================
+// 静态变量
+// ==================================
+
+static uint16_t param_values[PARAM_COUNT];
+static uint16_t param_saved[PARAM_COUNT];   // Flash中的值
+static uint16_t param_flash_head = 0;       // 下一条记录的位置
+static uint8_t param_flash_ok = 0;          // 保留页未被程序映像占用，可以读写
+static TimerHandle_t param_timer = NULL;
+
+// ==================================
+// Flash存储
+// ==================================
+
+/**
+ * @brief 检查保留页是否与程序映像重叠
+ * @return 1-保留页空闲 0-程序已占用该页（IROM大小未按要求减小）
+ */
+static uint8_t Param_Flash_Check(void)
+{
+#ifdef PARAM_IMAGE_END
+    if (PARAM_IMAGE_END > PARAM_FLASH_ADDR)
+    {
+        LOG_W(LOG_MOD_SYS, "Param: image ends at 0x%08lX, overlaps page 0x%08lX, persistence disabled",
+                           (unsigned long)PARAM_IMAGE_END, (unsigned long)PARAM_FLASH_ADDR);
+        return 0;
+    }
+#endif
+    return 1;
+}
+
+/**
+ * @brief 扫描保留页：恢复各参数最后一条有效记录，定位写入位置
+ */
+static void Param_Flash_Load(void)
+{
+    uint16_t i;
+
+    param_flash_head = PARAM_REC_SLOTS;
+    for (i = 0; i < PARAM_REC_SLOTS; i++)
+    {
+        uint16_t key = PARAM_REC_KEY(i);
+        uint16_t value = PARAM_REC_VALUE(i);
+        uint8_t id = (uint8_t)key;
+
+        if (key == 0xFFFF)
+        {
+            if (value == 0xFFFF)
+            {
+                param_flash_head = i;
+                break;
+            }
+            continue; // 写值后掉电，半字0未写，跳过
+        }
+        if ((key & 0xFF00) == PARAM_REC_MAGIC && id < PARAM_COUNT &&
+            value >= param_table[id].min && value <= param_table[id].max)
+        {
+            param_values[id] = value;
+        }
+    }
+}
+
+/**
+ * @brief 追加一条记录
+ * @return 0-成功 -1-写入失败
+ */
+static int8_t Param_Flash_Append(uint8_t id, uint16_t value)
+{
+    uint32_t addr = PARAM_REC_ADDR(param_flash_head);
+
+    param_flash_head++;
+    if (FLASH_ProgramHalfWord(addr + 2, value) != FLASH_COMPLETE ||
+        FLASH_ProgramHalfWord(addr, (uint16_t)(PARAM_REC_MAGIC | id)) != FLASH_COMPLETE)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 将变化的参数写入保留页，空间不足时擦除后写入全部参数
+ */
+static void Param_Flash_Save(void)
+{
+    uint16_t values[PARAM_COUNT];
+    uint8_t dirty = 0;
+    uint8_t i;
+
+    memcpy(values, param_values, sizeof(values));
+    for (i = 0; i < PARAM_COUNT; i++)
+    {
+        dirty += (values[i] != param_saved[i]);
+    }
+    if (dirty == 0 || !param_flash_ok)
+    {
+        return;
+    }
+
+    FLASH_Unlock();
+    if (PARAM_REC_SLOTS - param_flash_head < dirty)
+    {
+        FLASH_ErasePage(PARAM_FLASH_ADDR);
+        param_flash_head = 0;
+        memset(param_saved, 0xFF, sizeof(param_saved)); // 全部重写
+    }
+    for (i = 0; i < PARAM_COUNT; i++)
+    {
+        if (values[i] == param_saved[i])
+        {
+            continue;
+        }
+        if (param_flash_head >= PARAM_REC_SLOTS || Param_Flash_Append(i, values[i]) != 0)
+        {
+            LOG_E(LOG_MOD_SYS, "Param: flash write failed");
+            break;
+        }
+        param_saved[i] = values[i];
+    }
+    FLASH_Lock();
+}
+
+static void Param_Timer_Callback(TimerHandle_t timer)
+{
+    Param_Save();
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+int8_t Param_Init(void)
+{
+    uint8_t i;
+
+    if (param_timer != NULL)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < PARAM_COUNT; i++)
+    {
+        param_values[i] = param_table[i].def;
+    }
+    // 保留页被程序占用时不读不写，参数只在本次运行中有效
+    param_flash_ok = Param_Flash_Check();
+    if (param_flash_ok)
+    {
+        Param_Flash_Load();
+    }
+    memcpy(param_saved, param_values, sizeof(param_saved));
+
+    // 恢复的值直接应用，不触发保存
+    for (i = 0; i < PARAM_COUNT; i++)
+    {
+        param_table[i].on_change(param_values[i]);
+    }
+
+    param_timer = xTimerCreate("Param", pdMS_TO_TICKS(PARAM_SAVE_DELAY_MS), pdFALSE, NULL, Param_Timer_Callback);
+    if (param_timer == NULL)
+    {
+        LOG_E(LOG_MOD_SYS, "Param: timer create failed");
+        return -1;
+    }
+    LOG_I(LOG_MOD_SYS, "Param: %u records in flash", param_flash_head);
+    return 0;
+}
+
+uint16_t Param_Get(param_id_t id)
+{
+    return (id < PARAM_COUNT) ? param_values[id] : 0;
+}
+
+int8_t Param_Set(param_id_t id, uint16_t value)
+{
+    if (id >= PARAM_COUNT || value < param_table[id].min || value > param_table[id].max)
+    {
+        return -1;
+    }
+    if (param_values[id] == value)
+    {
+        return 0;
+    }
+
+    param_values[id] = value;
+    param_table[id].on_change(value);
+    LOG_I(LOG_MOD_SYS, "Param: %s = %u", param_table[id].name, value);
+
+    // 连续修改时重新计时，只在停止修改后写一次Flash
+    if (param_timer != NULL)
+    {
+        xTimerReset(param_timer, 0);
+    }
+    return 0;
+}
+
+param_id_t Param_Find(const char *name, uint16_t len)
+{
+    uint8_t i;
+
+    for (i = 0; i < PARAM_COUNT; i++)
+    {
+        if (strncmp(param_table[i].name, name, len) == 0 && param_table[i].name[len] == '\0')
+        {
+            return (param_id_t)i;
+        }
+    }
+    return PARAM_COUNT;
+}
+
+const param_def_t *Param_Def(param_id_t id)
+{
+    return (id < PARAM_COUNT) ? &param_table[id] : NULL;
+}
+
+uint16_t Param_Format(char *buf, uint16_t size)
+{
+    fmt_buf_t f;
+    uint8_t i;
+
+    fmt_init(&f, buf, size);
+    for (i = 0; i < PARAM_COUNT; i++)
+    {
+        if (i > 0)
+        {
+            fmt_char(&f, ',');
+        }
+        fmt_str(&f, param_table[i].name);
+        fmt_char(&f, '=');
+        fmt_u32(&f, param_values[i], 0, ' ');
+    }
+    return f.len;
+}
+
+void Param_Save(void)
+{
+    // 定时器任务与其他任务都可能调用，挂起调度器保证同一时刻只有一处写Flash
+    vTaskSuspendAll();
+    Param_Flash_Save();
+    xTaskResumeAll();
+}
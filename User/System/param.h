@@ -0,0 +1,117 @@
+/**
+ * @file param.h
+ * @brief 运行参数表（类型、范围、变更回调、掉电保存）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 可调参数统一登记在参数表中，本地界面和云端下发都通过 Param_Set() 修改：
+ *   - 按表项的类型和范围检查，越界的值拒绝；
+ *   - 修改后立即调用表项的变更回调，由回调把新值应用到对应模块
+ *     （如唤醒传感器任务按新的采样间隔运行），无需重启任务；
+ *   - 最后一次修改若干秒后写入片内Flash保留页，上电时恢复。
+ * Flash保留页按4字节记录顺序追加（参数号+值），后写的覆盖先写的，
+ * 写满后擦除整页再写入当前全部参数，减少擦写次数。
+ */
+
+#ifndef __PARAM_H
+#define __PARAM_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================================
+// 配置
+// ==================================
+
+// 参数保存页：第62页，需在工程中将IROM大小减去2KB（第63页留给遥测缓存溢出）
+// 启动时与链接器给出的映像结束地址比较，程序占用该页时不保存参数
+#define PARAM_FLASH_ADDR        0x0800F800
+#define PARAM_FLASH_PAGE_SIZE   1024
+#define PARAM_SAVE_DELAY_MS     5000    // 最后一次修改后延迟保存，连续按键只写一次
+
+// 参数类型
+#define PARAM_TYPE_U16          0       // 无符号整数
+#define PARAM_TYPE_BOOL         1       // 开关，可写 on/off 或 1/0
+
+/**
+ * @brief 参数号
+ */
+typedef enum
+{
+    PARAM_PUBLISH_S = 0,        // 发布间隔（秒）
+    PARAM_SAMPLE_S,             // 采样间隔（秒）
+    PARAM_DHT11_ON,             // 温湿度传感器开关
+    PARAM_LIGHT_ON,             // 光照传感器开关
+    PARAM_PM25_ON,              // PM2.5传感器开关
+    PARAM_COUNT
+} param_id_t;
+
+/**
+ * @brief 参数表项
+ */
+typedef struct
+{
+    const char *name;           // 下发命令和状态报告中使用的名称
+    uint8_t type;               // PARAM_TYPE_xxx
+    uint16_t min;
+    uint16_t max;
+    uint16_t def;               // 默认值（Flash中无记录时使用）
+    /**
+     * @brief 变更回调：把新值应用到对应模块（在调用 Param_Set() 的任务中执行）
+     */
+    void (*on_change)(uint16_t value);
+} param_def_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 从Flash恢复参数并应用，创建延迟保存定时器
+ * @return 0-成功 -1-失败
+ * @note 在创建各任务之前调用
+ */
+int8_t Param_Init(void);
+
+/**
+ * @brief 读取参数当前值
+ */
+uint16_t Param_Get(param_id_t id);
+
+/**
+ * @brief 修改参数
+ * @param id 参数号
+ * @param value 新值
+ * @return 0-成功（值未变化也返回0） -1-参数号无效或超出范围
+ */
+int8_t Param_Set(param_id_t id, uint16_t value);
+
+/**
+ * @brief 按名称查找参数
+ * @param name 名称（可不以'\0'结尾）
+ * @param len 名称长度
+ * @return 参数号，未找到返回 PARAM_COUNT
+ */
+param_id_t Param_Find(const char *name, uint16_t len);
+
+/**
+ * @brief 参数表项
+ */
+const param_def_t *Param_Def(param_id_t id);
+
+/**
+ * @brief 当前全部参数格式化为 "name=value,..."
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 写入长度
+ */
+uint16_t Param_Format(char *buf, uint16_t size);
+
+/**
+ * @brief 立即保存尚未写入Flash的修改
+ */
+void Param_Save(void);
+
+#endif // __PARAM_H
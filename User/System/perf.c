@@ -0,0 +1,317 @@
+/**
+ * @file perf.c
+ * @brief 界面性能统计实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "perf.h"
+
+#if PERF_ENABLE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================================
+// 静态变量
+// ==================================
+
+static perf_page_t perf_pages[PERF_MAX_PAGES];
+static uint8_t perf_page_count = 0;
+static uint32_t perf_cycles_per_us = 72;
+
+// 当前帧
+static perf_page_t *perf_cur = NULL;        // 最近一次绘制的页面（帧外刷屏也计入该页）
+static uint8_t perf_in_frame = 0;
+static uint32_t perf_frame_start = 0;
+static uint32_t perf_frame_flush_us = 0;
+static uint32_t perf_frame_bytes = 0;
+
+// 按键延迟
+static volatile uint8_t perf_key_pending = 0;
+static volatile uint32_t perf_key_stamp = 0;
+
+static uint32_t perf_wakes = 0;             // 菜单任务唤醒次数
+static uint32_t perf_frames = 0;            // 绘制帧数
+
+static const char *const perf_metric_name[PERF_METRIC_COUNT] = {
+    "draw us", "flush us", "flush B", "key us",
+};
+
+// ==================================
+// 直方图
+// ==================================
+
+static uint8_t Perf_Log2(uint32_t v)
+{
+    uint8_t n = 0;
+    while (v > 1 && n < PERF_HIST_BUCKETS - 1)
+    {
+        v >>= 1;
+        n++;
+    }
+    return n;
+}
+
+static void Perf_Hist_Add(perf_hist_t *h, uint32_t v)
+{
+    uint8_t b = Perf_Log2(v);
+
+    // 桶饱和时整体减半，分布形状不变
+    if (h->bucket[b] == 0xFF)
+    {
+        for (uint8_t i = 0; i < PERF_HIST_BUCKETS; i++)
+        {
+            h->bucket[i] >>= 1;
+        }
+    }
+    h->bucket[b]++;
+
+    // 累加和将溢出时计数和累加和一起减半，平均值不变
+    if (h->sum + v < h->sum)
+    {
+        h->sum >>= 1;
+        h->count >>= 1;
+    }
+    h->sum += v;
+    h->count++;
+    if (v > h->max)
+    {
+        h->max = v;
+    }
+}
+
+uint32_t Perf_Hist_Percentile(const perf_hist_t *h, uint8_t pct)
+{
+    uint32_t total = 0, acc = 0;
+    uint8_t i;
+
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+    {
+        total += h->bucket[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    uint32_t need = (total * pct + 99) / 100;
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+    {
+        acc += h->bucket[i];
+        if (acc >= need)
+        {
+            break;
+        }
+    }
+    if (i >= PERF_HIST_BUCKETS - 1)
+    {
+        return h->max;
+    }
+    // 桶上界不超过实际最大值
+    uint32_t upper = (2UL << i) - 1;
+    return (upper < h->max) ? upper : h->max;
+}
+
+// ==================================
+// 页面查找
+// ==================================
+
+static perf_page_t *Perf_Find_Page(const char *name)
+{
+    uint8_t i;
+
+    if (name == NULL)
+    {
+        name = "?";
+    }
+    // 菜单项名称为常量字符串，先比较指针
+    for (i = 0; i < perf_page_count; i++)
+    {
+        if (perf_pages[i].name == name || strcmp(perf_pages[i].name, name) == 0)
+        {
+            return &perf_pages[i];
+        }
+    }
+    if (perf_page_count < PERF_MAX_PAGES)
+    {
+        perf_pages[perf_page_count].name = name;
+        return &perf_pages[perf_page_count++];
+    }
+    // 页面数超出上限时统计到最后一项
+    return &perf_pages[PERF_MAX_PAGES - 1];
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+void Perf_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    PERF_DWT_CYCCNT = 0;
+    PERF_DWT_CTRL |= 1UL;       // CYCCNTENA
+
+    perf_cycles_per_us = SystemCoreClock / 1000000UL;
+    if (perf_cycles_per_us == 0)
+    {
+        perf_cycles_per_us = 1;
+    }
+}
+
+uint32_t Perf_Elapsed_Us(uint32_t start)
+{
+    return (Perf_Stamp() - start) / perf_cycles_per_us;
+}
+
+void Perf_Frame_Begin(const char *page)
+{
+    perf_cur = Perf_Find_Page(page);
+    perf_in_frame = 1;
+    perf_frame_flush_us = 0;
+    perf_frame_bytes = 0;
+    perf_frame_start = Perf_Stamp();
+}
+
+void Perf_Frame_End(void)
+{
+    uint32_t total;
+
+    if (!perf_in_frame || perf_cur == NULL)
+    {
+        return;
+    }
+    total = Perf_Elapsed_Us(perf_frame_start);
+    perf_in_frame = 0;
+    perf_frames++;
+
+    Perf_Hist_Add(&perf_cur->hist[PERF_METRIC_DRAW],
+                  (total > perf_frame_flush_us) ? total - perf_frame_flush_us : 0);
+    if (perf_frame_bytes > 0)
+    {
+        Perf_Hist_Add(&perf_cur->hist[PERF_METRIC_FLUSH], perf_frame_flush_us);
+        Perf_Hist_Add(&perf_cur->hist[PERF_METRIC_BYTES], perf_frame_bytes);
+    }
+    if (total > PERF_BUDGET_FRAME_US)
+    {
+        perf_cur->over_budget++;
+    }
+}
+
+void Perf_Flush_Done(uint32_t start, uint16_t bytes)
+{
+    uint32_t us = Perf_Elapsed_Us(start);
+
+    if (bytes == 0)
+    {
+        return;
+    }
+
+    if (perf_in_frame)
+    {
+        // 帧内刷屏累加到帧统计，帧结束时记录
+        perf_frame_flush_us += us;
+        perf_frame_bytes += bytes;
+    }
+    else if (perf_cur != NULL)
+    {
+        // 帧外刷屏（切换动画逐页上传等）直接记录
+        Perf_Hist_Add(&perf_cur->hist[PERF_METRIC_FLUSH], us);
+        Perf_Hist_Add(&perf_cur->hist[PERF_METRIC_BYTES], bytes);
+    }
+
+    // 按键后的第一次刷屏完成，即画面开始响应的时刻
+    if (perf_key_pending && perf_cur != NULL)
+    {
+        uint32_t key_us = Perf_Elapsed_Us(perf_key_stamp);
+        perf_key_pending = 0;
+        Perf_Hist_Add(&perf_cur->hist[PERF_METRIC_KEY], key_us);
+        if (key_us > PERF_BUDGET_KEY_US)
+        {
+            perf_cur->over_budget++;
+        }
+    }
+}
+
+void Perf_Key_Mark(void)
+{
+    // 已有未响应的按键时保留更早的时刻，统计最坏情况
+    taskENTER_CRITICAL();
+    if (!perf_key_pending)
+    {
+        perf_key_stamp = Perf_Stamp();
+        perf_key_pending = 1;
+    }
+    taskEXIT_CRITICAL();
+}
+
+void Perf_Wake(void)
+{
+    perf_wakes++;
+}
+
+uint8_t Perf_Page_Count(void)
+{
+    return perf_page_count;
+}
+
+const perf_page_t *Perf_Page_Get(uint8_t index)
+{
+    return (index < perf_page_count) ? &perf_pages[index] : NULL;
+}
+
+void Perf_Reset(void)
+{
+    taskENTER_CRITICAL();
+    memset(perf_pages, 0, sizeof(perf_pages));
+    perf_page_count = 0;
+    perf_cur = NULL;
+    perf_in_frame = 0;
+    perf_key_pending = 0;
+    perf_wakes = 0;
+    perf_frames = 0;
+    taskEXIT_CRITICAL();
+}
+
+void Perf_Dump(void)
+{
+    uint8_t i, m, b;
+
+    printf("\r\n===== UI perf: %lu wakes, %lu frames =====\r\n",
+           (unsigned long)perf_wakes, (unsigned long)perf_frames);
+    printf("budget: frame %luus key %luus\r\n",
+           (unsigned long)PERF_BUDGET_FRAME_US, (unsigned long)PERF_BUDGET_KEY_US);
+
+    for (i = 0; i < perf_page_count; i++)
+    {
+        const perf_page_t *pg = &perf_pages[i];
+
+        printf("[%s] over budget %u\r\n", pg->name, pg->over_budget);
+        for (m = 0; m < PERF_METRIC_COUNT; m++)
+        {
+            const perf_hist_t *h = &pg->hist[m];
+            if (h->count == 0)
+            {
+                continue;
+            }
+            printf("  %-8s n=%lu avg=%lu p50=%lu p95=%lu max=%lu |",
+                   perf_metric_name[m], (unsigned long)h->count,
+                   (unsigned long)(h->sum / h->count),
+                   (unsigned long)Perf_Hist_Percentile(h, 50),
+                   (unsigned long)Perf_Hist_Percentile(h, 95),
+                   (unsigned long)h->max);
+            // 直方图：每个桶的计数，桶 i 为 [2^i, 2^(i+1))
+            for (b = 0; b < PERF_HIST_BUCKETS; b++)
+            {
+                printf(" %u", h->bucket[b]);
+            }
+            printf("\r\n");
+        }
+    }
+    printf("==========================================\r\n");
+}
+
+#endif // PERF_ENABLE
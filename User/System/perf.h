@@ -0,0 +1,142 @@
+/**
+ * @file perf.h
+ * @brief 界面性能统计 - 帧绘制/刷屏耗时与按键到刷屏延迟
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 时间戳取自 DWT 周期计数器（72MHz，32位约59秒回绕），差值换算为微秒。
+ * 每个页面（按菜单项名称区分）记录四项直方图：
+ *   绘制耗时（不含刷屏）、刷屏耗时、刷屏字节数、按键到首次刷屏完成的延迟。
+ * 直方图按 log2 分桶，桶 i 收纳 [2^i, 2^(i+1)) 的数值，内存与样本数无关；
+ * 桶计数为8位，任一桶饱和时全部减半，保留分布形状用于估算百分位数。
+ * 统计结果可在诊断页查看，或调用 Perf_Dump() 从调试串口(USART1)输出。
+ */
+
+#ifndef __PERF_H
+#define __PERF_H
+
+#include "stm32f10x.h"
+
+#ifndef PERF_ENABLE
+#define PERF_ENABLE             1       // 0-关闭统计，所有接口编译为空
+#endif
+
+#define PERF_HIST_BUCKETS       16      // 直方图桶数，最后一桶收纳 >= 2^15
+#define PERF_MAX_PAGES          8       // 最多统计的页面数
+
+// 延迟预算（us），超出时计入页面的超预算次数
+#define PERF_BUDGET_FRAME_US    20000   // 单帧绘制+刷屏
+#define PERF_BUDGET_KEY_US      50000   // 按键事件到刷屏完成
+
+// 统计项
+typedef enum {
+    PERF_METRIC_DRAW = 0,   // 绘制耗时(us)，不含刷屏
+    PERF_METRIC_FLUSH,      // 刷屏耗时(us)
+    PERF_METRIC_BYTES,      // 刷屏字节数
+    PERF_METRIC_KEY,        // 按键到刷屏完成(us)
+    PERF_METRIC_COUNT
+} perf_metric_t;
+
+// log2 直方图
+typedef struct {
+    uint32_t count;
+    uint32_t sum;
+    uint32_t max;
+    uint8_t bucket[PERF_HIST_BUCKETS];
+} perf_hist_t;
+
+// 单个页面的统计
+typedef struct {
+    const char *name;
+    perf_hist_t hist[PERF_METRIC_COUNT];
+    uint16_t over_budget;       // 超出预算的次数（帧或按键）
+} perf_page_t;
+
+#if PERF_ENABLE
+
+// 本工程的 core_cm3.h 未定义 DWT 结构，直接按地址访问
+#define PERF_DWT_CTRL           (*(volatile uint32_t *)0xE0001000)
+#define PERF_DWT_CYCCNT         (*(volatile uint32_t *)0xE0001004)
+
+/**
+ * @brief 启用DWT周期计数器（调度器启动前调用）
+ */
+void Perf_Init(void);
+
+/**
+ * @brief 读取当前时间戳（CPU周期）
+ */
+#define Perf_Stamp()            (PERF_DWT_CYCCNT)
+
+/**
+ * @brief 计算从start到现在经过的微秒数
+ */
+uint32_t Perf_Elapsed_Us(uint32_t start);
+
+/**
+ * @brief 标记一帧开始（菜单任务绘制前调用）
+ * @param page 当前页面名称，用作统计分组
+ */
+void Perf_Frame_Begin(const char *page);
+
+/**
+ * @brief 标记一帧结束，记录绘制/刷屏统计
+ */
+void Perf_Frame_End(void);
+
+/**
+ * @brief 记录一次刷屏（OLED刷新接口返回前调用）
+ * @param start 刷屏开始时的时间戳
+ * @param bytes 发送的显存字节数
+ */
+void Perf_Flush_Done(uint32_t start, uint16_t bytes);
+
+/**
+ * @brief 记录按键事件时刻，下一次刷屏完成时计算延迟
+ */
+void Perf_Key_Mark(void);
+
+/**
+ * @brief 菜单任务被唤醒一次
+ */
+void Perf_Wake(void);
+
+uint8_t Perf_Page_Count(void);
+const perf_page_t *Perf_Page_Get(uint8_t index);
+
+/**
+ * @brief 估算百分位数（返回所在桶的上界）
+ * @param pct 百分位(1~100)
+ */
+uint32_t Perf_Hist_Percentile(const perf_hist_t *h, uint8_t pct);
+
+/**
+ * @brief 清空全部统计
+ */
+void Perf_Reset(void);
+
+/**
+ * @brief 从调试串口输出全部统计
+ */
+void Perf_Dump(void);
+
+#else
+
+#define Perf_Init()                     ((void)0)
+#define Perf_Stamp()                    (0U)
+#define Perf_Elapsed_Us(start)          ((void)(start), 0U)
+#define Perf_Frame_Begin(page)          ((void)(page))
+#define Perf_Frame_End()                ((void)0)
+#define Perf_Flush_Done(start, bytes)   ((void)(start), (void)(bytes))
+#define Perf_Key_Mark()                 ((void)0)
+#define Perf_Wake()                     ((void)0)
+#define Perf_Page_Count()               (0U)
+#define Perf_Page_Get(index)            ((const perf_page_t *)0)
+#define Perf_Hist_Percentile(h, pct)    (0U)
+#define Perf_Reset()                    ((void)0)
+#define Perf_Dump()                     ((void)0)
+
+#endif // PERF_ENABLE
+
+#endif // __PERF_H
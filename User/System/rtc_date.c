@@ -1,9 +1,15 @@
 #include "rtc_date.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
 
 // ================== 全局变量 ==================
 uint16_t MyRTC_Time[7] = {2005, 2, 13, 7, 30, 0}; // 
 myRTC_data RTC_data = {0};
+static volatile uint8_t rtc_ready = 0; // 时钟源配置完成标志
+static void (*rtc_second_callback)(void) = NULL; // 秒中断回调（中断上下文）
+
+static void MyRTC_Store(void);
 
 // 星期字符串（对齐 OLED 显示）
 static const char *weekday_str[] = {
@@ -138,6 +144,7 @@ static void SecondsToDateTime(uint32_t seconds,
 // ================== RTC 底层操作 ==================
 
 #define LSE_TIMEOUT_S   5  // 5秒超时
+#define LSE_POLL_MS     50 // LSE 起振轮询间隔（期间让出CPU）
 #define SYSCLK_FREQ_HZ  72000000
 uint8_t RTC_WaitForSynchro_Debug(void)
 {
@@ -147,7 +154,7 @@ uint8_t RTC_WaitForSynchro_Debug(void)
 
     while ((RTC->CRL & RTC_FLAG_RSF) == (uint16_t)RESET)
     {
-        Delay_ms(1);
+        vTaskDelay(1);
         if (++timeout > 500) {
             printf("[RTC ERROR] RSF timeout! CRL=0x%04X\n", RTC->CRL);
             printf("Check: 1. PC14/PC15 IN_FLOATING? 2. VBAT powered? 3. LSE crystal?\n");
@@ -158,7 +165,28 @@ uint8_t RTC_WaitForSynchro_Debug(void)
     printf("\n[RTC OK] RSF set! CRL=0x%04X\n", RTC->CRL);
     return 1;
 }
+// 时钟源就绪：置位标志并打开秒中断
+// 秒中断优先级需低于 configMAX_SYSCALL_INTERRUPT_PRIORITY，回调中可调用 FromISR 接口
+static void MyRTC_Start(void)
+{
+    NVIC_InitTypeDef NVIC_InitStruct;
+
+    RTC_WaitForLastTask();
+    RTC_ClearITPendingBit(RTC_IT_SEC);
+    RTC_ITConfig(RTC_IT_SEC, ENABLE);
+    RTC_WaitForLastTask();
+
+    NVIC_InitStruct.NVIC_IRQChannel = RTC_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 7; // 抢占优先级7
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    rtc_ready = 1;
+}
+
 // 初始化 RTC（LSE 为主，失败回退 LSI）
+// 注意：需在任务上下文中调用，等待 LSE 起振期间通过 vTaskDelay 让出CPU
 void MyRTC_Init(void)
 {
 
@@ -180,14 +208,9 @@ void MyRTC_Init(void)
         uint32_t timeout = 0;
         printf("RCC_LSEConfig(RCC_LSE_ON);");
         while (RCC_GetFlagStatus(RCC_FLAG_LSERDY) != SET) {
-            Delay_s(1);
-            printf("%d",timeout);
-            OLED_Printf_Line(0,"LSE time out : %d",(5-timeout));
-            OLED_DrawProgressBar(0,32,128,10,timeout,0,LSE_TIMEOUT_S,1,1,0);
-            OLED_Refresh_Dirty();
-            if (++timeout > LSE_TIMEOUT_S) {
+            vTaskDelay(pdMS_TO_TICKS(LSE_POLL_MS));
+            if (++timeout > (LSE_TIMEOUT_S * 1000 / LSE_POLL_MS)) {
                 printf("LSE timeout! Falling back to LSI.\n");
-                OLED_Clear();
                 goto USE_LSI;
             }
         }
@@ -196,8 +219,6 @@ void MyRTC_Init(void)
         RCC_RTCCLKCmd(ENABLE);
         
         printf(" RTC_WaitForSynchro");
-        OLED_Printf_Line(1,"wait for Synchro...");
-        OLED_Refresh_Dirty();
         if (!RTC_WaitForSynchro_Debug())
         {
             goto USE_LSI;
@@ -210,9 +231,10 @@ void MyRTC_Init(void)
         RTC_SetPrescaler(32767); // 32768 - 1 → 1Hz
         RTC_WaitForLastTask();
 
-        MyRTC_SetTime(); // 写入初始时间
+        MyRTC_Store(); // 写入初始时间
         BKP_WriteBackupRegister(BKP_DR1, 0xA5A6);
         printf("RTC init with LSE OK!\n");
+        MyRTC_Start();
         return;
 
     USE_LSI:
@@ -220,7 +242,7 @@ void MyRTC_Init(void)
         RCC_LSICmd(ENABLE);
         timeout = 0;
         while (RCC_GetFlagStatus(RCC_FLAG_LSIRDY) != SET) {
-            Delay_ms(1);
+            vTaskDelay(1);
             if (++timeout > 100) break; // LSI 通常 <10ms
         }
 
@@ -235,7 +257,7 @@ void MyRTC_Init(void)
         RTC_SetPrescaler(37999); // ≈1Hz
         RTC_WaitForLastTask();
 
-        MyRTC_SetTime();
+        MyRTC_Store();
         BKP_WriteBackupRegister(BKP_DR1, 0xA5A6); // 标志 LSI 模式
         printf("RTC init with LSI OK!\n");
 
@@ -245,13 +267,14 @@ void MyRTC_Init(void)
             printf("Resuming with LSI...\n");
             RCC_LSICmd(ENABLE);
             uint32_t t = 0;
-            while (RCC_GetFlagStatus(RCC_FLAG_LSIRDY) == RESET && t++ < 100) Delay_ms(1);
+            while (RCC_GetFlagStatus(RCC_FLAG_LSIRDY) == RESET && t++ < 100) vTaskDelay(1);
             RCC_RTCCLKConfig(RCC_RTCCLKSource_LSI);
         } else {
             printf("Resuming with LSE...\n");
             RCC_LSEConfig(RCC_LSE_ON);
             uint32_t t = 0;
-            while (RCC_GetFlagStatus(RCC_FLAG_LSERDY) == RESET && t++ < LSE_TIMEOUT_S) Delay_s(1);
+            while (RCC_GetFlagStatus(RCC_FLAG_LSERDY) == RESET && t++ < (LSE_TIMEOUT_S * 1000 / LSE_POLL_MS))
+                vTaskDelay(pdMS_TO_TICKS(LSE_POLL_MS));
             RCC_RTCCLKConfig(RCC_RTCCLKSource_LSE);
         }
         RCC_RTCCLKCmd(ENABLE);
@@ -259,11 +282,37 @@ void MyRTC_Init(void)
         RTC_WaitForLastTask();
     }
 
+    MyRTC_Start();
     printf("RTC init OK!\n");
 }
 
-// 写全局时间数组到 RTC（UTC 时间）
-void MyRTC_SetTime(void)
+// RTC 时钟源是否已配置完成
+uint8_t MyRTC_IsReady(void)
+{
+    return rtc_ready;
+}
+
+// 注册秒中断回调，回调在中断上下文中执行，只能调用 FromISR 接口
+void MyRTC_SetSecondCallback(void (*callback)(void))
+{
+    rtc_second_callback = callback;
+}
+
+// RTC 秒中断
+void RTC_IRQHandler(void)
+{
+    if (RTC_GetITStatus(RTC_IT_SEC) != RESET)
+    {
+        RTC_ClearITPendingBit(RTC_IT_SEC);
+        if (rtc_second_callback != NULL)
+        {
+            rtc_second_callback();
+        }
+    }
+}
+
+// 写全局时间数组到 RTC（UTC 时间），初始化过程中直接调用
+static void MyRTC_Store(void)
 {
     // MyRTC_Time 中是 **本地时间（东八区）**
     // → 转为 UTC 再存入 RTC
@@ -287,9 +336,28 @@ void MyRTC_SetTime(void)
     RTC_WaitForLastTask();
 }
 
+// 写全局时间数组到 RTC
+// RTC 仍在后台初始化时不访问寄存器：时钟源未配置，RTC_WaitForLastTask 可能一直等待
+void MyRTC_SetTime(void)
+{
+    if (!rtc_ready) {
+        printf("MyRTC_SetTime: RTC not ready\n");
+        return;
+    }
+    MyRTC_Store();
+}
+
 // 从 RTC 读取（UTC 秒数）→ 更新 MyRTC_Time 和 RTC_data（转为本地时间）
 void MyRTC_ReadTime(void)
 {
+    // RTC 仍在后台初始化（等待 LSE 起振）时保留默认时间
+    if (!rtc_ready) {
+        if (RTC_data.weekday == NULL) {
+            RTC_data.weekday = "";
+        }
+        return;
+    }
+
     uint32_t rtc_sec_utc = RTC_GetCounter();
 
     // 转为本地时间（UTC + 8h）
@@ -384,6 +452,12 @@ uint8_t RTC_SetFromNetworkTime(const char *time_str)
         printf("RTC_SetFromNetworkTime: NULL time string\n");
         return 0;
     }
+
+    // 时钟源仍在配置（等待 LSE 起振或回退 LSI），返回失败由连接管理器按退避重试
+    if (!MyRTC_IsReady()) {
+        printf("RTC_SetFromNetworkTime: RTC not ready\n");
+        return 0;
+    }
     
     printf("Parsing network time: %s\n", time_str);
     
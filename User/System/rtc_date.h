@@ -22,6 +22,8 @@ typedef struct
 
 extern myRTC_data RTC_data;
 void MyRTC_Init(void);
+uint8_t MyRTC_IsReady(void);
+void MyRTC_SetSecondCallback(void (*callback)(void));
 void MyRTC_SetTime(void);
 void MyRTC_ReadTime(void);
 void RTC_SetTime_Manual(uint8_t hours, uint8_t minutes, uint8_t seconds);
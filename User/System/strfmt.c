@@ -0,0 +1,170 @@
+/**
+ * @file strfmt.c
+ * @brief 轻量级整数/定点数格式化实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "strfmt.h"
+
+static const uint16_t fmt_pow10[5] = {1, 10, 100, 1000, 10000};
+
+// ==================================
+// 基础写入
+// ==================================
+
+void fmt_init(fmt_buf_t *f, char *buf, uint16_t size)
+{
+    f->buf = buf;
+    f->size = size;
+    f->len = 0;
+    if (size > 0)
+    {
+        buf[0] = '\0';
+    }
+}
+
+void fmt_char(fmt_buf_t *f, char c)
+{
+    if (f->len + 1 < f->size)
+    {
+        f->buf[f->len++] = c;
+        f->buf[f->len] = '\0';
+    }
+}
+
+void fmt_str(fmt_buf_t *f, const char *s)
+{
+    while (*s != '\0' && f->len + 1 < f->size)
+    {
+        f->buf[f->len++] = *s++;
+    }
+    if (f->size > 0)
+    {
+        f->buf[f->len] = '\0';
+    }
+}
+
+void fmt_strn(fmt_buf_t *f, const char *s, uint16_t n)
+{
+    while (n-- > 0 && *s != '\0' && f->len + 1 < f->size)
+    {
+        f->buf[f->len++] = *s++;
+    }
+    if (f->size > 0)
+    {
+        f->buf[f->len] = '\0';
+    }
+}
+
+// ==================================
+// 数字格式化
+// ==================================
+
+/**
+ * @brief 无符号数转十进制，写入tmp末尾，返回位数
+ */
+static uint8_t fmt_utoa(uint32_t v, char tmp[10])
+{
+    uint8_t n = 0;
+    do
+    {
+        tmp[9 - n] = (char)('0' + v % 10);
+        v /= 10;
+        n++;
+    } while (v != 0);
+    return n;
+}
+
+/**
+ * @brief 输出 [符号][填充][数字] 组合
+ */
+static void fmt_number(fmt_buf_t *f, uint32_t mag, uint8_t neg, uint8_t width, char pad)
+{
+    char tmp[10];
+    uint8_t digits = fmt_utoa(mag, tmp);
+    uint8_t total = digits + (neg ? 1 : 0);
+
+    if (neg && pad == '0')
+    {
+        fmt_char(f, '-');
+    }
+    while (total < width)
+    {
+        fmt_char(f, pad);
+        total++;
+    }
+    if (neg && pad != '0')
+    {
+        fmt_char(f, '-');
+    }
+    fmt_strn(f, &tmp[10 - digits], digits);
+}
+
+void fmt_u32(fmt_buf_t *f, uint32_t v, uint8_t width, char pad)
+{
+    fmt_number(f, v, 0, width, pad);
+}
+
+void fmt_i32(fmt_buf_t *f, int32_t v, uint8_t width, char pad)
+{
+    if (v < 0)
+    {
+        fmt_number(f, (uint32_t)(-(v + 1)) + 1, 1, width, pad);
+    }
+    else
+    {
+        fmt_number(f, (uint32_t)v, 0, width, pad);
+    }
+}
+
+void fmt_fixed(fmt_buf_t *f, int32_t v, uint8_t frac, uint8_t width)
+{
+    uint32_t mag;
+    uint8_t neg = 0;
+
+    if (frac > 4)
+    {
+        frac = 4;
+    }
+    if (frac == 0)
+    {
+        fmt_i32(f, v, width, ' ');
+        return;
+    }
+
+    if (v < 0)
+    {
+        neg = 1;
+        mag = (uint32_t)(-(v + 1)) + 1;
+    }
+    else
+    {
+        mag = (uint32_t)v;
+    }
+
+    uint32_t ip = mag / fmt_pow10[frac];
+    uint32_t fp = mag % fmt_pow10[frac];
+
+    // 整数部分宽度 = 总宽度 - 小数点 - 小数位
+    uint8_t int_width = (width > frac + 1) ? (uint8_t)(width - frac - 1) : 0;
+    fmt_number(f, ip, neg, int_width, ' ');
+    fmt_char(f, '.');
+    fmt_u32(f, fp, frac, '0');
+}
+
+void fmt_2d(fmt_buf_t *f, uint32_t v)
+{
+    fmt_u32(f, v, 2, '0');
+}
+
+int32_t fmt_to_fixed(float v, uint8_t frac)
+{
+    if (frac > 4)
+    {
+        frac = 4;
+    }
+    float scaled = v * (float)fmt_pow10[frac];
+    return (int32_t)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file strfmt.h
+ * @brief 轻量级整数/定点数格式化（替代热路径上的 snprintf/vsnprintf）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 所有函数写入调用者提供的缓冲区，始终保持 '\0' 结尾，空间不足时截断。
+ * 不依赖浮点运算与 locale，小数一律以定点整数传入，例如 25.3 传 253、frac=1。
+ *
+ * 用法：
+ *   char buf[16];
+ *   fmt_buf_t f;
+ *   fmt_init(&f, buf, sizeof(buf));
+ *   fmt_str(&f, "on#");
+ *   fmt_fixed(&f, 253, 1, 0);   // "on#25.3"
+ */
+
+#ifndef __STRFMT_H
+#define __STRFMT_H
+
+#include "stm32f10x.h"
+
+typedef struct {
+    char *buf;          // 目标缓冲区
+    uint16_t size;      // 缓冲区大小（含结束符）
+    uint16_t len;       // 已写入长度（不含结束符）
+} fmt_buf_t;
+
+/**
+ * @brief 绑定缓冲区并清空
+ * @param f 格式化上下文
+ * @param buf 目标缓冲区
+ * @param size 缓冲区大小（含结束符，至少为1）
+ */
+void fmt_init(fmt_buf_t *f, char *buf, uint16_t size);
+
+/**
+ * @brief 追加单个字符
+ */
+void fmt_char(fmt_buf_t *f, char c);
+
+/**
+ * @brief 追加短字符串
+ */
+void fmt_str(fmt_buf_t *f, const char *s);
+
+/**
+ * @brief 追加字符串的前n个字符（遇到'\0'提前结束）
+ */
+void fmt_strn(fmt_buf_t *f, const char *s, uint16_t n);
+
+/**
+ * @brief 追加无符号整数
+ * @param v 数值
+ * @param width 最小宽度（0表示不限），不足时左侧用pad填充
+ * @param pad 填充字符，通常为' '或'0'
+ */
+void fmt_u32(fmt_buf_t *f, uint32_t v, uint8_t width, char pad);
+
+/**
+ * @brief 追加有符号整数
+ * @note pad为'0'时负号位于填充之前，例如 -5 宽度3 -> "-05"
+ */
+void fmt_i32(fmt_buf_t *f, int32_t v, uint8_t width, char pad);
+
+/**
+ * @brief 追加定点小数
+ * @param v 放大 10^frac 倍后的整数值（例如 25.3 -> 253）
+ * @param frac 小数位数(0~4)
+ * @param width 最小总宽度（含符号和小数点），左侧补空格
+ */
+void fmt_fixed(fmt_buf_t *f, int32_t v, uint8_t frac, uint8_t width);
+
+/**
+ * @brief 追加两位补零数字（时间字段），大于99时按实际位数输出
+ */
+void fmt_2d(fmt_buf_t *f, uint32_t v);
+
+/**
+ * @brief 浮点数四舍五入为定点整数（只在数据采集边界使用一次）
+ * @param v 浮点值
+ * @param frac 小数位数(0~4)
+ * @return v * 10^frac 四舍五入后的整数
+ */
+int32_t fmt_to_fixed(float v, uint8_t frac);
+
+#endif // __STRFMT_H
@@ -0,0 +1,748 @@
+/**
+ * @file at_engine.c
+ * @brief ESP8266 异步AT指令引擎实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "at_engine.h"
+#include "uart2.h"
+#include "queue.h"
+#include "event_groups.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+// 引擎任务通知位
+#define AT_EVT_RX           (1UL << 0)  // UART2收到数据
+#define AT_EVT_CMD          (1UL << 1)  // 有新指令入队
+#define AT_EVT_RX_IDLE      (1UL << 2)  // UART2线路空闲（一段输出结束）
+#define AT_EVT_TX           (1UL << 3)  // UART2发送缓冲区发空
+
+#define AT_SYNC_NONE        0xFF
+
+// 队列中的指令
+typedef struct
+{
+    uart2_iov_t iov[AT_IOV_MAX];    // 指令片段，完成前必须保持有效
+    uint8_t iov_count;
+    const char *expect;
+    uint16_t timeout_ms;
+    at_done_cb_t done;
+    void *arg;
+    uint8_t sync_slot;          // 同步等待槽位，AT_SYNC_NONE-异步
+    char *resp;                 // 同步调用的应答缓冲区
+    uint16_t resp_size;
+    uint8_t flags;              // AT_FLAG_xxx
+    // 以下为执行状态
+    uint8_t sent;               // 已放入发送缓冲区
+    uint8_t prompted;           // AT_FLAG_PROMPT：已收到 '>'，数据片段待发或已发
+    uint8_t resp_filled;
+    TickType_t start;           // 放入发送缓冲区的时刻
+} at_cmd_t;
+
+typedef struct
+{
+    const char *prefix;
+    uint8_t prefix_len;
+    at_urc_cb_t cb;
+} at_urc_t;
+
+// ==================================
+// 静态变量
+// ==================================
+
+// 默认串口：UART2
+static const at_port_t at_port_uart2 = {
+    UART2_TX_Writev, UART2_RX_Peek, UART2_RX_Consume, UART2_RX_Overruns,
+    UART2_RX_Flush, UART2_SetRxCallback, UART2_SetTxCallback, UART2_SetBaudrate,
+};
+static const at_port_t *at_port = &at_port_uart2;
+
+static TaskHandle_t at_task_handle = NULL;
+static QueueHandle_t at_queue = NULL;
+static EventGroupHandle_t at_sync_events = NULL;
+
+// 已发出、等待应答的指令（按发送顺序，应答按顺序匹配最早的一条）
+static at_cmd_t at_pipe[AT_PIPE_MAX];
+static uint8_t at_pipe_head = 0;
+static uint8_t at_pipe_count = 0;
+
+#define AT_PIPE_AT(i)       (&at_pipe[(at_pipe_head + (i)) % AT_PIPE_MAX])
+#define AT_OLDEST()         AT_PIPE_AT(0)
+#define AT_NEWEST()         AT_PIPE_AT(at_pipe_count - 1)
+
+// 行缓冲
+static char at_line[AT_LINE_MAX + 1];
+static uint16_t at_line_len = 0;
+static uint8_t at_partial_armed = 0;    // 段尾有未换行的半行，静默后作为一行
+static TickType_t at_partial_tick;      // 最后一次收到数据的时刻
+
+// +IPD 数据：收齐包头后按长度原样取走，借用行缓冲存放
+static at_ipd_cb_t at_ipd_cb = NULL;
+static uint16_t at_ipd_left = 0;        // 当前数据包还未收到的字节数，0-不在数据中
+static uint8_t at_ipd_link;
+static uint8_t at_ipd_flags;
+
+// URC表
+static at_urc_t at_urc_table[AT_URC_MAX];
+static uint8_t at_urc_count = 0;
+
+// 同步等待槽位
+static uint8_t at_sync_used = 0;
+static int8_t at_sync_result[AT_SYNC_SLOTS];
+
+// ==================================
+// 指令执行
+// ==================================
+
+/**
+ * @brief 最早的一条指令完成，出队后通知提交者
+ */
+static void AT_Complete(int8_t result, const char *line)
+{
+    at_cmd_t cmd = *AT_OLDEST();
+
+    at_pipe_head = (at_pipe_head + 1) % AT_PIPE_MAX;
+    at_pipe_count--;
+
+    if (cmd.done != NULL)
+    {
+        cmd.done(result, line, cmd.arg);
+    }
+    if (cmd.sync_slot != AT_SYNC_NONE)
+    {
+        at_sync_result[cmd.sync_slot] = result;
+        xEventGroupSetBits(at_sync_events, (EventBits_t)1 << cmd.sync_slot);
+    }
+}
+
+/**
+ * @brief 把最新一条指令的片段交给DMA发送，缓冲区不足时等发送完成通知后重试
+ */
+static void AT_Transmit(void)
+{
+    at_cmd_t *cmd = AT_NEWEST();
+    const uart2_iov_t *iov = cmd->iov;
+    uint8_t count = cmd->iov_count;
+
+    // 分两次发出：先指令头，收到 '>' 后再发数据
+    if (cmd->flags & AT_FLAG_PROMPT)
+    {
+        if (!cmd->prompted)
+        {
+            count = 1;
+        }
+        else
+        {
+            iov++;
+            count--;
+        }
+    }
+
+    if (at_port->writev(iov, count) == 0)
+    {
+        cmd->sent = 1;
+        cmd->start = xTaskGetTickCount();
+    }
+}
+
+/**
+ * @brief 判断下一条指令能否在尚有未应答指令时发出
+ * @note 只有全部在途指令和新指令都允许流水发送时才不必等待
+ */
+static uint8_t AT_Can_Start(const at_cmd_t *next)
+{
+    uint8_t i;
+
+    if (at_pipe_count == 0)
+    {
+        return 1;
+    }
+    if (at_pipe_count >= AT_PIPE_MAX || !(next->flags & AT_FLAG_PIPELINE) || !AT_NEWEST()->sent)
+    {
+        return 0;
+    }
+    for (i = 0; i < at_pipe_count; i++)
+    {
+        if (!(AT_PIPE_AT(i)->flags & AT_FLAG_PIPELINE))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void AT_Start_Next(void)
+{
+    at_cmd_t *slot;
+
+    while (at_pipe_count < AT_PIPE_MAX)
+    {
+        // 先窥视再取出，直接放入在途队列的空位
+        slot = AT_PIPE_AT(at_pipe_count);
+        if (xQueuePeek(at_queue, slot, 0) != pdPASS || !AT_Can_Start(slot))
+        {
+            return;
+        }
+        xQueueReceive(at_queue, slot, 0);
+        slot->sent = 0;
+        slot->prompted = 0;
+        slot->resp_filled = 0;
+        at_pipe_count++;
+
+        AT_Transmit();
+        if (!slot->sent)
+        {
+            return;
+        }
+    }
+}
+
+static void AT_Check_Timeout(void)
+{
+    at_cmd_t *cmd;
+
+    while (at_pipe_count > 0)
+    {
+        cmd = AT_OLDEST();
+        if (!cmd->sent || xTaskGetTickCount() - cmd->start < pdMS_TO_TICKS(cmd->timeout_ms))
+        {
+            return;
+        }
+        // '>' 丢失时模块仍在等待数据，不发出则其后的指令都被当作数据；
+        // 照常发出，再等一小段时间取走 SEND OK（模块未在等待时数据按指令处理，应答 ERROR）
+        if ((cmd->flags & AT_FLAG_PROMPT) && !cmd->prompted)
+        {
+            LOG_W(LOG_MOD_WIFI, "AT: no prompt, send data anyway");
+            cmd->prompted = 1;
+            cmd->sent = 0;
+            if (cmd->timeout_ms > AT_PROMPT_LATE_MS)
+            {
+                cmd->timeout_ms = AT_PROMPT_LATE_MS;
+            }
+            AT_Transmit();
+            return;
+        }
+        // 不等待应答的指令到时即完成
+        AT_Complete(cmd->expect == AT_EXPECT_NONE ? AT_RES_OK : AT_RES_TIMEOUT, NULL);
+    }
+}
+
+// ==================================
+// 行解析
+// ==================================
+
+static void AT_Dispatch_Line(void)
+{
+    at_cmd_t *cmd;
+    uint8_t i;
+
+    at_line[at_line_len] = '\0';
+
+    // 主动上报优先，不参与指令应答匹配
+    for (i = 0; i < at_urc_count; i++)
+    {
+        if (strncmp(at_line, at_urc_table[i].prefix, at_urc_table[i].prefix_len) == 0)
+        {
+            at_urc_table[i].cb(at_line, at_line_len);
+            return;
+        }
+    }
+
+    if (at_pipe_count == 0 || !AT_OLDEST()->sent)
+    {
+        LOG_D(LOG_MOD_WIFI, "AT: unhandled \"%s\"", at_line);
+        return;
+    }
+
+    // 应答按发送顺序到达，总是交给最早的在途指令
+    cmd = AT_OLDEST();
+
+    // 等待发送提示符期间只关心 '>' 和错误（指令头的 OK 在 '>' 之前到达）
+    if ((cmd->flags & AT_FLAG_PROMPT) && !cmd->prompted)
+    {
+        if (at_line_len == 1 && at_line[0] == '>')
+        {
+            cmd->prompted = 1;
+            cmd->sent = 0;
+            AT_Transmit();
+        }
+        else if (strstr(at_line, "ERROR") != NULL || strstr(at_line, "FAIL") != NULL)
+        {
+            AT_Complete(AT_RES_ERROR, at_line);
+        }
+        return;
+    }
+    if (cmd->resp != NULL && !cmd->resp_filled)
+    {
+        uint16_t n = (at_line_len < cmd->resp_size - 1) ? at_line_len : cmd->resp_size - 1;
+        memcpy(cmd->resp, at_line, n);
+        cmd->resp[n] = '\0';
+        cmd->resp_filled = 1;
+    }
+
+    if (cmd->expect == AT_EXPECT_NONE)
+    {
+        return;
+    }
+    if (cmd->expect[0] == '\0' || strstr(at_line, cmd->expect) != NULL)
+    {
+        AT_Complete(AT_RES_OK, at_line);
+    }
+    else if (strstr(at_line, "ERROR") != NULL || strstr(at_line, "FAIL") != NULL)
+    {
+        AT_Complete(AT_RES_ERROR, at_line);
+    }
+}
+
+/**
+ * @brief 行缓冲中是否为完整的 +IPD 包头（"+IPD,<长度>" 或 "+IPD,<连接号>,<长度>"）
+ * @return 1-是，连接号和长度存入 at_ipd_link/at_ipd_left
+ */
+static uint8_t AT_Parse_IPD(void)
+{
+    uint32_t num[2] = {0, 0};
+    uint8_t count = 0;
+    uint16_t i;
+
+    if (at_line_len < 6 || memcmp(at_line, "+IPD,", 5) != 0)
+    {
+        return 0;
+    }
+    for (i = 5; i < at_line_len; i++)
+    {
+        char c = at_line[i];
+        if (c >= '0' && c <= '9' && num[count] < 0xFFFF)
+        {
+            num[count] = num[count] * 10 + (uint32_t)(c - '0');
+        }
+        else if (c == ',' && count == 0 && i > 5)
+        {
+            count = 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    if (at_line[at_line_len - 1] == ',' || num[count] == 0 || num[count] > 0xFFFF || (count == 1 && num[0] > 0xFF))
+    {
+        return 0;
+    }
+    at_ipd_link = (count == 1) ? (uint8_t)num[0] : AT_IPD_LINK_NONE;
+    at_ipd_left = (uint16_t)num[count];
+    return 1;
+}
+
+/**
+ * @brief +IPD 数据的一个字节，行缓冲满或数据包结束时交付一段
+ */
+static void AT_Feed_IPD(uint8_t c)
+{
+    at_line[at_line_len++] = (char)c;
+    at_ipd_left--;
+    if (at_ipd_left == 0 || at_line_len >= AT_LINE_MAX)
+    {
+        if (at_ipd_left == 0)
+        {
+            at_ipd_flags |= AT_IPD_LAST;
+        }
+        at_line[at_line_len] = '\0';
+        at_ipd_cb(at_ipd_link, at_line, at_line_len, at_ipd_flags);
+        at_ipd_flags = 0;
+        at_line_len = 0;
+    }
+}
+
+static void AT_Feed_Byte(uint8_t c)
+{
+    if (at_ipd_left > 0)
+    {
+        AT_Feed_IPD(c);
+        return;
+    }
+
+    // 包头之后的数据不经过行解析
+    if (c == ':' && at_ipd_cb != NULL && AT_Parse_IPD() == 1)
+    {
+        at_ipd_flags = AT_IPD_FIRST;
+        at_line_len = 0;
+        return;
+    }
+
+    if (c == '\r' || c == '\n')
+    {
+        if (at_line_len > 0)
+        {
+            AT_Dispatch_Line();
+            at_line_len = 0;
+        }
+        return;
+    }
+
+    // 发送提示符不带换行，单独成行
+    if (c == '>' && at_line_len == 0)
+    {
+        at_line[at_line_len++] = '>';
+        AT_Dispatch_Line();
+        at_line_len = 0;
+        return;
+    }
+
+    if (at_line_len < AT_LINE_MAX)
+    {
+        at_line[at_line_len++] = (char)c;
+    }
+}
+
+/**
+ * @brief 最早的在途指令正在等待任意应答（如网络时间，服务器不带换行）
+ */
+static uint8_t AT_Wants_Any(void)
+{
+    at_cmd_t *cmd;
+
+    if (at_pipe_count == 0)
+    {
+        return 0;
+    }
+    cmd = AT_OLDEST();
+    return cmd->sent && cmd->expect != AT_EXPECT_NONE && cmd->expect[0] == '\0' &&
+           !((cmd->flags & AT_FLAG_PROMPT) && !cmd->prompted);
+}
+
+/**
+ * @brief 从UART2环形缓冲区按连续段取走数据并逐字节解析
+ * @param idle 线路已空闲，段尾未换行的内容（如网络时间）在静默 AT_PARTIAL_QUIET_MS 后作为一行
+ * @note 一条应答可能被拆成多个TCP段，空闲中断只说明一段结束；其余情况半行等待换行
+ */
+static void AT_Process_RX(uint8_t idle)
+{
+    const uint8_t *data;
+    uint16_t len, i;
+    static uint16_t overruns = 0;
+
+    while ((len = at_port->rx_peek(&data)) > 0)
+    {
+        for (i = 0; i < len; i++)
+        {
+            AT_Feed_Byte(data[i]);
+        }
+        at_port->rx_consume(len);
+        at_partial_armed = 0;
+    }
+
+    if (at_port->rx_overruns() != overruns)
+    {
+        overruns = at_port->rx_overruns();
+        LOG_W(LOG_MOD_WIFI, "AT: rx overrun %u", overruns);
+        at_line_len = 0;    // 半行数据已不完整；+IPD 数据仍按长度取完，不回到按行解析
+    }
+
+    if (idle && at_line_len > 0 && at_ipd_left == 0 && AT_Wants_Any())
+    {
+        at_partial_armed = 1;
+        at_partial_tick = xTaskGetTickCount();
+    }
+}
+
+/**
+ * @brief 半行静默时间已到，作为一行处理
+ */
+static void AT_Check_Partial(void)
+{
+    if (!at_partial_armed || xTaskGetTickCount() - at_partial_tick < pdMS_TO_TICKS(AT_PARTIAL_QUIET_MS))
+    {
+        return;
+    }
+    at_partial_armed = 0;
+    if (at_line_len > 0 && at_ipd_left == 0 && AT_Wants_Any())
+    {
+        AT_Dispatch_Line();
+        at_line_len = 0;
+    }
+}
+
+// ==================================
+// 引擎任务
+// ==================================
+
+static void AT_RX_Notify(uint8_t event)
+{
+    BaseType_t woken = pdFALSE;
+    uint32_t bits = AT_EVT_RX;
+
+    if (event & UART2_RX_EVT_IDLE)
+    {
+        bits |= AT_EVT_RX_IDLE;
+    }
+    if (at_task_handle != NULL)
+    {
+        xTaskNotifyFromISR(at_task_handle, bits, eSetBits, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+static void AT_TX_Notify(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (at_task_handle != NULL)
+    {
+        xTaskNotifyFromISR(at_task_handle, AT_EVT_TX, eSetBits, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+static void AT_Task(void *pvParameters)
+{
+    uint32_t events;
+    TickType_t wait;
+
+    for (;;)
+    {
+        // 空闲或等待发送缓冲区时无限等待，否则等到最早一条指令超时
+        wait = portMAX_DELAY;
+        if (at_pipe_count > 0 && AT_OLDEST()->sent)
+        {
+            TickType_t elapsed = xTaskGetTickCount() - AT_OLDEST()->start;
+            TickType_t limit = pdMS_TO_TICKS(AT_OLDEST()->timeout_ms);
+            wait = (elapsed >= limit) ? 0 : limit - elapsed;
+        }
+        if (at_partial_armed)
+        {
+            TickType_t elapsed = xTaskGetTickCount() - at_partial_tick;
+            TickType_t quiet = pdMS_TO_TICKS(AT_PARTIAL_QUIET_MS);
+            TickType_t left = (elapsed >= quiet) ? 0 : quiet - elapsed;
+            wait = (left < wait) ? left : wait;
+        }
+
+        events = 0;
+        xTaskNotifyWait(0, 0xFFFFFFFF, &events, wait);
+
+        if (events & AT_EVT_RX)
+        {
+            AT_Process_RX((events & AT_EVT_RX_IDLE) != 0);
+        }
+        AT_Check_Partial();
+        if (at_pipe_count > 0 && !AT_NEWEST()->sent)
+        {
+            AT_Transmit();
+        }
+        AT_Check_Timeout();
+        AT_Start_Next();
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+int8_t AT_Init(void)
+{
+    return AT_Init_Port(&at_port_uart2);
+}
+
+int8_t AT_Init_Port(const at_port_t *port)
+{
+    if (at_task_handle != NULL)
+    {
+        return 0;
+    }
+    if (port == NULL)
+    {
+        return -1;
+    }
+    at_port = port;
+
+    at_queue = xQueueCreate(AT_QUEUE_LEN, sizeof(at_cmd_t));
+    at_sync_events = xEventGroupCreate();
+    if (at_queue == NULL || at_sync_events == NULL)
+    {
+        LOG_E(LOG_MOD_WIFI, "AT: queue create failed");
+        return -1;
+    }
+
+    if (xTaskCreate(AT_Task, "AT_Engine", AT_TASK_STACK, NULL, AT_TASK_PRIO, &at_task_handle) != pdPASS)
+    {
+        LOG_E(LOG_MOD_WIFI, "AT: task create failed");
+        return -1;
+    }
+
+    at_port->rx_flush();
+    at_port->set_rx_callback(AT_RX_Notify);
+    at_port->set_tx_callback(AT_TX_Notify);
+    return 0;
+}
+
+void AT_Set_IPD_Handler(at_ipd_cb_t cb)
+{
+    at_ipd_cb = cb;
+}
+
+int8_t AT_Set_Baudrate(uint32_t baudrate)
+{
+    if (at_port->set_baudrate == NULL)
+    {
+        return -1;
+    }
+    at_port->set_baudrate(baudrate);
+    return 0;
+}
+
+int8_t AT_Register_URC(const char *prefix, at_urc_cb_t cb)
+{
+    if (prefix == NULL || cb == NULL || at_urc_count >= AT_URC_MAX)
+    {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    at_urc_table[at_urc_count].prefix = prefix;
+    at_urc_table[at_urc_count].prefix_len = (uint8_t)strlen(prefix);
+    at_urc_table[at_urc_count].cb = cb;
+    at_urc_count++;
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+static int8_t AT_Submit(at_cmd_t *cmd, const uart2_iov_t *iov, uint8_t count,
+                        const char *expect, uint16_t timeout_ms, uint8_t flags)
+{
+    uint16_t total = 0;
+    uint8_t i;
+
+    if (at_queue == NULL || iov == NULL || count == 0 || count > AT_IOV_MAX)
+    {
+        return AT_RES_BUSY;
+    }
+    for (i = 0; i < count; i++)
+    {
+        cmd->iov[i] = iov[i];
+        total += iov[i].len;
+    }
+    if (total == 0 || total > UART2_TX_RING_SIZE || ((flags & AT_FLAG_PROMPT) && count < 2))
+    {
+        return AT_RES_BUSY;
+    }
+    if (flags & AT_FLAG_PROMPT)
+    {
+        flags &= (uint8_t)~AT_FLAG_PIPELINE; // 数据须紧跟在自己的 '>' 之后
+    }
+
+    cmd->iov_count = count;
+    cmd->flags = flags;
+    cmd->expect = expect;
+    cmd->timeout_ms = timeout_ms;
+
+    if (xQueueSend(at_queue, cmd, 0) != pdPASS)
+    {
+        return AT_RES_BUSY;
+    }
+    xTaskNotify(at_task_handle, AT_EVT_CMD, eSetBits);
+    return AT_RES_OK;
+}
+
+int8_t AT_Sendv(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms,
+                uint8_t flags, at_done_cb_t done, void *arg)
+{
+    at_cmd_t c;
+
+    c.done = done;
+    c.arg = arg;
+    c.sync_slot = AT_SYNC_NONE;
+    c.resp = NULL;
+    c.resp_size = 0;
+    return AT_Submit(&c, iov, count, expect, timeout_ms, flags);
+}
+
+int8_t AT_Send(const char *cmd, const char *expect, uint16_t timeout_ms,
+               at_done_cb_t done, void *arg)
+{
+    uart2_iov_t iov = {cmd, (uint16_t)strlen(cmd)};
+
+    return AT_Sendv(&iov, 1, expect, timeout_ms, 0, done, arg);
+}
+
+/**
+ * @brief 同步执行的公共实现
+ */
+static int8_t AT_Exec_Common(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms,
+                             uint8_t flags, char *resp, uint16_t resp_size)
+{
+    at_cmd_t c;
+    uint8_t slot;
+    int8_t result;
+
+    // 占用一个同步等待槽位，不占用调用任务自身的任务通知
+    taskENTER_CRITICAL();
+    for (slot = 0; slot < AT_SYNC_SLOTS; slot++)
+    {
+        if (!(at_sync_used & (1U << slot)))
+        {
+            at_sync_used |= (1U << slot);
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+    if (slot >= AT_SYNC_SLOTS)
+    {
+        return AT_RES_BUSY;
+    }
+
+    if (resp != NULL && resp_size > 0)
+    {
+        resp[0] = '\0';
+    }
+    c.done = NULL;
+    c.arg = NULL;
+    c.sync_slot = slot;
+    c.resp = (resp_size > 0) ? resp : NULL;
+    c.resp_size = resp_size;
+
+    // 片段在调用者栈上，本函数返回前指令必然已完成
+    result = AT_Submit(&c, iov, count, expect, timeout_ms, flags);
+    if (result == AT_RES_OK)
+    {
+        // 引擎保证每条指令在超时后完成
+        xEventGroupWaitBits(at_sync_events, (EventBits_t)1 << slot, pdTRUE, pdTRUE, portMAX_DELAY);
+        result = at_sync_result[slot];
+    }
+
+    taskENTER_CRITICAL();
+    at_sync_used &= ~(1U << slot);
+    taskEXIT_CRITICAL();
+    return result;
+}
+
+int8_t AT_Execv_Resp(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms,
+                     char *resp, uint16_t resp_size)
+{
+    return AT_Exec_Common(iov, count, expect, timeout_ms, 0, resp, resp_size);
+}
+
+int8_t AT_Execv(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms)
+{
+    return AT_Exec_Common(iov, count, expect, timeout_ms, 0, NULL, 0);
+}
+
+int8_t AT_Execv_Flags(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms,
+                      uint8_t flags)
+{
+    return AT_Exec_Common(iov, count, expect, timeout_ms, flags, NULL, 0);
+}
+
+int8_t AT_Exec_Resp(const char *cmd, const char *expect, uint16_t timeout_ms,
+                    char *resp, uint16_t resp_size)
+{
+    uart2_iov_t iov = {cmd, (uint16_t)strlen(cmd)};
+
+    return AT_Execv_Resp(&iov, 1, expect, timeout_ms, resp, resp_size);
+}
+
+int8_t AT_Exec(const char *cmd, const char *expect, uint16_t timeout_ms)
+{
+    return AT_Exec_Resp(cmd, expect, timeout_ms, NULL, 0);
+}
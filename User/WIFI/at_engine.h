@@ -0,0 +1,199 @@
+/**
+ * @file at_engine.h
+ * @brief ESP8266 异步AT指令引擎
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 引擎任务从UART2接收环形缓冲区中按行解析应答（\r\n 或接收空闲视为行结束，
+ * 行首的 '>' 作为发送提示符单独成行），指令排队依次发送：
+ *   - 每条指令带期望的结束标志和超时，完成时调用回调或唤醒同步等待者；
+ *   - 带 AT_FLAG_PIPELINE 的指令可连续发出，应答按发送顺序依次匹配；
+ *   - 以注册前缀开头的行视为主动上报(URC)，分发给对应处理函数，
+ *     例如 "WIFI DISCONNECT"、"CLOSED" 及透传模式下云平台下发的数据；
+ *   - 非透传模式的网络数据 "+IPD,[连接号,]<长度>:" 之后按长度原样取走，交给
+ *     AT_Set_IPD_Handler 设置的处理函数，不按行解析：对端发来的数据中即使含有
+ *     "\r\nOK"、"4,CLOSED" 等也不会被当作应答或主动上报。
+ * 指令可由多个片段组成（命令头/uid/主题/数据），发送时直接拷入UART2的
+ * DMA发送缓冲区，无需先拼接到临时缓冲区。带 AT_FLAG_PROMPT 的指令在队列中
+ * 作为一个整体执行（指令头、等待 '>'、数据），其他任务的指令不会插入其间。
+ * 调用者不再轮询接收缓冲，等待期间不占用CPU。
+ * 引擎只通过 at_port_t 访问串口，默认使用UART2；替换为其他实现
+ * （如主机上的伪终端或脚本化的模块模拟）即可脱离硬件运行整个WiFi协议栈。
+ */
+
+#ifndef __AT_ENGINE_H
+#define __AT_ENGINE_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "uart2.h"
+#include <string.h>
+
+// ==================================
+// 配置
+// ==================================
+
+#define AT_LINE_MAX         128     // 单行应答最大长度（超出部分丢弃）
+#define AT_IOV_MAX          8       // 单条指令最多片段数
+#define AT_QUEUE_LEN        4       // 指令队列深度
+#define AT_URC_MAX          8       // URC处理函数个数上限
+#define AT_SYNC_SLOTS       4       // 可同时同步等待的任务数
+#define AT_PIPE_MAX         3       // 最多同时在途（已发出未应答）的指令数
+#define AT_PARTIAL_QUIET_MS 50      // 等待任意应答时，未换行的半行静默多久后作为一行（TCP分段间隔远小于此）
+#define AT_PROMPT_LATE_MS   300     // 等不到 '>' 仍发出数据后，再等待应答的时间
+
+#define AT_TASK_STACK       256     // 引擎任务堆栈（字）
+#define AT_TASK_PRIO        3       // 高于ESP8266业务任务，及时取走应答
+
+// 指令结果
+#define AT_RES_OK           0       // 收到期望的结束标志
+#define AT_RES_ERROR        -1      // 收到 ERROR/FAIL
+#define AT_RES_TIMEOUT      -2      // 超时
+#define AT_RES_BUSY         -3      // 队列满或引擎未启动
+
+// 指令标志
+#define AT_FLAG_PIPELINE    0x01    // 可不等前一条应答连续发出（应答按发送顺序匹配）
+#define AT_FLAG_PROMPT      0x02    // 先只发第一个片段（如 AT+CIPSEND=..），收到 '>' 后再发其余片段；不可流水
+
+// 指令片段：字符串常量 / 运行时字符串
+#define AT_IOV_STR(s)       {(s), (uint16_t)(sizeof(s) - 1)}
+#define AT_IOV(p)           {(p), (uint16_t)strlen(p)}
+
+// +IPD 数据片段标志
+#define AT_IPD_FIRST        0x01    // 一个数据包的第一段
+#define AT_IPD_LAST         0x02    // 一个数据包的最后一段
+#define AT_IPD_LINK_NONE    0xFF    // 单连接模式（+IPD,<长度>: 不带连接号）
+
+// 期望标志取值约定
+#define AT_EXPECT_NONE      NULL    // 不等待应答，超时后视为成功（如 "+++"）
+#define AT_EXPECT_ANY       ""      // 任意非空行即完成（如网络时间查询）
+
+/**
+ * @brief 指令完成回调（在引擎任务中执行）
+ * @param result AT_RES_xxx
+ * @param line 使指令完成的应答行，超时时为NULL
+ * @param arg 提交时传入的参数
+ */
+typedef void (*at_done_cb_t)(int8_t result, const char *line, void *arg);
+
+/**
+ * @brief 串口操作（语义与 uart2.h 中同名函数一致）
+ */
+typedef struct
+{
+    int8_t (*writev)(const uart2_iov_t *iov, uint8_t count);    // 全部放入发送缓冲区返回0，空间不足返回-1
+    uint16_t (*rx_peek)(const uint8_t **data);                  // 取接收缓冲区中的连续一段
+    void (*rx_consume)(uint16_t len);
+    uint16_t (*rx_overruns)(void);
+    void (*rx_flush)(void);
+    void (*set_rx_callback)(void (*callback)(uint8_t event));   // event 取 UART2_RX_EVT_xxx
+    void (*set_tx_callback)(void (*callback)(void));            // 发送缓冲区发空时调用
+    void (*set_baudrate)(uint32_t baudrate);                    // 切换波特率，不支持时为NULL
+} at_port_t;
+
+/**
+ * @brief URC处理函数（在引擎任务中执行）
+ * @param line 完整的一行（不含\r\n，以'\0'结尾）
+ * @param len 行长度
+ */
+typedef void (*at_urc_cb_t)(const char *line, uint16_t len);
+
+/**
+ * @brief +IPD 数据处理函数（在引擎任务中执行）
+ * @param link 连接号，单连接模式为 AT_IPD_LINK_NONE
+ * @param data 数据片段（其后补'\0'，数据本身可能含'\0'），超过 AT_LINE_MAX 的数据包分多段交付
+ * @param len 片段长度
+ * @param flags AT_IPD_FIRST/AT_IPD_LAST
+ */
+typedef void (*at_ipd_cb_t)(uint8_t link, const char *data, uint16_t len, uint8_t flags);
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 创建引擎任务和指令队列，并挂接UART2接收通知
+ * @return 0-成功 -1-失败
+ * @note UART2初始化后调用，重复调用直接返回成功
+ */
+int8_t AT_Init(void);
+
+/**
+ * @brief 使用指定的串口操作启动引擎
+ * @param port 串口操作（运行期间必须保持有效）
+ * @return 0-成功 -1-失败
+ */
+int8_t AT_Init_Port(const at_port_t *port);
+
+/**
+ * @brief 注册URC处理函数
+ * @param prefix 行前缀（常量字符串）
+ * @param cb 处理函数
+ * @return 0-成功 -1-表已满
+ */
+int8_t AT_Register_URC(const char *prefix, at_urc_cb_t cb);
+
+/**
+ * @brief 设置 +IPD 数据处理函数，未设置时 +IPD 行按普通行处理
+ */
+void AT_Set_IPD_Handler(at_ipd_cb_t cb);
+
+/**
+ * @brief 切换串口波特率（与模块的 AT+UART_CUR 配合）
+ * @param baudrate 新波特率
+ * @return 0-成功 -1-串口不支持
+ * @note 只在没有指令在途时调用，切换瞬间收到的残缺字节按一行无效应答丢弃
+ */
+int8_t AT_Set_Baudrate(uint32_t baudrate);
+
+/**
+ * @brief 异步提交一条由多个片段组成的指令
+ * @param iov 片段数组（数组本身会被复制，片段内容在指令完成前必须保持有效）
+ * @param count 片段个数，不超过 AT_IOV_MAX
+ * @param expect 期望的结束标志子串（常量字符串），见 AT_EXPECT_xxx
+ * @param timeout_ms 超时时间（从放入发送缓冲区开始计）
+ * @param flags AT_FLAG_xxx
+ * @param done 完成回调，可为NULL
+ * @param arg 回调参数
+ * @return 0-已入队 AT_RES_BUSY-队列满或参数错误
+ * @note 指令按提交顺序完成，同一任务先异步提交若干条、最后同步执行一条，
+ *       同步返回时前面的指令必然都已完成
+ */
+int8_t AT_Sendv(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms,
+                uint8_t flags, at_done_cb_t done, void *arg);
+
+/**
+ * @brief 异步提交一条指令
+ * @param cmd 指令文本（完成前必须保持有效，AT指令需自带\r\n）
+ */
+int8_t AT_Send(const char *cmd, const char *expect, uint16_t timeout_ms,
+               at_done_cb_t done, void *arg);
+
+/**
+ * @brief 同步执行一条由多个片段组成的指令，阻塞调用任务直到完成
+ * @return AT_RES_xxx
+ */
+int8_t AT_Execv(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms);
+int8_t AT_Execv_Flags(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms,
+                      uint8_t flags);
+
+/**
+ * @brief 同步执行一条指令，阻塞调用任务直到完成
+ * @return AT_RES_xxx
+ */
+int8_t AT_Exec(const char *cmd, const char *expect, uint16_t timeout_ms);
+
+/**
+ * @brief 同步执行一条指令，并取回第一行非空应答
+ * @param resp 应答缓冲区
+ * @param resp_size 缓冲区大小
+ * @return AT_RES_xxx
+ */
+int8_t AT_Exec_Resp(const char *cmd, const char *expect, uint16_t timeout_ms,
+                    char *resp, uint16_t resp_size);
+int8_t AT_Execv_Resp(const uart2_iov_t *iov, uint8_t count, const char *expect, uint16_t timeout_ms,
+                     char *resp, uint16_t resp_size);
+
+#endif // __AT_ENGINE_H
@@ -0,0 +1,446 @@
+/**
+ * @file bemfa_client.c
+ * @brief 巴法云TCP协议客户端实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "bemfa_client.h"
+#include "downlink.h"
+#include "sensordata.h"
+#include "queue.h"
+#include "event_groups.h"
+#include "strfmt.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+// 等待应答的请求
+typedef struct
+{
+    uint8_t used;
+    uint8_t cmd;
+    uint8_t done;
+    uint8_t skipped;            // 作为最早的同类请求时丢弃过一条过期应答
+    int8_t result;
+    uint32_t seq;               // 提交顺序
+    char *resp;                 // 非 "cmd=" 应答的存放位置，NULL-不接受
+    uint16_t resp_size;
+} bemfa_pending_t;
+
+// 下发队列中的一条
+typedef struct
+{
+    uint8_t len;
+    char line[BEMFA_PUSH_LINE_MAX];
+} bemfa_push_t;
+
+// ==================================
+// 静态变量
+// ==================================
+
+static bemfa_pending_t bc_pending[BEMFA_PENDING_MAX];
+static uint32_t bc_seq = 0;
+static EventGroupHandle_t bc_events = NULL;
+static QueueHandle_t bc_push_queue = NULL;
+
+// 每种命令字超时请求的迟到应答个数及最近一次超时时刻
+static uint8_t bc_stale[BEMFA_CMD_MAX];
+static TickType_t bc_stale_tick[BEMFA_CMD_MAX];
+
+static bemfa_client_stats_t bc_stats;
+
+// ==================================
+// 应答关联
+// ==================================
+
+/**
+ * @brief 应答交给同一命令字最早的未完成请求
+ * @note 该命令字有超时请求时，先到的一条应答属于超时的请求，直接丢弃
+ */
+static void Bemfa_Client_On_Response(uint8_t cmd, int8_t result)
+{
+    bemfa_pending_t *oldest = NULL;
+    uint8_t slot = 0, stale = 0;
+
+    taskENTER_CRITICAL();
+    if (bc_stale[cmd] > 0 && xTaskGetTickCount() - bc_stale_tick[cmd] > pdMS_TO_TICKS(BEMFA_STALE_MS))
+    {
+        bc_stale[cmd] = 0;
+    }
+    for (uint8_t i = 0; i < BEMFA_PENDING_MAX; i++)
+    {
+        bemfa_pending_t *p = &bc_pending[i];
+        if (p->used && !p->done && p->cmd == cmd && (oldest == NULL || p->seq < oldest->seq))
+        {
+            oldest = p;
+            slot = i;
+        }
+    }
+    if (bc_stale[cmd] > 0)
+    {
+        bc_stale[cmd]--;
+        stale = 1;
+        if (oldest != NULL)
+        {
+            oldest->skipped = 1;
+        }
+    }
+    else if (oldest != NULL)
+    {
+        oldest->done = 1;
+        oldest->result = result;
+    }
+    taskEXIT_CRITICAL();
+
+    if (stale)
+    {
+        bc_stats.stale++;
+    }
+    else if (oldest != NULL)
+    {
+        bc_stats.responses++;
+        xEventGroupSetBits(bc_events, (EventBits_t)1 << slot);
+    }
+    else
+    {
+        bc_stats.unmatched++;
+        LOG_W(LOG_MOD_WIFI, "Bemfa: unmatched cmd=%u response", cmd);
+    }
+}
+
+/**
+ * @brief 没有 "cmd=" 前缀的一行（对时应答）交给最早的接受这类应答的请求
+ * @return 1-已交给请求 0-没有等待的请求
+ */
+static uint8_t Bemfa_Client_On_Text(const char *line, uint16_t len)
+{
+    bemfa_pending_t *oldest = NULL;
+    uint8_t slot = 0;
+
+    taskENTER_CRITICAL();
+    for (uint8_t i = 0; i < BEMFA_PENDING_MAX; i++)
+    {
+        bemfa_pending_t *p = &bc_pending[i];
+        if (p->used && !p->done && p->resp != NULL && (oldest == NULL || p->seq < oldest->seq))
+        {
+            oldest = p;
+            slot = i;
+        }
+    }
+    if (oldest != NULL)
+    {
+        uint16_t n = (len < oldest->resp_size - 1) ? len : oldest->resp_size - 1;
+        memcpy(oldest->resp, line, n);
+        oldest->resp[n] = '\0';
+        oldest->done = 1;
+        oldest->result = AT_RES_OK;
+    }
+    taskEXIT_CRITICAL();
+
+    if (oldest == NULL)
+    {
+        return 0;
+    }
+    bc_stats.responses++;
+    xEventGroupSetBits(bc_events, (EventBits_t)1 << slot);
+    return 1;
+}
+
+// ==================================
+// 下发
+// ==================================
+
+/**
+ * @brief 下发放入队列，只保留 topic=..&msg=.. 部分
+ */
+static void Bemfa_Client_On_Push(const char *line, uint16_t len)
+{
+    const char *topic = strstr(line, "topic=");
+    bemfa_push_t push;
+    uint16_t n;
+
+    bc_stats.pushes++;
+    if (topic == NULL)
+    {
+        return;
+    }
+    n = (uint16_t)(len - (topic - line));
+    if (n >= BEMFA_PUSH_LINE_MAX)
+    {
+        // 截断会改变命令含义，整条丢弃
+        bc_stats.push_drops++;
+        LOG_W(LOG_MOD_WIFI, "Bemfa: push too long (%u)", n);
+        return;
+    }
+    memcpy(push.line, topic, n);
+    push.line[n] = '\0';
+    push.len = (uint8_t)n;
+
+    if (xQueueSend(bc_push_queue, &push, 0) != pdPASS)
+    {
+        bc_stats.push_drops++;
+        LOG_W(LOG_MOD_WIFI, "Bemfa: push queue full, dropped %s", push.line);
+    }
+}
+
+// ==================================
+// 行分类
+// ==================================
+
+void Bemfa_Client_On_Line(const char *line, uint16_t len)
+{
+    const char *p = line + 4;
+    const char *res;
+    uint8_t cmd = 0;
+
+    if (len < 5 || memcmp(line, "cmd=", 4) != 0 || *p < '0' || *p > '9')
+    {
+        if (Bemfa_Client_On_Text(line, len) == 1)
+        {
+            return;
+        }
+        LOG_D(LOG_MOD_WIFI, "Bemfa: unhandled \"%s\"", line);
+        return;
+    }
+    while (*p >= '0' && *p <= '9')
+    {
+        cmd = (uint8_t)(cmd * 10 + (*p++ - '0'));
+    }
+
+    res = strstr(p, "&res=");
+    if (cmd == BEMFA_CMD_PUBLISH && res == NULL && strstr(p, "&topic=") != NULL)
+    {
+        Bemfa_Client_On_Push(line, len);
+    }
+    else if (res != NULL && cmd < BEMFA_CMD_MAX)
+    {
+        Bemfa_Client_On_Response(cmd, (res[5] == '1') ? AT_RES_OK : AT_RES_ERROR);
+    }
+    else
+    {
+        LOG_D(LOG_MOD_WIFI, "Bemfa: unhandled \"%s\"", line);
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+int8_t Bemfa_Client_Init(void)
+{
+    if (bc_events != NULL)
+    {
+        return 0;
+    }
+
+    bc_events = xEventGroupCreate();
+    bc_push_queue = xQueueCreate(BEMFA_PUSH_QUEUE_LEN, sizeof(bemfa_push_t));
+    if (bc_events == NULL || bc_push_queue == NULL)
+    {
+        LOG_E(LOG_MOD_WIFI, "Bemfa: client create failed");
+        return -1;
+    }
+    return AT_Register_URC("cmd=", Bemfa_Client_On_Line);
+}
+
+void Bemfa_Client_Reset(void)
+{
+    EventBits_t bits = 0;
+
+    taskENTER_CRITICAL();
+    for (uint8_t i = 0; i < BEMFA_PENDING_MAX; i++)
+    {
+        if (bc_pending[i].used && !bc_pending[i].done)
+        {
+            bc_pending[i].done = 1;
+            bc_pending[i].result = AT_RES_ERROR;
+            bits |= (EventBits_t)1 << i;
+        }
+    }
+    memset(bc_stale, 0, sizeof(bc_stale));
+    taskEXIT_CRITICAL();
+
+    if (bits != 0)
+    {
+        xEventGroupSetBits(bc_events, bits);
+    }
+}
+
+static void Bemfa_Tx_Done(int8_t result, const char *line, void *arg)
+{
+    ((bemfa_req_t *)arg)->tx_done = 1;
+}
+
+/**
+ * @brief 登记并发送一条请求
+ * @param resp 非 "cmd=" 应答的存放位置，NULL-按命令字关联 res= 应答
+ */
+static int8_t Bemfa_Submit(const uart2_iov_t *iov, uint8_t count, uint8_t cmd, bemfa_req_t *req,
+                           char *resp, uint16_t resp_size)
+{
+    uint8_t slot;
+    int8_t ret;
+
+    if (bc_events == NULL || cmd >= BEMFA_CMD_MAX || (resp != NULL && resp_size == 0))
+    {
+        return AT_RES_BUSY;
+    }
+
+    // 先登记再发送，应答不会早于登记到达
+    taskENTER_CRITICAL();
+    for (slot = 0; slot < BEMFA_PENDING_MAX; slot++)
+    {
+        if (!bc_pending[slot].used)
+        {
+            bc_pending[slot].used = 1;
+            bc_pending[slot].cmd = cmd;
+            bc_pending[slot].done = 0;
+            bc_pending[slot].skipped = 0;
+            bc_pending[slot].seq = ++bc_seq;
+            bc_pending[slot].resp = resp;
+            bc_pending[slot].resp_size = resp_size;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+    if (slot >= BEMFA_PENDING_MAX)
+    {
+        return AT_RES_BUSY;
+    }
+
+    xEventGroupClearBits(bc_events, (EventBits_t)1 << slot);
+    req->slot = slot;
+    req->result = AT_RES_TIMEOUT;
+    req->tx_done = 0;
+
+#if ESP8266_LAN_SERVER
+    {
+        // 多连接模式：指令头与帧作为一条指令，等到 '>' 后发出帧，SEND OK 即发送完成
+        uart2_iov_t link_iov[AT_IOV_MAX];
+        fmt_buf_t f;
+        uint16_t total = 0;
+        uint8_t i;
+
+        for (i = 0; i < count && i < AT_IOV_MAX - 1; i++)
+        {
+            link_iov[i + 1] = iov[i];
+            total += iov[i].len;
+        }
+        fmt_init(&f, req->link_cmd, sizeof(req->link_cmd));
+        fmt_str(&f, "AT+CIPSEND=" ESP8266_STR(ESP8266_CLOUD_LINK) ",");
+        fmt_u32(&f, total, 0, ' ');
+        fmt_str(&f, "\r\n");
+        link_iov[0].data = req->link_cmd;
+        link_iov[0].len = f.len;
+        ret = (count < AT_IOV_MAX)
+                  ? AT_Sendv(link_iov, count + 1, "SEND OK", 2000, AT_FLAG_PROMPT, Bemfa_Tx_Done, req)
+                  : AT_RES_BUSY;
+    }
+#else
+    // 应答由客户端关联，AT引擎只负责发送：不等待应答，发出即完成
+    ret = AT_Sendv(iov, count, AT_EXPECT_NONE, 0, AT_FLAG_PIPELINE, Bemfa_Tx_Done, req);
+#endif
+    if (ret != AT_RES_OK)
+    {
+        bc_pending[slot].used = 0;
+        return AT_RES_BUSY;
+    }
+    return AT_RES_OK;
+}
+
+int8_t Bemfa_Request_Submit(const uart2_iov_t *iov, uint8_t count, uint8_t cmd, bemfa_req_t *req)
+{
+    return Bemfa_Submit(iov, count, cmd, req, NULL, 0);
+}
+
+int8_t Bemfa_Request_Wait(bemfa_req_t *req, TickType_t deadline)
+{
+    bemfa_pending_t *p = &bc_pending[req->slot];
+    TickType_t now = xTaskGetTickCount();
+    int8_t result;
+
+    xEventGroupWaitBits(bc_events, (EventBits_t)1 << req->slot, pdTRUE, pdTRUE,
+                        ((int32_t)(deadline - now) > 0) ? deadline - now : 0);
+
+    taskENTER_CRITICAL();
+    if (p->done)
+    {
+        result = p->result;
+    }
+    else
+    {
+        // 应答可能迟到，记下以免错配给下一条同类请求；
+        // 若已替它丢弃过一条应答，那条多半就是它的，不再记
+        result = AT_RES_TIMEOUT;
+        // 以非 "cmd=" 行应答的请求不参与 res= 应答的关联
+        if (!p->skipped && p->resp == NULL && bc_stale[p->cmd] < 0xFF)
+        {
+            bc_stale[p->cmd]++;
+            bc_stale_tick[p->cmd] = xTaskGetTickCount();
+        }
+    }
+    p->used = 0;
+    taskEXIT_CRITICAL();
+
+    // 帧片段在调用者栈上，返回前确认已拷入发送缓冲区
+    while (!req->tx_done)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    req->result = result;
+    return result;
+}
+
+int8_t Bemfa_Request(const uart2_iov_t *iov, uint8_t count, uint8_t cmd, uint16_t timeout_ms)
+{
+    bemfa_req_t req;
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+
+    if (Bemfa_Request_Submit(iov, count, cmd, &req) != AT_RES_OK)
+    {
+        return AT_RES_BUSY;
+    }
+    return Bemfa_Request_Wait(&req, deadline);
+}
+
+int8_t Bemfa_Request_Resp(const uart2_iov_t *iov, uint8_t count, uint8_t cmd, uint16_t timeout_ms,
+                          char *resp, uint16_t resp_size)
+{
+    bemfa_req_t req;
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+
+    if (Bemfa_Submit(iov, count, cmd, &req, resp, resp_size) != AT_RES_OK)
+    {
+        return AT_RES_BUSY;
+    }
+    return Bemfa_Request_Wait(&req, deadline);
+}
+
+uint8_t Bemfa_Client_Dispatch_Pushes(void)
+{
+    bemfa_push_t push;
+    uint8_t n = 0;
+
+    if (bc_push_queue == NULL)
+    {
+        return 0;
+    }
+    while (xQueueReceive(bc_push_queue, &push, 0) == pdPASS)
+    {
+        LOG_I(LOG_MOD_WIFI, "ESP8266 Receive Data: %s", push.line);
+        if (Downlink_Dispatch(push.line, push.len) == 1)
+        {
+            LOG_I(LOG_MOD_WIFI, "Command processed successfully. Current sensor states: DHT11=%d, Light=%d, PM25=%d",
+                                DHT11_ON, Light_ON, PM25_ON);
+        }
+        n++;
+    }
+    return n;
+}
+
+void Bemfa_Client_GetStats(bemfa_client_stats_t *stats)
+{
+    *stats = bc_stats;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file bemfa_client.h
+ * @brief 巴法云TCP协议客户端：请求/应答关联与下发分流
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 透传模式下服务器发来的每一行都以 "cmd=N&" 开头（对时应答除外），
+ * 客户端作为AT引擎的URC处理函数接管全部这类行，不再交给AT指令按顺序匹配：
+ *   - 含 "res=" 的是应答，交给同一 cmd 最早的未完成请求
+ *     （订阅 cmd=1、发布 cmd=2、心跳 cmd=0），同类应答按发送顺序到达；
+ *   - cmd=2 且含 topic/msg 的是云端下发，放入下发队列，
+ *     由ESP8266任务调用 Bemfa_Client_Dispatch_Pushes() 交给命令分发器执行。
+ * 发布等待应答期间到达的下发不会被当成应答消耗掉，也不会阻塞AT引擎任务。
+ * 请求超时后其应答可能迟到，记为过期应答，下一条同类应答直接丢弃，
+ * 避免后续请求错配到前一条请求的应答。
+ * 对时应答（cmd=7）没有 "cmd=" 前缀，仍由AT引擎按指令应答匹配，
+ * 其余行都已被客户端取走，不会与之混淆。
+ * 多连接模式（ESP8266_LAN_SERVER）下每帧以 AT+CIPSEND=<连接号>,<长度> 发出，
+ * 服务器数据（含对时应答）都经 +IPD 交给客户端，对时应答改由 Bemfa_Request_Resp() 等待。
+ */
+
+#ifndef __BEMFA_CLIENT_H
+#define __BEMFA_CLIENT_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "at_engine.h"
+#include "esp8266.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define BEMFA_PENDING_MAX       4       // 同时等待应答的请求数（发布流水线 + 心跳）
+#define BEMFA_PUSH_QUEUE_LEN    4       // 下发队列深度
+#define BEMFA_PUSH_LINE_MAX     80      // 单条下发最大长度（去掉 cmd/uid 后的 topic=..&msg=..）
+#define BEMFA_STALE_MS          5000    // 过期应答的有效期，超过后不再丢弃同类应答
+
+// 协议命令字
+#define BEMFA_CMD_PING          0       // 心跳
+#define BEMFA_CMD_SUBSCRIBE     1       // 订阅
+#define BEMFA_CMD_PUBLISH       2       // 发布 / 下发
+#define BEMFA_CMD_TIME          7       // 对时
+#define BEMFA_CMD_MAX           8
+
+/**
+ * @brief 一个等待应答的请求（由调用者提供存储，完成前必须保持有效）
+ */
+typedef struct
+{
+    uint8_t slot;               // 等待槽位
+    int8_t result;              // AT_RES_xxx
+    volatile uint8_t tx_done;   // 已放入发送缓冲区
+#if ESP8266_LAN_SERVER
+    char link_cmd[24];          // AT+CIPSEND=<连接号>,<长度>
+#endif
+} bemfa_req_t;
+
+/**
+ * @brief 运行计数
+ */
+typedef struct
+{
+    uint16_t responses;         // 已关联到请求的应答
+    uint16_t stale;             // 丢弃的迟到应答
+    uint16_t unmatched;         // 没有对应请求的应答
+    uint16_t pushes;            // 收到的下发
+    uint16_t push_drops;        // 下发队列满而丢弃
+} bemfa_client_stats_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 创建下发队列并向AT引擎注册 "cmd=" 行处理
+ * @return 0-成功 -1-失败
+ * @note AT_Init() 之后调用
+ */
+int8_t Bemfa_Client_Init(void);
+
+/**
+ * @brief 新的TCP会话：未完成的请求全部以失败结束，清除过期应答记录
+ */
+void Bemfa_Client_Reset(void);
+
+/**
+ * @brief 处理一行服务器数据（"cmd=" URC 及非透传模式的 +IPD 数据）
+ * @param line 行内容（不含\r\n）
+ * @param len 行长度
+ */
+void Bemfa_Client_On_Line(const char *line, uint16_t len);
+
+/**
+ * @brief 提交一条请求，不等待应答
+ * @param iov 帧片段（须以\r\n结尾），发送完成前必须保持有效
+ * @param count 片段个数
+ * @param cmd 应答的命令字 BEMFA_CMD_xxx
+ * @param req 请求存储
+ * @return AT_RES_OK-已提交 AT_RES_BUSY-等待槽位或指令队列满
+ * @note 多条请求可连续提交，再依次 Bemfa_Request_Wait()
+ */
+int8_t Bemfa_Request_Submit(const uart2_iov_t *iov, uint8_t count, uint8_t cmd, bemfa_req_t *req);
+
+/**
+ * @brief 等待请求的应答
+ * @param req 已提交的请求
+ * @param deadline 截止时刻（系统节拍）
+ * @return AT_RES_OK-res=1 AT_RES_ERROR-其他res值或会话复位 AT_RES_TIMEOUT-超时
+ * @note 返回时帧已发出，片段存储可以释放
+ */
+int8_t Bemfa_Request_Wait(bemfa_req_t *req, TickType_t deadline);
+
+/**
+ * @brief 同步执行一条请求
+ * @return 同 Bemfa_Request_Wait()，提交失败返回 AT_RES_BUSY
+ */
+int8_t Bemfa_Request(const uart2_iov_t *iov, uint8_t count, uint8_t cmd, uint16_t timeout_ms);
+
+/**
+ * @brief 同步执行一条请求，以服务器发来的第一行非 "cmd=" 数据作为应答（多连接模式下的对时）
+ * @param resp 应答缓冲区
+ * @param resp_size 缓冲区大小
+ * @return AT_RES_OK-收到应答 AT_RES_TIMEOUT-超时 AT_RES_BUSY-提交失败
+ */
+int8_t Bemfa_Request_Resp(const uart2_iov_t *iov, uint8_t count, uint8_t cmd, uint16_t timeout_ms,
+                          char *resp, uint16_t resp_size);
+
+/**
+ * @brief 执行队列中的全部下发（在ESP8266任务中调用）
+ * @return 执行的条数
+ */
+uint8_t Bemfa_Client_Dispatch_Pushes(void);
+
+/**
+ * @brief 读取运行计数
+ */
+void Bemfa_Client_GetStats(bemfa_client_stats_t *stats);
+
+#endif // __BEMFA_CLIENT_H
@@ -0,0 +1,194 @@
+/**
+ * @file bemfa_topics.c
+ * @brief 巴法云主题表实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "bemfa_topics.h"
+#include "esp8266.h"
+#include "sensordata.h"
+#include "param.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================================
+// 消息格式化
+// ==================================
+
+// mydht004：on#温度#湿度
+static void Bemfa_Format_DHT11(fmt_buf_t *f, const outbox_entry_t *e)
+{
+    fmt_str(f, "on#");
+    fmt_u32(f, e->temp_int, 0, ' ');
+    fmt_char(f, '.');
+    fmt_u32(f, e->temp_deci, 0, ' ');
+    fmt_char(f, '#');
+    fmt_u32(f, e->humi, 0, ' ');
+}
+
+// myLUX004：#光照
+static void Bemfa_Format_Light(fmt_buf_t *f, const outbox_entry_t *e)
+{
+    fmt_char(f, '#');
+    fmt_u32(f, e->lux, 0, ' ');
+}
+
+// myMP25004：#PM2.5#等级
+static void Bemfa_Format_PM25(fmt_buf_t *f, const outbox_entry_t *e)
+{
+    fmt_char(f, '#');
+    fmt_fixed(f, e->pm25_x10, 1, 0);
+    fmt_char(f, '#');
+    fmt_u32(f, e->pm25_level, 0, ' ');
+}
+
+// ==================================
+// 主题表
+// ==================================
+
+const bemfa_topic_t bemfa_topics[] = {
+    {"mydht004", BEMFA_DIR_UP | BEMFA_DIR_DOWN, BEMFA_PUB_LIVE | BEMFA_PUB_BACKLOG,
+     OUTBOX_F_DHT11, Bemfa_Format_DHT11, PARAM_DHT11_ON, NULL},
+    {"myMP25004", BEMFA_DIR_UP | BEMFA_DIR_DOWN, BEMFA_PUB_LIVE | BEMFA_PUB_BACKLOG,
+     OUTBOX_F_PM25, Bemfa_Format_PM25, PARAM_PM25_ON, NULL},
+    {"myLUX004", BEMFA_DIR_UP | BEMFA_DIR_DOWN, BEMFA_PUB_LIVE | BEMFA_PUB_BACKLOG,
+     OUTBOX_F_LIGHT, Bemfa_Format_Light, PARAM_LIGHT_ON, NULL},
+    // 读数主题由面板组件按格式解析，参数报告等状态消息单独发布，不订阅也就不会收回
+    {BEMFA_STATUS_TOPIC, BEMFA_DIR_UP, 0, 0, NULL, PARAM_COUNT, NULL},
+};
+
+const uint8_t bemfa_topic_count = sizeof(bemfa_topics) / sizeof(bemfa_topics[0]);
+
+// ==================================
+// 接口实现
+// ==================================
+
+const char *Bemfa_Sub_List(void)
+{
+    static char list[BEMFA_SUB_LIST_MAX];
+    fmt_buf_t f;
+
+    if (list[0] != '\0')
+    {
+        return list;
+    }
+
+    fmt_init(&f, list, sizeof(list));
+    for (uint8_t i = 0; i < bemfa_topic_count; i++)
+    {
+        if (!(bemfa_topics[i].dir & BEMFA_DIR_DOWN))
+        {
+            continue;
+        }
+        if (f.len > 0)
+        {
+            fmt_char(&f, ',');
+        }
+        fmt_str(&f, bemfa_topics[i].name);
+    }
+    return list;
+}
+
+const bemfa_topic_t *Bemfa_Find_Topic(const char *name, uint16_t len)
+{
+    // 按名称排序的表项索引，首次查找时生成（插入排序，表项很少）
+    static uint8_t sorted[BEMFA_TOPICS_MAX];
+    static uint8_t sorted_count = 0;
+    dl_slice_t key = {name, len};
+    int lo, hi;
+
+    if (sorted_count == 0)
+    {
+        for (uint8_t i = 0; i < bemfa_topic_count && i < BEMFA_TOPICS_MAX; i++)
+        {
+            uint8_t j = i;
+            while (j > 0 && strcmp(bemfa_topics[sorted[j - 1]].name, bemfa_topics[i].name) > 0)
+            {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = i;
+            sorted_count = i + 1;
+        }
+    }
+
+    lo = 0;
+    hi = (int)sorted_count - 1;
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        const bemfa_topic_t *t = &bemfa_topics[sorted[mid]];
+        int c = Downlink_Slice_Cmp(&key, t->name);
+        if (c == 0)
+        {
+            return t;
+        }
+        if (c < 0)
+        {
+            hi = mid - 1;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+uint8_t Bemfa_Publish_Reading(const outbox_entry_t *e, uint8_t with_ts)
+{
+    // 只在ESP8266任务中调用，缓冲区放在静态区，不占用该任务的栈
+    static char data[BEMFA_TOPICS_MAX][BEMFA_MSG_MAX];
+    static esp8266_pub_t pub[BEMFA_TOPICS_MAX];
+    static uint8_t pub_reading[BEMFA_TOPICS_MAX];
+    uint8_t policy = with_ts ? BEMFA_PUB_BACKLOG : BEMFA_PUB_LIVE;
+    uint8_t pub_count = 0;
+    uint8_t failed = 0;
+    fmt_buf_t f;
+
+    // 各主题的数据先全部格式化，再一次性流水线发布
+    for (uint8_t i = 0; i < bemfa_topic_count && pub_count < BEMFA_TOPICS_MAX; i++)
+    {
+        const bemfa_topic_t *t = &bemfa_topics[i];
+        if (!(t->dir & BEMFA_DIR_UP) || !(t->policy & policy) || !(e->flags & t->reading))
+        {
+            continue;
+        }
+
+        fmt_init(&f, data[pub_count], sizeof(data[0]));
+        t->format(&f, e);
+        if (with_ts && e->ts != OUTBOX_TS_UNKNOWN)
+        {
+            fmt_char(&f, '#');
+            fmt_u32(&f, e->ts, 0, ' ');
+        }
+
+        pub[pub_count].topic = t->name;
+        pub[pub_count].msg = data[pub_count];
+        pub_reading[pub_count] = t->reading;
+        pub_count++;
+    }
+
+    if (pub_count == 0)
+    {
+        return 0;
+    }
+
+    ESP8266_TCP_Publish_Batch(BEMFA_UID, pub, pub_count);
+    for (uint8_t i = 0; i < pub_count; i++)
+    {
+        if (pub[i].result == AT_RES_OK)
+        {
+            LOG_D(LOG_MOD_WIFI, "publish %s%s ok", pub[i].topic, with_ts ? " (backlog)" : "");
+        }
+        else
+        {
+            LOG_W(LOG_MOD_WIFI, "publish %s failed (%d)", pub[i].topic, pub[i].result);
+            failed |= pub_reading[i];
+        }
+    }
+    return failed;
+}
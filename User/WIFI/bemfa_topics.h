@@ -0,0 +1,88 @@
+/**
+ * @file bemfa_topics.h
+ * @brief 巴法云主题表
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 订阅、发布、下发处理都由同一张主题表驱动：
+ *   - 订阅：表中所有可下发的主题拼成一个逗号分隔的列表，一次 cmd=1 完成；
+ *   - 发布：按记录中已开启的传感器格式化各主题消息，流水线批量发送；
+ *   - 下发：按主题名（排序索引二分查找）找到表项，on/off 修改表项的开关参数，
+ *     其余命令见 downlink.h。
+ * 新增主题只需在表中增加一项。
+ */
+
+#ifndef __BEMFA_TOPICS_H
+#define __BEMFA_TOPICS_H
+
+#include "stm32f10x.h"
+#include "strfmt.h"
+#include "outbox.h"
+#include "downlink.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define BEMFA_UID               "4af24e3731744508bd519435397e4ab5"  // 用户私钥
+#define BEMFA_STATUS_TOPIC      "mySTA004"  // 设备状态（参数报告等），只发布不订阅
+#define BEMFA_MSG_MAX           28      // 单条消息最大长度（含时间戳字段）
+#define BEMFA_SUB_LIST_MAX      96      // 订阅列表最大长度
+#define BEMFA_TOPICS_MAX        8       // 主题个数上限
+
+// 方向
+#define BEMFA_DIR_UP            0x01    // 设备发布
+#define BEMFA_DIR_DOWN          0x02    // 订阅，接收云端下发
+
+// 发布策略
+#define BEMFA_PUB_LIVE          0x01    // 每个发布周期发布当前读数
+#define BEMFA_PUB_BACKLOG       0x02    // 离线期间的读数缓存后带时间戳补发
+
+/**
+ * @brief 主题表项
+ */
+typedef struct bemfa_topic
+{
+    const char *name;               // 主题名
+    uint8_t dir;                    // BEMFA_DIR_xxx
+    uint8_t policy;                 // BEMFA_PUB_xxx，0表示不发布读数
+    uint8_t reading;                // 对应的记录标志 OUTBOX_F_xxx，记录中无此项时不发布
+    /**
+     * @brief 将记录格式化为消息
+     */
+    void (*format)(fmt_buf_t *f, const outbox_entry_t *e);
+    uint8_t sw;                     // on/off 命令控制的开关参数 PARAM_xxx，PARAM_COUNT表示无
+    dl_handler_t on_msg;            // 主题专用的下发处理（收到整个msg），NULL时使用通用命令表
+} bemfa_topic_t;
+
+extern const bemfa_topic_t bemfa_topics[];
+extern const uint8_t bemfa_topic_count;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 全部订阅主题的逗号分隔列表（首次调用时生成）
+ * @return 列表字符串，如 "mydht004,myMP25004,myLUX004"
+ */
+const char *Bemfa_Sub_List(void);
+
+/**
+ * @brief 按主题名查找表项（二分查找）
+ * @param name 主题名（可不以'\0'结尾）
+ * @param len 主题名长度
+ * @return 表项，未找到返回NULL
+ */
+const bemfa_topic_t *Bemfa_Find_Topic(const char *name, uint16_t len);
+
+/**
+ * @brief 按一条读数记录流水线发布各主题
+ * @param e 读数记录，flags 决定发布哪些主题
+ * @param with_ts 1-补发的历史数据：只发布 BEMFA_PUB_BACKLOG 主题，消息末尾附加 "#UTC秒"
+ * @return 发布失败的主题对应的记录标志，0表示全部成功
+ */
+uint8_t Bemfa_Publish_Reading(const outbox_entry_t *e, uint8_t with_ts);
+
+#endif // __BEMFA_TOPICS_H
@@ -0,0 +1,460 @@
+/**
+ * @file conn_mgr.c
+ * @brief ESP8266连接管理状态机实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "conn_mgr.h"
+#include "esp8266.h"
+#include "bemfa_client.h"
+#include "rtc_date.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================================
+// 静态变量
+// ==================================
+
+static const conn_config_t *conn_cfg = NULL;
+static conn_state_t conn_state = CONN_STATE_UART;
+static TickType_t conn_next = 0;            // 当前步骤下次尝试时刻
+static uint8_t conn_attempt = 0;
+static uint8_t conn_subscribed = 0;         // 本次TCP会话已完成订阅
+
+static TickType_t conn_hb_next = 0;         // 下次心跳时刻
+static uint8_t conn_hb_fails = 0;
+
+static uint8_t conn_time_synced = 0;
+static uint8_t conn_time_attempt = 0;
+static TickType_t conn_time_next = 0;
+static volatile uint8_t conn_time_request = 0;
+
+// 协商候选波特率，从高到低
+static const uint32_t conn_baud_rates[] = {921600, 460800};
+#define CONN_BAUD_RATE_COUNT (sizeof(conn_baud_rates) / sizeof(conn_baud_rates[0]))
+static uint32_t conn_baud = CONN_BAUD_DEFAULT;
+static uint8_t conn_baud_first = 0;         // 可尝试的最高候选，验证失败的速率不再尝试
+
+static uint32_t conn_rand = 1;
+static conn_stats_t conn_stats;
+
+static const char *const conn_state_names[CONN_STATE_COUNT] = {
+    "uart", "wifi down", "tcp down", "subscribe", "online",
+};
+
+// ==================================
+// 退避
+// ==================================
+
+static uint32_t Conn_Rand(void)
+{
+    conn_rand = conn_rand * 1103515245UL + 12345UL;
+    return conn_rand >> 16;
+}
+
+/**
+ * @brief 第n次失败后的等待时间：指数增长到上限，再取后一半内的随机值
+ * @note 随机抖动避免多台设备在同一时刻集中重连
+ */
+static TickType_t Conn_Backoff(uint8_t attempt)
+{
+    uint32_t ms = CONN_BACKOFF_BASE_MS;
+
+    while (attempt > 1 && ms < CONN_BACKOFF_MAX_MS)
+    {
+        ms <<= 1;
+        attempt--;
+    }
+    if (ms > CONN_BACKOFF_MAX_MS)
+    {
+        ms = CONN_BACKOFF_MAX_MS;
+    }
+    ms = ms / 2 + Conn_Rand() % (ms / 2 + 1);
+    return pdMS_TO_TICKS(ms);
+}
+
+static void Conn_Fail(void)
+{
+    if (conn_attempt < 0xFF)
+    {
+        conn_attempt++;
+    }
+    conn_next = xTaskGetTickCount() + Conn_Backoff(conn_attempt);
+}
+
+static void Conn_Enter(conn_state_t state)
+{
+    if (state != conn_state)
+    {
+        LOG_I(LOG_MOD_WIFI, "Conn: %s -> %s", conn_state_names[conn_state], conn_state_names[state]);
+    }
+    conn_state = state;
+    conn_attempt = 0;
+    conn_next = xTaskGetTickCount();
+}
+
+/**
+ * @brief 链路丢失：清除会话状态，回退到重新建立TCP（WiFi也断开时重新加入）
+ */
+static void Conn_Link_Lost(const char *reason)
+{
+    LOG_W(LOG_MOD_WIFI, "Conn: link lost (%s)", reason);
+    conn_stats.link_drops++;
+    Server_connected = 0;
+    conn_subscribed = 0;
+    Bemfa_Client_Reset();
+    Conn_Enter(wifi_connected ? CONN_STATE_TCP_DOWN : CONN_STATE_WIFI_DOWN);
+}
+
+// ==================================
+// 串口波特率
+// ==================================
+
+/**
+ * @brief 依次按默认波特率和各候选波特率探测模块（单片机复位而模块未复位时，
+ *        模块仍停留在上次协商的速率）
+ *
+ * 均无应答时模块可能停在透传模式，或在某一速率下能收但发送失真（验证失败的速率）：
+ * 按各候选速率退出透传并盲发切回默认波特率的指令，再按默认波特率探测一次。
+ * @return 模块应答的波特率，UART2已切换到该速率；0-均无应答，UART2为默认波特率
+ */
+static uint32_t Conn_Baud_Find(void)
+{
+    uint8_t i;
+
+    AT_Set_Baudrate(CONN_BAUD_DEFAULT);
+    if (ESP8266_Probe() == 1)
+    {
+        return CONN_BAUD_DEFAULT;
+    }
+    for (i = 0; i < CONN_BAUD_RATE_COUNT; i++)
+    {
+        AT_Set_Baudrate(conn_baud_rates[i]);
+        if (ESP8266_Probe() == 1)
+        {
+            return conn_baud_rates[i];
+        }
+    }
+
+    for (i = 0; i < CONN_BAUD_RATE_COUNT; i++)
+    {
+        AT_Set_Baudrate(conn_baud_rates[i]);
+        ESP8266_Force_Baudrate(CONN_BAUD_DEFAULT);
+    }
+    AT_Set_Baudrate(CONN_BAUD_DEFAULT);
+    ESP8266_Force_Baudrate(CONN_BAUD_DEFAULT); // 模块已在默认波特率时仅退出透传
+    if (ESP8266_Probe() == 1)
+    {
+        return CONN_BAUD_DEFAULT;
+    }
+    return 0;
+}
+
+/**
+ * @brief 步骤失败后确认模块仍按协商的波特率应答，不应答则回到串口协商
+ * @return 1-已回退（调用者不再做其他状态切换）
+ */
+static uint8_t Conn_Baud_Check(void)
+{
+    if (conn_baud == CONN_BAUD_DEFAULT || ESP8266_Probe() == 1)
+    {
+        return 0;
+    }
+
+    LOG_W(LOG_MOD_WIFI, "Conn: no reply at %lu baud, renegotiate", (unsigned long)conn_baud);
+    conn_stats.baud_fallbacks++;
+    conn_baud = CONN_BAUD_DEFAULT;
+    AT_Set_Baudrate(CONN_BAUD_DEFAULT);
+    Conn_Enter(CONN_STATE_UART);
+    return 1;
+}
+
+// ==================================
+// 各状态的单步操作
+// ==================================
+
+static void Conn_Step_Uart(void)
+{
+    uint32_t found;
+    uint8_t i;
+
+    // 关闭了协商或串口不支持切换（如主机模拟）
+    if (CONN_BAUD_MAX <= CONN_BAUD_DEFAULT || AT_Set_Baudrate(CONN_BAUD_DEFAULT) != 0)
+    {
+        conn_baud = CONN_BAUD_DEFAULT;
+        Conn_Enter(CONN_STATE_WIFI_DOWN);
+        return;
+    }
+
+    found = Conn_Baud_Find();
+    if (found == 0)
+    {
+        Conn_Fail();
+        return;
+    }
+    conn_baud = found;
+
+    // 从高到低尝试比当前更快的速率，第一个验证通过的即为结果
+    for (i = conn_baud_first; i < CONN_BAUD_RATE_COUNT && conn_baud_rates[i] > conn_baud; i++)
+    {
+        if (conn_baud_rates[i] > CONN_BAUD_MAX)
+        {
+            continue;
+        }
+        if (ESP8266_Set_Baudrate(conn_baud_rates[i]) == 1)
+        {
+            conn_baud = conn_baud_rates[i];
+            break;
+        }
+
+        // 验证失败：该速率不再尝试，找回模块后继续尝试更低的速率
+        conn_stats.baud_failures++;
+        conn_baud_first = i + 1;
+        found = Conn_Baud_Find();
+        if (found == conn_baud_rates[i] && ESP8266_Set_Baudrate(CONN_BAUD_DEFAULT) == 1)
+        {
+            found = CONN_BAUD_DEFAULT;
+        }
+        if (found == 0)
+        {
+            conn_baud = CONN_BAUD_DEFAULT;
+            AT_Set_Baudrate(CONN_BAUD_DEFAULT);
+            Conn_Fail();
+            return;
+        }
+        conn_baud = found;
+    }
+
+    LOG_I(LOG_MOD_WIFI, "Conn: uart %lu baud", (unsigned long)conn_baud);
+    Conn_Enter(wifi_connected ? CONN_STATE_TCP_DOWN : CONN_STATE_WIFI_DOWN);
+}
+
+static void Conn_Step_WiFi(void)
+{
+    if (ESP8266_Connect_WiFi(conn_cfg->ssid, conn_cfg->password) == 1)
+    {
+        wifi_connected = 1;
+        conn_stats.wifi_joins++;
+        Conn_Enter(CONN_STATE_TCP_DOWN);
+    }
+    else
+    {
+        conn_stats.wifi_failures++;
+        if (Conn_Baud_Check() == 0)
+        {
+            Conn_Fail();
+        }
+    }
+}
+
+static void Conn_Step_TCP(void)
+{
+    // 模块可能仍处于透传模式（链路静默断开时不会自动退出）
+    ESP8266_Close_Server();
+
+    if (ESP8266_Connect_Server(conn_cfg->host, conn_cfg->port) == 1)
+    {
+        Server_connected = 1;
+        conn_stats.tcp_connects++;
+        conn_subscribed = 0;
+        Bemfa_Client_Reset(); // 上一会话的迟到应答不再等待
+        conn_hb_fails = 0;
+        conn_hb_next = xTaskGetTickCount() + pdMS_TO_TICKS(CONN_HEARTBEAT_MS);
+        Conn_Enter(CONN_STATE_SUBSCRIBE);
+    }
+    else
+    {
+        conn_stats.tcp_failures++;
+        if (Conn_Baud_Check() == 1)
+        {
+            return;
+        }
+        Conn_Fail();
+        if (conn_attempt >= CONN_TCP_FAIL_REJOIN)
+        {
+            // 连续失败可能是WiFi已静默断开
+            wifi_connected = 0;
+            Conn_Enter(CONN_STATE_WIFI_DOWN);
+        }
+    }
+}
+
+static void Conn_Step_Subscribe(void)
+{
+    // 多个主题以逗号分隔，一次往返完成订阅
+    if (conn_cfg->sub_list == NULL || conn_cfg->sub_list[0] == '\0' ||
+        ESP8266_TCP_Subscribe(conn_cfg->uid, conn_cfg->sub_list) == 1)
+    {
+        LOG_I(LOG_MOD_WIFI, "Conn: subscribed %s", conn_cfg->sub_list);
+        conn_subscribed = 1;
+        Conn_Enter(CONN_STATE_ONLINE);
+    }
+    else
+    {
+        LOG_W(LOG_MOD_WIFI, "Conn: subscribe %s failed", conn_cfg->sub_list);
+        conn_stats.subscribe_failures++;
+        Conn_Fail();
+    }
+}
+
+/**
+ * @brief 心跳：成功则按正常间隔，失败则尽快复查，连续失败判定链路丢失
+ */
+static void Conn_Step_Heartbeat(void)
+{
+    if (ESP8266_TCP_Heartbeat() == 1)
+    {
+        conn_hb_fails = 0;
+        conn_hb_next = xTaskGetTickCount() + pdMS_TO_TICKS(CONN_HEARTBEAT_MS);
+        return;
+    }
+
+    conn_stats.heartbeat_failures++;
+    if (++conn_hb_fails >= CONN_HEARTBEAT_FAIL_MAX)
+    {
+        Conn_Link_Lost("heartbeat");
+        return;
+    }
+    conn_hb_next = xTaskGetTickCount() + pdMS_TO_TICKS(CONN_HEARTBEAT_RETRY_MS);
+}
+
+static void Conn_Step_Time(void)
+{
+    char time_buffer[32];
+
+    conn_time_request = 0;
+    if (ESP8266_TCP_GetTime(conn_cfg->uid, time_buffer, sizeof(time_buffer)) == 1 &&
+        RTC_SetFromNetworkTime(time_buffer) == 1)
+    {
+        conn_time_synced = 1;
+        conn_time_attempt = 0;
+        conn_stats.time_syncs++;
+        // pdMS_TO_TICKS 先乘以节拍频率，6小时的毫秒数会溢出32位
+        conn_time_next = xTaskGetTickCount() + (TickType_t)(CONN_TIME_RESYNC_MS / portTICK_PERIOD_MS);
+    }
+    else
+    {
+        conn_stats.time_failures++;
+        if (conn_time_attempt < 0xFF)
+        {
+            conn_time_attempt++;
+        }
+        conn_time_next = xTaskGetTickCount() + Conn_Backoff(conn_time_attempt);
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+void Conn_Init(const conn_config_t *cfg)
+{
+    conn_cfg = cfg;
+    conn_rand ^= SysTick->VAL ^ RTC_GetCounter();
+    conn_subscribed = 0;
+    conn_time_next = xTaskGetTickCount();
+    memset(&conn_stats, 0, sizeof(conn_stats));
+    Conn_Enter(CONN_STATE_UART);
+}
+
+void Conn_Poll(void)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    if (conn_cfg == NULL)
+    {
+        return;
+    }
+
+    // URC处理函数清除的标志：CLOSED / WIFI DISCONNECT
+    if (conn_state >= CONN_STATE_SUBSCRIBE && !Server_connected)
+    {
+        Conn_Link_Lost(wifi_connected ? "closed" : "wifi");
+        return;
+    }
+    if (conn_state == CONN_STATE_TCP_DOWN && !wifi_connected)
+    {
+        Conn_Enter(CONN_STATE_WIFI_DOWN);
+    }
+    else if (conn_state == CONN_STATE_WIFI_DOWN && wifi_connected)
+    {
+        // 模块自动重连成功（WIFI GOT IP）
+        Conn_Enter(CONN_STATE_TCP_DOWN);
+    }
+
+    // 会话保活优先于其他步骤
+    if (conn_state >= CONN_STATE_SUBSCRIBE && (int32_t)(now - conn_hb_next) >= 0)
+    {
+        Conn_Step_Heartbeat();
+        return;
+    }
+
+    if ((int32_t)(now - conn_next) >= 0)
+    {
+        switch (conn_state)
+        {
+        case CONN_STATE_UART:
+            Conn_Step_Uart();
+            return;
+        case CONN_STATE_WIFI_DOWN:
+            Conn_Step_WiFi();
+            return;
+        case CONN_STATE_TCP_DOWN:
+            Conn_Step_TCP();
+            return;
+        case CONN_STATE_SUBSCRIBE:
+            Conn_Step_Subscribe();
+            return;
+        default:
+            break;
+        }
+    }
+
+    // 订阅完成后对时，之后定期重新对时
+    if (conn_state == CONN_STATE_ONLINE &&
+        (conn_time_request || (int32_t)(now - conn_time_next) >= 0))
+    {
+        Conn_Step_Time();
+    }
+}
+
+uint8_t Conn_Is_Up(void)
+{
+    return (conn_state >= CONN_STATE_SUBSCRIBE && Server_connected) ? 1 : 0;
+}
+
+void Conn_Probe(void)
+{
+    if (conn_state >= CONN_STATE_SUBSCRIBE)
+    {
+        conn_hb_next = xTaskGetTickCount();
+    }
+}
+
+void Conn_Request_Time_Sync(void)
+{
+    conn_time_request = 1;
+}
+
+void Conn_GetStats(conn_stats_t *stats)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    *stats = conn_stats;
+    stats->state = conn_state;
+    stats->attempt = conn_attempt;
+    stats->subscribed = conn_subscribed;
+    stats->time_synced = conn_time_synced;
+    stats->baudrate = conn_baud;
+    stats->retry_in_ms = ((int32_t)(conn_next - now) > 0 && conn_state < CONN_STATE_ONLINE)
+                             ? (uint32_t)(conn_next - now) * portTICK_PERIOD_MS
+                             : 0;
+}
+
+const char *Conn_State_Name(conn_state_t state)
+{
+    return (state < CONN_STATE_COUNT) ? conn_state_names[state] : "?";
+}
@@ -0,0 +1,131 @@
+/**
+ * @file conn_mgr.h
+ * @brief ESP8266连接管理状态机
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 在ESP8266任务中周期调用 Conn_Poll()，每次最多执行一步阻塞操作：
+ *   串口协商 -> WiFi断开 -> 加入WiFi -> 建立TCP透传 -> 订阅全部主题 -> 在线
+ * 串口协商用 AT+UART_CUR 将模块与UART2从默认波特率提升到候选速率中
+ * 最高的可用值；模块在后续步骤中不再应答（如模块单独复位回到默认波特率）
+ * 时回到默认波特率重新协商。
+ * 各步骤失败后按带随机抖动的指数退避重试；在线期间定时发送心跳，
+ * 连续心跳失败或收到 CLOSED/WIFI DISCONNECT 上报即判定链路丢失，
+ * 回退到对应状态重新建立，每个新的TCP会话重新订阅。
+ * TCP建立后即可发布遥测，无需等待订阅和对时完成。
+ */
+
+#ifndef __CONN_MGR_H
+#define __CONN_MGR_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define CONN_BAUD_DEFAULT           115200  // 模块上电默认波特率
+#define CONN_BAUD_MAX               921600  // 协商上限，设为 CONN_BAUD_DEFAULT 即不协商
+#define CONN_BACKOFF_BASE_MS        1000    // 首次失败后的重试间隔
+#define CONN_BACKOFF_MAX_MS         32000   // 重试间隔上限
+#define CONN_TCP_FAIL_REJOIN        4       // TCP连续失败次数达到后重新加入WiFi
+#define CONN_HEARTBEAT_MS           60000   // 心跳间隔
+#define CONN_HEARTBEAT_RETRY_MS     5000    // 心跳失败后尽快复查
+#define CONN_HEARTBEAT_FAIL_MAX     2       // 连续心跳失败次数达到即判定链路丢失
+#define CONN_TIME_RESYNC_MS         (6UL * 3600UL * 1000UL) // 定期重新对时
+
+/**
+ * @brief 连接状态
+ */
+typedef enum
+{
+    CONN_STATE_UART = 0,        // 串口波特率协商
+    CONN_STATE_WIFI_DOWN,       // 等待加入WiFi
+    CONN_STATE_TCP_DOWN,        // WiFi已连接，等待建立TCP透传
+    CONN_STATE_SUBSCRIBE,       // TCP已建立，订阅主题（已可发布）
+    CONN_STATE_ONLINE,          // 订阅全部完成
+    CONN_STATE_COUNT
+} conn_state_t;
+
+/**
+ * @brief 连接参数（内容在运行期间必须保持有效）
+ */
+typedef struct
+{
+    const char *ssid;
+    const char *password;
+    const char *host;
+    const char *port;
+    const char *uid;                // 巴法云私钥
+    const char *sub_list;           // 订阅主题列表（逗号分隔，一次请求完成）
+} conn_config_t;
+
+/**
+ * @brief 运行状态与计数
+ */
+typedef struct
+{
+    conn_state_t state;
+    uint8_t attempt;                // 当前步骤连续失败次数
+    uint8_t subscribed;             // 本次会话已完成订阅
+    uint8_t time_synced;            // 已从网络对时
+    uint32_t retry_in_ms;           // 距下次重试的时间
+    uint32_t baudrate;              // 当前与模块通信的波特率
+    uint16_t baud_failures;         // 切换后验证失败次数
+    uint16_t baud_fallbacks;        // 运行中失去应答、回到默认波特率的次数
+    uint16_t wifi_joins;            // 加入WiFi成功次数
+    uint16_t wifi_failures;
+    uint16_t tcp_connects;          // 建立TCP成功次数
+    uint16_t tcp_failures;
+    uint16_t link_drops;            // 链路丢失次数（上报或心跳判定）
+    uint16_t heartbeat_failures;
+    uint16_t subscribe_failures;
+    uint16_t time_syncs;
+    uint16_t time_failures;
+} conn_stats_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 设置连接参数并复位状态机
+ * @param cfg 连接参数
+ */
+void Conn_Init(const conn_config_t *cfg);
+
+/**
+ * @brief 推进状态机（ESP8266任务中循环调用）
+ * @note 未到重试时刻时立即返回，否则执行一步可能阻塞数秒的AT操作
+ */
+void Conn_Poll(void);
+
+/**
+ * @brief TCP透传是否已建立（可发布遥测）
+ */
+uint8_t Conn_Is_Up(void);
+
+/**
+ * @brief 请求尽快发送心跳确认链路（例如发布全部失败时）
+ */
+void Conn_Probe(void);
+
+/**
+ * @brief 请求重新对时（其他任务可调用，由ESP8266任务执行）
+ */
+void Conn_Request_Time_Sync(void);
+
+/**
+ * @brief 读取运行状态与计数
+ */
+void Conn_GetStats(conn_stats_t *stats);
+
+/**
+ * @brief 状态名称（用于显示和调试输出）
+ */
+const char *Conn_State_Name(conn_state_t state);
+
+#endif // __CONN_MGR_H
@@ -0,0 +1,365 @@
+/**
+ * @file downlink.c
+ * @brief 云端下发命令解析与分发实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "downlink.h"
+#include "bemfa_topics.h"
+#include "esp8266.h"
+#include "sensordata.h"
+#include "param.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================================
+// 切片工具
+// ==================================
+
+int Downlink_Slice_Cmp(const dl_slice_t *s, const char *str)
+{
+    uint16_t i;
+
+    for (i = 0; i < s->len; i++)
+    {
+        if (str[i] == '\0' || s->p[i] != str[i])
+        {
+            return (str[i] == '\0') ? 1 : (int)(uint8_t)s->p[i] - (int)(uint8_t)str[i];
+        }
+    }
+    return (str[i] == '\0') ? 0 : -1;
+}
+
+uint8_t Downlink_Slice_U32(const dl_slice_t *s, uint32_t *out)
+{
+    uint32_t v = 0;
+
+    if (s->len == 0 || s->len > 9)
+    {
+        return 0;
+    }
+    for (uint16_t i = 0; i < s->len; i++)
+    {
+        if (s->p[i] < '0' || s->p[i] > '9')
+        {
+            return 0;
+        }
+        v = v * 10 + (uint32_t)(s->p[i] - '0');
+    }
+    *out = v;
+    return 1;
+}
+
+// ==================================
+// 帧切分
+// ==================================
+
+uint8_t Downlink_Parse(const char *line, uint16_t len, dl_frame_t *frame)
+{
+    const char *end = line + len;
+    const char *p = line;
+
+    memset(frame, 0, sizeof(*frame));
+
+    while (p < end && *p != '\r' && *p != '\n' && *p != '\0')
+    {
+        const char *key = p;
+        dl_slice_t *field = NULL;
+        uint16_t key_len;
+
+        while (p < end && *p != '=' && *p != '&')
+        {
+            p++;
+        }
+        key_len = (uint16_t)(p - key);
+        if (p >= end || *p != '=')
+        {
+            // 无值的字段，跳过
+            p += (p < end);
+            continue;
+        }
+        p++;
+
+        // 按长度区分已知字段
+        switch (key_len)
+        {
+        case 3:
+            if (memcmp(key, "cmd", 3) == 0)
+            {
+                field = &frame->cmd;
+            }
+            else if (memcmp(key, "uid", 3) == 0)
+            {
+                field = &frame->uid;
+            }
+            else if (memcmp(key, "msg", 3) == 0)
+            {
+                field = &frame->msg;
+            }
+            break;
+        case 5:
+            if (memcmp(key, "topic", 5) == 0)
+            {
+                field = &frame->topic;
+            }
+            break;
+        default:
+            break;
+        }
+
+        const char *value = p;
+        if (field == &frame->msg)
+        {
+            // msg 是最后一个字段，取到行尾
+            while (p < end && *p != '\r' && *p != '\n' && *p != '\0')
+            {
+                p++;
+            }
+        }
+        else
+        {
+            while (p < end && *p != '&' && *p != '\r' && *p != '\n' && *p != '\0')
+            {
+                p++;
+            }
+        }
+        if (field != NULL)
+        {
+            field->p = value;
+            field->len = (uint16_t)(p - value);
+        }
+        if (p < end && *p == '&')
+        {
+            p++;
+        }
+    }
+
+    return (frame->topic.len > 0 && frame->msg.p != NULL) ? 1 : 0;
+}
+
+// ==================================
+// 命令处理
+// ==================================
+
+// 传感器开关：topic 表项中的开关参数
+static uint8_t Downlink_Switch(const bemfa_topic_t *topic, uint8_t on)
+{
+    if (topic->sw >= PARAM_COUNT || Param_Set((param_id_t)topic->sw, on) != 0)
+    {
+        return 0;
+    }
+    LOG_I(LOG_MOD_WIFI, "%s sensor turned %s via remote command", topic->name, on ? "ON" : "OFF");
+    return 1;
+}
+
+static uint8_t Downlink_On(const bemfa_topic_t *topic, const dl_slice_t *args, uint8_t argc)
+{
+    return Downlink_Switch(topic, 1);
+}
+
+static uint8_t Downlink_Off(const bemfa_topic_t *topic, const dl_slice_t *args, uint8_t argc)
+{
+    return Downlink_Switch(topic, 0);
+}
+
+/**
+ * @brief 按参数类型解析参数值后修改
+ */
+static uint8_t Downlink_Set_Param(param_id_t id, const dl_slice_t *value)
+{
+    uint32_t v;
+
+    if (Param_Def(id)->type == PARAM_TYPE_BOOL && Downlink_Slice_Cmp(value, "on") == 0)
+    {
+        v = 1;
+    }
+    else if (Param_Def(id)->type == PARAM_TYPE_BOOL && Downlink_Slice_Cmp(value, "off") == 0)
+    {
+        v = 0;
+    }
+    else if (!Downlink_Slice_U32(value, &v) || v > 0xFFFF)
+    {
+        return 0;
+    }
+    return (Param_Set(id, (uint16_t)v) == 0) ? 1 : 0;
+}
+
+// pub#<秒>：发布间隔
+static uint8_t Downlink_Pub(const bemfa_topic_t *topic, const dl_slice_t *args, uint8_t argc)
+{
+    return (argc >= 1) ? Downlink_Set_Param(PARAM_PUBLISH_S, &args[0]) : 0;
+}
+
+// rate#<秒>：采样间隔
+static uint8_t Downlink_Rate(const bemfa_topic_t *topic, const dl_slice_t *args, uint8_t argc)
+{
+    return (argc >= 1) ? Downlink_Set_Param(PARAM_SAMPLE_S, &args[0]) : 0;
+}
+
+// set#<参数名>#<值>：修改参数表中的任意参数
+static uint8_t Downlink_Set(const bemfa_topic_t *topic, const dl_slice_t *args, uint8_t argc)
+{
+    param_id_t id;
+
+    if (argc < 2)
+    {
+        return 0;
+    }
+    id = Param_Find(args[0].p, args[0].len);
+    return (id < PARAM_COUNT) ? Downlink_Set_Param(id, &args[1]) : 0;
+}
+
+// get：在状态主题上发布当前全部参数 "param#pub=15,rate=3,..."
+// 不发回命令所在的主题：读数主题的面板组件按 on#温度#湿度 等格式解析，且设备订阅了该主题
+static uint8_t Downlink_Get(const bemfa_topic_t *topic, const dl_slice_t *args, uint8_t argc)
+{
+    char msg[64] = "param#";
+
+    Param_Format(msg + 6, sizeof(msg) - 6);
+    LOG_I(LOG_MOD_WIFI, "Params: %s", msg + 6);
+    if (ESP8266_TCP_Publish(BEMFA_UID, BEMFA_STATUS_TOPIC, msg) != 1)
+    {
+        LOG_W(LOG_MOD_WIFI, "Params report failed");
+    }
+    return 1;
+}
+
+// 采样方案：发布间隔(秒)、采样间隔(秒)
+static const struct
+{
+    const char *name;
+    uint16_t publish_s;
+    uint16_t sample_s;
+} downlink_profiles[] = {
+    {"eco", 60, 10},
+    {"fast", 5, 1},
+    {"normal", 15, 3},
+};
+
+static uint8_t Downlink_Profile(const bemfa_topic_t *topic, const dl_slice_t *args, uint8_t argc)
+{
+    if (argc < 1)
+    {
+        return 0;
+    }
+    for (uint8_t i = 0; i < sizeof(downlink_profiles) / sizeof(downlink_profiles[0]); i++)
+    {
+        if (Downlink_Slice_Cmp(&args[0], downlink_profiles[i].name) == 0)
+        {
+            Param_Set(PARAM_PUBLISH_S, downlink_profiles[i].publish_s);
+            Param_Set(PARAM_SAMPLE_S, downlink_profiles[i].sample_s);
+            LOG_I(LOG_MOD_WIFI, "Profile %s: publish %us, sample %us", downlink_profiles[i].name,
+                                downlink_profiles[i].publish_s, downlink_profiles[i].sample_s);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 命令表（必须按名称排序，二分查找）
+static const struct
+{
+    const char *name;
+    dl_handler_t handler;
+} downlink_cmds[] = {
+    {"get", Downlink_Get},
+    {"off", Downlink_Off},
+    {"on", Downlink_On},
+    {"profile", Downlink_Profile},
+    {"pub", Downlink_Pub},
+    {"rate", Downlink_Rate},
+    {"set", Downlink_Set},
+};
+
+static dl_handler_t Downlink_Find_Cmd(const dl_slice_t *name)
+{
+    int lo = 0;
+    int hi = (int)(sizeof(downlink_cmds) / sizeof(downlink_cmds[0])) - 1;
+
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        int c = Downlink_Slice_Cmp(name, downlink_cmds[mid].name);
+        if (c == 0)
+        {
+            return downlink_cmds[mid].handler;
+        }
+        if (c < 0)
+        {
+            hi = mid - 1;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+// ==================================
+// 分发
+// ==================================
+
+uint8_t Downlink_Dispatch(const char *line, uint16_t len)
+{
+    dl_frame_t frame;
+    dl_slice_t verb;
+    dl_slice_t args[DL_ARGS_MAX];
+    uint8_t argc = 0;
+    const bemfa_topic_t *topic;
+    dl_handler_t handler;
+
+    if (!Downlink_Parse(line, len, &frame))
+    {
+        LOG_W(LOG_MOD_WIFI, "Downlink: malformed frame");
+        return 0;
+    }
+
+    topic = Bemfa_Find_Topic(frame.topic.p, frame.topic.len);
+    if (topic == NULL || !(topic->dir & BEMFA_DIR_DOWN))
+    {
+        LOG_W(LOG_MOD_WIFI, "Downlink: unknown topic %.*s", frame.topic.len, frame.topic.p);
+        return 0;
+    }
+
+    // msg：命令#参数#参数
+    const char *p = frame.msg.p;
+    const char *end = frame.msg.p + frame.msg.len;
+    verb.p = p;
+    while (p < end && *p != '#')
+    {
+        p++;
+    }
+    verb.len = (uint16_t)(p - verb.p);
+    while (p < end && argc < DL_ARGS_MAX)
+    {
+        args[argc].p = ++p;
+        while (p < end && *p != '#')
+        {
+            p++;
+        }
+        args[argc].len = (uint16_t)(p - args[argc].p);
+        argc++;
+    }
+
+    // 主题自带处理函数时收到整个msg，否则按命令表分发
+    if (topic->on_msg != NULL)
+    {
+        handler = topic->on_msg;
+        args[0] = frame.msg;
+        argc = 1;
+    }
+    else
+    {
+        handler = Downlink_Find_Cmd(&verb);
+    }
+    if (handler == NULL || !handler(topic, args, argc))
+    {
+        LOG_W(LOG_MOD_WIFI, "Downlink: %s rejected '%.*s'", topic->name, frame.msg.len, frame.msg.p);
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file downlink.h
+ * @brief 云端下发命令解析与分发
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 下发帧格式：cmd=2&uid=xxx&topic=xxx&msg=xxx
+ *   - 一次扫描切分出各字段，字段值以 (指针, 长度) 切片表示，不拷贝；
+ *   - topic 在按名称排序的主题索引中二分查找；
+ *   - msg 按 '#' 切分为 命令#参数#参数，命令在排序的命令表中二分查找，
+ *     处理函数直接收到参数切片。
+ * 支持的命令（参数修改都经过参数表，范围检查、立即生效并保存）：
+ *   on / off            开关该主题对应的传感器
+ *   pub#<秒>            发布间隔（5~60）
+ *   rate#<秒>           采样间隔（1~10）
+ *   profile#<名称>      采样方案：fast / normal / eco
+ *   set#<参数名>#<值>   修改参数表中的任意参数，如 set#dht11#off
+ *   get                 在状态主题 BEMFA_STATUS_TOPIC 上发布 "param#pub=15,rate=3,..."
+ */
+
+#ifndef __DOWNLINK_H
+#define __DOWNLINK_H
+
+#include "stm32f10x.h"
+
+#define DL_ARGS_MAX     4       // 命令参数个数上限
+
+/**
+ * @brief 字符串切片（指向接收行内部，不以'\0'结尾）
+ */
+typedef struct
+{
+    const char *p;
+    uint16_t len;
+} dl_slice_t;
+
+/**
+ * @brief 切分后的下发帧
+ */
+typedef struct
+{
+    dl_slice_t cmd;
+    dl_slice_t uid;
+    dl_slice_t topic;
+    dl_slice_t msg;
+} dl_frame_t;
+
+struct bemfa_topic;
+
+/**
+ * @brief 命令处理函数（在ESP8266任务中执行）
+ * @param topic 帧所属主题
+ * @param args 参数切片
+ * @param argc 参数个数
+ * @return 1-已执行 0-参数错误
+ */
+typedef uint8_t (*dl_handler_t)(const struct bemfa_topic *topic, const dl_slice_t *args, uint8_t argc);
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 一次扫描切分 key=value&... 帧
+ * @param line 帧内容
+ * @param len 帧长度
+ * @param frame 输出各字段切片，缺少的字段长度为0
+ * @return 1-含 topic 和 msg 字段 0-格式错误
+ * @note msg 为最后一个字段，其值可包含 '&'
+ */
+uint8_t Downlink_Parse(const char *line, uint16_t len, dl_frame_t *frame);
+
+/**
+ * @brief 解析并执行一条下发帧
+ * @return 1-已执行 0-未知主题/命令或参数错误
+ */
+uint8_t Downlink_Dispatch(const char *line, uint16_t len);
+
+/**
+ * @brief 切片与字符串比较
+ * @return 0-相等，其余同 strcmp
+ */
+int Downlink_Slice_Cmp(const dl_slice_t *s, const char *str);
+
+/**
+ * @brief 切片转换为无符号整数
+ * @param s 切片（只含数字）
+ * @param out 输出值
+ * @return 1-成功 0-非数字或溢出
+ */
+uint8_t Downlink_Slice_U32(const dl_slice_t *s, uint32_t *out);
+
+#endif // __DOWNLINK_H
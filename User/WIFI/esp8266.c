@@ -1,7 +1,7 @@
 /**
  * @file esp8266.c
  * @author Jaychen (719095404@qq.com)
- * @brief esp8266ӰͷTCP豸
+ * @brief esp8266连接巴法云TCP设备
  * @version 0.1
  * @date 2025-12-09
  * 
@@ -9,6 +9,10 @@
  * 
  */
 #include "esp8266.h"
+#include "bemfa_topics.h"
+#include "bemfa_client.h"
+#include "lan_server.h"
+#include "log.h"
 #include <string.h>
 #include <stdio.h>
 #include <FreeRTOS.h>
@@ -16,324 +20,380 @@
 
 extern uint8_t Server_connected=0;
 extern uint8_t wifi_connected = 0;
-//䵽ƶ˵ʱ
+//传输到云端的时间间隔
 uint16_t publish_delaytime = 15;
 
-extern uint8_t uart2_buffer[UART2_BUF_SIZE]; // uart2ջ
-extern uint8_t uart2_rx_len;     // uart2ճ
+// ==================================
+// 主动上报(URC)处理，在AT引擎任务中执行
+// ==================================
+
+static void ESP8266_On_WiFi_Disconnect(const char *line, uint16_t len)
+{
+    LOG_I(LOG_MOD_WIFI, "ESP8266 URC: %s", line);
+    wifi_connected = 0;
+    Server_connected = 0;
+}
+
+static void ESP8266_On_WiFi_Got_IP(const char *line, uint16_t len)
+{
+    LOG_I(LOG_MOD_WIFI, "ESP8266 URC: %s", line);
+    wifi_connected = 1;
+}
+
+static void ESP8266_On_Link_Closed(const char *line, uint16_t len)
+{
+    LOG_I(LOG_MOD_WIFI, "ESP8266 URC: %s", line);
+    Server_connected = 0;
+}
+
+// 云端连接的数据按行重组：一行可能跨多个数据包，一个数据包也可能有多行
+static char esp_cloud_line[AT_LINE_MAX + 1];
+static uint16_t esp_cloud_len = 0;
+
+static void ESP8266_Cloud_Line(void)
+{
+    esp_cloud_line[esp_cloud_len] = '\0';
+    Bemfa_Client_On_Line(esp_cloud_line, esp_cloud_len);
+    esp_cloud_len = 0;
+}
+
+// 非透传模式下的网络数据（+IPD 按长度取出，不经过行解析）
+static void ESP8266_On_IPD(uint8_t link, const char *data, uint16_t len, uint8_t flags)
+{
+    uint16_t i;
+
+#if ESP8266_LAN_SERVER
+    if (link != ESP8266_CLOUD_LINK)
+    {
+        // 局域网客户端的数据只交给服务器，且只看数据包开头的请求行
+        if (flags & AT_IPD_FIRST)
+        {
+            Lan_Server_On_Request(link, data, len);
+        }
+        return;
+    }
+#endif
+    for (i = 0; i < len; i++)
+    {
+        if (data[i] == '\r' || data[i] == '\n')
+        {
+            if (esp_cloud_len > 0)
+            {
+                ESP8266_Cloud_Line();
+            }
+        }
+        else if (esp_cloud_len < AT_LINE_MAX)
+        {
+            esp_cloud_line[esp_cloud_len++] = data[i];
+        }
+    }
+    // 对时应答不带换行；cmd= 帧都以换行结束，数据包末尾的半帧等下一个包
+    if ((flags & AT_IPD_LAST) && esp_cloud_len > 0 &&
+        memcmp(esp_cloud_line, "cmd=", esp_cloud_len < 4 ? esp_cloud_len : 4) != 0)
+    {
+        ESP8266_Cloud_Line();
+    }
+}
 
+/**
+ * @brief 启动AT引擎并注册主动上报处理函数
+ * @note 巴法云的应答和下发（cmd=...）由协议客户端接管
+ */
 void ESP8266_Receive_Start(void)
 {
-    uart2_rx_len = 0;
-    memset(uart2_buffer, 0, sizeof(uart2_buffer));
+    if (AT_Init() != 0)
+    {
+        return;
+    }
+    AT_Register_URC("WIFI DISCONNECT", ESP8266_On_WiFi_Disconnect);
+    AT_Register_URC("WIFI GOT IP", ESP8266_On_WiFi_Got_IP);
+    AT_Register_URC("CLOSED", ESP8266_On_Link_Closed);
+#if ESP8266_LAN_SERVER
+    AT_Register_URC(ESP8266_STR(ESP8266_CLOUD_LINK) ",CLOSED", ESP8266_On_Link_Closed);
+#endif
+    AT_Set_IPD_Handler(ESP8266_On_IPD);
+    Bemfa_Client_Init();
 }
 
 /**
- * @brief ָָʱڽָ
+ * @brief 发送指令，并指定时间内接收指定的数据
  *
- * @param cmd  ATָע\r\n
- * @param wait_string   ȴַ
- * @param timeout  ʱʱms
- * @return uint8_t 0ʱ1ɹ
+ * @param cmd  AT指令注意带\r\n
+ * @param wait_string   等待字符串，NULL表示不等待应答
+ * @param timeout  超时时间ms
+ * @return uint8_t 0：超时或失败，1：成功
+ * @note 由AT引擎排队执行，等待期间调用任务阻塞不占用CPU
  */
 uint8_t ESP8266_Send_AT_Cmd(const char *cmd, const char *wait_string, uint16_t timeout)
 {
-    uart2_rx_len = 0;
-    memset(uart2_buffer, 0, sizeof(uart2_buffer));
-    UART2_SendDataToWiFi_Poll((uint8_t *)cmd, strlen(cmd));    // 
-    //printf("ESP8266 Send cmd: %s", cmd);
-loop:
-    while (uart2_rx_len <= 0 && timeout > 0)
-    {
-        timeout--;
-        vTaskDelay(pdMS_TO_TICKS(1));
-    }
-    if (uart2_rx_len > 0 && timeout > 0 && strstr((const char *)uart2_buffer, wait_string))
+    return (AT_Exec(cmd, wait_string, timeout) == AT_RES_OK) ? 1 : 0;
+}
+
+// 退出透传模式
+uint8_t ESP8266_Exit_Transmit_Mode(void)
+{
+    if (ESP8266_Send_AT_Cmd("+++", AT_EXPECT_NONE, 2000) != 1) // 退出透传模式，无应答
     {
-        //printf("uart2_rx_len = %d, uart2_buf = %s\n", uart2_rx_len, uart2_buffer);
-        uart2_rx_len = 0; // սջ,
-        return 1;         // ɹ
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Exit Transmit Mode , Error");
+        return 0;
     }
-    else if (timeout > 0)
+    LOG_I(LOG_MOD_WIFI, "ESP8266 Exit Transmit Mode , Success");
+    return 1;
+}
+
+// 测试模块在当前波特率下是否应答
+uint8_t ESP8266_Probe(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < 3; i++)
     {
-        uart2_rx_len = 0; // սջ,
-        goto loop;
+        if (ESP8266_Send_AT_Cmd("AT\r\n", "OK", 300) == 1)
+        {
+            return 1;
+        }
     }
-    uart2_rx_len = 0; // սջ,
     return 0;
 }
 
-// ˳͸ģʽ
-uint8_t ESP8266_Exit_Transmit_Mode(void)
+// 切换波特率：模块以原波特率应答OK后才切换，本端随后跟随
+uint8_t ESP8266_Set_Baudrate(uint32_t baudrate)
 {
-    if (ESP8266_Send_AT_Cmd("+++", NULL, 2000) != 1) // ˳͸ģʽ
+    char cmd[40];
+
+    snprintf(cmd, sizeof(cmd), "AT+UART_CUR=%lu,8,1,0,0\r\n", (unsigned long)baudrate);
+    if (ESP8266_Send_AT_Cmd(cmd, "OK", 500) != 1)
     {
-        printf("ESP8266 Exit Transmit Mode , Error\r\n");
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: AT+UART_CUR=%lu , Error", (unsigned long)baudrate);
         return 0;
     }
-    printf("ESP8266 Exit Transmit Mode , Success\r\n");
-    return 1;
+    vTaskDelay(pdMS_TO_TICKS(20));
+    AT_Set_Baudrate(baudrate);
+    return ESP8266_Probe();
+}
+
+void ESP8266_Force_Baudrate(uint32_t baudrate)
+{
+    char cmd[40];
+
+    ESP8266_Exit_Transmit_Mode();
+    // 前置空行结束模块此前收到的乱码，指令本身才不会被拒绝
+    snprintf(cmd, sizeof(cmd), "\r\nAT+UART_CUR=%lu,8,1,0,0\r\n", (unsigned long)baudrate);
+    ESP8266_Send_AT_Cmd(cmd, AT_EXPECT_NONE, 50);
 }
 
-uint8_t ESP8266_Connect_WiFi(char *ssid, char *password)
+uint8_t ESP8266_Connect_WiFi(const char *ssid, const char *password)
 {
     uint8_t i = 0;
-    char cmd[50];                                       // ָ
-    ESP8266_Exit_Transmit_Mode();                      // ˳͸ģʽ
+    char cmd[50];                                       // 指令缓冲
+    ESP8266_Exit_Transmit_Mode();                      // 退出透传模式
 
-    while (ESP8266_Send_AT_Cmd("AT\r\n", "OK", 500) != 1) // ģ״̬
+    while (ESP8266_Send_AT_Cmd("AT\r\n", "OK", 500) != 1) // 测试模块状态
     {
         i++;
         if (i >= 3)
         {
-            printf("ESP8266 Send cmd: AT , Error\r\n");
+            LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: AT , Error");
             return 0;
         }
     }
-    if (ESP8266_Send_AT_Cmd("ATE0\r\n", "OK", 500) != 1) // رջ
+    if (ESP8266_Send_AT_Cmd("ATE0\r\n", "OK", 500) != 1) // 关闭回显
     {
-        printf("ESP8266 Send cmd: ATE0 , Error\r\n");
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: ATE0 , Error");
         return 0;
     }
     
-    if (ESP8266_Send_AT_Cmd("AT+CWMODE=3\r\n", "OK", 500) != 1) // Ϊstationģʽ
+    if (ESP8266_Send_AT_Cmd("AT+CWMODE=3\r\n", "OK", 500) != 1) // 设置为station模式
     {
-        printf("ESP8266 Send cmd: AT+CWMODE=3 , Error\r\n");
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: AT+CWMODE=3 , Error");
         return 0;
     }
 
-    snprintf(cmd, sizeof(cmd), "AT+CWJAP=\"%s\",\"%s\"\r\n", ssid, password); // ƴָ
-    if (ESP8266_Send_AT_Cmd(cmd, "OK", 8000) != 1)                           // WiFi
+    snprintf(cmd, sizeof(cmd), "AT+CWJAP=\"%s\",\"%s\"\r\n", ssid, password); // 拼接指令
+    if (ESP8266_Send_AT_Cmd(cmd, "OK", 8000) != 1)                           // 连接WiFi
     {
-        printf("ESP8266 Send cmd: %s, Error\r\n", cmd);
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: %s, Error", cmd);
         return 0;
     }
     return 1;
 }
 
-// ӷbemfa.comTCP˿8344, MQTT˿ڣ9501͸ģʽ
-uint8_t ESP8266_Connect_Server(char *ip, char *port)
+#if ESP8266_LAN_SERVER
+// 多连接模式：开启局域网服务器，云端会话使用固定连接号，按帧发送
+uint8_t ESP8266_Connect_Server(const char *ip, const char *port)
 {
-    char cmd[50];                                            // ָ
-    if (ESP8266_Send_AT_Cmd("AT+CIPMODE=1\r\n", "OK", 2000) != 1) // ͸ģʽ
+    char cmd[60];
+    if (ESP8266_Send_AT_Cmd("AT+CIPMODE=0\r\n", "OK", 2000) != 1) // 关闭透传
     {
-        printf("ESP8266 Send cmd: AT+CIPMODE=1 , Error\r\n");
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: AT+CIPMODE=0 , Error");
         return 0;
     }
-    // ӷͶ˿AT+CIPSTART="TCP","bemfa.com",8344
+    Lan_Server_Start(); // 同时设置多连接模式；服务器开启失败不影响云端会话
+
+    esp_cloud_len = 0; // 上一会话残留的半行
+    snprintf(cmd, sizeof(cmd), "AT+CIPSTART=" ESP8266_STR(ESP8266_CLOUD_LINK) ",\"TCP\",\"%s\",%s\r\n", ip, port);
+    if (ESP8266_Send_AT_Cmd(cmd, "OK", 5000) != 1) // 连接服务器
+    {
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: %s, Error", cmd);
+        return 0;
+    }
+    return 1;
+}
+
+// 关闭云端连接，局域网服务器保持运行
+void ESP8266_Close_Server(void)
+{
+    ESP8266_Send_AT_Cmd("AT+CIPCLOSE=" ESP8266_STR(ESP8266_CLOUD_LINK) "\r\n", "OK", 1000);
+}
+#else
+// 连接服务器bemfa.com，TCP端口8344, MQTT端口：9501，进入透传模式
+uint8_t ESP8266_Connect_Server(const char *ip, const char *port)
+{
+    char cmd[50];                                            // 指令缓冲
+    if (ESP8266_Send_AT_Cmd("AT+CIPMODE=1\r\n", "OK", 2000) != 1) // 设置透传模式
+    {
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: AT+CIPMODE=1 , Error");
+        return 0;
+    }
+    esp_cloud_len = 0; // 上一会话残留的半行
+    // 连接服务器和端口AT+CIPSTART="TCP","bemfa.com",8344
     snprintf(cmd, sizeof(cmd), "AT+CIPSTART=\"TCP\",\"%s\",%s\r\n", ip, port);
-    if (ESP8266_Send_AT_Cmd(cmd, "OK", 5000) != 1) // ӷ
+    if (ESP8266_Send_AT_Cmd(cmd, "OK", 5000) != 1) // 连接服务器
     {
-        printf("ESP8266 Send cmd: %s, Error\r\n", cmd);
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: %s, Error", cmd);
         return 0;
     }
-    // ͸ģʽ淢Ķ
-    if (ESP8266_Send_AT_Cmd("AT+CIPSEND\r\n", "OK", 3000) != 1) // ͸ģʽ
+    // 进入透传模式，后面发的都会无条件传输
+    if (ESP8266_Send_AT_Cmd("AT+CIPSEND\r\n", "OK", 3000) != 1) // 进入透传模式
     {
-        printf("ESP8266 Send cmd: AT+CIPSEND\r\n, Error\r\n");
+        LOG_W(LOG_MOD_WIFI, "ESP8266 Send cmd: AT+CIPSEND , Error");
         return 0;
     }
     return 1;
 }
 
-// 
-uint8_t ESP8266_TCP_Subscribe(char *uid, char *topic)
+// 退出透传并关闭TCP连接（连接已断开时关闭指令返回ERROR，忽略）
+void ESP8266_Close_Server(void)
 {
-    char cmd[128]; // ָ
-    snprintf(cmd, sizeof(cmd), "cmd=1&uid=%s&topic=%s", uid, topic);
-    if (ESP8266_Send_AT_Cmd(cmd, "cmd=1&res=1", 1000) != 1) // ȴĳɹ
-    {
-        return 0; // ʧ
-    }
-    return 1; // ĳɹ
+    ESP8266_Exit_Transmit_Mode();
+    ESP8266_Send_AT_Cmd("AT+CIPCLOSE\r\n", "OK", 1000);
 }
+#endif
 
-// 
-uint8_t ESP8266_TCP_Publish(char *uid, char *topic, char *data)
+// 订阅主题，topic 可为逗号分隔的多个主题，一次应答
+uint8_t ESP8266_TCP_Subscribe(const char *uid, const char *topic)
 {
-    char cmd[128]; // ָ
-    // cmd=2&uid=4d9ec352e0376f2110a0c601a2857225&topic=light002&msg=#32#27.80#ON#
-    snprintf(cmd, sizeof(cmd), "cmd=2&uid=%s&topic=%s&msg=%s", uid, topic, data);
-    if (ESP8266_Send_AT_Cmd(cmd, "cmd=2&res=1", 1000) != 1) // ȴɹ
+    // 按片段直接放入发送缓冲区，不再拼接
+    const uart2_iov_t cmd[] = {
+        AT_IOV_STR("cmd=1&uid="), AT_IOV(uid), AT_IOV_STR("&topic="), AT_IOV(topic), AT_IOV_STR("\r\n"),
+    };
+    if (Bemfa_Request(cmd, 5, BEMFA_CMD_SUBSCRIBE, 1000) != AT_RES_OK) // 等待订阅成功
     {
-        return 0; // ʧ
+        return 0; // 订阅失败
     }
-    return 1;
+    return 1; // 订阅成功
 }
 
-
-
-// 
-uint8_t ESP8266_TCP_Heartbeat(void)
+// 发布主题
+uint8_t ESP8266_TCP_Publish(const char *uid, const char *topic, const char *data)
 {
-    if (ESP8266_Send_AT_Cmd("cmd=0&msg=ping", "cmd=0&res=1", 1000) != 1) // ȴ
-    {
-        return 0;
-    }
-    return 1;
+    esp8266_pub_t item = {topic, data, ESP8266_PUB_PENDING};
+
+    return ESP8266_TCP_Publish_Batch(uid, &item, 1);
 }
-// ȡʱ
-uint8_t ESP8266_TCP_GetTime(char *uid, char *time_buffer, uint16_t buffer_size)
+
+/**
+ * @brief 发布不超过 AT_PIPE_MAX 个主题：全部连续提交，再依次等待应答
+ */
+static void ESP8266_Publish_Chunk(const char *uid, esp8266_pub_t *items, uint8_t count)
 {
-    char cmd[128];
-    snprintf(cmd, sizeof(cmd), "cmd=7&uid=%s&type=1\r\n", uid);
-    
-    // սջ
-    uart2_rx_len = 0;
-    memset(uart2_buffer, 0, sizeof(uart2_buffer));
-    
-    // ʱȡ
-    UART2_SendDataToWiFi_Poll((uint8_t *)cmd, strlen(cmd));
-    
-    // ȴӦ
-    uint16_t timeout = 3000;
-    while (uart2_rx_len <= 0 && timeout > 0)
+    // 发布只在ESP8266任务中进行，片段和请求放在静态区（函数返回前请求均已完成）
+    static uart2_iov_t cmd[AT_PIPE_MAX][7];
+    static bemfa_req_t req[AT_PIPE_MAX];
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(1000);
+    uint8_t i;
+
+    for (i = 0; i < count; i++)
     {
-        timeout--;
-        vTaskDelay(pdMS_TO_TICKS(1));
+        // cmd=2&uid=4d9ec352e0376f2110a0c601a2857225&topic=light002&msg=#32#27.80#ON#
+        // 连续发送的帧可能合并到同一个TCP包中，以\r\n分隔
+        const uart2_iov_t frame[] = {
+            AT_IOV_STR("cmd=2&uid="), AT_IOV(uid), AT_IOV_STR("&topic="), AT_IOV(items[i].topic),
+            AT_IOV_STR("&msg="), AT_IOV(items[i].msg), AT_IOV_STR("\r\n"),
+        };
+
+        // 片段数组须保持到帧发出，复制到本函数的存储中
+        memcpy(cmd[i], frame, sizeof(frame));
+        items[i].result = ESP8266_PUB_PENDING;
+        if (Bemfa_Request_Submit(cmd[i], 7, BEMFA_CMD_PUBLISH, &req[i]) != AT_RES_OK)
+        {
+            items[i].result = AT_RES_BUSY;
+        }
     }
-    
-    if (uart2_rx_len > 0 && timeout > 0)
+
+    // 应答由客户端按命令字关联，期间到达的下发进入下发队列
+    for (i = 0; i < count; i++)
     {
-        // ʱݣʽ2021-06-11 16:39:27
-//        char *time_start = (char *)uart2_buffer;
-        
-        // ֱӸƽյݵ
-        uint16_t copy_len = uart2_rx_len < buffer_size - 1 ? uart2_rx_len : buffer_size - 1;
-        memcpy(time_buffer, uart2_buffer, copy_len);
-        time_buffer[copy_len] = '\0';
-        
-        // ӡյڵ
-        printf("Received time data: %s\n", time_buffer);
-        
-        uart2_rx_len = 0; // սջ
-        return 1;
+        if (items[i].result == ESP8266_PUB_PENDING)
+        {
+            items[i].result = Bemfa_Request_Wait(&req[i], deadline);
+        }
     }
-    
-    uart2_rx_len = 0; // սջ
-    return 0;
 }
 
-// ==================================
-// Ϣ
-// ==================================
-
-/**
- * @brief ַеָ
- * @param buffer յַ
- * @param topic Ҫҵtopic
- * @param msg_value 洢ҵmsgֵ
- * @return 1-ɹҵ0-δҵ
- */
-uint8_t ESP8266_Parse_Command(const char *buffer, const char *topic, char *msg_value)
+uint8_t ESP8266_TCP_Publish_Batch(const char *uid, esp8266_pub_t *items, uint8_t count)
 {
-    if (buffer == NULL || topic == NULL || msg_value == NULL) {
-        return 0;
-    }
-    
-    // ʱַв
-    char temp_topic[64];
-    snprintf(temp_topic, sizeof(temp_topic), "topic=%s", topic);
-    
-    // printf("Looking for topic: %s in buffer: %s\r\n", temp_topic, buffer);  // ӵϢ
-    
-    // Ƿָtopic
-    if (strstr(buffer, temp_topic) == NULL) {
-        printf("Topic not found\r\n");  // ӵϢ
+    uint8_t i, ok = 0;
+
+    if (items == NULL || count == 0)
+    {
         return 0;
     }
-    
-    // printf("Topic found!\r\n");  // ӵϢ
-    
-    // msg
-    const char *msg_start = strstr(buffer, "msg=");
-    if (msg_start == NULL) {
-        printf("msg parameter not found\r\n");  // ӵϢ
-        return 0;
+
+    // 在途帧数受流水线深度限制，主题较多时分组发送
+    for (i = 0; i < count; i += AT_PIPE_MAX)
+    {
+        ESP8266_Publish_Chunk(uid, &items[i], (count - i > AT_PIPE_MAX) ? AT_PIPE_MAX : count - i);
     }
-    
-    // "msg="ǰ׺
-    msg_start += 4;
-    
-    // ȡmsgֱֵ&\r\nַ
-    int i = 0;
-    while (msg_start[i] != '\0' && msg_start[i] != '&' && msg_start[i] != '\r' && msg_start[i] != '\n' && i < 31) {
-        msg_value[i] = msg_start[i];
-        i++;
+    for (i = 0; i < count; i++)
+    {
+        if (items[i].result == AT_RES_OK)
+        {
+            ok++;
+        }
     }
-    msg_value[i] = '\0';
-    
-    // printf("Extracted msg_value: %s\r\n", msg_value);  // ӵϢ
-    
-    return 1;
+    return ok;
 }
 
-/**
- * @brief صԶ
- * @param buffer յַ
- * @return 1-ɹ0-δ
- */
-uint8_t ESP8266_Process_Sensor_Commands(const char *buffer)
+// 发送心跳包
+uint8_t ESP8266_TCP_Heartbeat(void)
 {
-    if (buffer == NULL) {
+    const uart2_iov_t cmd[] = {AT_IOV_STR("cmd=0&msg=ping\r\n")};
+
+    if (Bemfa_Request(cmd, 1, BEMFA_CMD_PING, 1000) != AT_RES_OK) // 等待
+    {
         return 0;
     }
+    return 1;
+}
+// 获取时间
+uint8_t ESP8266_TCP_GetTime(const char *uid, char *time_buffer, uint16_t buffer_size)
+{
+    const uart2_iov_t cmd[] = {
+        AT_IOV_STR("cmd=7&uid="), AT_IOV(uid), AT_IOV_STR("&type=1\r\n"),
+    };
     
-    printf("Processing command: %s\r\n", buffer);  // ӵϢ
-    
-    char msg_value[32] = {0};
-    
-    // DHT11
-    if (ESP8266_Parse_Command(buffer, "mydht004", msg_value)) {
-        printf("Found DHT11 topic, msg_value: %s\r\n", msg_value);  // ӵϢ
-        extern uint8_t DHT11_ON;
-        // printf("Before change - DHT11_ON = %d\r\n", DHT11_ON);  // ޸ıǰֵ
-        // printf("Comparing msg_value: '%s' with 'on' and 'off'\r\n", msg_value);
-        // printf("strcmp(msg_value, \"on\") = %d\r\n", strcmp(msg_value, "on"));
-        // printf("strcmp(msg_value, \"off\") = %d\r\n", strcmp(msg_value, "off"));
-        
-        if (strcmp(msg_value, "on") == 0) {
-            DHT11_ON = 1;
-            printf("DHT11 sensor turned ON via remote command, current status: %d\r\n", DHT11_ON);
-            return 1;
-        } else if (strcmp(msg_value, "off") == 0) {
-            DHT11_ON = 0;
-            printf("DHT11 sensor turned OFF via remote command, current status: %d\r\n", DHT11_ON);
-            return 1;
-        } else {
-            printf("Invalid msg_value: '%s'\r\n", msg_value);
-        }
-        return 1; // ȷʹmsgֵƥҲ
-    }
-    
-    // Light
-    if (ESP8266_Parse_Command(buffer, "myLUX004", msg_value)) {
-        printf("Found Light topic, msg_value: %s\r\n", msg_value);  // ӵϢ
-        extern uint8_t Light_ON;
-        if (strcmp(msg_value, "on") == 0) {
-            Light_ON = 1;
-            printf("Light sensor turned ON via remote command, current status: %d\r\n", Light_ON);
-            return 1;
-        } else if (strcmp(msg_value, "off") == 0) {
-            Light_ON = 0;
-            printf("Light sensor turned OFF via remote command, current status: %d\r\n", Light_ON);
-            return 1;
-        }
-        return 1; // ȷʹmsgֵƥҲ
-    }
-    
-    // PM2.5
-    if (ESP8266_Parse_Command(buffer, "myMP25004", msg_value)) {
-        extern uint8_t PM25_ON;
-        if (strcmp(msg_value, "on") == 0) {
-            PM25_ON = 1;
-            printf("PM25 sensor turned ON via remote command\r\n");
-            return 1;
-        } else if (strcmp(msg_value, "off") == 0) {
-            PM25_ON = 0;
-            printf("PM25 sensor turned OFF via remote command\r\n");
-            return 1;
-        }
+    // 时间数据（格式：2021-06-11 16:39:27）没有固定前缀，取第一行应答；
+    // cmd= 开头的行都由协议客户端取走，不会被误当作时间
+#if ESP8266_LAN_SERVER
+    if (Bemfa_Request_Resp(cmd, 3, BEMFA_CMD_TIME, 3000, time_buffer, buffer_size) == AT_RES_OK)
+#else
+    if (AT_Execv_Resp(cmd, 3, AT_EXPECT_ANY, 3000, time_buffer, buffer_size) == AT_RES_OK)
+#endif
+    {
+        // 打印接收到的数据用于调试
+        LOG_I(LOG_MOD_WIFI, "Received time data: %s", time_buffer);
+        return 1;
     }
     
     return 0;
@@ -9,22 +9,59 @@
 #include "stm32f10x.h"
 #include <stdint.h>
 #include "sensordata.h"
-extern uint8_t uart2_buffer[UART2_BUF_SIZE]; // uart2接收缓冲
-extern uint8_t uart2_rx_len;     // uart2接收长度
+#include "at_engine.h"
+
+// 局域网HTTP服务（见 lan_server.h）。ESP8266只有多连接模式下才能开启服务器，
+// 而多连接模式不能透传：开启后云端会话改为按帧 AT+CIPSEND，占用固定的连接号
+#ifndef ESP8266_LAN_SERVER
+#define ESP8266_LAN_SERVER 0
+#endif
+#define ESP8266_CLOUD_LINK 4    // 服务器按从小到大分配连接号，云端使用最大的一个
+
+#define ESP8266_STR_(x) #x
+#define ESP8266_STR(x) ESP8266_STR_(x)
 
 extern uint8_t wifi_connected;
 extern uint8_t Server_connected;
 extern uint16_t publish_delaytime;
 
 void ESP8266_Receive_Start(void);
-uint8_t ESP8266_Connect_WiFi(char *ssid, char *password);
-uint8_t ESP8266_Connect_Server(char *ip, char *port);
-uint8_t ESP8266_TCP_Subscribe(char *uid, char *topic);
-uint8_t ESP8266_TCP_Publish(char *uid, char *topic, char *data);
-uint8_t ESP8266_TCP_Heartbeat(void);
-uint8_t ESP8266_TCP_GetTime(char *uid, char *time_buffer, uint16_t buffer_size);
+uint8_t ESP8266_Probe(void);
+/**
+ * @brief 用 AT+UART_CUR 切换模块波特率（不写入模块Flash，复位后恢复默认），
+ *        随后切换UART2并用 AT 验证链路
+ * @return 1-切换并验证成功 0-模块拒绝或验证失败（此时双方波特率未知）
+ */
+uint8_t ESP8266_Set_Baudrate(uint32_t baudrate);
+/**
+ * @brief 按UART2当前速率退出透传并盲发 AT+UART_CUR，不等待应答
+ *        （模块在该速率下能收但发送失真、或停在透传模式时仍能切换）
+ */
+void ESP8266_Force_Baudrate(uint32_t baudrate);
+uint8_t ESP8266_Connect_WiFi(const char *ssid, const char *password);
+uint8_t ESP8266_Connect_Server(const char *ip, const char *port);
+void ESP8266_Close_Server(void);
+uint8_t ESP8266_TCP_Subscribe(const char *uid, const char *topic);
+uint8_t ESP8266_TCP_Publish(const char *uid, const char *topic, const char *data);
 
-// 新增消息解析函数
-uint8_t ESP8266_Parse_Command(const char *buffer, const char *topic, char *msg_value);
-uint8_t ESP8266_Process_Sensor_Commands(const char *buffer);
+// 批量发布的单个主题
+#define ESP8266_PUB_PENDING 1   // 等待应答中
+typedef struct
+{
+    const char *topic;
+    const char *msg;
+    int8_t result;              // 输出：AT_RES_xxx
+} esp8266_pub_t;
+
+/**
+ * @brief 流水线批量发布：各主题的发布帧连续发出，应答按顺序匹配
+ * @param uid 用户私钥
+ * @param items 主题数组，result 返回每个主题的结果
+ * @param count 主题个数
+ * @return 成功的主题个数
+ * @note 一个发布周期的耗时约为一次网络往返
+ */
+uint8_t ESP8266_TCP_Publish_Batch(const char *uid, esp8266_pub_t *items, uint8_t count);
+uint8_t ESP8266_TCP_Heartbeat(void);
+uint8_t ESP8266_TCP_GetTime(const char *uid, char *time_buffer, uint16_t buffer_size);
 #endif 
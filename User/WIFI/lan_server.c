@@ -0,0 +1,440 @@
+/**
+ * @file lan_server.c
+ * @brief 局域网HTTP/JSON只读接口实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "lan_server.h"
+#include "esp8266.h"
+#include "outbox.h"
+#include "strfmt.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+#if ESP8266_LAN_SERVER
+
+#define LAN_LINK_NONE       0xFF
+
+typedef enum
+{
+    LAN_PATH_NOW = 0,
+    LAN_PATH_HISTORY,
+    LAN_PATH_NOT_FOUND
+} lan_path_t;
+
+// 等待应答的请求
+typedef struct
+{
+    uint8_t link;
+    uint8_t path;
+} lan_request_t;
+
+// 输出窗口：每次按顺序生成整个应答，只保留 [skip, skip+size) 部分
+typedef struct
+{
+    char *buf;
+    uint16_t skip;
+    uint16_t size;
+    uint16_t pos;               // 已生成的总长度
+} lan_out_t;
+
+// ==================================
+// 静态变量
+// ==================================
+
+static outbox_entry_t lan_history[LAN_HISTORY_LEN];
+static uint8_t lan_history_head = 0;        // 下一条写入位置
+static uint8_t lan_history_count = 0;
+static TickType_t lan_history_tick = 0;
+
+static lan_request_t lan_pending[LAN_PENDING_MAX];
+static uint8_t lan_pending_count = 0;
+
+// 当前应答，只由持有 lan_busy 的一方修改
+static volatile uint8_t lan_busy = 0;       // 正在提交或有一条服务指令在AT队列中
+static volatile uint8_t lan_link = LAN_LINK_NONE;
+static uint8_t lan_path;
+static outbox_entry_t lan_now;              // 请求时刻的读数，分段生成时保持不变
+static uint32_t lan_up;                     // 同上：运行时间（秒）
+static uint16_t lan_pub;                    // 同上：发布周期（秒）
+static uint16_t lan_body_len;
+static uint16_t lan_total;                  // 0-尚未生成
+static uint16_t lan_offset;
+static uint16_t lan_chunk_len;
+static char lan_chunk[LAN_CHUNK_SIZE];
+static char lan_cmd[24];
+
+// ==================================
+// JSON生成
+// ==================================
+
+static void Lan_Put(lan_out_t *o, const char *s, uint16_t n)
+{
+    while (n--)
+    {
+        if (o->pos >= o->skip && o->pos - o->skip < o->size)
+        {
+            o->buf[o->pos - o->skip] = *s;
+        }
+        o->pos++;
+        s++;
+    }
+}
+
+static void Lan_Str(lan_out_t *o, const char *s)
+{
+    Lan_Put(o, s, (uint16_t)strlen(s));
+}
+
+/**
+ * @brief 输出定点数，present为0时输出null
+ */
+static void Lan_Num(lan_out_t *o, uint8_t present, int32_t v, uint8_t frac)
+{
+    char tmp[12];
+    fmt_buf_t f;
+
+    if (!present)
+    {
+        Lan_Str(o, "null");
+        return;
+    }
+    fmt_init(&f, tmp, sizeof(tmp));
+    fmt_fixed(&f, v, frac, 0);
+    Lan_Put(o, tmp, f.len);
+}
+
+static int32_t Lan_Temp_x10(const outbox_entry_t *e)
+{
+    return e->temp_int * 10 + e->temp_deci;
+}
+
+static void Lan_Body_Now(lan_out_t *o)
+{
+    const outbox_entry_t *e = &lan_now;
+    uint8_t dht = (e->flags & OUTBOX_F_DHT11) != 0;
+
+    Lan_Str(o, "{\"ts\":");
+    Lan_Num(o, e->ts != OUTBOX_TS_UNKNOWN, (int32_t)e->ts, 0);
+    Lan_Str(o, ",\"up\":");
+    Lan_Num(o, 1, (int32_t)lan_up, 0);
+    Lan_Str(o, ",\"temp\":");
+    Lan_Num(o, dht, Lan_Temp_x10(e), 1);
+    Lan_Str(o, ",\"humi\":");
+    Lan_Num(o, dht, e->humi, 0);
+    // 露点简化公式 Td = T - (100 - RH) / 5，相对湿度50%以上误差约1℃
+    Lan_Str(o, ",\"dew\":");
+    Lan_Num(o, dht, Lan_Temp_x10(e) - (100 - e->humi) * 2, 1);
+    Lan_Str(o, ",\"lux\":");
+    Lan_Num(o, (e->flags & OUTBOX_F_LIGHT) != 0, e->lux, 0);
+    Lan_Str(o, ",\"pm25\":");
+    Lan_Num(o, (e->flags & OUTBOX_F_PM25) != 0, e->pm25_x10, 1);
+    Lan_Str(o, ",\"level\":");
+    Lan_Num(o, (e->flags & OUTBOX_F_PM25) != 0, e->pm25_level, 0);
+    Lan_Str(o, ",\"pub\":");
+    Lan_Num(o, 1, lan_pub, 0);
+    Lan_Str(o, "}");
+}
+
+static void Lan_Body_History(lan_out_t *o)
+{
+    int32_t sum[4] = {0, 0, 0, 0};     // 温度 湿度 光照 PM2.5
+    uint8_t cnt[4] = {0, 0, 0, 0};
+    uint8_t i;
+
+    for (i = 0; i < lan_history_count; i++)
+    {
+        const outbox_entry_t *e = &lan_history[i];
+        if (e->flags & OUTBOX_F_DHT11)
+        {
+            sum[0] += Lan_Temp_x10(e);
+            sum[1] += e->humi;
+            cnt[0]++;
+            cnt[1]++;
+        }
+        if (e->flags & OUTBOX_F_LIGHT)
+        {
+            sum[2] += e->lux;
+            cnt[2]++;
+        }
+        if (e->flags & OUTBOX_F_PM25)
+        {
+            sum[3] += e->pm25_x10;
+            cnt[3]++;
+        }
+    }
+
+    Lan_Str(o, "{\"period\":");
+    Lan_Num(o, 1, lan_pub, 0);
+    Lan_Str(o, ",\"n\":");
+    Lan_Num(o, 1, lan_history_count, 0);
+    Lan_Str(o, ",\"avg\":{\"temp\":");
+    Lan_Num(o, cnt[0] > 0, cnt[0] ? (sum[0] + cnt[0] / 2) / cnt[0] : 0, 1);
+    Lan_Str(o, ",\"humi\":");
+    Lan_Num(o, cnt[1] > 0, cnt[1] ? (sum[1] + cnt[1] / 2) / cnt[1] : 0, 0);
+    Lan_Str(o, ",\"lux\":");
+    Lan_Num(o, cnt[2] > 0, cnt[2] ? (sum[2] + cnt[2] / 2) / cnt[2] : 0, 0);
+    Lan_Str(o, ",\"pm25\":");
+    Lan_Num(o, cnt[3] > 0, cnt[3] ? (sum[3] + cnt[3] / 2) / cnt[3] : 0, 1);
+
+    // 每行 [时间戳,温度,湿度,光照,PM2.5]，从旧到新
+    Lan_Str(o, "},\"rows\":[");
+    for (i = 0; i < lan_history_count; i++)
+    {
+        uint8_t idx = (uint8_t)((lan_history_head + LAN_HISTORY_LEN - lan_history_count + i) % LAN_HISTORY_LEN);
+        const outbox_entry_t *e = &lan_history[idx];
+        uint8_t dht = (e->flags & OUTBOX_F_DHT11) != 0;
+
+        Lan_Str(o, (i == 0) ? "[" : ",[");
+        Lan_Num(o, e->ts != OUTBOX_TS_UNKNOWN, (int32_t)e->ts, 0);
+        Lan_Str(o, ",");
+        Lan_Num(o, dht, Lan_Temp_x10(e), 1);
+        Lan_Str(o, ",");
+        Lan_Num(o, dht, e->humi, 0);
+        Lan_Str(o, ",");
+        Lan_Num(o, (e->flags & OUTBOX_F_LIGHT) != 0, e->lux, 0);
+        Lan_Str(o, ",");
+        Lan_Num(o, (e->flags & OUTBOX_F_PM25) != 0, e->pm25_x10, 1);
+        Lan_Str(o, "]");
+    }
+    Lan_Str(o, "]}");
+}
+
+static void Lan_Body(lan_out_t *o)
+{
+    switch (lan_path)
+    {
+    case LAN_PATH_NOW:
+        Lan_Body_Now(o);
+        break;
+    case LAN_PATH_HISTORY:
+        Lan_Body_History(o);
+        break;
+    default:
+        Lan_Str(o, "{\"error\":\"not found\"}");
+        break;
+    }
+}
+
+/**
+ * @brief 生成完整应答（状态行、头部、JSON）
+ */
+static void Lan_Render(lan_out_t *o)
+{
+    Lan_Str(o, (lan_path == LAN_PATH_NOT_FOUND) ? "HTTP/1.0 404 Not Found\r\n" : "HTTP/1.0 200 OK\r\n");
+    Lan_Str(o, "Content-Type: application/json\r\nAccess-Control-Allow-Origin: *\r\n"
+               "Connection: close\r\nContent-Length: ");
+    Lan_Num(o, 1, lan_body_len, 0);
+    Lan_Str(o, "\r\n\r\n");
+    Lan_Body(o);
+}
+
+// ==================================
+// 应答发送
+// ==================================
+
+static void Lan_Server_Kick(void);
+
+static void Lan_On_Sent(int8_t result, const char *line, void *arg)
+{
+    // 发送失败（客户端已断开等）不再继续，直接关闭
+    lan_offset = (result == AT_RES_OK) ? (uint16_t)(lan_offset + lan_chunk_len) : lan_total;
+    lan_busy = 0;
+    Lan_Server_Kick();
+}
+
+static void Lan_On_Closed(int8_t result, const char *line, void *arg)
+{
+    lan_link = LAN_LINK_NONE;
+    lan_busy = 0;
+    Lan_Server_Kick();
+}
+
+/**
+ * @brief 提交当前应答的下一步（下一段数据或关闭连接），没有当前应答时取下一个请求
+ * @note AT引擎任务和ESP8266任务都可调用，同一时刻只有一方能提交
+ */
+static void Lan_Server_Kick(void)
+{
+    uart2_iov_t iov[2];
+    fmt_buf_t f;
+    int8_t ret;
+
+    taskENTER_CRITICAL();
+    if (lan_busy)
+    {
+        taskEXIT_CRITICAL();
+        return;
+    }
+    lan_busy = 1;
+    if (lan_link == LAN_LINK_NONE && lan_pending_count > 0)
+    {
+        lan_link = lan_pending[0].link;
+        lan_path = lan_pending[0].path;
+        lan_pending_count--;
+        memmove(&lan_pending[0], &lan_pending[1], lan_pending_count * sizeof(lan_request_t));
+        lan_total = 0;
+        lan_offset = 0;
+    }
+    taskEXIT_CRITICAL();
+
+    if (lan_link == LAN_LINK_NONE)
+    {
+        lan_busy = 0;
+        return;
+    }
+
+    // 新请求：取当前读数，先空跑一遍得到长度（各段都按这一次取到的值生成）
+    if (lan_total == 0)
+    {
+        lan_out_t o = {NULL, 0, 0, 0};
+
+        Outbox_Capture(&lan_now);
+        lan_up = xTaskGetTickCount() / configTICK_RATE_HZ;
+        lan_pub = publish_delaytime;
+        Lan_Body(&o);
+        lan_body_len = o.pos;
+        o.pos = 0;
+        Lan_Render(&o);
+        lan_total = o.pos;
+    }
+
+    fmt_init(&f, lan_cmd, sizeof(lan_cmd));
+    if (lan_offset < lan_total)
+    {
+        lan_out_t o = {lan_chunk, lan_offset, LAN_CHUNK_SIZE, 0};
+
+        Lan_Render(&o);
+        lan_chunk_len = (lan_total - lan_offset > LAN_CHUNK_SIZE) ? LAN_CHUNK_SIZE : (uint16_t)(lan_total - lan_offset);
+        fmt_str(&f, "AT+CIPSEND=");
+        fmt_u32(&f, lan_link, 0, ' ');
+        fmt_char(&f, ',');
+        fmt_u32(&f, lan_chunk_len, 0, ' ');
+        fmt_str(&f, "\r\n");
+        iov[0].data = lan_cmd;
+        iov[0].len = f.len;
+        iov[1].data = lan_chunk;
+        iov[1].len = lan_chunk_len;
+        ret = AT_Sendv(iov, 2, "SEND OK", 2000, AT_FLAG_PROMPT, Lan_On_Sent, NULL);
+    }
+    else
+    {
+        fmt_str(&f, "AT+CIPCLOSE=");
+        fmt_u32(&f, lan_link, 0, ' ');
+        fmt_str(&f, "\r\n");
+        ret = AT_Send(lan_cmd, "OK", 1000, Lan_On_Closed, NULL);
+    }
+
+    if (ret != AT_RES_OK)
+    {
+        lan_busy = 0; // 指令队列满，由 Lan_Server_Poll() 重试
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+uint8_t Lan_Server_Start(void)
+{
+    // 已有连接时修改会返回错误（此时已是多连接模式且服务器在运行），忽略
+    AT_Exec("AT+CIPMUX=1\r\n", "OK", 1000);
+    AT_Exec("AT+CIPSERVERMAXCONN=" LAN_SERVER_MAX_CONN "\r\n", "OK", 1000);
+    if (AT_Exec("AT+CIPSERVER=1," LAN_SERVER_PORT "\r\n", "OK", 2000) != AT_RES_OK)
+    {
+        LOG_E(LOG_MOD_WIFI, "LAN: server start failed");
+        return 0;
+    }
+    AT_Exec("AT+CIPSTO=" LAN_SERVER_TIMEOUT_S "\r\n", "OK", 1000);
+    return 1;
+}
+
+void Lan_Server_On_Request(uint8_t link, const char *data, uint16_t len)
+{
+    uint8_t path = LAN_PATH_NOT_FOUND;
+    uint8_t queued = 0;
+    uint16_t line = 0;
+
+    // 只处理请求行（"<方法> <路径> HTTP/1.x"），不是请求行开头的数据包（如请求体）忽略
+    while (line < len && data[line] != '\r' && data[line] != '\n')
+    {
+        line++;
+    }
+    if (link >= ESP8266_CLOUD_LINK || line < 14 || memcmp(data + line - 9, " HTTP/1.", 8) != 0)
+    {
+        return;
+    }
+    len = line;
+    if (len > 5 && memcmp(data, "GET /", 5) == 0)
+    {
+        const char *p = data + 4;
+        uint16_t n = 0;
+
+        while (4 + n < len && p[n] != ' ' && p[n] != '?')
+        {
+            n++;
+        }
+        if (n == 1 || (n == 4 && memcmp(p, "/now", 4) == 0))
+        {
+            path = LAN_PATH_NOW;
+        }
+        else if (n == 8 && memcmp(p, "/history", 8) == 0)
+        {
+            path = LAN_PATH_HISTORY;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    if (lan_pending_count < LAN_PENDING_MAX)
+    {
+        lan_pending[lan_pending_count].link = link;
+        lan_pending[lan_pending_count].path = path;
+        lan_pending_count++;
+        queued = 1;
+    }
+    taskEXIT_CRITICAL();
+
+    if (!queued)
+    {
+        LOG_W(LOG_MOD_WIFI, "LAN: busy, request on link %u dropped", link);
+        return;
+    }
+    Lan_Server_Kick();
+}
+
+void Lan_Server_Poll(void)
+{
+    if (xTaskGetTickCount() - lan_history_tick >= pdMS_TO_TICKS(publish_delaytime * 1000UL))
+    {
+        outbox_entry_t e;
+        uint8_t recorded = 0;
+
+        Outbox_Capture(&e);
+
+        // 应答分段生成期间历史不变，否则各段长度与 Content-Length 不一致
+        taskENTER_CRITICAL();
+        if (lan_link == LAN_LINK_NONE)
+        {
+            lan_history[lan_history_head] = e;
+            lan_history_head = (uint8_t)((lan_history_head + 1) % LAN_HISTORY_LEN);
+            if (lan_history_count < LAN_HISTORY_LEN)
+            {
+                lan_history_count++;
+            }
+            recorded = 1;
+        }
+        taskEXIT_CRITICAL();
+
+        if (recorded)
+        {
+            lan_history_tick = xTaskGetTickCount();
+        }
+    }
+
+    Lan_Server_Kick();
+}
+
+#endif // ESP8266_LAN_SERVER
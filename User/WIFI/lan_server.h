@@ -0,0 +1,56 @@
+/**
+ * @file lan_server.h
+ * @brief 局域网HTTP/JSON只读接口（ESP8266 AT+CIPSERVER）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 开启 ESP8266_LAN_SERVER 后模块工作在多连接模式，在 LAN_SERVER_PORT 上监听，
+ * 同一局域网内的看板直接读取，不经过云端往返和限频：
+ *   GET /         当前读数及派生指标（露点、污染等级、运行时间）
+ *   GET /history  最近 LAN_HISTORY_LEN 条读数（每个发布周期一条）及其均值
+ * 请求在AT引擎任务中解析，应答分段用 AT+CIPSEND 异步发出后关闭连接。
+ * 任何时刻最多一条服务指令在AT指令队列中，与云端会话的指令交替执行，
+ * ESP8266任务的发布不等待局域网请求。
+ */
+
+#ifndef __LAN_SERVER_H
+#define __LAN_SERVER_H
+
+#include "stm32f10x.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define LAN_SERVER_PORT         "80"
+#define LAN_SERVER_MAX_CONN     "2"     // 同时接入的客户端数（连接号0~1，云端使用 ESP8266_CLOUD_LINK）
+#define LAN_SERVER_TIMEOUT_S    "10"    // 客户端空闲超时，及时回收未发完请求的连接
+#define LAN_HISTORY_LEN         8       // 历史读数条数
+#define LAN_CHUNK_SIZE          192     // 单次 AT+CIPSEND 的数据长度（须小于UART2发送缓冲区）
+#define LAN_PENDING_MAX         2       // 等待应答的请求数，超出的请求丢弃
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 设置多连接模式并开启服务器（建立云端连接前调用）
+ * @return 1-服务器已开启 0-失败
+ */
+uint8_t Lan_Server_Start(void);
+
+/**
+ * @brief 处理客户端发来的数据包（+IPD，在AT引擎任务中执行）
+ * @param link 连接号
+ * @param data 数据包的开头部分，只解析第一行（请求行）
+ * @param len 长度
+ */
+void Lan_Server_On_Request(uint8_t link, const char *data, uint16_t len);
+
+/**
+ * @brief 记录历史读数，重试因指令队列满而暂停的应答（ESP8266任务中循环调用）
+ */
+void Lan_Server_Poll(void);
+
+#endif // __LAN_SERVER_H
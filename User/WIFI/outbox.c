@@ -0,0 +1,385 @@
+/**
+ * @file outbox.c
+ * @brief 遥测数据离线缓存实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "outbox.h"
+#include "semphr.h"
+#include "timers.h"
+#include "sensordata.h"
+#include "rtc_date.h"
+#include "strfmt.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================================
+// 静态变量
+// ==================================
+
+static outbox_entry_t outbox_ram[OUTBOX_SIZE];
+static uint16_t outbox_tail = 0;            // 最早的记录
+static uint16_t outbox_count = 0;
+
+static SemaphoreHandle_t outbox_mutex = NULL;
+static TimerHandle_t outbox_timer = NULL;
+static const uint16_t *outbox_period = NULL;
+static volatile uint8_t outbox_live = 0;
+static uint16_t outbox_elapsed = 0;         // 离线采集计时（秒）
+static uint8_t outbox_pending = 0;          // 定时器未能存入的记录
+static outbox_entry_t outbox_pending_entry;
+
+static outbox_stats_t outbox_stats;
+
+#if OUTBOX_FLASH_SPILL
+#define OUTBOX_FLASH_SLOTS  (OUTBOX_FLASH_PAGE_SIZE / sizeof(outbox_entry_t))
+#define OUTBOX_FLASH_ENTRY(i) \
+    ((const outbox_entry_t *)(OUTBOX_FLASH_ADDR + (uint32_t)(i) * sizeof(outbox_entry_t)))
+
+static uint16_t outbox_flash_head = 0;      // 下一个空槽
+static uint16_t outbox_flash_tail = 0;      // 最早的未补发记录
+#endif
+
+// ==================================
+// RAM环形缓存
+// ==================================
+
+#define OUTBOX_AT(i)    (outbox_ram[(outbox_tail + (i)) % OUTBOX_SIZE])
+
+/**
+ * @brief 较旧的一半隔条丢弃，其余记录顺序前移
+ * @note 反复抽稀后越早的数据间隔越大，覆盖的时间跨度随之成倍增长
+ */
+static void Outbox_Thin(void)
+{
+    uint16_t half = outbox_count / 2;
+    uint16_t dst = 0;
+
+    for (uint16_t src = 0; src < outbox_count; src++)
+    {
+        if (src < half && (src & 1))
+        {
+            continue;
+        }
+        if (dst != src)
+        {
+            OUTBOX_AT(dst) = OUTBOX_AT(src);
+        }
+        dst++;
+    }
+    outbox_stats.thinned += outbox_count - dst;
+    outbox_count = dst;
+}
+
+// ==================================
+// Flash保留页
+// ==================================
+
+#if OUTBOX_FLASH_SPILL
+
+/**
+ * @brief 扫描保留页，恢复写入位置和补发位置
+ * @note 记录按顺序写入、按顺序补发，空槽之前第一条未标记的记录即最早的记录
+ */
+static void Outbox_Flash_Scan(void)
+{
+    uint16_t i;
+
+    outbox_flash_head = OUTBOX_FLASH_SLOTS;
+    for (i = 0; i < OUTBOX_FLASH_SLOTS; i++)
+    {
+        if (OUTBOX_FLASH_ENTRY(i)->flags == 0xFF)
+        {
+            outbox_flash_head = i;
+            break;
+        }
+    }
+    for (i = 0; i < outbox_flash_head; i++)
+    {
+        if (OUTBOX_FLASH_ENTRY(i)->mark != 0)
+        {
+            break;
+        }
+    }
+    outbox_flash_tail = i;
+}
+
+/**
+ * @brief 按半字写入一条记录
+ * @return 0-成功 -1-写入失败
+ */
+static int8_t Outbox_Flash_Write(uint16_t slot, const outbox_entry_t *e)
+{
+    const uint16_t *src = (const uint16_t *)e;
+    uint32_t addr = (uint32_t)OUTBOX_FLASH_ENTRY(slot);
+    int8_t ret = 0;
+
+    FLASH_Unlock();
+    for (uint8_t i = 0; i < sizeof(outbox_entry_t) / 2; i++)
+    {
+        // 擦除后即为0xFFFF，无需编程（mark字段保持未标记）
+        if (src[i] != 0xFFFF && FLASH_ProgramHalfWord(addr + i * 2, src[i]) != FLASH_COMPLETE)
+        {
+            ret = -1;
+            break;
+        }
+    }
+    FLASH_Lock();
+    return ret;
+}
+
+/**
+ * @brief 将RAM中最早的一半记录溢出到保留页
+ * @return 溢出的记录数，保留页已满时为0
+ * @note 擦除期间CPU取指暂停约20ms，只在保留页全部补发完成后才擦除
+ */
+static uint16_t Outbox_Flash_Spill(void)
+{
+    uint16_t n = outbox_count / 2;
+    uint16_t done = 0;
+
+    if (outbox_flash_head > 0 && outbox_flash_tail == outbox_flash_head)
+    {
+        FLASH_Unlock();
+        FLASH_ErasePage(OUTBOX_FLASH_ADDR);
+        FLASH_Lock();
+        outbox_flash_head = 0;
+        outbox_flash_tail = 0;
+    }
+    if (n > OUTBOX_FLASH_SLOTS - outbox_flash_head)
+    {
+        n = OUTBOX_FLASH_SLOTS - outbox_flash_head;
+    }
+
+    while (done < n)
+    {
+        outbox_entry_t e = OUTBOX_AT(0);
+        e.mark = 0xFFFF;
+        if (Outbox_Flash_Write(outbox_flash_head, &e) != 0)
+        {
+            // 写坏的槽标记为非空且已补发，记录仍留在RAM中
+            FLASH_Unlock();
+            FLASH_ProgramHalfWord((uint32_t)&OUTBOX_FLASH_ENTRY(outbox_flash_head)->flags, 0);
+            FLASH_ProgramHalfWord((uint32_t)&OUTBOX_FLASH_ENTRY(outbox_flash_head)->mark, 0);
+            FLASH_Lock();
+            if (outbox_flash_tail == outbox_flash_head)
+            {
+                outbox_flash_tail++;
+            }
+            outbox_flash_head++;
+            break;
+        }
+        outbox_flash_head++;
+        outbox_tail = (outbox_tail + 1) % OUTBOX_SIZE;
+        outbox_count--;
+        done++;
+    }
+    outbox_stats.spilled += done;
+    return done;
+}
+
+static uint16_t Outbox_Flash_Count(void)
+{
+    return outbox_flash_head - outbox_flash_tail;
+}
+
+#endif // OUTBOX_FLASH_SPILL
+
+// ==================================
+// 离线采集定时器
+// ==================================
+
+/**
+ * @brief 每秒计时，离线期间按发布周期采集一条记录（定时器任务中执行）
+ * @note 定时器回调不能阻塞，缓存忙时保留记录到下一秒再存
+ */
+static void Outbox_Timer_Callback(TimerHandle_t timer)
+{
+    if (outbox_live)
+    {
+        outbox_elapsed = 0;
+    }
+    else if (++outbox_elapsed >= *outbox_period)
+    {
+        outbox_elapsed = 0;
+        Outbox_Capture(&outbox_pending_entry);
+        outbox_pending = 1;
+    }
+
+    if (outbox_pending && Outbox_Push(&outbox_pending_entry, 0) == 0)
+    {
+        outbox_pending = 0;
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+int8_t Outbox_Init(const uint16_t *period_s)
+{
+    if (outbox_mutex != NULL)
+    {
+        return 0;
+    }
+
+    outbox_mutex = xSemaphoreCreateMutex();
+    outbox_timer = xTimerCreate("Outbox", pdMS_TO_TICKS(1000), pdTRUE, NULL, Outbox_Timer_Callback);
+    if (outbox_mutex == NULL || outbox_timer == NULL || period_s == NULL)
+    {
+        LOG_E(LOG_MOD_WIFI, "Outbox: init failed");
+        return -1;
+    }
+    outbox_period = period_s;
+
+#if OUTBOX_FLASH_SPILL
+    Outbox_Flash_Scan();
+    if (Outbox_Flash_Count() > 0)
+    {
+        LOG_I(LOG_MOD_WIFI, "Outbox: %u readings restored from flash", Outbox_Flash_Count());
+    }
+#endif
+
+    xTimerStart(outbox_timer, 0);
+    return 0;
+}
+
+void Outbox_SetLive(uint8_t live)
+{
+    outbox_live = live;
+}
+
+void Outbox_Capture(outbox_entry_t *e)
+{
+    memset(e, 0, sizeof(*e));
+    e->ts = MyRTC_IsReady() ? RTC_GetCounter() : OUTBOX_TS_UNKNOWN;
+    e->mark = 0xFFFF;
+
+    if (DHT11_ON)
+    {
+        e->flags |= OUTBOX_F_DHT11;
+        e->temp_int = SensorData.dht11_data.temp_int;
+        e->temp_deci = SensorData.dht11_data.temp_deci;
+        e->humi = SensorData.dht11_data.humi_int;
+    }
+    if (Light_ON)
+    {
+        e->flags |= OUTBOX_F_LIGHT;
+        e->lux = SensorData.light_data.lux;
+    }
+    if (PM25_ON)
+    {
+        int32_t pm = fmt_to_fixed(SensorData.pm25_data.pm25_value, 1);
+        e->flags |= OUTBOX_F_PM25;
+        e->pm25_x10 = (pm < 0) ? 0 : (pm > 0xFFFF) ? 0xFFFF : (uint16_t)pm;
+        e->pm25_level = SensorData.pm25_data.level;
+    }
+}
+
+int8_t Outbox_Push(const outbox_entry_t *e, TickType_t wait)
+{
+    if (outbox_mutex == NULL || xSemaphoreTake(outbox_mutex, wait) != pdTRUE)
+    {
+        return -1;
+    }
+    if (e->flags == 0)
+    {
+        // 没有开启任何传感器，无数据可缓存
+        xSemaphoreGive(outbox_mutex);
+        return 0;
+    }
+
+    if (outbox_count >= OUTBOX_SIZE)
+    {
+#if OUTBOX_FLASH_SPILL
+        if (Outbox_Flash_Spill() == 0)
+#endif
+        {
+            Outbox_Thin();
+        }
+    }
+    OUTBOX_AT(outbox_count) = *e;
+    outbox_count++;
+    outbox_stats.pushed++;
+
+    xSemaphoreGive(outbox_mutex);
+    return 0;
+}
+
+int8_t Outbox_Peek(outbox_entry_t *e)
+{
+    int8_t ret = -1;
+
+    if (outbox_mutex == NULL)
+    {
+        return -1;
+    }
+    xSemaphoreTake(outbox_mutex, portMAX_DELAY);
+#if OUTBOX_FLASH_SPILL
+    // Flash中的记录总是早于RAM中的记录
+    if (Outbox_Flash_Count() > 0)
+    {
+        *e = *OUTBOX_FLASH_ENTRY(outbox_flash_tail);
+        ret = 0;
+    }
+    else
+#endif
+    if (outbox_count > 0)
+    {
+        *e = OUTBOX_AT(0);
+        ret = 0;
+    }
+    xSemaphoreGive(outbox_mutex);
+    return ret;
+}
+
+void Outbox_Pop(void)
+{
+    if (outbox_mutex == NULL)
+    {
+        return;
+    }
+    xSemaphoreTake(outbox_mutex, portMAX_DELAY);
+#if OUTBOX_FLASH_SPILL
+    if (Outbox_Flash_Count() > 0)
+    {
+        // 已补发的记录将mark写0（允许在已编程的半字上写0）
+        FLASH_Unlock();
+        FLASH_ProgramHalfWord((uint32_t)&OUTBOX_FLASH_ENTRY(outbox_flash_tail)->mark, 0);
+        FLASH_Lock();
+        outbox_flash_tail++;
+        outbox_stats.drained++;
+    }
+    else
+#endif
+    if (outbox_count > 0)
+    {
+        outbox_tail = (outbox_tail + 1) % OUTBOX_SIZE;
+        outbox_count--;
+        outbox_stats.drained++;
+    }
+    xSemaphoreGive(outbox_mutex);
+}
+
+uint16_t Outbox_Count(void)
+{
+#if OUTBOX_FLASH_SPILL
+    return outbox_count + Outbox_Flash_Count();
+#else
+    return outbox_count;
+#endif
+}
+
+void Outbox_GetStats(outbox_stats_t *stats)
+{
+    *stats = outbox_stats;
+    stats->count = Outbox_Count();
+#if OUTBOX_FLASH_SPILL
+    stats->flash_count = Outbox_Flash_Count();
+#else
+    stats->flash_count = 0;
+#endif
+}
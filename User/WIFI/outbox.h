@@ -0,0 +1,125 @@
+/**
+ * @file outbox.h
+ * @brief 遥测数据离线缓存（断网期间的存储转发）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * WiFi或服务器不可用时，每个发布周期的传感器读数以16字节的紧凑记录
+ * 带时间戳存入有界缓存，恢复连接后由ESP8266任务按固定节奏补发：
+ *   - 缓存满时对较旧的一半隔条抽稀，越早的数据越稀疏，新数据不丢；
+ *   - 补发间隔固定，且在实时发布之后进行，不挤占实时数据；
+ *   - 可选将较旧的记录溢出到片内Flash保留页，掉电后仍可补发。
+ */
+
+#ifndef __OUTBOX_H
+#define __OUTBOX_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define OUTBOX_SIZE                 24      // RAM缓存记录数
+#define OUTBOX_DRAIN_INTERVAL_MS    2000    // 补发节奏：每个间隔补发一条记录
+
+// 溢出到片内Flash（默认关闭）：使用最后一页，需在工程中将IROM大小减去1KB
+#define OUTBOX_FLASH_SPILL          0
+#define OUTBOX_FLASH_ADDR           0x0800FC00  // 第63页
+#define OUTBOX_FLASH_PAGE_SIZE      1024
+
+// 记录中的传感器标志（采集时对应传感器已开启）
+#define OUTBOX_F_DHT11              0x01
+#define OUTBOX_F_LIGHT              0x02
+#define OUTBOX_F_PM25               0x04
+
+#define OUTBOX_TS_UNKNOWN           0       // RTC尚未就绪，无有效时间戳
+
+/**
+ * @brief 一条读数记录（16字节，与Flash半字编程对齐）
+ */
+typedef struct
+{
+    uint32_t ts;            // 采集时刻，UTC秒（与RTC计数器一致）
+    uint16_t lux;           // 光照强度
+    uint16_t pm25_x10;      // PM2.5，0.1 μg/m³
+    uint8_t temp_int;       // 温度整数部分
+    uint8_t temp_deci;      // 温度小数部分
+    uint8_t humi;           // 湿度
+    uint8_t pm25_level;     // 污染等级
+    uint8_t flags;          // OUTBOX_F_xxx，Flash中0xFF表示空槽
+    uint8_t reserved;
+    uint16_t mark;          // Flash中已补发的记录写0
+} outbox_entry_t;
+
+/**
+ * @brief 运行统计
+ */
+typedef struct
+{
+    uint16_t count;         // 待补发记录数（RAM+Flash）
+    uint16_t flash_count;   // 其中位于Flash的记录数
+    uint32_t pushed;        // 累计存入
+    uint32_t drained;       // 累计补发完成
+    uint32_t thinned;       // 抽稀丢弃
+    uint32_t spilled;       // 溢出到Flash
+} outbox_stats_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 初始化缓存并启动离线采集定时器
+ * @param period_s 采集周期变量（秒），与发布周期一致，界面可随时修改
+ * @return 0-成功 -1-失败
+ * @note 开启Flash溢出时会扫描保留页，恢复掉电前未补发的记录
+ */
+int8_t Outbox_Init(const uint16_t *period_s);
+
+/**
+ * @brief 设置实时发布状态
+ * @param live 1-实时发布中（由发布任务自行存入失败的记录） 0-离线，由定时器按周期采集
+ */
+void Outbox_SetLive(uint8_t live);
+
+/**
+ * @brief 从当前传感器数据和RTC生成一条记录
+ * @param e 输出记录
+ */
+void Outbox_Capture(outbox_entry_t *e);
+
+/**
+ * @brief 存入一条记录，缓存满时先抽稀（或溢出到Flash）
+ * @param e 记录
+ * @param wait 缓存被占用时的等待时间（tick），定时器回调中必须为0
+ * @return 0-成功 -1-缓存忙
+ */
+int8_t Outbox_Push(const outbox_entry_t *e, TickType_t wait);
+
+/**
+ * @brief 取出最早的一条记录（不移除）
+ * @param e 输出记录
+ * @return 0-成功 -1-缓存为空
+ */
+int8_t Outbox_Peek(outbox_entry_t *e);
+
+/**
+ * @brief 移除最早的一条记录（补发成功后调用）
+ */
+void Outbox_Pop(void);
+
+/**
+ * @brief 待补发记录数
+ */
+uint16_t Outbox_Count(void);
+
+/**
+ * @brief 读取运行统计
+ */
+void Outbox_GetStats(outbox_stats_t *stats);
+
+#endif // __OUTBOX_H
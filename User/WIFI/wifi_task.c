@@ -0,0 +1,141 @@
+/**
+ * @file wifi_task.c
+ * @brief ESP8266任务主循环实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "wifi_task.h"
+#include "esp8266.h"
+#include "bemfa_client.h"
+#include "bemfa_topics.h"
+#include "lan_server.h"
+#include <stdio.h>
+
+// ==================================
+// 静态变量
+// ==================================
+
+static uint8_t wifi_first = 1;              // 链路建立后立即发布一次
+static TickType_t wifi_publish_tick = 0;
+static TickType_t wifi_drain_tick = 0;
+static outbox_entry_t wifi_drain;           // 正在补发的历史记录
+static uint8_t wifi_drain_valid = 0;
+static const wifi_task_hooks_t *wifi_hooks = NULL;
+
+// ==================================
+// 发布
+// ==================================
+
+/**
+ * @brief 实时发布当前读数，未成功的主题存入缓存稍后补发
+ */
+static void WiFi_Task_Publish(void)
+{
+    outbox_entry_t snap;
+    uint8_t failed;
+
+    if (wifi_hooks != NULL && wifi_hooks->publish_begin != NULL)
+    {
+        wifi_hooks->publish_begin();
+    }
+    Outbox_Capture(&snap);
+    failed = Bemfa_Publish_Reading(&snap, 0);
+    if (wifi_hooks != NULL && wifi_hooks->publish_end != NULL)
+    {
+        wifi_hooks->publish_end(&snap, failed);
+    }
+
+    if (failed)
+    {
+        if (failed == snap.flags)
+        {
+            // 全部主题失败，尽快用心跳确认链路
+            Conn_Probe();
+        }
+        snap.flags = failed;
+        Outbox_Push(&snap, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief 补发一条历史记录，只重发失败的主题
+ */
+static void WiFi_Task_Drain(void)
+{
+    if (wifi_drain_valid || Outbox_Peek(&wifi_drain) == 0)
+    {
+        wifi_drain_valid = 1;
+        uint8_t failed = Bemfa_Publish_Reading(&wifi_drain, 1);
+        if (failed == 0)
+        {
+            Outbox_Pop();
+            wifi_drain_valid = 0;
+        }
+        else
+        {
+            wifi_drain.flags = failed;
+        }
+    }
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+void WiFi_Task_Init(conn_config_t *cfg)
+{
+    wifi_first = 1;
+    wifi_publish_tick = xTaskGetTickCount();
+    wifi_drain_tick = xTaskGetTickCount();
+    wifi_drain_valid = 0;
+
+    ESP8266_Receive_Start();
+
+    // 连接的建立、保活和断线恢复都由连接管理状态机完成
+    cfg->sub_list = Bemfa_Sub_List(); // 主题表中的全部订阅主题，一次请求完成
+    Conn_Init(cfg);
+}
+
+void WiFi_Task_Step(void)
+{
+    // 执行云端下发：AT引擎收到后放入下发队列，发布等待应答期间到达的也不会丢失
+    Bemfa_Client_Dispatch_Pushes();
+#if ESP8266_LAN_SERVER
+    Lan_Server_Poll(); // 局域网请求的应答由AT引擎异步发出，这里只记录历史和重试
+#endif
+
+    // 每轮最多执行一步连接操作（加入WiFi/建立TCP/订阅/心跳/对时）
+    Conn_Poll();
+    if (wifi_hooks != NULL && wifi_hooks->polled != NULL)
+    {
+        wifi_hooks->polled();
+    }
+
+    Outbox_SetLive(Conn_Is_Up());
+    if (!Conn_Is_Up())
+    {
+        // TCP透传未建立，不向AT指令模式发送透传数据，读数由缓存定时器保存
+        wifi_first = 1;
+        return;
+    }
+
+    if ((xTaskGetTickCount() - wifi_publish_tick) / 1000 >= publish_delaytime || wifi_first)
+    {
+        wifi_publish_tick = xTaskGetTickCount();
+        wifi_first = 0;
+        WiFi_Task_Publish();
+    }
+    else if (xTaskGetTickCount() - wifi_drain_tick >= pdMS_TO_TICKS(OUTBOX_DRAIN_INTERVAL_MS))
+    {
+        // 按固定节奏补发一条历史记录，与实时发布错开
+        wifi_drain_tick = xTaskGetTickCount();
+        WiFi_Task_Drain();
+    }
+}
+
+void WiFi_Task_SetHooks(const wifi_task_hooks_t *hooks)
+{
+    wifi_hooks = hooks;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file wifi_task.h
+ * @brief ESP8266任务主循环 - 下发执行、连接管理、实时发布与离线补发
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * ESP8266任务在完成串口初始化后调用 WiFi_Task_Init()，之后循环调用
+ * WiFi_Task_Step() 并让出CPU。每轮依次：执行云端下发 -> 局域网服务器维护 ->
+ * 推进连接状态机 -> 到发布周期则实时发布，否则按固定节奏补发一条缓存记录。
+ * 主机模拟器用同一个循环体，通过钩子记录链路变化和发布耗时。
+ */
+
+#ifndef __WIFI_TASK_H
+#define __WIFI_TASK_H
+
+#include "stm32f10x.h"
+#include "conn_mgr.h"
+#include "outbox.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define WIFI_TASK_PERIOD_MS     100     // 每轮之间的让出时间
+
+/**
+ * @brief 观察钩子（均可为NULL，在ESP8266任务中调用）
+ */
+typedef struct
+{
+    void (*polled)(void);           // 连接状态机推进后（链路状态可能已变化）
+    void (*publish_begin)(void);    // 实时发布开始前
+    void (*publish_end)(const outbox_entry_t *snap, uint8_t failed); // 实时发布完成，failed为失败主题的标志
+} wifi_task_hooks_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 启动AT接收、设置订阅列表并复位连接状态机
+ * @param cfg 连接参数（sub_list 由主题表填入，运行期间必须保持有效）
+ * @note 调用前需已调用 Outbox_Init() 并完成UART2（或AT端口）初始化
+ */
+void WiFi_Task_Init(conn_config_t *cfg);
+
+/**
+ * @brief 执行一轮主循环（不含末尾的让出）
+ * @note 连接步骤和发布可能阻塞数秒
+ */
+void WiFi_Task_Step(void);
+
+/**
+ * @brief 设置观察钩子
+ * @param hooks 钩子表，NULL表示不观察（内容在运行期间必须保持有效）
+ */
+void WiFi_Task_SetHooks(const wifi_task_hooks_t *hooks);
+
+#endif // __WIFI_TASK_H
@@ -10,52 +10,47 @@
 #include "queue.h"
 #include "unified_menu.h"
 #include "index.h"
+#include "menu_tree.h"
 #include "esp8266.h"
+#include "outbox.h"
+#include "conn_mgr.h"
+#include "bemfa_topics.h"
+#include "wifi_task.h"
 #include "uart2.h"
 #include "light.h"
-#include "rtc_date.h"
 #include "PM25.h"
 #include "sensordata.h"
-// 洢¼
-QueueHandle_t keyQueue; // 
-
-// ֤״̬Ŀɷ
+#include "boot.h"
+#include "perf.h"
+#include "param.h"
+#include "telemetry.h"
+#include "log.h"
+// 创建队列来存储按键事件
+QueueHandle_t keyQueue; // 按键队列
+
+// 验证传感器状态变量的可访问性
 extern uint8_t DHT11_ON;
 extern uint8_t Light_ON; 
 extern uint8_t PM25_ON;
 
 static TaskHandle_t Menu_handle = NULL;
-static TaskHandle_t Key_handle = NULL;
 static TaskHandle_t ESP8266_handle = NULL;
 
-/*  */
+/* 任务函数声明 */
 static void Menu_Main_Task(void *pvParameters);
-static void Key_Main_Task(void *pvParameters);
 static void ESP8266_Main_Task(void *pvParameters);
+static void Boot_Splash(void);
+static void Menu_On_Sample(void);
+static void Menu_On_Second(void);
 
 int main(void)
 {
-    // ϵͳʼʼ
+    // 最小化初始化：中断分组、延时定时器、调试串口，其余外设在各任务中并发初始化
+    NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
     TIM2_Delay_Init();
     debug_init();
-    OLED_Init();
-
-    OLED_Show_many_Tupian(tjbg, 8, 1);
-
-    OLED_Refresh();
-    Key_Init();
-    Beep_Init();
-    PM25_Init();
-
-    // ʼUART2ESP8266ͨ
-    UART2_DMA_RX_Init(115200);
-
-    BEEP_Buzz(10);
-
-    OLED_Printf_Line(0, "STM32F103C8T6");
-    OLED_Printf_Line(1, "FreeRTOS V20221201");
-    OLED_Printf_Line(2, "fengwuheng");
-    OLED_Printf_Line(3, "v1.0.0");
+    Perf_Init();
+    Param_Init(); // 恢复保存的运行参数，在创建任务前应用
 
     printf("\r\n==================================\r\n");
     printf("||     STM32F103C8T6   \t\t||\r\n");
@@ -63,448 +58,176 @@ int main(void)
     printf("||     fengwuheng   \t\t||\r\n");
     printf("||     v1.0.0   \t\t||\r\n");
     printf("=====================================\r\n");
-    Light_ADC_Init();
-    printf("Light_ADC_Init OK\n");
-
-    OLED_Refresh();
-    Delay_s(1);
-    OLED_Clear();
 
-    // printf("ESP8266ʼڶн...\r\n");
-    // OLED_Printf_Line(0, "WiFi Connecting...");
-    // OLED_Printf_Line(1, "Please Wait...");
-    OLED_Refresh();
-
-    // ʼģ
-    SensorData_Init();
-    printf("Sensor data initialization complete\r\n");
-
-    // ʼ˵ϵͳ
-    if (menu_system_init() != 0)
+    // 创建启动事件组及RTC初始化任务
+    if (Boot_Init() != 0)
     {
-        printf("Menu system initialization failed\r\n");
+        printf("Boot initialization failed\r\n");
         return -1;
     }
 
-    // ʼҳ
-    menu_item_t *index_menu = index_init();
-    if (index_menu == NULL)
-    {
-        printf("Index page initialization failed\r\n");
-        return -1;
-    }
-
-    // ҳΪ˵
-    g_menu_sys.root_menu = index_menu;
-    g_menu_sys.current_menu = index_menu;
-
-    /* ˵ */
-    xTaskCreate((TaskFunction_t)Menu_Main_Task, /*  */
-                (const char *)"Menu_Main",      /*  */
-                (uint16_t)2024,                 /* ջС */
-                (void *)NULL,                   /*  */
-                (UBaseType_t)4,                 /* ȼ */
-                (TaskHandle_t *)&Menu_handle);  /* ƾ */
-    xTaskCreate(Key_Main_Task, "KeyMain", 96, NULL, 4, &Key_handle);
+    /* 创建菜单任务 */
+    xTaskCreate((TaskFunction_t)Menu_Main_Task, /* 任务函数 */
+                (const char *)"Menu_Main",      /* 任务名称 */
+                (uint16_t)2024,                 /* 任务堆栈大小 */
+                (void *)NULL,                   /* 任务函数参数 */
+                (UBaseType_t)4,                 /* 任务优先级 */
+                (TaskHandle_t *)&Menu_handle);  /* 任务控制句柄 */
 
     printf("creat task OK\n");
 
-    // ݲɼ
+    // 创建传感器数据采集任务（传感器外设在任务内初始化）
     SensorData_CreateTask();
     printf("SensorData task created\n");
+    Telemetry_Init(); // USART1二进制遥测，主机订阅后才发送
     
-    // ӡʼ״̬
+    // 打印传感器初始状态
     printf("Initial sensor states: DHT11=%d, Light=%d, PM25=%d\n", DHT11_ON, Light_ON, PM25_ON);
 
-    // ESP8266
-    xTaskCreate((TaskFunction_t)ESP8266_Main_Task, /*  */
-                (const char *)"ESP8266_Main",      /*  */
-                (uint16_t)384,                     /* ջС */
-                (void *)NULL,                      /*  */
-                (UBaseType_t)2,                    /* ȼ */
-                (TaskHandle_t *)&ESP8266_handle);  /*  */
+    // 创建ESP8266任务
+    xTaskCreate((TaskFunction_t)ESP8266_Main_Task, /* 任务函数 */
+                (const char *)"ESP8266_Main",      /* 任务名称 */
+                (uint16_t)384,                     /* 任务堆栈大小 */
+                (void *)NULL,                      /* 任务参数 */
+                (UBaseType_t)2,                    /* 任务优先级 */
+                (TaskHandle_t *)&ESP8266_handle);  /* 任务句柄 */
 
-    // ӵϢȷϵ
+    // 添加调试信息，确认调度器启动
     printf("Starting scheduler...\n");
 
-    /*  */
+    /* 启动调度器 */
     vTaskStartScheduler();
 
-    // ʧܣִе
+    // 如果调度器启动失败，会执行到这里
     printf("ERROR: Scheduler failed to start!\n");
     // LED2_ON();
 }
 
-static void Menu_Main_Task(void *pvParameters)
-{
-    printf("Menu_Main_Task start ->\n");
-    // ֱӵͳһ˵ܵ
-    menu_task(pvParameters);
-}
-
-static void Key_Main_Task(void *pvParameters)
+/**
+ * @brief 播放启动画面，首次采样完成后提前结束
+ * @note 每帧之间让出CPU，传感器/ESP8266/RTC任务在此期间并发初始化
+ */
+static void Boot_Splash(void)
 {
-    // ֱӵͳһ˵ܵİ
-    menu_key_task(pvParameters);
-}
-
-static void ESP8266_Main_Task(void *pvParameters)
-{
-    printf("ESP8266_Main_Task start ->\n");
-
-    uint8_t first = 1;
-    TickType_t heart_tick = xTaskGetTickCount(); //
-    TickType_t Publish_tick = xTaskGetTickCount();
-
-    vTaskDelay(pdMS_TO_TICKS(2000)); // ȴESP8266
-    ESP8266_Receive_Start();
-
-    uint8_t retry_count = 0;
-    const uint8_t max_retries = 5;
-
-    while (!wifi_connected && retry_count < max_retries)
+    for (uint8_t i = 0; i < BOOT_SPLASH_MAX_FRAMES; i++)
     {
-        retry_count++;
-        printf("WiFi connection attempt %d/%d\r\n", retry_count, max_retries);
+        OLED_ShowPicture(32, 0, 64, 64, tjbg[i], 1);
+        OLED_Refresh();
 
-        if (ESP8266_Connect_WiFi("ElevatedNetwork.lt", "798798798") == 1) // WiFi
+        if (Boot_IsDone(BOOT_EVT_FIRST_SAMPLE))
         {
-            printf("ESP8266 Connect WiFi Success\r\n");
-            wifi_connected = 1;
-        }
-        else
-        {
-            printf("ESP8266 Connect WiFi Error, attempt %d/%d\r\n", retry_count, max_retries);
-            if (retry_count < max_retries)
-            {
-                // ȴ5
-                vTaskDelay(pdMS_TO_TICKS(5000));
-            }
+            break;
         }
+        vTaskDelay(pdMS_TO_TICKS(BOOT_SPLASH_FRAME_MS));
     }
+}
 
-    if (!wifi_connected)
-    {
-        printf("WiFi connection failed after %d attempts, entering retry loop\r\n", max_retries);
+/**
+ * @brief 传感器完成一轮采样：唤醒菜单任务
+ */
+static void Menu_On_Sample(void)
+{
+    menu_notify(MENU_NOTIFY_DATA);
+}
 
-        // ѭ
-        while (!wifi_connected)
-        {
-            vTaskDelay(pdMS_TO_TICKS(30000)); // ÿ30һ
-            printf("Retrying WiFi connection...\r\n");
-            if (ESP8266_Connect_WiFi("ElevatedNetwork.lt", "798798798") == 1)
-            {
-                printf("ESP8266 Connect WiFi Success after retry\r\n");
-                wifi_connected = 1;
-                OLED_Printf_Line(0, "WiFi Connected!");
-                OLED_Refresh();
-            }
-        }
-    }
+/**
+ * @brief RTC秒中断：唤醒菜单任务（中断上下文）
+ */
+static void Menu_On_Second(void)
+{
+    BaseType_t woken = pdFALSE;
+    menu_notify_from_isr(MENU_NOTIFY_TICK, &woken);
+    portYIELD_FROM_ISR(woken);
+}
 
-    retry_count = 0;
-    while (!Server_connected && retry_count < max_retries)
-    {
-        retry_count++;
-        printf("Server connection attempt %d/%d\r\n", retry_count, max_retries);
-        if (ESP8266_Connect_Server("bemfa.com", "8344") == 1) // ӷ
-        {
-            printf("ESP8266 Connect Server Success\r\n");
-            Server_connected = 1;
-        }
-        else
-        {
-            printf("ESP8266 Connect Server Error, attempt %d/%d\r\n", retry_count, max_retries);
-            if (retry_count < max_retries)
-            {
-                // ȴ5
-                vTaskDelay(pdMS_TO_TICKS(5000));
-            }
-        }
-    }
+static void Menu_Main_Task(void *pvParameters)
+{
+    printf("Menu_Main_Task start ->\n");
 
-    if (!Server_connected)
-    {
-        printf("Server connection failed after %d attempts, entering retry loop\r\n", max_retries);
+    OLED_Init();
+    Boot_Mark(BOOT_PHASE_DISPLAY);
 
-        while (!Server_connected)
-        {
-            vTaskDelay(pdMS_TO_TICKS(30000)); // ÿ30һ
-            printf("Retrying Server connection...\r\n");
-            if (ESP8266_Connect_Server("bemfa.com", "8344") == 1)
-            {
-                printf("ESP8266 Connect Server Success after retry\r\n");
-                Server_connected = 1;
-            }
-        }
-    }
+    Key_Init();
+    Beep_Init();
+    Boot_Mark(BOOT_PHASE_INPUT);
 
-    printf("ESP8266 Connect Server Success\r\n");
-   // ====================== 1mydht004ԣ ======================
-    retry_count = 0;
-    uint8_t sub1_connected = 0;
-    const char* uid = "4af24e3731744508bd519435397e4ab5";
-    const char* topic1 = "mydht004";
-    
-    while (!sub1_connected && retry_count < max_retries)
+    // 初始化菜单系统
+    if (menu_system_init() != 0)
     {
-        retry_count++;
-        printf("Subscribe %s attempt %d/%d\r\n", topic1, retry_count, max_retries);
-        
-        if (ESP8266_TCP_Subscribe(uid, topic1) == 1) // 
-        {
-            printf("ESP8266 TCP Subscribe %s Success\r\n", topic1);
-            sub1_connected = 1;
-        }
-        else
-        {
-            printf("ESP8266 TCP Subscribe %s Error, attempt %d/%d\r\n", topic1, retry_count, max_retries);
-            if (retry_count < max_retries)
-            {
-                // ȴ5
-                vTaskDelay(pdMS_TO_TICKS(5000));
-            }
-        }
+        printf("Menu system initialization failed\r\n");
+        vTaskDelete(NULL);
     }
 
-    if (!sub1_connected)
+    // 创建并初始化首页
+#if MENU_USE_STATIC_TREE
+    menu_item_t *index_menu = menu_tree_init(); // 编译期菜单树，不占用堆
+#else
+    menu_item_t *index_menu = index_init();
+#endif
+    if (index_menu == NULL)
     {
-        printf("Subscribe %s failed after %d attempts, entering retry loop\r\n", topic1, max_retries);
-
-        // ѭ
-        while (!sub1_connected)
-        {
-            vTaskDelay(pdMS_TO_TICKS(30000)); // ÿ30һ
-            printf("Retrying subscribe %s...\r\n", topic1);
-            if (ESP8266_TCP_Subscribe(uid, topic1) == 1)
-            {
-                printf("ESP8266 TCP Subscribe %s Success after retry\r\n", topic1);
-                sub1_connected = 1;
-            }
-        }
+        printf("Index page initialization failed\r\n");
+        vTaskDelete(NULL);
     }
 
-    // ====================== 2myMP25004ԣ ======================
-    retry_count = 0;
-    uint8_t sub2_connected = 0;
-    const char* topic2 = "myMP25004";
-    
-    while (!sub2_connected && retry_count < max_retries)
-    {
-        retry_count++;
-        printf("Subscribe %s attempt %d/%d\r\n", topic2, retry_count, max_retries);
-        
-        if (ESP8266_TCP_Subscribe(uid, topic2) == 1) // 
-        {
-            printf("ESP8266 TCP Subscribe %s Success\r\n", topic2);
-            sub2_connected = 1;
-        }
-        else
-        {
-            printf("ESP8266 TCP Subscribe %s Error, attempt %d/%d\r\n", topic2, retry_count, max_retries);
-            if (retry_count < max_retries)
-            {
-                // ȴ5
-                vTaskDelay(pdMS_TO_TICKS(5000));
-            }
-        }
-    }
+    // 设置首页为根菜单
+    g_menu_sys.root_menu = index_menu;
+    g_menu_sys.current_menu = index_menu;
+    Key_SetEventCallback(menu_key_callback); // 按键中断经定时器消抖后直接投递菜单事件
+    Boot_Mark(BOOT_PHASE_MENU);
 
-    if (!sub2_connected)
-    {
-        printf("Subscribe %s failed after %d attempts, entering retry loop\r\n", topic2, max_retries);
+    Boot_Splash();
+    OLED_Clear();
+    BEEP_Buzz(10);
+    Boot_Mark(BOOT_PHASE_UI_READY);
 
-        // ѭ
-        while (!sub2_connected)
-        {
-            vTaskDelay(pdMS_TO_TICKS(30000)); // ÿ30һ
-            printf("Retrying subscribe %s...\r\n", topic2);
-            if (ESP8266_TCP_Subscribe(uid, topic2) == 1)
-            {
-                printf("ESP8266 TCP Subscribe %s Success after retry\r\n", topic2);
-                sub2_connected = 1;
-            }
-        }
-    }
+    // 菜单任务平时阻塞，由新采样和RTC秒中断唤醒刷新
+    SensorData_SetUpdateCallback(Menu_On_Sample);
+    MyRTC_SetSecondCallback(Menu_On_Second);
 
-    // ====================== 3myLUX004ԣ ======================
-    retry_count = 0;
-    uint8_t sub3_connected = 0;
-    const char* topic3 = "myLUX004";
-    
-    while (!sub3_connected && retry_count < max_retries)
-    {
-        retry_count++;
-        printf("Subscribe %s attempt %d/%d\r\n", topic3, retry_count, max_retries);
-        
-        if (ESP8266_TCP_Subscribe(uid, topic3) == 1) // 
-        {
-            printf("ESP8266 TCP Subscribe %s Success\r\n", topic3);
-            sub3_connected = 1;
-        }
-        else
-        {
-            printf("ESP8266 TCP Subscribe %s Error, attempt %d/%d\r\n", topic3, retry_count, max_retries);
-            if (retry_count < max_retries)
-            {
-                // ȴ5
-                vTaskDelay(pdMS_TO_TICKS(5000));
-            }
-        }
-    }
+    // 直接调用统一菜单框架的任务
+    menu_task(pvParameters);
+}
 
-    if (!sub3_connected)
-    {
-        printf("Subscribe %s failed after %d attempts, entering retry loop\r\n", topic3, max_retries);
+static void ESP8266_Main_Task(void *pvParameters)
+{
+    printf("ESP8266_Main_Task start ->\n");
 
-        // ѭ
-        while (!sub3_connected)
-        {
-            vTaskDelay(pdMS_TO_TICKS(30000)); // ÿ30һ
-            printf("Retrying subscribe %s...\r\n", topic3);
-            if (ESP8266_TCP_Subscribe(uid, topic3) == 1)
-            {
-                printf("ESP8266 TCP Subscribe %s Success after retry\r\n", topic3);
-                sub3_connected = 1;
-            }
-        }
-    }
+#if DEBUG_STACK_CHECK
+    UBaseType_t stack_free_min = (UBaseType_t)-1; // 已报告的最小剩余栈（字）
+#endif
 
-    // ====================== ȡʱ䣨ԣ ======================
-    retry_count = 0;
-    uint8_t get_time_success = 0;
-    char time_buffer[64];
-    
-    while (!get_time_success && retry_count < max_retries)
-    {
-        retry_count++;
-        printf("Get Time attempt %d/%d\r\n", retry_count, max_retries);
-        
-        if (ESP8266_TCP_GetTime(uid, time_buffer, sizeof(time_buffer)) == 1)
-        {
-            printf("ESP8266 Get Time Success: %s\r\n", time_buffer);
-            get_time_success = 1;
-        }
-        else
-        {
-            printf("ESP8266 Get Time Error, attempt %d/%d\r\n", retry_count, max_retries);
-            if (retry_count < max_retries)
-            {
-                // ȴ5
-                vTaskDelay(pdMS_TO_TICKS(5000));
-            }
-        }
-    }
+    // 离线期间按发布周期缓存读数，连接建立前的数据也不丢失
+    Outbox_Init(&publish_delaytime);
 
-    if (!get_time_success)
-    {
-        printf("Get Time failed after %d attempts, entering retry loop\r\n", max_retries);
+    // 初始化UART2，用于ESP8266通信
+    UART2_DMA_RX_Init(CONN_BAUD_DEFAULT); // 连接管理随后协商更高的波特率
+    Boot_Mark(BOOT_PHASE_UART2);
 
-        // ѭ
-        while (!get_time_success)
-        {
-            vTaskDelay(pdMS_TO_TICKS(30000)); // ÿ30һ
-            printf("Retrying Get Time...\r\n");
-            if (ESP8266_TCP_GetTime(uid, time_buffer, sizeof(time_buffer)) == 1)
-            {
-                printf("ESP8266 Get Time Success after retry: %s\r\n", time_buffer);
-                get_time_success = 1;
-            }
-        }
-    }
+    vTaskDelay(pdMS_TO_TICKS(2000)); // 等待ESP8266开机
 
-    // ͬRTC
-    if (RTC_SetFromNetworkTime(time_buffer) != 1)
-    {
-        printf("RTC Sync Failed\r\n");
-    }
-    else
-    {
-        printf("RTC Sync Success\r\n");
-    }
+    static conn_config_t conn_cfg = {
+        .ssid = "ElevatedNetwork.lt",
+        .password = "798798798",
+        .host = "bemfa.com",
+        .port = "8344",
+        .uid = BEMFA_UID,
+    };
+    WiFi_Task_Init(&conn_cfg);
 
     while (1)
     {
-        if ((xTaskGetTickCount() - heart_tick) / 1000 >= 60)
-        {
-            // ƽ̨
-            heart_tick = xTaskGetTickCount();
-            ESP8266_TCP_Heartbeat();
-        }
+        WiFi_Task_Step();
 
-        if ((xTaskGetTickCount() - Publish_tick) / 1000 >= publish_delaytime || first)
-        {
-            printf("---->\r\n");
-            // 
-            Publish_tick = xTaskGetTickCount();
-            first = 0;
-
-            //
-
-            char data[16];
-            //  :mydht004
-            if (DHT11_ON)
-            {
-                snprintf(data, sizeof(data), "on#%d.%d#%d",
-                         SensorData.dht11_data.temp_int,
-                         SensorData.dht11_data.temp_deci,
-                         SensorData.dht11_data.humi_int);
-
-                if (ESP8266_TCP_Publish("4af24e3731744508bd519435397e4ab5", "mydht004", data) != 1) // 
-                {
-                    printf("ESP8266 TCP Publish mydht004 Error\r\n");
-                }
-                else
-                {
-                    printf("ESP8266 TCP Publish mydht004 Success\r\n");
-                }
-            }
-            if (Light_ON)
-            {
-                //  :myLuxGet
-                snprintf(data, sizeof(data), "#%d",
-                         SensorData.light_data.lux);
-
-                if (ESP8266_TCP_Publish("4af24e3731744508bd519435397e4ab5", "myLUX004", data) != 1) // 
-                {
-                    printf("ESP8266 TCP Publish myLuxGet Error\r\n");
-                }
-                else
-                {
-                    printf("ESP8266 TCP Publish myLuxGet Success\r\n");
-                }
-            }
-            if (PM25_ON)
-            {
-                //  : myMP25004
-                snprintf(data, sizeof(data), "#%0.1f#%d",
-                         SensorData.pm25_data.pm25_value,
-                         SensorData.pm25_data.level);
-                if (ESP8266_TCP_Publish("4af24e3731744508bd519435397e4ab5", "myMP25004", data) != 1) // 
-                {
-                    printf("ESP8266 TCP Publish myMP25004 Error\r\n");
-                }
-                else
-                {
-                    printf("ESP8266 TCP Publish myMP25004 Success\r\n");
-                }
-            }
-        }
-        if (uart2_rx_len > 0)
+#if DEBUG_STACK_CHECK
+        // 发布调用链最深，剩余栈创新低时报告，用于核对任务栈大小
+        UBaseType_t stack_free = uxTaskGetStackHighWaterMark(NULL);
+        if (stack_free < stack_free_min)
         {
-            uart2_rx_len = 0;
-            printf("ESP8266 Receive Data: %s\r\n", uart2_buffer); // յͷ·
-            
-            // ʹµͳһϢ
-            uint8_t result = ESP8266_Process_Sensor_Commands((const char *)uart2_buffer);
-            if (result == 1) {
-                printf("Command processed successfully. Current sensor states: DHT11=%d, Light=%d, PM25=%d\r\n", 
-                       DHT11_ON, Light_ON, PM25_ON);
-            } else {
-                printf("No matching sensor command found\r\n");
-            }
-            
+            stack_free_min = stack_free;
+            LOG_D(LOG_MOD_WIFI, "ESP8266 task stack free: %u words", (unsigned)stack_free);
         }
-        vTaskDelay(pdMS_TO_TICKS(1));
+#endif
+        vTaskDelay(pdMS_TO_TICKS(WIFI_TASK_PERIOD_MS));
     }
 }
@@ -0,0 +1,43 @@
+#ifndef _DIAG_PAGE_H_
+#define _DIAG_PAGE_H_
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "unified_menu.h"
+#include "oled_print.h"
+#include "ui_widget.h"
+#include "perf.h"
+
+typedef struct
+{
+   uint8_t selected_page; // 当前查看的统计页面序号
+   // 刷新标志
+   uint8_t need_refresh; // 需要刷新
+   uint32_t last_update; // 上次更新时间
+
+} Diag_state_t;
+
+// 声明静态状态变量，避免动态内存分配
+extern Diag_state_t g_diag_state;
+
+/**
+ * @brief 初始化界面性能诊断页面
+ * @return 创建的诊断菜单项指针
+ */
+menu_item_t *Diag_init(void);
+
+/**
+ * @brief 诊断页自定义绘制函数
+ * @param context 绘制上下文
+ */
+void Diag_draw_function(void *context);
+
+void Diag_key_handler(menu_item_t *item, uint8_t key_event);
+
+void Diag_on_enter(menu_item_t *item);
+
+void Diag_on_exit(menu_item_t *item);
+
+#endif
@@ -8,6 +8,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "sensordata.h"
+#include "ui_widget.h"
 
 // 声明外部传感器状态变量
 extern uint8_t DHT11_ON;
@@ -21,8 +22,9 @@ extern uint8_t PM25_ON;
 
 typedef struct
 {
-   int16_t last_date_L;
+   ui_tween_t lux_bar;   // 光照进度条显示值（lux）
    u8 result;
+   uint8_t last_on;      // 上次绘制时的光照开关状态，0xFF表示尚未绘制
    // 刷新标志
    uint8_t need_refresh; // 需要刷新
    uint32_t last_update; // 上次更新时间
@@ -54,7 +56,4 @@ void Light_on_enter(menu_item_t *item);
 
 void Light_on_exit(menu_item_t *item);
 
-// 光照进度条（line=1）
-void OLED_DrawLightBar_Line1(uint16_t lux);
-
 #endif
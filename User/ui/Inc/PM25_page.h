@@ -8,6 +8,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "sensordata.h"
+#include "ui_widget.h"
 
 // 声明外部传感器状态变量
 extern uint8_t DHT11_ON;
@@ -16,8 +17,9 @@ extern uint8_t PM25_ON;
 
 typedef struct
 {
-   int16_t last_date_PM;
+   ui_tween_t pm25_bar;  // PM2.5进度条显示值（ug/m3）
    u8 result;
+   uint8_t last_on;      // 上次绘制时的PM2.5开关状态，0xFF表示尚未绘制
    // 刷新标志
    uint8_t need_refresh; // 需要刷新
    uint32_t last_update; // 上次更新时间
@@ -49,9 +51,6 @@ void PM25_on_enter(menu_item_t *item);
 
 void PM25_on_exit(menu_item_t *item);
 
-// PM2.5进度条（line=1）
-void OLED_DrawPM25Bar_Line1(uint16_t pm25_value);
-
 // PM2.5等级描述获取函数
 const char* PM25_GetLevelString(uint8_t level);
 
@@ -7,6 +7,7 @@
 #include "queue.h"
 #include "unified_menu.h"
 #include "oled_print.h"
+#include "ui_widget.h"
 #include "esp8266.h"
 #include "sensordata.h"
 
@@ -8,6 +8,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "sensordata.h"
+#include "ui_widget.h"
 
 // 声明外部传感器状态变量
 extern uint8_t DHT11_ON;
@@ -16,9 +17,10 @@ extern uint8_t PM25_ON;
 
 typedef struct
 {
-   int16_t last_date_T;
-   int16_t last_date_H;
+   ui_tween_t temp_bar;  // 温度进度条显示值（0.1°C）
+   ui_tween_t humi_bar;  // 湿度进度条显示值（%）
    u8 result;
+   uint8_t last_on;      // 上次绘制时的DHT11开关状态，0xFF表示尚未绘制
    // 刷新标志
    uint8_t need_refresh; // 需要刷新
    uint32_t last_update; // 上次更新时间
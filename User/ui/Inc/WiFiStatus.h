@@ -7,6 +7,7 @@
 #include "queue.h"
 #include "unified_menu.h"
 #include "oled_print.h"
+#include "ui_widget.h"
 #include "esp8266.h"
 #include "rtc_date.h"
 
@@ -23,7 +24,6 @@ typedef struct
    uint8_t need_refresh;          // 需要刷新
    uint32_t last_update;          // 上次更新时间
    uint32_t last_time_sync;       // 上次时间同步时间
-   char time_buffer[64];          // 时间缓冲区
    
 } WiFiStatus_state_t;
 
@@ -55,6 +55,11 @@ extern index_state_t g_index_state;
 // 函数声明
 // ==================================
 
+/**
+ * @brief 初始化首页状态（不创建菜单项，静态菜单树使用）
+ */
+void index_state_init(void);
+
 /**
  * @brief 初始化首页
  * @return 创建的首页菜单项指针
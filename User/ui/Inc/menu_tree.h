@@ -0,0 +1,28 @@
+/**
+ * @file menu_tree.h
+ * @brief 编译期静态菜单树
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 菜单层次在启动后不再变化，静态菜单树在编译期生成全部菜单项：
+ * 菜单项为静态变量（不占用堆），子项指针表为flash常量表，启动时无需任何分配。
+ * 关闭 MENU_USE_STATIC_TREE 后回退到 index_init() 动态创建菜单。
+ */
+
+#ifndef __MENU_TREE_H
+#define __MENU_TREE_H
+
+#include "unified_menu.h"
+
+#ifndef MENU_USE_STATIC_TREE
+#define MENU_USE_STATIC_TREE    1       // 1-使用静态菜单树 0-运行时动态创建
+#endif
+
+/**
+ * @brief 初始化静态菜单树（只初始化页面状态，不分配内存）
+ * @return 根菜单（首页）
+ */
+menu_item_t *menu_tree_init(void);
+
+#endif // __MENU_TREE_H
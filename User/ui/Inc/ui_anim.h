@@ -0,0 +1,80 @@
+/**
+ * @file ui_anim.h
+ * @brief 基于时间的界面补间动画（定点数 + 缓动曲线）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 补间的当前值只由经过的节拍数决定，与绘制频率无关：无论页面多久重绘一次，
+ * 同一段动画的时长和轨迹都相同。ui_tween_step() 发现动画未结束时置位忙标志，
+ * 菜单任务每轮取走该标志，按 UI_ANIM_FRAME_MS 限定的帧率继续请求重绘，
+ * 没有动画时不产生额外的绘制。
+ */
+
+#ifndef __UI_ANIM_H
+#define __UI_ANIM_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define UI_ANIM_ONE         32768   // Q15 定点数的 1.0
+#define UI_ANIM_FRAME_MS    33      // 动画期间的重绘间隔（约30帧/秒）
+
+// 缓动曲线
+typedef enum {
+    UI_EASE_LINEAR = 0,     // 匀速
+    UI_EASE_OUT_QUAD,       // 先快后慢（二次）
+    UI_EASE_IN_OUT_QUAD,    // 慢-快-慢（二次）
+    UI_EASE_OUT_CUBIC       // 先快后慢（三次），适合数值条
+} ui_ease_t;
+
+// 补间状态
+typedef struct {
+    int32_t from;           // 起点
+    int32_t to;             // 终点
+    int32_t value;          // 当前值
+    TickType_t start;       // 起始节拍
+    TickType_t duration;    // 时长（节拍）
+    uint8_t ease;           // ui_ease_t
+    uint8_t active;         // 1-进行中
+} ui_tween_t;
+
+/**
+ * @brief 缓动曲线求值
+ * @param ease 曲线类型
+ * @param p 进度，Q15（0 ~ UI_ANIM_ONE）
+ * @return 缓动后的进度，Q15
+ */
+uint16_t ui_ease(ui_ease_t ease, uint16_t p);
+
+/**
+ * @brief 初始化补间，当前值设为value，不启动动画
+ * @param duration_ms 每次改变目标后走完全程的时间
+ */
+void ui_tween_init(ui_tween_t *t, int32_t value, uint16_t duration_ms, ui_ease_t ease);
+
+/**
+ * @brief 设置新的目标值，从当前值出发重新开始计时
+ * @note 目标未变化时不重启，可以每帧无条件调用
+ */
+void ui_tween_to(ui_tween_t *t, int32_t target);
+
+/**
+ * @brief 立即跳到指定值并停止动画
+ */
+void ui_tween_jump(ui_tween_t *t, int32_t value);
+
+/**
+ * @brief 按当前节拍推进补间
+ * @return 当前值
+ */
+int32_t ui_tween_step(ui_tween_t *t);
+
+/**
+ * @brief 取走并清除动画忙标志（菜单任务每轮调用一次）
+ * @return 1-上一轮绘制中有补间尚未结束
+ */
+uint8_t ui_anim_take_busy(void);
+
+#endif // __UI_ANIM_H
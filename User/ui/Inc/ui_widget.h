@@ -0,0 +1,144 @@
+/**
+ * @file ui_widget.h
+ * @brief 保留模式控件层（标签/数值/进度条/图标/折线图）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 控件记录自己的矩形区域和上次绘制时的数据值。页面把控件绑定到数据源，
+ * 每帧调用 ui_widgets_update()：只有数据值变化或被标记失效的控件才会
+ * 清除自己的区域、重绘并标记脏区域，未变化的控件不产生显存和总线开销。
+ */
+
+#ifndef __UI_WIDGET_H
+#define __UI_WIDGET_H
+
+#include "stm32f10x.h"
+#include "oled_print.h"
+
+// ==================================
+// 控件类型
+// ==================================
+
+typedef enum {
+    UI_WIDGET_LABEL = 0,    // 文本标签：前缀 + 按数据值从文本表选择的文本
+    UI_WIDGET_VALUE,        // 数值：前缀 + 定点数 + 后缀
+    UI_WIDGET_BAR,          // 进度条
+    UI_WIDGET_ICON,         // 图标：按数据值从图片表选择
+    UI_WIDGET_CHART         // 折线图：数据源变化时记录一个新采样
+} ui_widget_type_t;
+
+typedef struct ui_widget ui_widget_t;
+
+// 数据源：返回控件绑定的当前值（整数或定点数）
+typedef int32_t (*ui_source_t)(void);
+
+// 自定义绘制函数：在控件矩形内绘制value，区域已清除
+// 进度条控件的value为填充像素数（长边方向），其余控件为数据源原值
+typedef void (*ui_render_t)(ui_widget_t *w, int32_t value);
+
+// ==================================
+// 控件结构
+// ==================================
+
+struct ui_widget {
+    uint8_t type;           // ui_widget_type_t
+    uint8_t valid;          // 0-下一帧必须重绘
+    uint8_t x, y, w, h;     // 控件矩形
+    ui_source_t source;     // 数据源，NULL表示静态控件（值恒为0）
+    ui_render_t render;     // 自定义绘制，NULL使用类型默认绘制
+    int32_t last;           // 上次绘制时的值
+
+    union {
+        struct {
+            const char *prefix;         // 固定文本
+            const char *const *texts;   // 按值选择的文本表，可为NULL
+            uint8_t count;              // 文本表长度
+        } label;
+        struct {
+            const char *prefix;
+            const char *suffix;
+            uint8_t frac;               // 小数位数（定点数）
+            uint8_t width;              // 数字最小宽度
+        } value;
+        struct {
+            int32_t min;
+            int32_t max;
+        } bar;
+        struct {
+            const uint8_t *const *bmps; // 按值选择的图片表
+            uint8_t count;
+        } icon;
+        struct {
+            ui_source_t sample;         // 采样值
+            int16_t *buf;               // 历史环形缓冲（调用者提供）
+            uint8_t len;                // 缓冲长度
+            uint8_t head;               // 下一个写入位置
+            uint8_t count;              // 已记录的采样数
+        } chart;
+    } u;
+};
+
+// ==================================
+// 静态定义宏
+// ==================================
+
+#define UI_LABEL(_x, _y, _w, _h, _text) \
+    {.type = UI_WIDGET_LABEL, .x = (_x), .y = (_y), .w = (_w), .h = (_h), \
+     .u = {.label = {(_text), NULL, 0}}}
+
+#define UI_LABEL_SEL(_x, _y, _w, _h, _src, _prefix, _texts) \
+    {.type = UI_WIDGET_LABEL, .x = (_x), .y = (_y), .w = (_w), .h = (_h), .source = (_src), \
+     .u = {.label = {(_prefix), (_texts), (uint8_t)(sizeof(_texts) / sizeof((_texts)[0]))}}}
+
+#define UI_VALUE(_x, _y, _w, _h, _src, _prefix, _frac, _width, _suffix) \
+    {.type = UI_WIDGET_VALUE, .x = (_x), .y = (_y), .w = (_w), .h = (_h), .source = (_src), \
+     .u = {.value = {(_prefix), (_suffix), (_frac), (_width)}}}
+
+#define UI_BAR(_x, _y, _w, _h, _src, _min, _max) \
+    {.type = UI_WIDGET_BAR, .x = (_x), .y = (_y), .w = (_w), .h = (_h), .source = (_src), \
+     .u = {.bar = {(_min), (_max)}}}
+
+#define UI_ICON(_x, _y, _w, _h, _src, _bmps) \
+    {.type = UI_WIDGET_ICON, .x = (_x), .y = (_y), .w = (_w), .h = (_h), .source = (_src), \
+     .u = {.icon = {(_bmps), (uint8_t)(sizeof(_bmps) / sizeof((_bmps)[0]))}}}
+
+// _seq 变化一次记录一个 _sample 采样（如传感器采样计数）
+#define UI_CHART(_x, _y, _w, _h, _seq, _sample, _buf) \
+    {.type = UI_WIDGET_CHART, .x = (_x), .y = (_y), .w = (_w), .h = (_h), .source = (_seq), \
+     .u = {.chart = {(_sample), (_buf), (uint8_t)(sizeof(_buf) / sizeof((_buf)[0])), 0, 0}}}
+
+#define UI_WIDGET_COUNT(arr)    ((uint8_t)(sizeof(arr) / sizeof((arr)[0])))
+
+// ==================================
+// 接口
+// ==================================
+
+/**
+ * @brief 标记控件失效，下一次更新时无条件重绘
+ */
+void ui_widget_invalidate(ui_widget_t *w);
+
+/**
+ * @brief 标记一组控件失效（页面进入/清屏后调用）
+ */
+void ui_widgets_invalidate(ui_widget_t *widgets, uint8_t count);
+
+/**
+ * @brief 更新单个控件：值变化或失效时重绘并标记脏区域
+ * @return 1-已重绘 0-未变化
+ */
+uint8_t ui_widget_update(ui_widget_t *w);
+
+/**
+ * @brief 更新一组控件
+ * @return 本次重绘的控件数
+ */
+uint8_t ui_widgets_update(ui_widget_t *widgets, uint8_t count);
+
+/**
+ * @brief 清空折线图历史
+ */
+void ui_chart_reset(ui_widget_t *w);
+
+#endif // __UI_WIDGET_H
@@ -19,6 +19,8 @@
 #include <stdio.h>
 #include "beep.h"
 #include "debug.h"
+#include "oled_transition.h"
+#include "ui_anim.h"
 // ==================================
 // 菜单类型枚举
 // ==================================
@@ -79,9 +81,12 @@ typedef struct menu_item {
     uint8_t height;                     // 高度
     
     // 状态信息
-    uint8_t is_selected;                // 是否选中
-    uint8_t is_visible;                 // 是否可见
-    uint8_t is_enabled;                 // 是否启用
+    uint8_t is_selected : 1;            // 是否选中
+    uint8_t is_visible : 1;             // 是否可见
+    uint8_t is_enabled : 1;             // 是否启用
+    uint8_t is_static : 1;              // 静态菜单树中的项（不在堆上，不可增删子项/释放）
+    uint8_t transition;                 // 进入时的切换动画(oled_transition_t)，返回时反向播放
+    uint8_t refresh_mask;               // 显示时需要自动重绘的通知(MENU_NOTIFY_DATA/TICK)，0表示只在按键后重绘
     
     // 回调函数
     void (*on_enter)(struct menu_item *item);        // 进入时回调
@@ -91,7 +96,7 @@ typedef struct menu_item {
     
     // 层次关系
     struct menu_item *parent;           // 父菜单
-    struct menu_item **children;         // 子菜单数组
+    struct menu_item *const *children;   // 子菜单数组（静态菜单树中为flash常量表）
     uint8_t child_count;                 // 子菜单数量
     uint8_t selected_child;              // 选中的子项索引
     
@@ -152,12 +157,24 @@ typedef struct {
     // FreeRTOS资源
     QueueHandle_t event_queue;           // 事件队列
     SemaphoreHandle_t display_mutex;     // 显示互斥量
+    TaskHandle_t task_handle;            // 菜单任务句柄（接收任务通知）
     
-    // 按键处理
-    uint32_t last_key_time;              // 上次按键时间
-    uint8_t key_debounce_time;           // 按键去抖时间(ms)
+    // 动画帧请求
+    uint8_t frame_pending;               // 已请求下一帧
+    TickType_t frame_due;                // 下一帧到期时间
 } menu_system_t;
 
+// ==================================
+// 菜单任务通知位
+// ==================================
+
+#define MENU_NOTIFY_EVENT   (1UL << 0)  // 事件队列有新事件
+#define MENU_NOTIFY_DATA    (1UL << 1)  // 传感器完成一轮采样
+#define MENU_NOTIFY_TICK    (1UL << 2)  // RTC秒中断
+#define MENU_NOTIFY_FRAME   (1UL << 3)  // 动画请求下一帧
+
+#define MENU_FRAME_MIN_MS   20          // 动画帧最小间隔(ms)
+
 // ==================================
 // 菜单事件类型
 // ==================================
@@ -176,7 +193,7 @@ typedef enum {
 typedef struct {
     menu_event_type_t type;
     uint32_t timestamp;
-    uint8_t param;
+    uint8_t param;           // 按键事件：key_action_t（按下/松开/长按/连发）
 } menu_event_t;
 
 // ==================================
@@ -238,6 +255,22 @@ int8_t menu_item_set_callbacks(menu_item_t *item,
                                void (*on_select)(menu_item_t*),
                                void (*on_key)(menu_item_t*, uint8_t));
 
+/**
+ * @brief 设置菜单项的切换动画
+ * @param item 菜单项
+ * @param transition 进入该菜单时播放的动画，返回父菜单时自动反向
+ * @return 0-成功，其他-失败
+ */
+int8_t menu_item_set_transition(menu_item_t *item, oled_transition_t transition);
+
+/**
+ * @brief 设置菜单项显示期间的自动重绘条件
+ * @param item 菜单项
+ * @param mask MENU_NOTIFY_DATA/MENU_NOTIFY_TICK 组合，0表示只在按键后重绘
+ * @return 0-成功，其他-失败
+ */
+int8_t menu_item_set_refresh(menu_item_t *item, uint8_t mask);
+
 /**
  * @brief 删除指定的菜单项，并释放内存
  * @param menu 要删除的菜单项指针
@@ -296,6 +329,33 @@ void menu_clear_and_redraw(void);
  */
 int8_t menu_process_event(menu_event_t *event);
 
+/**
+ * @brief 投递菜单事件并唤醒菜单任务
+ * @param event 菜单事件
+ * @return pdPASS-成功，其他-队列已满
+ */
+BaseType_t menu_post_event(const menu_event_t *event);
+
+/**
+ * @brief 唤醒菜单任务（任务上下文）
+ * @param bits MENU_NOTIFY_* 组合
+ */
+void menu_notify(uint32_t bits);
+
+/**
+ * @brief 唤醒菜单任务（中断上下文）
+ * @param bits MENU_NOTIFY_* 组合
+ * @param woken 输出：是否需要在退出中断时切换任务
+ */
+void menu_notify_from_isr(uint32_t bits, BaseType_t *woken);
+
+/**
+ * @brief 请求在指定时间后重绘一帧（动画用）
+ * @param delay_ms 延迟时间，小于 MENU_FRAME_MIN_MS 时按 MENU_FRAME_MIN_MS 处理
+ * @note 只能在菜单任务中调用（绘制函数、按键回调），动画需要每帧重新请求
+ */
+void menu_request_frame(uint32_t delay_ms);
+
 /**
  * @brief 按键转换为菜单事件
  * @param key 按键值
@@ -303,6 +363,15 @@ int8_t menu_process_event(menu_event_t *event);
  */
 menu_event_t menu_key_to_event(uint8_t key);
 
+/**
+ * @brief 按键驱动事件回调，把按键动作投递到菜单事件队列
+ * @param key 键码(1~4)
+ * @param action 按键动作
+ * @param tick 事件发生时的系统节拍
+ * @note 通过 Key_SetEventCallback 注册，在定时器任务中执行
+ */
+void menu_key_callback(uint8_t key, key_action_t action, TickType_t tick);
+
 /**
  * @brief 处理横向菜单按键事件
  * @param menu 当前菜单
@@ -364,12 +433,6 @@ int8_t menu_enter_selected(void);
  */
 void menu_task(void *pvParameters);
 
-/**
- * @brief 按键处理任务
- * @param pvParameters 任务参数
- */
-void menu_key_task(void *pvParameters);
-
 //创建自定义菜单项
 #define MENU_ITEM_CUSTOM(name, draw_func, context) \
     menu_item_create(name, MENU_TYPE_CUSTOM, \
@@ -0,0 +1,241 @@
+#include "Diag_page.h"
+
+// 定义静态状态变量，避免动态内存分配
+Diag_state_t g_diag_state = {0};
+
+// ==================================
+// 静态函数声明
+// ==================================
+static void Diag_display_info(void *context);
+static const perf_page_t *Diag_current_page(void);
+
+// ==================================
+// 控件（每行一项统计：平均/P95/最大，单位ms）
+// ==================================
+
+// 选中页和样本数任一变化都需要重画
+static int32_t Diag_src_metric(perf_metric_t metric)
+{
+  const perf_page_t *pg = Diag_current_page();
+  uint32_t count = (pg != NULL) ? pg->hist[metric].count : 0;
+  return (int32_t)((count & 0x00FFFFFF) | ((uint32_t)g_diag_state.selected_page << 24));
+}
+
+static int32_t Diag_src_header(void)
+{
+  return g_diag_state.selected_page | (Perf_Page_Count() << 8);
+}
+
+static int32_t Diag_src_draw(void)  { return Diag_src_metric(PERF_METRIC_DRAW); }
+static int32_t Diag_src_flush(void) { return Diag_src_metric(PERF_METRIC_FLUSH); }
+static int32_t Diag_src_key(void)   { return Diag_src_metric(PERF_METRIC_KEY); }
+
+static void Diag_render_header(ui_widget_t *w, int32_t value)
+{
+  const perf_page_t *pg = Diag_current_page();
+  char line_buf[22];
+  fmt_buf_t f;
+
+  fmt_init(&f, line_buf, sizeof(line_buf));
+  if (pg == NULL)
+  {
+    fmt_str(&f, "No perf data");
+  }
+  else
+  {
+    fmt_strn(&f, pg->name, 13);
+    fmt_char(&f, ' ');
+    fmt_u32(&f, g_diag_state.selected_page + 1, 0, ' ');
+    fmt_char(&f, '/');
+    fmt_u32(&f, Perf_Page_Count(), 0, ' ');
+  }
+  OLED_ShowString(w->x, w->y, (uint8_t *)line_buf, 12, 1);
+}
+
+/**
+ * @brief 输出一行统计："标签 平均 P95 最大ms"，微秒按0.1ms显示
+ */
+static void Diag_render_metric(ui_widget_t *w, const char *label, perf_metric_t metric)
+{
+  const perf_page_t *pg = Diag_current_page();
+  char line_buf[22];
+  fmt_buf_t f;
+
+  fmt_init(&f, line_buf, sizeof(line_buf));
+  fmt_str(&f, label);
+  if (pg == NULL || pg->hist[metric].count == 0)
+  {
+    fmt_str(&f, " -");
+  }
+  else
+  {
+    const perf_hist_t *h = &pg->hist[metric];
+    fmt_fixed(&f, (int32_t)(h->sum / h->count / 100), 1, 5);
+    fmt_fixed(&f, (int32_t)(Perf_Hist_Percentile(h, 95) / 100), 1, 5);
+    fmt_fixed(&f, (int32_t)(h->max / 100), 1, 5);
+    fmt_str(&f, "ms");
+  }
+  OLED_ShowString(w->x, w->y, (uint8_t *)line_buf, 12, 1);
+}
+
+static void Diag_render_draw(ui_widget_t *w, int32_t value)
+{
+  Diag_render_metric(w, "draw ", PERF_METRIC_DRAW);
+}
+
+static void Diag_render_flush(ui_widget_t *w, int32_t value)
+{
+  Diag_render_metric(w, "flush", PERF_METRIC_FLUSH);
+}
+
+static void Diag_render_key(ui_widget_t *w, int32_t value)
+{
+  Diag_render_metric(w, "key  ", PERF_METRIC_KEY);
+}
+
+static ui_widget_t Diag_widgets[] = {
+  {.type = UI_WIDGET_LABEL, .x = 0, .y = 0, .w = 128, .h = 16,
+   .source = Diag_src_header, .render = Diag_render_header},
+  {.type = UI_WIDGET_LABEL, .x = 0, .y = 16, .w = 128, .h = 16,
+   .source = Diag_src_draw, .render = Diag_render_draw},
+  {.type = UI_WIDGET_LABEL, .x = 0, .y = 32, .w = 128, .h = 16,
+   .source = Diag_src_flush, .render = Diag_render_flush},
+  {.type = UI_WIDGET_LABEL, .x = 0, .y = 48, .w = 128, .h = 16,
+   .source = Diag_src_key, .render = Diag_render_key},
+};
+
+static const perf_page_t *Diag_current_page(void)
+{
+  uint8_t count = Perf_Page_Count();
+
+  if (count == 0)
+  {
+    return NULL;
+  }
+  if (g_diag_state.selected_page >= count)
+  {
+    g_diag_state.selected_page = 0;
+  }
+  return Perf_Page_Get(g_diag_state.selected_page);
+}
+
+/**
+ * @brief 初始化界面性能诊断页面
+ * @return 创建的诊断菜单项指针
+ */
+menu_item_t *Diag_init(void)
+{
+  // 创建自定义菜单项，不分配具体状态数据
+  menu_item_t *Diag_page = MENU_ITEM_CUSTOM("Diagnostics", Diag_draw_function, NULL);
+  if (Diag_page == NULL)
+  {
+    return NULL;
+  }
+
+  menu_item_set_callbacks(Diag_page, Diag_on_enter, Diag_on_exit, NULL, Diag_key_handler);
+
+  printf("Diag_page created successfully\r\n");
+  return Diag_page;
+}
+
+/**
+ * @brief 诊断页自定义绘制函数
+ * @param context 绘制上下文
+ */
+void Diag_draw_function(void *context)
+{
+  Diag_state_t *state = (Diag_state_t *)context;
+  if (state == NULL)
+  {
+    return;
+  }
+
+  Diag_display_info(state);
+
+  OLED_Refresh_Dirty();
+}
+
+void Diag_key_handler(menu_item_t *item, uint8_t key_event)
+{
+  Diag_state_t *state = (Diag_state_t *)item->content.custom.draw_context;
+  uint8_t count = Perf_Page_Count();
+  if (state == NULL) {
+    return;
+  }
+
+  switch (key_event)
+  {
+  case MENU_EVENT_KEY_UP:
+    // KEY0 - 上一个页面的统计
+    if (count > 0)
+    {
+      state->selected_page = (state->selected_page == 0) ? count - 1 : state->selected_page - 1;
+    }
+    break;
+
+  case MENU_EVENT_KEY_DOWN:
+    // KEY1 - 下一个页面的统计
+    if (count > 0)
+    {
+      state->selected_page = (state->selected_page + 1) % count;
+    }
+    break;
+
+  case MENU_EVENT_KEY_SELECT:
+    // KEY2 - 返回上一级
+    menu_back_to_parent();
+    break;
+
+  case MENU_EVENT_KEY_ENTER:
+    // KEY3 - 从调试串口输出全部统计
+    Perf_Dump();
+    break;
+
+  default:
+    break;
+  }
+
+  // 标记需要刷新
+  state->need_refresh = 1;
+}
+
+void Diag_on_enter(menu_item_t *item)
+{
+  printf("Enter Diag page\r\n");
+
+  g_diag_state.need_refresh = 1;
+  g_diag_state.last_update = xTaskGetTickCount();
+
+  // 设置静态状态到菜单项上下文
+  item->content.custom.draw_context = &g_diag_state;
+
+  // 清屏并标记全部控件重画
+  OLED_Clear();
+  ui_widgets_invalidate(Diag_widgets, UI_WIDGET_COUNT(Diag_widgets));
+}
+
+void Diag_on_exit(menu_item_t *item)
+{
+  printf("Exit Diag page\r\n");
+
+  // 清空指针，防止野指针
+  item->content.custom.draw_context = NULL;
+
+  // 清屏
+  OLED_Clear();
+}
+
+// ==================================
+// 显示信息函数
+// ==================================
+
+static void Diag_display_info(void *context)
+{
+  Diag_state_t *state = (Diag_state_t *)context;
+  if (state == NULL) {
+    return;
+  }
+
+  // 样本数变化的行才重画，诊断页自身的绘制对统计影响最小
+  ui_widgets_update(Diag_widgets, UI_WIDGET_COUNT(Diag_widgets));
+}
@@ -1,5 +1,6 @@
 #include "Light_page.h"
 #include "esp8266.h"
+#include "param.h"
 
 // 定义静态状态变量，避免动态内存分配
 Light_state_t g_light_state = {0};
@@ -10,17 +11,58 @@ static void Light_init_sensor_data(Light_state_t *state);
 static void Light_cleanup_sensor_data(Light_state_t *state);
 static void Light_display_info(void *context);
 
-// 光照进度条（line=1）
-void OLED_DrawLightBar_Line1(uint16_t lux)
+// ==================================
+// 控件
+// ==================================
+
+#define LIGHT_BAR_ANIM_MS   800 // 进度条从当前位置移动到新数值的时间
+
+static const char *const Light_level_texts[] = {
+  "Dark", "Dim", "Normal", "Bright", "Very Bright",
+};
+
+// 下标0-白天 1-夜晚
+static const uint8_t *const Light_icons[] = {
+  gImage_sun, gImage_moon,
+};
+
+static int32_t Light_src_lux(void)
+{
+  return SensorData.light_data.lux;
+}
+
+// 光照等级：<50 Dark, <200 Dim, <500 Normal, <2000 Bright, 其余 Very Bright
+static int32_t Light_src_level(void)
+{
+  uint16_t lux = SensorData.light_data.lux;
+
+  if (lux < 50)   return 0;
+  if (lux < 200)  return 1;
+  if (lux < 500)  return 2;
+  if (lux < 2000) return 3;
+  return 4;
+}
+
+static int32_t Light_src_night(void)
+{
+  return SensorData.light_data.lux < 200;
+}
+
+static int32_t Light_src_bar(void)
 {
-  OLED_Clear_Line(1);
-  // 标签
-  OLED_ShowString(0, 16, (uint8_t *)"0", 12, 1);
-  OLED_ShowString(105, 16, (uint8_t *)"987", 12, 1);
-  // 进度条：x=25, y=18, w=78, h=8, 0~5000 lux
-  OLED_DrawProgressBar(22, 18, 78, 8, lux, 0, 987, 1, 1,1);
+  return g_light_state.lux_bar.value;
 }
 
+static ui_widget_t Light_widgets[] = {
+  UI_VALUE(0, 0, 128, 16, Light_src_lux, "Light: ", 0, 0, " lux"),
+  // 光照进度条（line=1）：0~987 lux
+  UI_LABEL(0, 16, 12, 16, "0"),
+  UI_BAR(22, 18, 78, 8, Light_src_bar, 0, 987),
+  UI_LABEL(105, 16, 18, 16, "987"),
+  UI_LABEL_SEL(0, 32, 96, 16, Light_src_level, "Level: ", Light_level_texts),
+  UI_ICON(96, 32, 32, 32, Light_src_night, Light_icons),
+};
+
 /**
  * @brief 初始化光照页面
  * @return 创建的光照菜单项指针
@@ -46,29 +88,36 @@ menu_item_t *Light_init(void)
  */
 void Light_draw_function(void *context)
 {
-  if (Light_ON)
-  {
-     Light_state_t *state = (Light_state_t *)context;
+  Light_state_t *state = (Light_state_t *)context;
   if (state == NULL)
   {
     return;
   }
 
-  // 光照数据由全局SensorData任务定期更新，无需单独读取
+  // 传感器开关切换后整屏重画（进入页面时 on_enter 已清屏）
+  if (state->last_on != Light_ON)
+  {
+    if (state->last_on != 0xFF)
+    {
+      OLED_Clear();
+    }
+    state->last_on = Light_ON;
+    ui_widgets_invalidate(Light_widgets, UI_WIDGET_COUNT(Light_widgets));
 
-  Light_display_info(state);
-   
-  
-  OLED_Refresh_Dirty();
+    if (!Light_ON)
+    {
+      OLED_Puts_Line_32(0, "No Data");
+      OLED_Puts_Line_32(2, "light off");
+    }
   }
-  else
+
+  // 光照数据由全局SensorData任务定期更新，无需单独读取
+  if (Light_ON)
   {
-    OLED_Printf_Line_32(0,"No Data");
-    OLED_Printf_Line_32(2,"light off");
-    OLED_Refresh_Dirty();
+    Light_display_info(state);
   }
-  
- 
+
+  OLED_Refresh_Dirty();
 }
 
 void Light_key_handler(menu_item_t *item, uint8_t key_event)
@@ -83,14 +132,13 @@ void Light_key_handler(menu_item_t *item, uint8_t key_event)
   case MENU_EVENT_KEY_UP:
     // KEY0 - 开启光照传感器
     printf("Light: KEY0 pressed\r\n");
-    Light_ON=1;
+    Param_Set(PARAM_LIGHT_ON, 1);
     break;
 
   case MENU_EVENT_KEY_DOWN:
     // KEY1 - 关闭光照传感器
     printf("Light: KEY1 pressed\r\n");
-    OLED_Clear();
-    Light_ON=0;
+    Param_Set(PARAM_LIGHT_ON, 0);
     break;
 
   case MENU_EVENT_KEY_SELECT:
@@ -195,8 +243,11 @@ static void Light_init_sensor_data(Light_state_t *state)
     // 初始化状态
     state->need_refresh = 1;
     state->last_update = xTaskGetTickCount();
-    state->last_date_L = 0;
+    ui_tween_init(&state->lux_bar, 0, LIGHT_BAR_ANIM_MS, UI_EASE_OUT_CUBIC);
+    state->last_on = 0xFF;
     state->result = 1;
+
+    ui_widgets_invalidate(Light_widgets, UI_WIDGET_COUNT(Light_widgets));
     
     printf("Light state initialized\r\n");
 }
@@ -220,66 +271,11 @@ static void Light_display_info(void *context)
   if (state == NULL) {
     return;
   }
-  
-  OLED_Clear_Line(0);
-  OLED_Printf_Line(0, "Light: %d lux", SensorData.light_data.lux);
-  
-  // 光照等级描述
-  const char* light_desc = "";
-  if (SensorData.light_data.lux < 50) {
-    light_desc = "Dark";
-  } else if (SensorData.light_data.lux < 200) {
-    light_desc = "Dim";
-  } else if (SensorData.light_data.lux < 500) {
-    light_desc = "Normal";
-  } else if (SensorData.light_data.lux < 2000) {
-    light_desc = "Bright";
-  } else {
-    light_desc = "Very Bright";
-  }
-  
-  OLED_Clear_Line(2);
-  OLED_Printf_Line(2, "Level: %s", light_desc);
-  OLED_Clear_Line(3);
-  if (SensorData.light_data.lux < 200)
-  {
-    OLED_ShowPicture(96,32,32,32,gImage_moon,1);
-  }else
-  {
-    OLED_ShowPicture(96,32,32,32,gImage_sun,1);
-  }
-  
-  
-  
-  // 渐进式更新光照显示值，避免突变
-  if (SensorData.light_data.lux > state->last_date_L)
-  {
-    if (SensorData.light_data.lux - state->last_date_L >= 100)
-    {
-      state->last_date_L += 20;
-    }
-    else
-    {
-      state->last_date_L++;
-    }
-  }
-  else if (SensorData.light_data.lux < state->last_date_L)
-  {
-    if (state->last_date_L - SensorData.light_data.lux >= 100)
-    {
-      state->last_date_L -= 20;
-    }
-    else
-    {
-      state->last_date_L--;
-    }
-  }
-  
-  // 确保值不为负
-  if (state->last_date_L < 0) {
-    state->last_date_L = 0;
-  }
-  
-  // 绘制光照进度条
-  OLED_DrawLightBar_Line1(state->last_date_L);
+
+  // 进度条按时间缓动到最新数值，动画期间菜单任务会继续请求重绘
+  ui_tween_to(&state->lux_bar, SensorData.light_data.lux);
+  ui_tween_step(&state->lux_bar);
+
+  // 只重画数值变化的控件
+  ui_widgets_update(Light_widgets, UI_WIDGET_COUNT(Light_widgets));
 }
@@ -1,5 +1,6 @@
 #include "PM25_page.h"
 #include "esp8266.h"
+#include "param.h"
 
 // 定义静态状态变量，避免动态内存分配
 PM25_state_t g_pm25_state = {0};
@@ -10,30 +11,65 @@ static void PM25_init_sensor_data(PM25_state_t *state);
 static void PM25_cleanup_sensor_data(PM25_state_t *state);
 static void PM25_display_info(void *context);
 
-// PM2.5进度条（line=1）
-void OLED_DrawPM25Bar_Line1(uint16_t pm25_value)
+// ==================================
+// 控件
+// ==================================
+
+#define PM25_BAR_ANIM_MS    800 // 进度条从当前位置移动到新数值的时间
+#define PM25_HISTORY_LEN    32  // 趋势图采样数（每点4像素）
+
+// 等级描述，下标为 PM25_LEVEL_xxx，最后一项为未知等级
+static const char *const PM25_level_texts[] = {
+  "Good", "Moderate", "Unhealthy(S)", "Unhealthy", "Very Unh", "Hazardous", "Unknown",
+};
+
+static int16_t PM25_history[PM25_HISTORY_LEN];
+
+static int32_t PM25_src_value(void)
+{
+  return fmt_to_fixed(SensorData.pm25_data.pm25_value, 1);
+}
+
+static int32_t PM25_src_level(void)
+{
+  uint8_t level = SensorData.pm25_data.level;
+  return (level > PM25_LEVEL_HAZARDOUS) ? PM25_LEVEL_HAZARDOUS + 1 : level;
+}
+
+static int32_t PM25_src_bar(void)
+{
+  return g_pm25_state.pm25_bar.value;
+}
+
+static int32_t PM25_src_seq(void)
 {
-  OLED_Clear_Line(1);
-  // 标签
-  OLED_ShowString(0, 16, (uint8_t *)"0", 12, 1);
-  OLED_ShowString(105, 16, (uint8_t *)"300", 12, 1);
-  // 进度条：x=25, y=18, w=78, h=8, 0~300 ug/m3
-  OLED_DrawProgressBar(22, 18, 78, 8, pm25_value, 0, 300, 1, 1,1);
+  return (int32_t)SensorData_GetSampleCount();
 }
 
+static int32_t PM25_src_sample(void)
+{
+  return (int32_t)SensorData.pm25_data.pm25_value;
+}
+
+static ui_widget_t PM25_widgets[] = {
+  UI_VALUE(0, 0, 128, 16, PM25_src_value, "PM2.5: ", 1, 0, " ug/m3"),
+  // PM2.5进度条（line=1）：0~300 ug/m3
+  UI_LABEL(0, 16, 12, 16, "0"),
+  UI_BAR(22, 18, 78, 8, PM25_src_bar, 0, 300),
+  UI_LABEL(105, 16, 18, 16, "300"),
+  UI_LABEL_SEL(0, 32, 128, 16, PM25_src_level, "Quality: ", PM25_level_texts),
+  // 趋势图（line=3）：每轮采样记录一个点
+  UI_CHART(0, 48, 128, 16, PM25_src_seq, PM25_src_sample, PM25_history),
+};
+
 // PM2.5等级描述获取函数
 const char* PM25_GetLevelString(uint8_t level)
 {
-  switch(level)
+  if (level > PM25_LEVEL_HAZARDOUS)
   {
-    case PM25_LEVEL_GOOD: return "Good";
-    case PM25_LEVEL_MODERATE: return "Moderate";
-    case PM25_LEVEL_UNHEALTHY_SENSITIVE: return "Unhealthy(S)";
-    case PM25_LEVEL_UNHEALTHY: return "Unhealthy";
-    case PM25_LEVEL_VERY_UNHEALTHY: return "Very Unh";
-    case PM25_LEVEL_HAZARDOUS: return "Hazardous";
-    default: return "Unknown";
+    level = PM25_LEVEL_HAZARDOUS + 1;
   }
+  return PM25_level_texts[level];
 }
 
 /**
@@ -61,29 +97,36 @@ menu_item_t *PM25_init(void)
  */
 void PM25_draw_function(void *context)
 {
-  if (PM25_ON)
-  {
-     PM25_state_t *state = (PM25_state_t *)context;
+  PM25_state_t *state = (PM25_state_t *)context;
   if (state == NULL)
   {
     return;
   }
 
-  // PM2.5数据由全局SensorData任务定期更新，无需单独读取
+  // 传感器开关切换后整屏重画（进入页面时 on_enter 已清屏）
+  if (state->last_on != PM25_ON)
+  {
+    if (state->last_on != 0xFF)
+    {
+      OLED_Clear();
+    }
+    state->last_on = PM25_ON;
+    ui_widgets_invalidate(PM25_widgets, UI_WIDGET_COUNT(PM25_widgets));
 
-  PM25_display_info(state);
-   
-  
-  OLED_Refresh_Dirty();
+    if (!PM25_ON)
+    {
+      OLED_Puts_Line_32(0, "No Data");
+      OLED_Puts_Line_32(2, "pm25 off");
+    }
   }
-  else
+
+  // PM2.5数据由全局SensorData任务定期更新，无需单独读取
+  if (PM25_ON)
   {
-    OLED_Printf_Line_32(0,"No Data");
-    OLED_Printf_Line_32(2,"pm25 off");
-    OLED_Refresh_Dirty();
+    PM25_display_info(state);
   }
-  
- 
+
+  OLED_Refresh_Dirty();
 }
 
 void PM25_key_handler(menu_item_t *item, uint8_t key_event)
@@ -98,14 +141,13 @@ void PM25_key_handler(menu_item_t *item, uint8_t key_event)
   case MENU_EVENT_KEY_UP:
     // KEY0 - 开启PM2.5传感器
     printf("PM25: KEY0 pressed\r\n");
-    PM25_ON=1;
+    Param_Set(PARAM_PM25_ON, 1);
     break;
 
   case MENU_EVENT_KEY_DOWN:
     // KEY1 - 关闭PM2.5传感器
     printf("PM25: KEY1 pressed\r\n");
-    OLED_Clear();
-    PM25_ON=0;
+    Param_Set(PARAM_PM25_ON, 0);
     break;
 
   case MENU_EVENT_KEY_SELECT:
@@ -210,8 +252,11 @@ static void PM25_init_sensor_data(PM25_state_t *state)
     // 初始化状态
     state->need_refresh = 1;
     state->last_update = xTaskGetTickCount();
-    state->last_date_PM = 0;
+    ui_tween_init(&state->pm25_bar, 0, PM25_BAR_ANIM_MS, UI_EASE_OUT_CUBIC);
+    state->last_on = 0xFF;
     state->result = 1;
+
+    ui_widgets_invalidate(PM25_widgets, UI_WIDGET_COUNT(PM25_widgets));
     
     printf("PM25 state initialized\r\n");
 }
@@ -235,46 +280,11 @@ static void PM25_display_info(void *context)
   if (state == NULL) {
     return;
   }
-  
-  // 显示PM2.5数值，保留一位小数
-  OLED_Clear_Line(0);
-  OLED_Printf_Line(0, "PM2.5: %.1f ug/m3", SensorData.pm25_data.pm25_value);
-  
-  // 显示空气质量等级
-  OLED_Clear_Line(2);
-  OLED_Printf_Line(2, "Quality: %s", PM25_GetLevelString(SensorData.pm25_data.level));
-  OLED_Clear_Line(3);
-  // 渐进式更新PM2.5显示值，避免突变
-  uint16_t current_pm25 = (uint16_t)(SensorData.pm25_data.pm25_value);
-  
-  if (current_pm25 > state->last_date_PM)
-  {
-    if (current_pm25 - state->last_date_PM >= 30)
-    {
-      state->last_date_PM += 10;
-    }
-    else
-    {
-      state->last_date_PM++;
-    }
-  }
-  else if (current_pm25 < state->last_date_PM)
-  {
-    if (state->last_date_PM - current_pm25 >= 30)
-    {
-      state->last_date_PM -= 10;
-    }
-    else
-    {
-      state->last_date_PM--;
-    }
-  }
-  
-  // 确保值不为负
-  if (state->last_date_PM < 0) {
-    state->last_date_PM = 0;
-  }
-  
-  // 绘制PM2.5进度条
-  OLED_DrawPM25Bar_Line1(state->last_date_PM);
+
+  // 进度条按时间缓动到最新数值，动画期间菜单任务会继续请求重绘
+  ui_tween_to(&state->pm25_bar, (int32_t)SensorData.pm25_data.pm25_value);
+  ui_tween_step(&state->pm25_bar);
+
+  // 只重画数值变化的控件
+  ui_widgets_update(PM25_widgets, UI_WIDGET_COUNT(PM25_widgets));
 }
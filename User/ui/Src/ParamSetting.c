@@ -1,8 +1,5 @@
 #include "ParamSetting.h"
-
-// 声明外部变量
-extern uint16_t publish_delaytime;
-extern uint16_t Sensordata_delaytime;
+#include "param.h"
 
 // 定义静态状态变量，避免动态内存分配
 ParamSetting_state_t g_paramsetting_state = {0};
@@ -14,26 +11,81 @@ static void ParamSetting_init_data(ParamSetting_state_t *state);
 static void ParamSetting_cleanup_data(ParamSetting_state_t *state);
 static void ParamSetting_display_info(void *context);
 
-// 发布间隔进度条（line=1）
-void OLED_DrawPublishBar_Line1(uint16_t delay_value)
+// ==================================
+// 控件
+// ==================================
+
+static const char *const ParamSetting_item_texts[] = {
+  "Set Publish Delay", "Set Sensor Delay",
+};
+
+static int32_t ParamSetting_src_publish(void)
 {
-  OLED_Clear_Line(1);
-  // 标签
-  OLED_ShowString(0, 16, (uint8_t *)"5", 12, 1);
-  OLED_ShowString(110, 16, (uint8_t *)"60", 12, 1);
-  // 进度条：x=20, y=18, w=88, h=8, 5~60秒
-  OLED_DrawProgressBar(17, 18, 87, 8, delay_value, 5, 60, 1, 1,1);
+  return g_paramsetting_state.current_publish_delay;
 }
 
-// 传感器间隔进度条（line=3）
-void OLED_DrawSensorBar_Line3(uint16_t delay_value)
+static int32_t ParamSetting_src_sensor(void)
 {
-  OLED_Clear_Line(3);
-  OLED_ShowString(0, 48, (uint8_t *)"1", 12, 1);
-  OLED_ShowString(110, 48, (uint8_t *)"10", 12, 1);
-  OLED_DrawProgressBar(17, 52, 87, 8, delay_value, 1, 10, 1, 1,1);
+  return g_paramsetting_state.current_sensor_delay;
+}
+
+static int32_t ParamSetting_src_selected(void)
+{
+  return g_paramsetting_state.selected_item;
+}
+
+// 标题行同时依赖两个参数和选中项，打包为一个值比较
+static int32_t ParamSetting_src_header(void)
+{
+  return ((int32_t)g_paramsetting_state.selected_item << 16) |
+         ((int32_t)(g_paramsetting_state.current_publish_delay & 0xFF) << 8) |
+         (g_paramsetting_state.current_sensor_delay & 0xFF);
 }
 
+/**
+ * @brief 标题行："[发布]s/传感器s"，方括号标出当前选中的参数
+ */
+static void ParamSetting_render_header(ui_widget_t *w, int32_t value)
+{
+  uint8_t selected = (uint8_t)(value >> 16);
+  uint8_t publish = (uint8_t)(value >> 8);
+  uint8_t sensor = (uint8_t)value;
+  char line_buf[16];
+  fmt_buf_t f;
+
+  fmt_init(&f, line_buf, sizeof(line_buf));
+  if (selected == 0)
+  {
+    fmt_char(&f, '[');
+    fmt_u32(&f, publish, 2, ' ');
+    fmt_str(&f, "]s/");
+    fmt_u32(&f, sensor, 2, ' ');
+    fmt_char(&f, 's');
+  }
+  else
+  {
+    fmt_u32(&f, publish, 2, ' ');
+    fmt_str(&f, "s/[");
+    fmt_u32(&f, sensor, 2, ' ');
+    fmt_str(&f, "]s");
+  }
+  OLED_ShowString(w->x, w->y, (uint8_t *)line_buf, 12, 1);
+}
+
+static ui_widget_t ParamSetting_widgets[] = {
+  {.type = UI_WIDGET_LABEL, .x = 0, .y = 0, .w = 128, .h = 16,
+   .source = ParamSetting_src_header, .render = ParamSetting_render_header},
+  // 发布间隔进度条（line=1）：5~60秒
+  UI_LABEL(0, 16, 12, 16, "5"),
+  UI_BAR(17, 18, 87, 8, ParamSetting_src_publish, 5, 60),
+  UI_LABEL(110, 16, 18, 16, "60"),
+  UI_LABEL_SEL(0, 32, 128, 16, ParamSetting_src_selected, "  ", ParamSetting_item_texts),
+  // 传感器间隔进度条（line=3）：1~10秒
+  UI_LABEL(0, 48, 12, 16, "1"),
+  UI_BAR(17, 52, 87, 8, ParamSetting_src_sensor, 1, 10),
+  UI_LABEL(110, 48, 18, 16, "10"),
+};
+
 /**
  * @brief 初始化参数设置页面
  * @return 创建的参数设置菜单项指针
@@ -81,26 +133,16 @@ void ParamSetting_key_handler(menu_item_t *item, uint8_t key_event)
   {
   case MENU_EVENT_KEY_UP:
     // KEY0 - 增加当前参数值
+    // 范围由参数表检查，修改立即生效并延迟保存到Flash
     if (state->selected_item == 0) {
       // 增加发布间隔
-      
-      if (state->current_publish_delay < 60) {
-        taskENTER_CRITICAL();
-        state->current_publish_delay++;
-        publish_delaytime = state->current_publish_delay;
-         taskEXIT_CRITICAL();
-        printf("Publish delay increased to %d seconds\r\n", state->current_publish_delay);
-       
+      if (Param_Set(PARAM_PUBLISH_S, state->current_publish_delay + 1) == 0) {
+        printf("Publish delay increased to %d seconds\r\n", Param_Get(PARAM_PUBLISH_S));
       }
-
     } else {
       // 增加传感器间隔
-      if (state->current_sensor_delay < 10) {
-         taskENTER_CRITICAL();
-        state->current_sensor_delay++;
-        Sensordata_delaytime = state->current_sensor_delay * 1000;
-        taskEXIT_CRITICAL();
-        printf("Sensor delay increased to %d seconds\r\n", state->current_sensor_delay);
+      if (Param_Set(PARAM_SAMPLE_S, state->current_sensor_delay + 1) == 0) {
+        printf("Sensor delay increased to %d seconds\r\n", Param_Get(PARAM_SAMPLE_S));
       }
     }
     break;
@@ -109,21 +151,13 @@ void ParamSetting_key_handler(menu_item_t *item, uint8_t key_event)
     // KEY1 - 减少当前参数值
     if (state->selected_item == 0) {
       // 减少发布间隔
-      if (state->current_publish_delay > 5) {
-         taskENTER_CRITICAL();
-        state->current_publish_delay--;
-        publish_delaytime = state->current_publish_delay;
-         taskEXIT_CRITICAL();
-        printf("Publish delay decreased to %d seconds\r\n", state->current_publish_delay);
+      if (Param_Set(PARAM_PUBLISH_S, state->current_publish_delay - 1) == 0) {
+        printf("Publish delay decreased to %d seconds\r\n", Param_Get(PARAM_PUBLISH_S));
       }
     } else {
       // 减少传感器间隔
-      if (state->current_sensor_delay > 1) {
-          taskENTER_CRITICAL();
-        state->current_sensor_delay--;
-        Sensordata_delaytime = state->current_sensor_delay * 1000;
-         taskEXIT_CRITICAL();
-        printf("Sensor delay decreased to %d seconds\r\n", state->current_sensor_delay);
+      if (Param_Set(PARAM_SAMPLE_S, state->current_sensor_delay - 1) == 0) {
+        printf("Sensor delay decreased to %d seconds\r\n", Param_Get(PARAM_SAMPLE_S));
       }
     }
     break;
@@ -231,9 +265,11 @@ static void ParamSetting_init_data(ParamSetting_state_t *state)
     state->last_update = xTaskGetTickCount();
     state->selected_item = 0;
     
-    // 从外部变量获取当前值
-    state->current_publish_delay = publish_delaytime;
-    state->current_sensor_delay = Sensordata_delaytime / 1000; // 转换为秒
+    // 从参数表获取当前值
+    state->current_publish_delay = Param_Get(PARAM_PUBLISH_S);
+    state->current_sensor_delay = Param_Get(PARAM_SAMPLE_S);
+
+    ui_widgets_invalidate(ParamSetting_widgets, UI_WIDGET_COUNT(ParamSetting_widgets));
     
     printf("ParamSetting state initialized\r\n");
     printf("Current publish delay: %d seconds\r\n", state->current_publish_delay);
@@ -259,29 +295,11 @@ static void ParamSetting_display_info(void *context)
   if (state == NULL) {
     return;
   }
-  
-  // 根据当前选中的项目显示不同的内容
-  switch (state->selected_item)
-  {
-  case 0: // 设置发布间隔
-    OLED_Clear_Line(1);
-    OLED_Printf_Line(0, "[%2d]s/%2ds", state->current_publish_delay, state->current_sensor_delay);
-    OLED_Clear_Line(2);
-    OLED_Printf_Line(2, "  Set Publish Delay");
-    break;
-  case 1: // 设置传感器间隔
-    OLED_Clear_Line(1);
-    OLED_Printf_Line(0, "%2ds/[%2d]s", state->current_publish_delay, state->current_sensor_delay);
-    OLED_Clear_Line(2);
-    OLED_Printf_Line(2, "  Set Sensor Delay");
-    break;
-  }
-  
-  // 显示操作提示
-  OLED_Printf_Line(3, "KEY0:+ KEY1:- KEY2:OK");
-  OLED_Printf_Line(4, "KEY3:Switch");
-  
-  // 显示进度条
-  OLED_DrawPublishBar_Line1(state->current_publish_delay);
-  OLED_DrawSensorBar_Line3(state->current_sensor_delay);
+
+  // 参数也可能由云端下发修改，每次绘制取最新值
+  state->current_publish_delay = Param_Get(PARAM_PUBLISH_S);
+  state->current_sensor_delay = Param_Get(PARAM_SAMPLE_S);
+
+  // 只重画参数或选中项变化的控件
+  ui_widgets_update(ParamSetting_widgets, UI_WIDGET_COUNT(ParamSetting_widgets));
 }
@@ -1,5 +1,6 @@
 #include "TandH.h"
 #include "esp8266.h"
+#include "param.h"
 
 // 声明外部变量
 extern uint8_t DHT11_ON;
@@ -12,26 +13,45 @@ TandH_state_t g_tandh_state = {0};
 static void TandH_init_sensor_data(TandH_state_t *state);
 static void TandH_cleanup_sensor_data(TandH_state_t *state);
 static void TandH_display_info(void *context);
-// 温度进度条（line=1）
-void OLED_DrawTempBar_Line1(int16_t temp_tenth) // 0.1°C
+// ==================================
+// 控件
+// ==================================
+
+#define TANDH_BAR_ANIM_MS   800 // 进度条从当前位置移动到新数值的时间
+
+static int32_t TandH_src_temp(void)
 {
-  OLED_Clear_Line(1);
-  // 标签
-  OLED_ShowString(0, 16, (uint8_t *)"0", 12, 1);
-  OLED_ShowString(110, 16, (uint8_t *)"50", 12, 1);
-  // 进度条：x=20, y=18, w=88, h=8, 0~500 (0.0~50.0°C)
-  OLED_DrawProgressBar(17, 18, 87, 8, temp_tenth, 0, 500, 1, 1,1);
+  return SensorData.dht11_data.temp_int * 10 + SensorData.dht11_data.temp_deci;
 }
 
-// 湿度进度条（line=3）
-void OLED_DrawHumidityBar_Line3(uint8_t humi)
+static int32_t TandH_src_humi(void)
 {
-  OLED_Clear_Line(3);
-  OLED_ShowString(0, 48, (uint8_t *)"0", 12, 1);
-  OLED_ShowString(110, 48, (uint8_t *)"100", 12, 1);
-  OLED_DrawProgressBar(17, 52, 87, 8, humi, 0, 100, 1, 1,1);
+  return SensorData.dht11_data.humi_int * 10 + SensorData.dht11_data.humi_deci;
 }
 
+static int32_t TandH_src_temp_bar(void)
+{
+  return g_tandh_state.temp_bar.value;
+}
+
+static int32_t TandH_src_humi_bar(void)
+{
+  return g_tandh_state.humi_bar.value;
+}
+
+static ui_widget_t TandH_widgets[] = {
+  UI_VALUE(0, 0, 128, 16, TandH_src_temp, "Temperature:", 1, 0, "C"),
+  // 温度进度条（line=1）：0~500 (0.0~50.0°C)
+  UI_LABEL(0, 16, 12, 16, "0"),
+  UI_BAR(17, 18, 87, 8, TandH_src_temp_bar, 0, 500),
+  UI_LABEL(110, 16, 18, 16, "50"),
+  UI_VALUE(0, 32, 128, 16, TandH_src_humi, "Humidity:  ", 1, 0, "%"),
+  // 湿度进度条（line=3）
+  UI_LABEL(0, 48, 12, 16, "0"),
+  UI_BAR(17, 52, 87, 8, TandH_src_humi_bar, 0, 100),
+  UI_LABEL(110, 48, 18, 16, "100"),
+};
+
 /**
  * @brief 初始化温湿度页面
  * @return 创建的温湿菜单项指针
@@ -57,30 +77,36 @@ menu_item_t *TandH_init(void)
  */
 void TandH_draw_function(void *context)
 {
-
-  if (DHT11_ON)
-  {
-     TandH_state_t *state = (TandH_state_t *)context;
+  TandH_state_t *state = (TandH_state_t *)context;
   if (state == NULL)
   {
     return;
   }
 
-  // 温湿度数据由全局SensorData任务定期更新，无需单独读取
+  // 传感器开关切换后整屏重画（进入页面时 on_enter 已清屏）
+  if (state->last_on != DHT11_ON)
+  {
+    if (state->last_on != 0xFF)
+    {
+      OLED_Clear();
+    }
+    state->last_on = DHT11_ON;
+    ui_widgets_invalidate(TandH_widgets, UI_WIDGET_COUNT(TandH_widgets));
 
-  TandH_display_info(state);
-   
-  
-  OLED_Refresh_Dirty();
+    if (!DHT11_ON)
+    {
+      OLED_Puts_Line_32(0, "No Data");
+      OLED_Puts_Line_32(2, "dht11 off");
+    }
   }
-  else
+
+  // 温湿度数据由全局SensorData任务定期更新，无需单独读取
+  if (DHT11_ON)
   {
-    OLED_Printf_Line_32(0,"No Data");
-    OLED_Printf_Line_32(2,"dht11 off");
-    OLED_Refresh_Dirty();
+    TandH_display_info(state);
   }
-  
- 
+
+  OLED_Refresh_Dirty();
 }
 
 void TandH_key_handler(menu_item_t *item, uint8_t key_event)
@@ -95,14 +121,13 @@ void TandH_key_handler(menu_item_t *item, uint8_t key_event)
   case MENU_EVENT_KEY_UP:
     // KEY0 - 可以用来切换某些状态或进入特定功能
     printf("Index: KEY0 pressed\r\n");
-    DHT11_ON=1;
+    Param_Set(PARAM_DHT11_ON, 1);
     break;
 
   case MENU_EVENT_KEY_DOWN:
     // KEY1 - 可以用来切换某些状态或进入特定功能
     printf("Index: KEY1 pressed\r\n");
-    OLED_Clear();
-    DHT11_ON=0;
+    Param_Set(PARAM_DHT11_ON, 0);
     break;
 
   case MENU_EVENT_KEY_SELECT:
@@ -208,8 +233,12 @@ static void TandH_init_sensor_data(TandH_state_t *state)
     // 初始化状态
     state->need_refresh = 1;
     state->last_update = xTaskGetTickCount();
-    state->last_date_H = 0;
+    ui_tween_init(&state->temp_bar, 0, TANDH_BAR_ANIM_MS, UI_EASE_OUT_CUBIC);
+    ui_tween_init(&state->humi_bar, 0, TANDH_BAR_ANIM_MS, UI_EASE_OUT_CUBIC);
+    state->last_on = 0xFF;
     state->result = 1;
+
+    ui_widgets_invalidate(TandH_widgets, UI_WIDGET_COUNT(TandH_widgets));
     
     printf("TandH state initialized\r\n");
 }
@@ -234,52 +263,13 @@ static void TandH_display_info(void *context)
   if (state == NULL) {
     return;
   }
-  
- 
-      OLED_Clear_Line(3);
-      OLED_Printf_Line(0, "Temperature:%d.%dC ",
-                       SensorData.dht11_data.temp_int,  SensorData.dht11_data.temp_deci);
-      OLED_Printf_Line(2, "Humidity:  %d.%d%%",
-                        SensorData.dht11_data.humi_int, SensorData.dht11_data.humi_deci);
-                       // 横向温度计（支持小数：25.5°C → 255）
-    
 
-    int16_t temp_tenth =  SensorData.dht11_data.temp_int * 10 +  SensorData.dht11_data.temp_deci;
-    if (temp_tenth >state->last_date_T)
-    {
-      
-     if (temp_tenth-state->last_date_T>=30)
-     {
-        state->last_date_T+=10;
-     }
-     
-        state->last_date_T++;
-      
-    }else if (temp_tenth  < state->last_date_T)
-    {
-      
-        state->last_date_T--;
-    
-    }
-      OLED_DrawTempBar_Line1(state->last_date_T);
-
-    if ( SensorData.dht11_data.humi_int>state->last_date_H )
-    {
-      if ( SensorData.dht11_data.humi_int-state->last_date_H>=10)
-      {
-        state->last_date_H+=4;
-      }
-      
-      state->last_date_H++;
-    }else if ( SensorData.dht11_data.humi_int < state->last_date_H  )
-    {
-      state->last_date_H-=3;
-    }
-    
-
-    // 横向湿度条
-    OLED_DrawHumidityBar_Line3(state->last_date_H);
-    
-     
+  // 进度条按时间缓动到最新数值，动画期间菜单任务会继续请求重绘
+  ui_tween_to(&state->temp_bar, TandH_src_temp());
+  ui_tween_to(&state->humi_bar, SensorData.dht11_data.humi_int);
+  ui_tween_step(&state->temp_bar);
+  ui_tween_step(&state->humi_bar);
 
+  // 只重画数值变化的控件
+  ui_widgets_update(TandH_widgets, UI_WIDGET_COUNT(TandH_widgets));
 }
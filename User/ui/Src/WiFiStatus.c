@@ -1,6 +1,7 @@
 #include "WiFiStatus.h"
 #include "esp8266.h"
 #include "rtc_date.h"
+#include "conn_mgr.h"
 
 // 声明外部变量
 extern uint8_t wifi_connected;
@@ -17,6 +18,93 @@ static void WiFiStatus_cleanup_state(WiFiStatus_state_t *state);
 static void WiFiStatus_display_info(void *context);
 static uint8_t WiFiStatus_sync_time(void);
 
+// ==================================
+// 控件：连接状态机状态、断线计数、WiFi/服务器连接状态
+// ==================================
+
+static const char *const WiFiStatus_conn_texts[] = {
+  "Disconnected", "Connected",
+};
+
+static int32_t WiFiStatus_src_wifi(void)
+{
+  return g_wifistatus_state.wifi_status ? 1 : 0;
+}
+
+static int32_t WiFiStatus_src_server(void)
+{
+  return g_wifistatus_state.server_status ? 1 : 0;
+}
+
+// 状态、连续失败次数或重试倒计时变化时重画
+static int32_t WiFiStatus_src_state(void)
+{
+  conn_stats_t st;
+  Conn_GetStats(&st);
+  return (int32_t)(st.state | (st.attempt << 4) | ((st.retry_in_ms / 1000) << 16));
+}
+
+static int32_t WiFiStatus_src_counters(void)
+{
+  conn_stats_t st;
+  Conn_GetStats(&st);
+  return (int32_t)(st.link_drops | (st.heartbeat_failures << 12) | ((uint32_t)st.time_synced << 24));
+}
+
+/**
+ * @brief 输出状态行："tcp down #3 12s"，失败次数和倒计时只在重试等待中显示
+ */
+static void WiFiStatus_render_state(ui_widget_t *w, int32_t value)
+{
+  conn_stats_t st;
+  char line_buf[22];
+  fmt_buf_t f;
+
+  Conn_GetStats(&st);
+  fmt_init(&f, line_buf, sizeof(line_buf));
+  fmt_str(&f, Conn_State_Name(st.state));
+  if (st.attempt > 0)
+  {
+    fmt_str(&f, " #");
+    fmt_u32(&f, st.attempt, 0, ' ');
+  }
+  if (st.retry_in_ms > 0)
+  {
+    fmt_char(&f, ' ');
+    fmt_u32(&f, (st.retry_in_ms + 999) / 1000, 0, ' ');
+    fmt_char(&f, 's');
+  }
+  OLED_ShowString(w->x, w->y, (uint8_t *)line_buf, 12, 1);
+}
+
+/**
+ * @brief 输出计数行："drop 2 hb 1 time OK"
+ */
+static void WiFiStatus_render_counters(ui_widget_t *w, int32_t value)
+{
+  conn_stats_t st;
+  char line_buf[22];
+  fmt_buf_t f;
+
+  Conn_GetStats(&st);
+  fmt_init(&f, line_buf, sizeof(line_buf));
+  fmt_str(&f, "drop ");
+  fmt_u32(&f, st.link_drops, 0, ' ');
+  fmt_str(&f, " hb ");
+  fmt_u32(&f, st.heartbeat_failures, 0, ' ');
+  fmt_str(&f, st.time_synced ? " time OK" : " time --");
+  OLED_ShowString(w->x, w->y, (uint8_t *)line_buf, 12, 1);
+}
+
+static ui_widget_t WiFiStatus_widgets[] = {
+  {.type = UI_WIDGET_LABEL, .x = 0, .y = 0, .w = 128, .h = 16,
+   .source = WiFiStatus_src_state, .render = WiFiStatus_render_state},
+  {.type = UI_WIDGET_LABEL, .x = 0, .y = 16, .w = 128, .h = 16,
+   .source = WiFiStatus_src_counters, .render = WiFiStatus_render_counters},
+  UI_LABEL_SEL(0, 32, 128, 16, WiFiStatus_src_wifi, "WiFi: ", WiFiStatus_conn_texts),
+  UI_LABEL_SEL(0, 48, 128, 16, WiFiStatus_src_server, "Server: ", WiFiStatus_conn_texts),
+};
+
 /**
  * @brief 初始化WiFi状态页面
  * @return 创建的WiFi状态菜单项指针
@@ -49,8 +137,11 @@ void WiFiStatus_draw_function(void *context)
   }
 
   // 更新连接状态
+  conn_stats_t st;
+  Conn_GetStats(&st);
   state->wifi_status = wifi_connected;
   state->server_status = Server_connected;
+  state->time_sync_status = st.time_synced;
 
   WiFiStatus_display_info(state);
 
@@ -67,17 +158,16 @@ void WiFiStatus_key_handler(menu_item_t *item, uint8_t key_event)
   switch (key_event)
   {
   case MENU_EVENT_KEY_UP:
-    // KEY0 - 手动尝试同步时间
-    printf("WiFiStatus: KEY0 pressed - Attempt time sync\r\n");
-    if (state->wifi_status && state->server_status) {
-      WiFiStatus_sync_time();
-    }
+    // KEY0 - 请求重新对时（由ESP8266任务执行，不阻塞界面）
+    printf("WiFiStatus: KEY0 pressed - Request time sync\r\n");
+    WiFiStatus_sync_time();
     break;
 
   case MENU_EVENT_KEY_DOWN:
     // KEY1 - 刷新显示
     printf("WiFiStatus: KEY1 pressed - Refresh display\r\n");
     OLED_Clear();
+    ui_widgets_invalidate(WiFiStatus_widgets, UI_WIDGET_COUNT(WiFiStatus_widgets));
     state->need_refresh = 1;
     break;
 
@@ -135,16 +225,9 @@ void WiFiStatus_on_enter(menu_item_t *item)
   // 设置静态状态到菜单项上下文
   item->content.custom.draw_context = &g_wifistatus_state;
   
-  // 清屏并标记需要刷新
+  // 清屏并标记需要刷新（上线后由连接管理自动对时，无需在此同步）
   OLED_Clear();
   g_wifistatus_state.need_refresh = 1;
-  
-  // 如果WiFi和服务器已连接，尝试同步时间
-  if (g_wifistatus_state.wifi_status && g_wifistatus_state.server_status && 
-      !g_wifistatus_state.time_sync_attempted) {
-    printf("WiFi and Server connected, attempting time sync...\r\n");
-    WiFiStatus_sync_time();
-  }
 }
 
 void WiFiStatus_on_exit(menu_item_t *item)
@@ -193,6 +276,8 @@ static void WiFiStatus_init_state(WiFiStatus_state_t *state)
     state->need_refresh = 1;
     state->last_update = xTaskGetTickCount();
     state->last_time_sync = 0;
+
+    ui_widgets_invalidate(WiFiStatus_widgets, UI_WIDGET_COUNT(WiFiStatus_widgets));
     
     printf("WiFiStatus state initialized\r\n");
 }
@@ -215,90 +300,25 @@ static void WiFiStatus_cleanup_state(WiFiStatus_state_t *state)
 // ==================================
 
 /**
- * @brief 同步时间函数
- * @return 1-成功，0-失败
+ * @brief 请求重新对时
+ * @return 1-已提交请求，0-TCP未建立
+ * @note 对时由ESP8266任务中的连接管理执行，结果在计数行显示
  */
 static uint8_t WiFiStatus_sync_time(void)
 {
     WiFiStatus_state_t *state = &g_wifistatus_state;
-    
+
     // 标记已尝试同步
     state->time_sync_attempted = 1;
-    state->time_sync_status = 0;
-    
-    // 检查连接状态
-    if (!state->wifi_status || !state->server_status) {
+
+    if (!Conn_Is_Up()) {
         printf("WiFiStatus: Cannot sync time - WiFi or Server not connected\r\n");
         return 0;
     }
-    
-    // ====================== 获取时间（带重试） ======================
-    uint8_t retry_count = 0;
-    uint8_t max_retries = 3;
-    uint8_t get_time_success = 0;
-    
-    printf("WiFiStatus: Starting time sync...\r\n");
-    
-    while (!get_time_success && retry_count < max_retries)
-    {
-        retry_count++;
-        printf("WiFiStatus: Get Time attempt %d/%d\r\n", retry_count, max_retries);
-        OLED_Printf_Line(0, " Get Time attempt %d/%d", retry_count, max_retries);
-        OLED_Printf_Line(1, " getting ...");
-        if (ESP8266_TCP_GetTime("1", state->time_buffer, sizeof(state->time_buffer)) == 1)
-        {
-            printf("WiFiStatus: ESP8266 Get Time Success: %s\r\n", state->time_buffer);
-            OLED_Printf_Line(0, " Get Time Success");
-                OLED_Printf_Line(1, " %s", state->time_buffer);
-            get_time_success = 1;
-        }
-        else
-        {
-            printf("WiFiStatus: ESP8266 Get Time Error, attempt %d/%d\r\n", retry_count, max_retries);
-            if (retry_count < max_retries)
-            {
-                // 等待5秒后重试
-                vTaskDelay(pdMS_TO_TICKS(5000));
-            }
-        }
-    }
-
-    if (!get_time_success)
-    {
-        printf("WiFiStatus: Get Time failed after %d attempts, entering retry loop\r\n", max_retries);
-
-        // 进入无限重试循环
-        while (!get_time_success)
-        {
-            vTaskDelay(pdMS_TO_TICKS(30000)); // 每30秒重试一次
-            printf("WiFiStatus: Retrying Get Time...\r\n");
-            if (ESP8266_TCP_GetTime("1", state->time_buffer, sizeof(state->time_buffer)) == 1)
-            {
-                
-                printf("WiFiStatus: ESP8266 after retry: %s\r\n", state->time_buffer);
-                
-                get_time_success = 1;
-            }
-        }
-    }
 
-    // 同步到RTC
-    if (RTC_SetFromNetworkTime(state->time_buffer) != 1)
-    {
-       
-        OLED_Printf_Line(0," RTC Sync Failed");
-        printf("WiFiStatus: RTC Sync Failed\r\n");
-        state->time_sync_status = 0;
-        return 0;
-    }
-    else
-    {
-        OLED_Printf_Line(0," RTC Sync Success");
-        printf("WiFiStatus: RTC Sync Success\r\n");
-        state->time_sync_status = 1;
-        state->last_time_sync = xTaskGetTickCount();
-        return 1;
-    }
+    Conn_Request_Time_Sync();
+    printf("WiFiStatus: Time sync requested\r\n");
+    return 1;
 }
 
 // ==================================
@@ -311,28 +331,7 @@ static void WiFiStatus_display_info(void *context)
   if (state == NULL) {
     return;
   }
-  
- 
-  
-  // 显示WiFi连接状态
-  OLED_Printf_Line(2, "WiFi: %s", state->wifi_status ? "Connected" : "Disconnected");
-  
-  // 显示服务器连接状态
-  OLED_Printf_Line(3, "Server: %s", state->server_status ? "Connected" : "Disconnected");
-  
-  // 显示时间同步状态
-  if (state->time_sync_attempted) {
-    OLED_Printf_Line(4, "Time Sync: %s", state->time_sync_status ? "Success" : "Failed");
-  } else {
-    OLED_Printf_Line(4, "Time Sync: Not Attempted");
-  }
-  
-  // 显示时间信息
-  if (state->time_sync_status && strlen(state->time_buffer) > 0) {
-    OLED_Printf_Line(5, "Time: %s", state->time_buffer);
-  }
-  
-  // 显示操作提示
-  OLED_Printf_Line(6, "KEY0: Sync KEY1: Refresh");
-  OLED_Printf_Line(7, "KEY2: Back");
+
+  // WiFi/服务器连接状态，只在状态变化时重画
+  ui_widgets_update(WiFiStatus_widgets, UI_WIDGET_COUNT(WiFiStatus_widgets));
 }
@@ -31,7 +31,7 @@ static void index_scroll_to_offset(uint8_t target_offset);
 // 首页实现
 // ==================================
 
-menu_item_t *index_init(void)
+void index_state_init(void)
 {
     // 初始化首页状态
     memset(&g_index_state, 0, sizeof(index_state_t));
@@ -43,8 +43,12 @@ menu_item_t *index_init(void)
     g_index_state.scroll_direction = 0;
     g_index_state.scroll_step = 0;
      
-    // 初始化RTC
-    MyRTC_Init();
+    // RTC 由启动流程在独立任务中初始化（见 boot.c）
+}
+
+menu_item_t *index_init(void)
+{
+    index_state_init();
 
     // 创建首页菜单项
     menu_item_t *index_menu = MENU_ITEM_CUSTOM("Index", index_draw_function, &g_index_state);
@@ -56,6 +60,9 @@ menu_item_t *index_init(void)
     // 设置回调函数
     menu_item_set_callbacks(index_menu, index_on_enter, index_on_exit, NULL, index_key_handler);
 
+    // 时钟每秒刷新，传感器数据采样后刷新
+    menu_item_set_refresh(index_menu, MENU_NOTIFY_TICK | MENU_NOTIFY_DATA);
+
     // 创建并添加主菜单作为子菜单
     menu_item_t *main_menu = main_menu_init();
     if (main_menu != NULL)
@@ -206,9 +213,6 @@ static void index_update_scroll(void)
             state->scroll_offset = 64 - (state->scroll_step * 8);
         }
         index_refresh_display();
-        // 调试信息
-        // printf("Scroll step %d, direction %d, offset %d\r\n",
-        //        state->scroll_step, state->scroll_direction, state->scroll_offset);
 
         state->need_refresh = 1;
 
@@ -224,9 +228,11 @@ static void index_update_scroll(void)
                 state->scroll_offset = 0;
             }
             state->scroll_direction = 0;
-            // 任何滚动完成后都强制清屏，确保内容正确显示
-            // OLED_Clear();
-            // printf("Scroll completed, final offset: %d\r\n", state->scroll_offset);
+        }
+        else
+        {
+            // 菜单任务按通知阻塞，滚动未完成时请求下一帧
+            menu_request_frame(UI_ANIM_FRAME_MS);
         }
     }
 }
@@ -260,6 +266,7 @@ static void index_scroll_to_offset(uint8_t target_offset)
 
     state->scroll_step = 0;
     state->need_refresh = 1;
+    g_menu_sys.need_refresh = 1;
 }
 
 static void index_display_time_info(void)
@@ -309,79 +316,80 @@ static void index_display_time_info(void)
         OLED_Refresh_Dirty();
     }
 
-    OLED_Printf(x_offset, 0, "%02d/%02d/%02d",
-                g_index_state.year,
-                g_index_state.month,
-                g_index_state.day);
-
-    OLED_Printf(x_offset, 16, " %02d:%02d:%02d",
-                g_index_state.hours,
-                g_index_state.minutes,
-                g_index_state.seconds
-
-    );
+    char line_buf[16];
+    fmt_buf_t f;
+
+    fmt_init(&f, line_buf, sizeof(line_buf));
+    fmt_2d(&f, g_index_state.year);
+    fmt_char(&f, '/');
+    fmt_2d(&f, g_index_state.month);
+    fmt_char(&f, '/');
+    fmt_2d(&f, g_index_state.day);
+    OLED_Puts(x_offset, 0, line_buf);
+
+    fmt_init(&f, line_buf, sizeof(line_buf));
+    fmt_char(&f, ' ');
+    fmt_2d(&f, g_index_state.hours);
+    fmt_char(&f, ':');
+    fmt_2d(&f, g_index_state.minutes);
+    fmt_char(&f, ':');
+    fmt_2d(&f, g_index_state.seconds);
+    OLED_Puts(x_offset, 16, line_buf);
+
+    OLED_Puts(x_offset, 32, wifi_connected ? " wifi:OK   " : " wifi:NO   ");
+    OLED_Puts(x_offset, 48, Server_connected ? "Server:OK " : "Server:NO ");
 
-   
-        OLED_Printf(x_offset, 32, " wifi:%s   ",
-
-                    wifi_connected ? "OK" : "NO"
-            );
-    
-
-    
-        OLED_Printf(x_offset, 48, "Server:%s ",
-                    Server_connected ? "OK" : "NO"
-                );
-   
-        
-   
     // 应用滚动偏移显示内容
 
     if (x_offset == 0)
     {
         if (DHT11_ON&&!DHT11_ERR)
         {
-
-            OLED_Printf(64, 0, " T : %2d.%1d",
-                        SensorData.dht11_data.temp_int,
-                        SensorData.dht11_data.temp_deci);
-            OLED_Printf(64, 16, " H : %2d",
-                        SensorData.dht11_data.humi_int);
+            fmt_init(&f, line_buf, sizeof(line_buf));
+            fmt_str(&f, " T : ");
+            fmt_u32(&f, SensorData.dht11_data.temp_int, 2, ' ');
+            fmt_char(&f, '.');
+            fmt_u32(&f, SensorData.dht11_data.temp_deci, 1, '0');
+            OLED_Puts(64, 0, line_buf);
+
+            fmt_init(&f, line_buf, sizeof(line_buf));
+            fmt_str(&f, " H : ");
+            fmt_u32(&f, SensorData.dht11_data.humi_int, 2, ' ');
+            OLED_Puts(64, 16, line_buf);
         }
         else
         {
-            OLED_Printf(64, 0, " T : %s",DHT11_ERR?"ERR":"OFF");
+            OLED_Puts(64, 0, DHT11_ERR ? " T : ERR" : " T : OFF");
 
-            OLED_Printf(64, 16, " H : %s",DHT11_ERR?"ERR":"OFF");
+            OLED_Puts(64, 16, DHT11_ERR ? " H : ERR" : " H : OFF");
         }
     //light
      if (Light_ON&&!Light_ERR)
     {
-        OLED_Printf(64, 32, " L : %2d ",
-
-                
-                    SensorData.light_data.lux);
+        fmt_init(&f, line_buf, sizeof(line_buf));
+        fmt_str(&f, " L : ");
+        fmt_u32(&f, SensorData.light_data.lux, 2, ' ');
+        fmt_char(&f, ' ');
+        OLED_Puts(64, 32, line_buf);
     }
     else
     {
-        OLED_Printf(64, 32, " L : %s ",Light_ERR?"ERR":"OFF");
+        OLED_Puts(64, 32, Light_ERR ? " L : ERR " : " L : OFF ");
     }
     //pm25
     if (PM25_ON&&!PM25_ERR)
     {
-        OLED_Printf(64, 48, " P : %3.1f ",
-                   
-                    SensorData.pm25_data.pm25_value);
+        fmt_init(&f, line_buf, sizeof(line_buf));
+        fmt_str(&f, " P : ");
+        fmt_fixed(&f, fmt_to_fixed(SensorData.pm25_data.pm25_value, 1), 1, 3);
+        fmt_char(&f, ' ');
+        OLED_Puts(64, 48, line_buf);
     }
     else
     {
-        OLED_Printf(64, 48, " P : %s ",PM25_ERR?"ERR":"OFF");
+        OLED_Puts(64, 48, PM25_ERR ? " P : ERR " : " P : OFF ");
     }
     }
-
-   
-
-    
 }
 
 static void index_display_status_info(void)
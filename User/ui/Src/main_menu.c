@@ -17,6 +17,7 @@
 #include "PM25_page.h"
 #include "WiFiStatus.h"
 #include "ParamSetting.h"
+#include "Diag_page.h"
 // ==================================
 // 图标数组
 // ==================================
@@ -61,12 +62,15 @@ menu_item_t *main_menu_init(void)
                             main_menu_on_exit,  // 退出回调
                             NULL,               // 选中回调（不需要特殊处理）
                             NULL);              // 按键处理
+    menu_item_set_transition(main_menu, OLED_TRANS_SLIDE_UP);
 
     menu_item_t *TandH_page = TandH_init();
     if (TandH_page != NULL)
     {
 
         TandH_page->content.custom.icon_data = gImage_TandH;
+        menu_item_set_transition(TandH_page, OLED_TRANS_SLIDE_UP);
+        menu_item_set_refresh(TandH_page, MENU_NOTIFY_DATA);
         menu_add_child(main_menu, TandH_page);
     }
 
@@ -74,6 +78,8 @@ menu_item_t *main_menu_init(void)
     if (Light_page != NULL)
     {
         Light_page->content.custom.icon_data = gImage_lightQD;
+        menu_item_set_transition(Light_page, OLED_TRANS_SLIDE_UP);
+        menu_item_set_refresh(Light_page, MENU_NOTIFY_DATA);
         menu_add_child(main_menu, Light_page);
     }
 
@@ -81,6 +87,8 @@ menu_item_t *main_menu_init(void)
     if (PM25_page != NULL)
     {
         PM25_page->content.custom.icon_data = gImage_pm25; // 使用test图标作为占位符
+        menu_item_set_transition(PM25_page, OLED_TRANS_SLIDE_UP);
+        menu_item_set_refresh(PM25_page, MENU_NOTIFY_DATA);
         menu_add_child(main_menu, PM25_page);
     }
 
@@ -98,6 +106,8 @@ menu_item_t *main_menu_init(void)
     if (WiFiStatus_page != NULL)
     {
         WiFiStatus_page->content.custom.icon_data = gImage_wifi;
+        menu_item_set_transition(WiFiStatus_page, OLED_TRANS_SLIDE_UP);
+        menu_item_set_refresh(WiFiStatus_page, MENU_NOTIFY_TICK); // 连接状态由ESP任务更新，每秒刷新
         menu_add_child(main_menu, WiFiStatus_page);
     }
 
@@ -106,9 +116,20 @@ menu_item_t *main_menu_init(void)
     if (ParamSetting_page != NULL)
     {
         ParamSetting_page->content.custom.icon_data = gImage_setting;
+        menu_item_set_transition(ParamSetting_page, OLED_TRANS_SLIDE_UP);
         menu_add_child(main_menu, ParamSetting_page);
     }
 
+    // 添加界面性能诊断页面
+    menu_item_t *Diag_page = Diag_init();
+    if (Diag_page != NULL)
+    {
+        Diag_page->content.custom.icon_data = gImage_test;
+        menu_item_set_transition(Diag_page, OLED_TRANS_SLIDE_UP);
+        menu_item_set_refresh(Diag_page, MENU_NOTIFY_TICK); // 统计持续累积，每秒刷新
+        menu_add_child(main_menu, Diag_page);
+    }
+
     return main_menu;
 }
 
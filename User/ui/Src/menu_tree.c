@@ -0,0 +1,136 @@
+/**
+ * @file menu_tree.c
+ * @brief 编译期静态菜单树实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "menu_tree.h"
+#include "index.h"
+#include "main_menu.h"
+#include "TandH.h"
+#include "Light_page.h"
+#include "PM25_page.h"
+#include "WiFiStatus.h"
+#include "ParamSetting.h"
+#include "Diag_page.h"
+
+// ==================================
+// 主菜单页面表
+// ==================================
+
+// X(标识, 名称, 绘制函数, 进入回调, 退出回调, 按键回调, 图标, 自动重绘条件)
+#define MAIN_MENU_PAGES(X)                                                                                  \
+    X(TandH, "Temp&Humid", TandH_draw_function, TandH_on_enter, TandH_on_exit, TandH_key_handler,           \
+      gImage_TandH, MENU_NOTIFY_DATA)                                                                       \
+    X(Light, "Light", Light_draw_function, Light_on_enter, Light_on_exit, Light_key_handler,                \
+      gImage_lightQD, MENU_NOTIFY_DATA)                                                                     \
+    X(PM25, "PM2.5", PM25_draw_function, PM25_on_enter, PM25_on_exit, PM25_key_handler,                     \
+      gImage_pm25, MENU_NOTIFY_DATA)                                                                        \
+    X(WiFiStatus, "WiFi Status", WiFiStatus_draw_function, WiFiStatus_on_enter, WiFiStatus_on_exit,         \
+      WiFiStatus_key_handler, gImage_wifi, MENU_NOTIFY_TICK)                                                \
+    X(ParamSetting, "ParamSetting", ParamSetting_draw_function, ParamSetting_on_enter, ParamSetting_on_exit, \
+      ParamSetting_key_handler, gImage_setting, 0)                                                         \
+    X(Diag, "Diagnostics", Diag_draw_function, Diag_on_enter, Diag_on_exit, Diag_key_handler,              \
+      gImage_test, MENU_NOTIFY_TICK)
+
+// ==================================
+// 菜单项声明
+// ==================================
+
+#define MENU_TREE_PAGE_DECLARE(id, name, draw, enter, exit, key, icon, refresh) \
+    static menu_item_t menu_page_##id;
+MAIN_MENU_PAGES(MENU_TREE_PAGE_DECLARE)
+
+static menu_item_t menu_index;
+static menu_item_t menu_main;
+
+// ==================================
+// 子项表（flash）
+// ==================================
+
+#define MENU_TREE_PAGE_REF(id, name, draw, enter, exit, key, icon, refresh) &menu_page_##id,
+
+static menu_item_t *const menu_main_children[] = {
+    MAIN_MENU_PAGES(MENU_TREE_PAGE_REF)
+};
+
+static menu_item_t *const menu_index_children[] = {
+    &menu_main,
+};
+
+#define MENU_TREE_COUNT(table) ((uint8_t)(sizeof(table) / sizeof((table)[0])))
+
+// ==================================
+// 菜单项定义
+// ==================================
+
+// 首页：时钟每秒刷新，传感器数据采样后刷新
+static menu_item_t menu_index = {
+    .name = "Index",
+    .type = MENU_TYPE_CUSTOM,
+    .content = {.custom = {index_draw_function, &g_index_state}},
+    .width = 128,
+    .height = 16,
+    .is_visible = 1,
+    .is_enabled = 1,
+    .is_static = 1,
+    .refresh_mask = MENU_NOTIFY_TICK | MENU_NOTIFY_DATA,
+    .on_enter = index_on_enter,
+    .on_exit = index_on_exit,
+    .on_key = index_key_handler,
+    .children = menu_index_children,
+    .child_count = MENU_TREE_COUNT(menu_index_children),
+};
+
+// 主菜单（横向图标菜单）
+static menu_item_t menu_main = {
+    .name = "Main Menu",
+    .type = MENU_TYPE_HORIZONTAL_ICON,
+    .width = 32,
+    .height = 32,
+    .is_visible = 1,
+    .is_enabled = 1,
+    .is_static = 1,
+    .transition = OLED_TRANS_SLIDE_UP,
+    .on_enter = main_menu_on_enter,
+    .on_exit = main_menu_on_exit,
+    .parent = &menu_index,
+    .children = menu_main_children,
+    .child_count = MENU_TREE_COUNT(menu_main_children),
+};
+
+// 主菜单下的自定义页面，状态由各页面 on_enter 绑定到 draw_context
+#define MENU_TREE_PAGE_DEFINE(id, page_name, draw, enter, exit, key, icon, refresh) \
+    static menu_item_t menu_page_##id = {                                           \
+        .name = page_name,                                                          \
+        .type = MENU_TYPE_CUSTOM,                                                   \
+        .content = {.custom = {draw, NULL, icon, NULL}},                            \
+        .width = 128,                                                               \
+        .height = 16,                                                               \
+        .is_visible = 1,                                                            \
+        .is_enabled = 1,                                                            \
+        .is_static = 1,                                                             \
+        .transition = OLED_TRANS_SLIDE_UP,                                          \
+        .refresh_mask = refresh,                                                    \
+        .on_enter = enter,                                                          \
+        .on_exit = exit,                                                            \
+        .on_key = key,                                                              \
+        .parent = &menu_main,                                                       \
+    };
+MAIN_MENU_PAGES(MENU_TREE_PAGE_DEFINE)
+
+// ==================================
+// 接口实现
+// ==================================
+
+menu_item_t *menu_tree_init(void)
+{
+    index_state_init();
+
+    printf("Static menu tree: %d pages, 0 bytes heap\r\n",
+           MENU_TREE_COUNT(menu_main_children) + 2);
+
+    return &menu_index;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file ui_anim.c
+ * @brief 基于时间的界面补间动画实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "ui_anim.h"
+
+static uint8_t ui_anim_busy = 0;    // 本轮绘制中有补间未结束
+
+// ==================================
+// 缓动曲线（Q15）
+// ==================================
+
+uint16_t ui_ease(ui_ease_t ease, uint16_t p)
+{
+    uint32_t inv;
+
+    if (p >= UI_ANIM_ONE)
+    {
+        return UI_ANIM_ONE;
+    }
+
+    switch (ease)
+    {
+    case UI_EASE_OUT_QUAD:
+        // 1 - (1-p)^2
+        inv = UI_ANIM_ONE - p;
+        return (uint16_t)(UI_ANIM_ONE - ((inv * inv) >> 15));
+
+    case UI_EASE_IN_OUT_QUAD:
+        // 前半段 2p^2，后半段 1 - 2(1-p)^2
+        if (p < UI_ANIM_ONE / 2)
+        {
+            return (uint16_t)(((uint32_t)p * p) >> 14);
+        }
+        inv = UI_ANIM_ONE - p;
+        return (uint16_t)(UI_ANIM_ONE - ((inv * inv) >> 14));
+
+    case UI_EASE_OUT_CUBIC:
+        // 1 - (1-p)^3
+        inv = UI_ANIM_ONE - p;
+        return (uint16_t)(UI_ANIM_ONE - ((((inv * inv) >> 15) * inv) >> 15));
+
+    case UI_EASE_LINEAR:
+    default:
+        return p;
+    }
+}
+
+// ==================================
+// 补间
+// ==================================
+
+void ui_tween_init(ui_tween_t *t, int32_t value, uint16_t duration_ms, ui_ease_t ease)
+{
+    t->from = value;
+    t->to = value;
+    t->value = value;
+    t->start = 0;
+    t->duration = pdMS_TO_TICKS(duration_ms);
+    t->ease = (uint8_t)ease;
+    t->active = 0;
+}
+
+void ui_tween_to(ui_tween_t *t, int32_t target)
+{
+    if (target == t->to)
+    {
+        return;
+    }
+
+    // 从当前位置平滑转向新目标
+    ui_tween_step(t);
+    t->from = t->value;
+    t->to = target;
+    t->start = xTaskGetTickCount();
+    t->active = (t->value != target && t->duration > 0);
+    if (!t->active)
+    {
+        t->value = target;
+    }
+}
+
+void ui_tween_jump(ui_tween_t *t, int32_t value)
+{
+    t->from = value;
+    t->to = value;
+    t->value = value;
+    t->active = 0;
+}
+
+int32_t ui_tween_step(ui_tween_t *t)
+{
+    TickType_t elapsed;
+
+    if (!t->active)
+    {
+        return t->value;
+    }
+
+    elapsed = xTaskGetTickCount() - t->start;
+    if (elapsed >= t->duration)
+    {
+        t->value = t->to;
+        t->active = 0;
+        return t->value;
+    }
+
+    uint16_t p = (uint16_t)(((uint32_t)elapsed << 15) / t->duration);
+    uint16_t e = ui_ease((ui_ease_t)t->ease, p);
+
+    t->value = t->from + (int32_t)(((int64_t)(t->to - t->from) * e) >> 15);
+    ui_anim_busy = 1;
+    return t->value;
+}
+
+uint8_t ui_anim_take_busy(void)
+{
+    uint8_t busy = ui_anim_busy;
+    ui_anim_busy = 0;
+    return busy;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file ui_widget.c
+ * @brief 保留模式控件层实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "ui_widget.h"
+
+#define UI_FONT_SIZE    12      // 控件文本字号
+#define UI_FONT_WIDTH   6       // 12号字体字符宽度
+#define UI_TEXT_MAX     22      // 128/6 = 21 个字符 + 结束符
+
+// ==================================
+// 默认绘制函数
+// ==================================
+
+/**
+ * @brief 按控件宽度截断后输出文本
+ */
+static void ui_draw_text(ui_widget_t *w, fmt_buf_t *f)
+{
+    uint8_t max_chars = w->w / UI_FONT_WIDTH;
+
+    if (f->len > max_chars)
+    {
+        f->buf[max_chars] = '\0';
+    }
+    OLED_ShowString(w->x, w->y, (uint8_t *)f->buf, UI_FONT_SIZE, 1);
+}
+
+static void ui_render_label(ui_widget_t *w, int32_t value)
+{
+    char buf[UI_TEXT_MAX];
+    fmt_buf_t f;
+
+    fmt_init(&f, buf, sizeof(buf));
+    if (w->u.label.prefix != NULL)
+    {
+        fmt_str(&f, w->u.label.prefix);
+    }
+    if (w->u.label.texts != NULL && value >= 0 && value < w->u.label.count)
+    {
+        fmt_str(&f, w->u.label.texts[value]);
+    }
+    ui_draw_text(w, &f);
+}
+
+static void ui_render_value(ui_widget_t *w, int32_t value)
+{
+    char buf[UI_TEXT_MAX];
+    fmt_buf_t f;
+
+    fmt_init(&f, buf, sizeof(buf));
+    if (w->u.value.prefix != NULL)
+    {
+        fmt_str(&f, w->u.value.prefix);
+    }
+    fmt_fixed(&f, value, w->u.value.frac, w->u.value.width);
+    if (w->u.value.suffix != NULL)
+    {
+        fmt_str(&f, w->u.value.suffix);
+    }
+    ui_draw_text(w, &f);
+}
+
+/**
+ * @brief 进度条的值换算为填充像素数，数值变化但填充长度不变时不重画
+ */
+static int32_t ui_bar_pixels(ui_widget_t *w, int32_t value)
+{
+    uint8_t len = (w->w > w->h) ? w->w : w->h;
+
+    if (w->u.bar.max <= w->u.bar.min)
+    {
+        return 0;
+    }
+    if (value < w->u.bar.min)
+        value = w->u.bar.min;
+    if (value > w->u.bar.max)
+        value = w->u.bar.max;
+    return (value - w->u.bar.min) * len / (w->u.bar.max - w->u.bar.min);
+}
+
+static void ui_render_bar(ui_widget_t *w, int32_t value)
+{
+    uint8_t len = (w->w > w->h) ? w->w : w->h;
+
+    OLED_DrawProgressBar(w->x, w->y, w->w, w->h, value, 0, len, 1, 1, 1);
+}
+
+static void ui_render_icon(ui_widget_t *w, int32_t value)
+{
+    if (value < 0 || value >= w->u.icon.count)
+    {
+        return;
+    }
+    OLED_ShowPicture(w->x, w->y, w->w, w->h, w->u.icon.bmps[value], 1);
+}
+
+/**
+ * @brief 折线图：最新采样在最右侧，纵轴按历史数据自动缩放
+ */
+static void ui_render_chart(ui_widget_t *w, int32_t value)
+{
+    int16_t *buf = w->u.chart.buf;
+    uint8_t len = w->u.chart.len;
+    uint8_t count = w->u.chart.count;
+    uint8_t step = (len > 0 && w->w >= len) ? (uint8_t)(w->w / len) : 1;
+    int16_t vmin, vmax;
+    uint8_t i, prev_x = 0, prev_y = 0;
+
+    (void)value;
+    if (count == 0 || w->h < 2)
+    {
+        return;
+    }
+
+    // oldest 为最早一个采样的位置
+    uint8_t oldest = (uint8_t)((w->u.chart.head + len - count) % len);
+
+    vmin = vmax = buf[oldest];
+    for (i = 1; i < count; i++)
+    {
+        int16_t v = buf[(oldest + i) % len];
+        if (v < vmin) vmin = v;
+        if (v > vmax) vmax = v;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        int16_t v = buf[(oldest + i) % len];
+        uint8_t px = (uint8_t)(w->x + w->w - 1 - (count - 1 - i) * step);
+        uint8_t py;
+
+        if (vmax == vmin)
+        {
+            py = (uint8_t)(w->y + w->h / 2);
+        }
+        else
+        {
+            py = (uint8_t)(w->y + w->h - 1 - (int32_t)(v - vmin) * (w->h - 1) / (vmax - vmin));
+        }
+
+        if (i == 0)
+        {
+            OLED_DrawPoint(px, py, 1);
+        }
+        else
+        {
+            OLED_DrawLine(prev_x, prev_y, px, py, 1);
+        }
+        prev_x = px;
+        prev_y = py;
+    }
+}
+
+static const ui_render_t ui_default_render[] = {
+    ui_render_label,    // UI_WIDGET_LABEL
+    ui_render_value,    // UI_WIDGET_VALUE
+    ui_render_bar,      // UI_WIDGET_BAR
+    ui_render_icon,     // UI_WIDGET_ICON
+    ui_render_chart,    // UI_WIDGET_CHART
+};
+
+// ==================================
+// 接口实现
+// ==================================
+
+void ui_widget_invalidate(ui_widget_t *w)
+{
+    w->valid = 0;
+}
+
+void ui_widgets_invalidate(ui_widget_t *widgets, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        widgets[i].valid = 0;
+    }
+}
+
+static void ui_chart_push(ui_widget_t *w)
+{
+    if (w->u.chart.buf == NULL || w->u.chart.len == 0 || w->u.chart.sample == NULL)
+    {
+        return;
+    }
+    w->u.chart.buf[w->u.chart.head] = (int16_t)w->u.chart.sample();
+    w->u.chart.head = (uint8_t)((w->u.chart.head + 1) % w->u.chart.len);
+    if (w->u.chart.count < w->u.chart.len)
+    {
+        w->u.chart.count++;
+    }
+}
+
+void ui_chart_reset(ui_widget_t *w)
+{
+    w->u.chart.head = 0;
+    w->u.chart.count = 0;
+    w->valid = 0;
+}
+
+uint8_t ui_widget_update(ui_widget_t *w)
+{
+    int32_t value = (w->source != NULL) ? w->source() : 0;
+    ui_render_t render = w->render;
+
+    if (w->type == UI_WIDGET_BAR)
+    {
+        value = ui_bar_pixels(w, value);
+    }
+
+    if (w->valid && value == w->last)
+    {
+        return 0;
+    }
+
+    // 折线图的数据源是采样序号，序号变化才记录新采样，失效重绘不追加
+    if (w->type == UI_WIDGET_CHART && (value != w->last || w->u.chart.count == 0))
+    {
+        ui_chart_push(w);
+    }
+
+    if (render == NULL && w->type < sizeof(ui_default_render) / sizeof(ui_default_render[0]))
+    {
+        render = ui_default_render[w->type];
+    }
+
+    OLED_Clear_Rect(w->x, w->y, w->x + w->w - 1, w->y + w->h - 1);
+    if (render != NULL)
+    {
+        render(w, value);
+    }
+    OLED_Set_Dirty_Area(w->x, w->y, w->x + w->w - 1, w->y + w->h - 1);
+
+    w->last = value;
+    w->valid = 1;
+    return 1;
+}
+
+uint8_t ui_widgets_update(ui_widget_t *widgets, uint8_t count)
+{
+    uint8_t drawn = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        drawn += ui_widget_update(&widgets[i]);
+    }
+    return drawn;
+}
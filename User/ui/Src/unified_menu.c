@@ -7,6 +7,8 @@
  */
 
 #include "unified_menu.h"
+#include "perf.h"
+#include "log.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -30,6 +32,7 @@ static void menu_update_page_info(menu_item_t *menu);
 static void menu_item_deselect_all(menu_item_t *menu);
 static void menu_item_update_selection(menu_item_t *menu, uint8_t new_index);
 static void menu_set_layout_for_type(menu_type_t type);
+static TickType_t menu_next_wait(void);
 
 // ==================================
 // 菜单系统初始化
@@ -61,10 +64,6 @@ int8_t menu_system_init(void)
     g_menu_sys.total_pages = 1;
     g_menu_sys.items_per_page = 4;
 
-    // 初始化按键处理
-    g_menu_sys.last_key_time = 0;
-    g_menu_sys.key_debounce_time = (uint8_t)500; // 500ms去抖
-
     // 设置默认布局配置
     g_menu_sys.layout = (menu_layout_config_t)LAYOUT_HORIZONTAL_MAIN();
 
@@ -133,6 +132,12 @@ int8_t menu_add_child(menu_item_t *parent, menu_item_t *child)
         return -1;
     }
 
+    // 静态菜单树的子项表在flash中，不能修改
+    if (parent->is_static)
+    {
+        return -4;
+    }
+
     // 不允许重复添加同一 child（防循环/重复）
     for (uint8_t i = 0; i < parent->child_count; i++)
     {
@@ -158,7 +163,7 @@ int8_t menu_add_child(menu_item_t *parent, menu_item_t *child)
         memcpy(new_children, parent->children, sizeof(menu_item_t *) * parent->child_count);
         // printf("FREE: menu_add_child %s, old children pointer array addr=%p, size=%d bytes (old children array release)\n",
         //    parent->name, parent->children, sizeof(menu_item_t *) * parent->child_count);
-        vPortFree(parent->children); // 释放旧数组
+        vPortFree((void *)parent->children); // 释放旧数组
     }
 
     // 添加新 child 指针到末尾
@@ -206,6 +211,28 @@ int8_t menu_item_set_callbacks(menu_item_t *item,
     return 0;
 }
 
+int8_t menu_item_set_transition(menu_item_t *item, oled_transition_t transition)
+{
+    if (item == NULL)
+    {
+        return -1;
+    }
+
+    item->transition = (uint8_t)transition;
+    return 0;
+}
+
+int8_t menu_item_set_refresh(menu_item_t *item, uint8_t mask)
+{
+    if (item == NULL)
+    {
+        return -1;
+    }
+
+    item->refresh_mask = mask;
+    return 0;
+}
+
 int8_t menu_remove_child(menu_item_t *parent, menu_item_t *child)
 {
     if (parent == NULL || child == NULL || parent->child_count == 0 || parent->children == NULL)
@@ -213,6 +240,12 @@ int8_t menu_remove_child(menu_item_t *parent, menu_item_t *child)
         return -1;
     }
 
+    // 静态菜单树的子项表在flash中，不能修改
+    if (parent->is_static)
+    {
+        return -4;
+    }
+
     // 查找 child 指针在 children 数组中的位置（指针比较！）
     int8_t index = -1;
     for (uint8_t i = 0; i < parent->child_count; i++)
@@ -266,7 +299,7 @@ int8_t menu_remove_child(menu_item_t *parent, menu_item_t *child)
     // 释放旧数组，更新
     // printf("FREE: menu_remove_child %s, old children pointer array addr=%p, size=%d bytes (old children array release during removal)\n",
     //        parent->name, parent->children, sizeof(menu_item_t *) * parent->child_count);
-    vPortFree(parent->children);
+    vPortFree((void *)parent->children);
     parent->children = new_children;
     parent->child_count = new_count;
 
@@ -281,6 +314,8 @@ int8_t menu_item_delete(menu_item_t *item)
         return -1;
     if (item == g_menu_sys.current_menu || item == g_menu_sys.root_menu)
         return -2;
+    if (item->is_static)
+        return -4; // 静态菜单树中的项不能释放
 
     //  加锁
     if (g_menu_sys.display_mutex)
@@ -317,8 +352,8 @@ int8_t menu_item_delete(menu_item_t *item)
     {
         menu_item_t *cur = stack[--top];
 
-        // 安全检查
-        if (!cur)
+        // 安全检查（挂在动态菜单下的静态项不释放）
+        if (!cur || cur->is_static)
             continue;
 
         printf("Processing: %s (child_count=%d)\n", cur->name, cur->child_count);
@@ -354,7 +389,7 @@ int8_t menu_item_delete(menu_item_t *item)
         {
             // printf("FREE: %s children array, addr=%p, size=%d bytes\n",
             //    cur->name, cur->children, sizeof(menu_item_t *) * cur->child_count);
-            vPortFree(cur->children);
+            vPortFree((void *)cur->children);
             cur->children = NULL;
             cur->child_count = 0;
         }
@@ -401,6 +436,9 @@ void menu_refresh_display(void)
         return;
     }
 
+    // 统计本帧绘制与刷屏耗时（页面绘制函数内的刷屏单独计时）
+    Perf_Frame_Begin(g_menu_sys.current_menu->name);
+
     switch (g_menu_sys.current_menu->type)
     {
     case MENU_TYPE_HORIZONTAL_ICON:
@@ -419,6 +457,8 @@ void menu_refresh_display(void)
         break;
     }
 
+    Perf_Frame_End();
+
     g_menu_sys.last_refresh_time = xTaskGetTickCount();
     g_menu_sys.need_refresh = 0;
 
@@ -455,7 +495,15 @@ void menu_display_horizontal(menu_item_t *menu)
     // 显示中间图标（清晰）
     if (menu->children[center_index]->content.icon.icon_data)
     {
-        OLED_Printf_Line(3,"       %s",menu->children[center_index]->name);
+        char name_buf[24];
+        fmt_buf_t f;
+        fmt_init(&f, name_buf, sizeof(name_buf));
+        fmt_str(&f, "       ");
+        if (menu->children[center_index]->name)
+        {
+            fmt_str(&f, menu->children[center_index]->name);
+        }
+        OLED_Puts_Line(3, name_buf);
         if (menu->children[center_index]->type == MENU_TYPE_CUSTOM)
         {
             OLED_ShowPicture(48, 16, 32, 32,
@@ -512,7 +560,16 @@ void menu_display_vertical(menu_item_t *menu)
         uint8_t line = i - start_index;
         char arrow = (i == menu->selected_child) ? '>' : ' ';
 
-        OLED_Printf_Line(line, "%c %s", arrow, menu->children[i]->content.text.text);
+        char line_buf[24];
+        fmt_buf_t f;
+        fmt_init(&f, line_buf, sizeof(line_buf));
+        fmt_char(&f, arrow);
+        fmt_char(&f, ' ');
+        if (menu->children[i]->content.text.text)
+        {
+            fmt_str(&f, menu->children[i]->content.text.text);
+        }
+        OLED_Puts_Line(line, line_buf);
     }
 
     // 如果本页不足4行，下面几行清空
@@ -534,13 +591,72 @@ void menu_clear_and_redraw(void)
 // 菜单事件处理
 // ==================================
 
+BaseType_t menu_post_event(const menu_event_t *event)
+{
+    BaseType_t ret = xQueueSend(g_menu_sys.event_queue, event, 0);
+    if (ret == pdPASS)
+    {
+        menu_notify(MENU_NOTIFY_EVENT);
+    }
+    return ret;
+}
+
+void menu_notify(uint32_t bits)
+{
+    if (g_menu_sys.task_handle != NULL)
+    {
+        xTaskNotify(g_menu_sys.task_handle, bits, eSetBits);
+    }
+}
+
+void menu_notify_from_isr(uint32_t bits, BaseType_t *woken)
+{
+    if (g_menu_sys.task_handle != NULL)
+    {
+        xTaskNotifyFromISR(g_menu_sys.task_handle, bits, eSetBits, woken);
+    }
+}
+
+void menu_request_frame(uint32_t delay_ms)
+{
+    if (delay_ms < MENU_FRAME_MIN_MS)
+    {
+        delay_ms = MENU_FRAME_MIN_MS;
+    }
+
+    TickType_t due = xTaskGetTickCount() + pdMS_TO_TICKS(delay_ms);
+
+    // 多个动画同时请求时取最早的一帧
+    if (!g_menu_sys.frame_pending || (int32_t)(due - g_menu_sys.frame_due) < 0)
+    {
+        g_menu_sys.frame_due = due;
+        g_menu_sys.frame_pending = 1;
+    }
+}
+
+void menu_key_callback(uint8_t key, key_action_t action, TickType_t tick)
+{
+    menu_event_t event = menu_key_to_event(key);
+    if (event.type == MENU_EVENT_NONE)
+    {
+        return;
+    }
+
+    event.timestamp = tick;
+    event.param = (uint8_t)action;
+    if (menu_post_event(&event) == pdPASS &&
+        (action == KEY_ACTION_PRESS || action == KEY_ACTION_REPEAT))
+    {
+        // 会产生画面变化的按键，从此刻开始计算按键到刷屏延迟
+        Perf_Key_Mark();
+    }
+}
+
 menu_event_t menu_key_to_event(uint8_t key)
 {
     menu_event_t event;
     memset(&event, 0, sizeof(menu_event_t));
     event.timestamp = xTaskGetTickCount();
-    BEEP_Buzz(1);
-    printf("key press - > %d\n", key - 1);
     switch (key)
     {
     case 1:
@@ -602,21 +718,25 @@ int8_t menu_process_event(menu_event_t *event)
 
     menu_item_t *current = g_menu_sys.current_menu;
 
-    // 按键去抖处理
-    uint32_t current_time = xTaskGetTickCount();
-    if (event->type != MENU_EVENT_NONE && event->type != MENU_EVENT_REFRESH)
+    // 按键事件：消抖已由按键驱动完成，页面只处理按下和连发
+    if (event->type >= MENU_EVENT_KEY_UP && event->type <= MENU_EVENT_KEY_ENTER)
     {
-        if (current_time - g_menu_sys.last_key_time < pdMS_TO_TICKS(g_menu_sys.key_debounce_time))
+        if (event->param == KEY_ACTION_PRESS)
         {
-            return 0; // 去抖，忽略按键
+            BEEP_Buzz(1);
+        }
+        else if (event->param != KEY_ACTION_REPEAT)
+        {
+            return 0; // 松开/长按暂无页面使用
         }
-        g_menu_sys.last_key_time = current_time;
     }
 
     // 调用自定义按键处理（如果存在）
     if (current->on_key)
     {
         current->on_key(current, event->type);
+        // 输入已改变页面状态，重绘一次
+        g_menu_sys.need_refresh = 1;
         // 返回0表示事件已处理
         return 0;
     }
@@ -692,7 +812,7 @@ int8_t menu_handle_vertical_key(menu_item_t *menu, uint8_t key_event)
         {
             menu->selected_child--;
         }
-        printf("selected : %d\n", menu->selected_child);
+        LOG_D(LOG_MOD_MENU, "selected : %d", menu->selected_child);
         // 更新分页信息
         menu_update_page_info(menu);
         g_menu_sys.need_refresh = 1;
@@ -701,7 +821,7 @@ int8_t menu_handle_vertical_key(menu_item_t *menu, uint8_t key_event)
     case MENU_EVENT_KEY_DOWN:
         // 下一个选项（循环选择）
         menu->selected_child = (menu->selected_child + 1) % menu->child_count;
-        printf("selected : %d\n", menu->selected_child);
+        LOG_D(LOG_MOD_MENU, "selected : %d", menu->selected_child);
         // 更新分页信息
         menu_update_page_info(menu);
         g_menu_sys.need_refresh = 1;
@@ -737,6 +857,9 @@ int8_t menu_enter(menu_item_t *menu)
         return -1;
     }
 
+    // 启动切换动画：之后的清屏/绘制只写显存，由动画逐步上传
+    OLED_Transition_Begin((oled_transition_t)menu->transition);
+
     // 调用退出回调
     if (g_menu_sys.current_menu && g_menu_sys.current_menu->on_exit)
     {
@@ -760,18 +883,22 @@ int8_t menu_enter(menu_item_t *menu)
     {
         menu->on_enter(menu);
     }
-    printf("\nparent : %s ,\n current : %s \n", g_menu_sys.current_menu->parent->name, g_menu_sys.current_menu->name);
+    LOG_D(LOG_MOD_MENU, "parent : %s , current : %s",
+          menu->parent ? menu->parent->name : "NULL", menu->name);
     return 0;
 }
 
 int8_t menu_back_to_parent(void)
 {
-    printf("menu_back_to_parent\n");
-    printf("\nparent : %s ,\n current : %s \n", g_menu_sys.current_menu->parent->name, g_menu_sys.current_menu->name);
+    LOG_D(LOG_MOD_MENU, "menu_back_to_parent");
     if (g_menu_sys.current_menu == NULL || g_menu_sys.current_menu->parent == NULL)
     {
         return -1;
     }
+    LOG_D(LOG_MOD_MENU, "parent : %s , current : %s", g_menu_sys.current_menu->parent->name, g_menu_sys.current_menu->name);
+
+    // 反向播放进入时的切换动画
+    OLED_Transition_Begin(OLED_Transition_Reverse((oled_transition_t)g_menu_sys.current_menu->transition));
     OLED_Clear();
     menu_item_t *parent = g_menu_sys.current_menu->parent;
 
@@ -794,7 +921,7 @@ int8_t menu_back_to_parent(void)
     // 刷新显示
     g_menu_sys.need_refresh = 1;
 
-    printf("back to ->  %s\n", parent->name);
+    LOG_D(LOG_MOD_MENU, "back to ->  %s", parent->name);
     // 调用父菜单的进入回调
     if (parent->on_enter)
     {
@@ -849,8 +976,8 @@ int8_t menu_enter_selected(void)
     menu_item_t *menu = g_menu_sys.current_menu;
     menu_item_t *selected = menu->children[menu->selected_child];
 
-    printf("menu_enter_selected: current=%s, selected=%s, child_count=%d\n",
-           menu->name, selected->name, selected->child_count);
+    LOG_D(LOG_MOD_MENU, "menu_enter_selected: current=%s, selected=%s, child_count=%d",
+          menu->name, selected->name, selected->child_count);
 
     // 调用选中回调
     if (selected->on_select)
@@ -865,23 +992,15 @@ int8_t menu_enter_selected(void)
     if (selected->child_count > 0)
     {
         // 有子菜单的菜单项：直接进入该菜单
-        printf("menu_enter_selected - Entering menu with children\n");
-        printf("parent : %s ,\n current : %s \n", selected->parent->name, selected->name);
+        LOG_D(LOG_MOD_MENU, "menu_enter_selected - Entering menu with children");
         return menu_enter(selected);
     }
     else
     {
         // 没有子菜单的菜单项：可能是功能页面或自定义页面
-        printf("menu_enter_selected - Entering leaf node (custom page/function)\n");
-        printf("parent : %s ,\n current : %s \n", selected->parent->name, selected->name);
+        LOG_D(LOG_MOD_MENU, "menu_enter_selected - Entering leaf node (custom page/function)");
 
-        // 调用进入回调
-        if (selected->on_enter)
-        {
-            selected->on_enter(selected);
-        }
-
-        // 进入该页面
+        // 进入该页面（进入回调由 menu_enter 调用）
         return menu_enter(selected);
     }
 }
@@ -892,45 +1011,56 @@ int8_t menu_enter_selected(void)
 
 void menu_task(void *pvParameters)
 {
-    const TickType_t delay_20ms = pdMS_TO_TICKS(20);
     menu_event_t event;
+    uint32_t notify_bits;
+
+    g_menu_sys.task_handle = xTaskGetCurrentTaskHandle();
 
     while (1)
     {
-        // 处理菜单事件
-        if (xQueueReceive(g_menu_sys.event_queue, &event, 0) == pdPASS)
+        // 阻塞等待：按键事件、新采样、RTC秒中断或动画帧到期
+        notify_bits = 0;
+        xTaskNotifyWait(0, 0xFFFFFFFFUL, &notify_bits, menu_next_wait());
+        Perf_Wake();
+
+        // 处理全部排队的菜单事件
+        while (xQueueReceive(g_menu_sys.event_queue, &event, 0) == pdPASS)
         {
             menu_process_event(&event);
         }
 
-        // 定时刷新显示
-        if (g_menu_sys.need_refresh ||
-            (xTaskGetTickCount() - g_menu_sys.last_refresh_time) > pdMS_TO_TICKS(50))
+        // 当前页面关心的数据有更新
+        if (g_menu_sys.current_menu != NULL &&
+            (notify_bits & g_menu_sys.current_menu->refresh_mask))
         {
-            menu_refresh_display();
+            g_menu_sys.need_refresh = 1;
         }
 
-        vTaskDelay(delay_20ms);
-    }
-}
+        // 动画帧到期
+        if (g_menu_sys.frame_pending &&
+            (int32_t)(xTaskGetTickCount() - g_menu_sys.frame_due) >= 0)
+        {
+            g_menu_sys.frame_pending = 0;
+            g_menu_sys.need_refresh = 1;
+        }
 
-void menu_key_task(void *pvParameters)
-{
-    const TickType_t delay_10ms = pdMS_TO_TICKS(10);
-    uint8_t key;
+        // 只在有变化时重绘（切换动画播放中不重绘，画面由动画逐步上传）
+        if (g_menu_sys.need_refresh && OLED_Transition_Accepts_Frame())
+        {
+            menu_refresh_display();
+        }
 
-    while (1)
-    {
-        if ((key = KEY_Get()) != 0)
+        // 绘制中有补间动画未结束：按限定帧率继续重绘，动画结束后恢复阻塞
+        if (ui_anim_take_busy())
         {
-            menu_event_t event = menu_key_to_event(key);
-            if (event.type != MENU_EVENT_NONE)
-            {
-                xQueueSend(g_menu_sys.event_queue, &event, 0);
-            }
+            menu_request_frame(UI_ANIM_FRAME_MS);
         }
 
-        vTaskDelay(delay_10ms);
+        // 新画面已绘制到显存，推进切换动画
+        if (OLED_Transition_Active())
+        {
+            OLED_Transition_Poll();
+        }
     }
 }
 
@@ -938,6 +1068,36 @@ void menu_key_task(void *pvParameters)
 // 静态辅助函数实现
 // ==================================
 
+/**
+ * @brief 计算菜单任务下一次等待时间
+ * @return 无动画且无待绘制内容时返回 portMAX_DELAY
+ */
+static TickType_t menu_next_wait(void)
+{
+    TickType_t wait = portMAX_DELAY;
+
+    if (OLED_Transition_Active())
+    {
+        wait = pdMS_TO_TICKS(OLED_TRANS_STEP_MS);
+    }
+    else if (g_menu_sys.need_refresh)
+    {
+        return 0;
+    }
+
+    if (g_menu_sys.frame_pending)
+    {
+        TickType_t now = xTaskGetTickCount();
+        TickType_t left = ((int32_t)(g_menu_sys.frame_due - now) > 0) ? (g_menu_sys.frame_due - now) : 0;
+        if (left < wait)
+        {
+            wait = left;
+        }
+    }
+
+    return wait;
+}
+
 static void menu_update_page_info(menu_item_t *menu)
 {
     if (menu == NULL || menu->type != MENU_TYPE_VERTICAL_LIST)
@@ -0,0 +1,398 @@
+/**
+ * @file bemfa_emu.c
+ * @brief 巴法云 TCP 服务器替身实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "bemfa_emu.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BEMFA_EMU_LINE_MAX      256
+#define BEMFA_EMU_OUT_MAX       1024
+#define BEMFA_EMU_TOPICS        16
+
+typedef struct
+{
+    char topic[32];
+    char msg[64];
+} bemfa_emu_topic_t;
+
+typedef struct
+{
+    uint32_t session;
+    uint16_t len;
+    uint8_t data[];
+} bemfa_emu_seg_t;
+
+// ==================================
+// 静态变量
+// ==================================
+
+static bemfa_emu_cfg_t cfg;
+static bemfa_emu_stats_t stats;
+static uint8_t be_connected = 0;
+static uint8_t be_link = 0;
+static uint32_t be_session = 0;
+
+static char be_line[BEMFA_EMU_LINE_MAX];
+static uint16_t be_line_len = 0;
+
+static char be_out[BEMFA_EMU_OUT_MAX];  // 合并窗口内待发的数据
+static uint16_t be_out_len = 0;
+static uint8_t be_out_items = 0;
+static uint8_t be_out_armed = 0;
+
+static bemfa_emu_topic_t be_topics[BEMFA_EMU_TOPICS];
+
+// ==================================
+// 发送
+// ==================================
+
+static void be_seg_event(void *arg)
+{
+    bemfa_emu_seg_t *s = arg;
+
+    if (s->session == be_session && be_connected)
+    {
+        Esp_Emu_Peer_Send(be_link, s->data, s->len);
+    }
+    free(s);
+}
+
+static void be_seg_after(uint64_t delay, const char *data, uint16_t len)
+{
+    bemfa_emu_seg_t *s = malloc(sizeof(*s) + len);
+
+    s->session = be_session;
+    s->len = len;
+    memcpy(s->data, data, len);
+    sim_event_after(delay, be_seg_event, s);
+}
+
+/**
+ * @brief 待发数据作为一个TCP段发出（可能丢失或被拆开）
+ */
+static void be_flush(void *arg)
+{
+    uint16_t len = be_out_len;
+
+    be_out_armed = 0;
+    be_out_len = 0;
+    if (len == 0 || (uint32_t)(uintptr_t)arg != be_session)
+    {
+        return;
+    }
+    if (be_out_items > 1)
+    {
+        stats.segments_merged++;
+    }
+    be_out_items = 0;
+
+    if (cfg.drop_percent != 0 && sim_rand() % 100 < cfg.drop_percent)
+    {
+        stats.segments_dropped++;
+        sim_log("bemfa: dropped segment\n");
+        return;
+    }
+    if (len > 1 && cfg.split_percent != 0 && sim_rand() % 100 < cfg.split_percent)
+    {
+        uint16_t cut = (uint16_t)sim_rand_range(1, len - 1u);
+        stats.segments_split++;
+        be_seg_after(0, be_out, cut);
+        be_seg_after(cfg.split_gap_us, be_out + cut, (uint16_t)(len - cut));
+        return;
+    }
+    be_seg_after(0, be_out, len);
+}
+
+static void be_queue(const char *s)
+{
+    uint16_t len = (uint16_t)strlen(s);
+
+    if (be_out_len + len > BEMFA_EMU_OUT_MAX)
+    {
+        be_flush((void *)(uintptr_t)be_session);
+    }
+    memcpy(be_out + be_out_len, s, len);
+    be_out_len += len;
+    be_out_items++;
+    if (cfg.coalesce_us == 0)
+    {
+        be_flush((void *)(uintptr_t)be_session);
+    }
+    else if (!be_out_armed)
+    {
+        be_out_armed = 1;
+        sim_event_after(cfg.coalesce_us, be_flush, (void *)(uintptr_t)be_session);
+    }
+}
+
+typedef struct
+{
+    uint32_t session;
+    char text[];
+} bemfa_emu_reply_t;
+
+static void be_reply_event(void *arg)
+{
+    bemfa_emu_reply_t *r = arg;
+
+    if (r->session == be_session && be_connected)
+    {
+        be_queue(r->text);
+    }
+    free(r);
+}
+
+/**
+ * @brief 经处理时间后应答
+ */
+static void be_reply(const char *text)
+{
+    size_t len = strlen(text) + 1;
+    bemfa_emu_reply_t *r = malloc(sizeof(*r) + len);
+    uint64_t delay = cfg.reply_us + (cfg.reply_jitter_us ? sim_rand_range(0, cfg.reply_jitter_us) : 0);
+
+    r->session = be_session;
+    memcpy(r->text, text, len);
+    sim_event_after(delay, be_reply_event, r);
+}
+
+// ==================================
+// 请求
+// ==================================
+
+/**
+ * @brief 取 key=value 字段
+ * @return 值长度，-1-没有该字段
+ */
+static int be_field(const char *line, const char *key, char *out, size_t size)
+{
+    char pat[16];
+    const char *p;
+    size_t n = 0;
+
+    snprintf(pat, sizeof(pat), "%s=", key);
+    p = strstr(line, pat);
+    while (p != NULL && p != line && p[-1] != '&')
+    {
+        p = strstr(p + 1, pat);
+    }
+    if (p == NULL)
+    {
+        return -1;
+    }
+    p += strlen(pat);
+    while (p[n] != '\0' && p[n] != '&' && n + 1 < size)
+    {
+        out[n] = p[n];
+        n++;
+    }
+    out[n] = '\0';
+    return (int)n;
+}
+
+static void be_record(const char *topic, const char *msg)
+{
+    bemfa_emu_topic_t *free_slot = NULL;
+
+    for (uint8_t i = 0; i < BEMFA_EMU_TOPICS; i++)
+    {
+        if (strcmp(be_topics[i].topic, topic) == 0)
+        {
+            snprintf(be_topics[i].msg, sizeof(be_topics[i].msg), "%s", msg);
+            return;
+        }
+        if (free_slot == NULL && be_topics[i].topic[0] == '\0')
+        {
+            free_slot = &be_topics[i];
+        }
+    }
+    if (free_slot != NULL)
+    {
+        snprintf(free_slot->topic, sizeof(free_slot->topic), "%.*s", (int)sizeof(free_slot->topic) - 1, topic);
+        snprintf(free_slot->msg, sizeof(free_slot->msg), "%.*s", (int)sizeof(free_slot->msg) - 1, msg);
+    }
+}
+
+static void be_bad(const char *line)
+{
+    stats.bad_frames++;
+    sim_log("bemfa: bad frame \"%.40s\"\n", line);
+}
+
+static void be_request(const char *line)
+{
+    char cmd[8], uid[48], topic[128], msg[64];
+
+    sim_log("bemfa: <- %s\n", line);
+    if (be_field(line, "cmd", cmd, sizeof(cmd)) <= 0)
+    {
+        be_bad(line);
+        return;
+    }
+    if (strcmp(cmd, "0") == 0)
+    {
+        stats.pings++;
+        be_reply("cmd=0&res=1\r\n");
+        return;
+    }
+    if (be_field(line, "uid", uid, sizeof(uid)) <= 0 || (cfg.uid != NULL && strcmp(uid, cfg.uid) != 0))
+    {
+        be_bad(line);
+        return;
+    }
+    if (strcmp(cmd, "1") == 0 && be_field(line, "topic", topic, sizeof(topic)) > 0)
+    {
+        stats.subscribes++;
+        be_reply("cmd=1&res=1\r\n");
+    }
+    else if (strcmp(cmd, "2") == 0 && be_field(line, "topic", topic, sizeof(topic)) > 0 &&
+             be_field(line, "msg", msg, sizeof(msg)) >= 0)
+    {
+        stats.publishes++;
+        be_record(topic, msg);
+        be_reply("cmd=2&res=1\r\n");
+    }
+    else if (strcmp(cmd, "7") == 0)
+    {
+        stats.time_requests++;
+        be_reply(cfg.time_str);
+    }
+    else
+    {
+        be_bad(line);
+    }
+}
+
+// ==================================
+// 对端接口
+// ==================================
+
+static uint8_t be_connect(uint8_t link, const char *host, uint16_t port)
+{
+    if (cfg.refuse || strcmp(host, "bemfa.com") != 0 || port != 8344)
+    {
+        return 0;
+    }
+    be_session++;
+    be_connected = 1;
+    be_link = link;
+    be_line_len = 0;
+    be_out_len = 0;
+    be_out_items = 0;
+    be_out_armed = 0;
+    stats.connects++;
+    return 1;
+}
+
+static void be_recv(uint8_t link, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        char c = (char)data[i];
+        if (c == '\n')
+        {
+            if (be_line_len > 0 && be_line[be_line_len - 1] == '\r')
+            {
+                be_line_len--;
+            }
+            be_line[be_line_len] = '\0';
+            if (be_line_len > 0)
+            {
+                be_request(be_line);
+            }
+            be_line_len = 0;
+        }
+        else if (be_line_len < BEMFA_EMU_LINE_MAX - 1)
+        {
+            be_line[be_line_len++] = c;
+        }
+    }
+}
+
+static void be_closed(uint8_t link)
+{
+    if (be_connected)
+    {
+        be_connected = 0;
+        be_session++;
+        stats.closes++;
+    }
+}
+
+const esp_emu_peer_t bemfa_emu_peer = {be_connect, be_recv, be_closed};
+
+// ==================================
+// 接口实现
+// ==================================
+
+void Bemfa_Emu_Init(const bemfa_emu_cfg_t *c)
+{
+    cfg = *c;
+    if (cfg.reply_us == 0)
+    {
+        cfg.reply_us = 5000;
+    }
+    if (cfg.time_str == NULL)
+    {
+        cfg.time_str = "2026-10-19 12:00:00";
+    }
+    memset(&stats, 0, sizeof(stats));
+    memset(be_topics, 0, sizeof(be_topics));
+    be_connected = 0;
+    be_session++;
+    Esp_Emu_Set_Cloud(&bemfa_emu_peer);
+}
+
+int8_t Bemfa_Emu_Push(const char *topic, const char *msg)
+{
+    char line[160];
+
+    if (!be_connected)
+    {
+        return -1;
+    }
+    snprintf(line, sizeof(line), "cmd=2&uid=%s&topic=%s&msg=%s\r\n", cfg.uid != NULL ? cfg.uid : "", topic, msg);
+    stats.pushes++;
+    be_queue(line);
+    return 0;
+}
+
+void Bemfa_Emu_Close(void)
+{
+    if (be_connected)
+    {
+        be_connected = 0;
+        be_session++;
+        stats.closes++;
+        Esp_Emu_Peer_Close(be_link);
+    }
+}
+
+uint8_t Bemfa_Emu_Connected(void)
+{
+    return be_connected;
+}
+
+const char *Bemfa_Emu_Last_Msg(const char *topic)
+{
+    for (uint8_t i = 0; i < BEMFA_EMU_TOPICS; i++)
+    {
+        if (strcmp(be_topics[i].topic, topic) == 0)
+        {
+            return be_topics[i].msg;
+        }
+    }
+    return NULL;
+}
+
+void Bemfa_Emu_GetStats(bemfa_emu_stats_t *s)
+{
+    *s = stats;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file bemfa_emu.h
+ * @brief 巴法云 TCP 服务器替身（接在 esp_emu 的云端对端上）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 按行（\r\n）解析设备发来的 cmd=0/1/2/7 请求并应答 res=1 或时间字符串，
+ * 可主动下发 cmd=2。应答经 coalesce_us 合并为一个TCP段（多个应答、下发连在一起），
+ * 按概率拆成两段且中间间隔 split_gap_us，或整段丢弃。
+ */
+
+#ifndef __BEMFA_EMU_H
+#define __BEMFA_EMU_H
+
+#include "esp_emu.h"
+
+typedef struct
+{
+    uint32_t reply_us;          // 服务器处理时间
+    uint32_t reply_jitter_us;   // 处理时间随机增加量上限
+    uint32_t coalesce_us;       // 合并窗口，0-每条应答单独成段
+    uint8_t split_percent;      // 一个段被拆成两段的概率（%）
+    uint32_t split_gap_us;      // 拆开的两段之间的间隔
+    uint8_t drop_percent;       // 应答段丢失的概率（%）
+    uint8_t refuse;             // 拒绝连接
+    const char *uid;
+    const char *time_str;       // cmd=7 的应答（不带换行）
+} bemfa_emu_cfg_t;
+
+typedef struct
+{
+    uint32_t connects;
+    uint32_t closes;
+    uint32_t subscribes;
+    uint32_t publishes;
+    uint32_t pings;
+    uint32_t time_requests;
+    uint32_t pushes;
+    uint32_t bad_frames;        // 无法解析的行（乱码、透传中的AT指令等）
+    uint32_t segments_dropped;
+    uint32_t segments_split;
+    uint32_t segments_merged;   // 含多条应答/下发的段
+} bemfa_emu_stats_t;
+
+/**
+ * @brief 复位服务器并接入模块模拟器
+ */
+void Bemfa_Emu_Init(const bemfa_emu_cfg_t *cfg);
+
+extern const esp_emu_peer_t bemfa_emu_peer;
+
+/**
+ * @brief 下发 cmd=2&uid=..&topic=<topic>&msg=<msg>
+ * @return 0-成功 -1-没有连接
+ */
+int8_t Bemfa_Emu_Push(const char *topic, const char *msg);
+
+/**
+ * @brief 服务器关闭连接
+ */
+void Bemfa_Emu_Close(void);
+
+uint8_t Bemfa_Emu_Connected(void);
+
+/**
+ * @brief 某主题最近一次发布的消息，没有时返回NULL
+ */
+const char *Bemfa_Emu_Last_Msg(const char *topic);
+
+void Bemfa_Emu_GetStats(bemfa_emu_stats_t *stats);
+
+#endif // __BEMFA_EMU_H
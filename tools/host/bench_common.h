@@ -0,0 +1,37 @@
+/**
+ * @file bench_common.h
+ * @brief 主机基准测试公共计时工具
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __BENCH_COMMON_H
+#define __BENCH_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 防止编译器把结果优化掉
+static volatile uint32_t bench_sink;
+
+/**
+ * @brief 打印一行对比结果
+ * @param name 用例名
+ * @param base_ns 基线每次耗时
+ * @param new_ns 新实现每次耗时
+ */
+static inline void bench_report(const char *name, double base_ns, double new_ns)
+{
+    printf("  %-28s %9.1f ns %9.1f ns   x%.2f\n", name, base_ns, new_ns, base_ns / new_ns);
+}
+
+#endif // __BENCH_COMMON_H
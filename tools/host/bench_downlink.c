@@ -0,0 +1,238 @@
+/**
+ * @file bench_downlink.c
+ * @brief 下发帧分发（downlink.c）与原 ESP8266_Parse_Command 逐主题扫描的主机对比基准
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 基线是改为查表分发之前 esp8266.c 中的实现：对主题表的每一项拼出 "topic=<名称>"，
+ * 在整帧中 strstr 查找，命中后再 strstr 查找 "msg=" 并拷贝出消息，由主题回调 strcmp
+ * 判断 on/off。新实现为 Downlink_Dispatch：一次扫描切分字段，主题和命令二分查找。
+ * 两边都只记录开关结果，参数表与发布接口由本文件替代；printf 两边都丢弃，
+ * 避免串口输出掩盖解析本身的差异。先校验两边对每条帧的处理结果一致，再分别计时。
+ */
+
+#include "bench_common.h"
+#include "bemfa_topics.h"
+#include "downlink.h"
+#include "esp8266.h"
+#include "param.h"
+#include "log.h"
+#include <stdarg.h>
+#include <string.h>
+
+#define BENCH_ITER      2000000UL
+
+// 一次分发的结果：被修改的开关参数及其值
+static int applied_id;
+static int applied_value;
+
+int bench_printf(const char *fmt, ...)
+{
+    return 0;
+}
+
+// ==================================
+// 固件接口替身
+// ==================================
+
+int8_t Param_Set(param_id_t id, uint16_t value)
+{
+    applied_id = (int)id;
+    applied_value = value;
+    return 0;
+}
+
+const param_def_t *Param_Def(param_id_t id)
+{
+    return NULL;
+}
+
+param_id_t Param_Find(const char *name, uint16_t len)
+{
+    return PARAM_COUNT;
+}
+
+uint16_t Param_Format(char *buf, uint16_t size)
+{
+    buf[0] = '\0';
+    return 0;
+}
+
+uint8_t ESP8266_TCP_Publish(const char *uid, const char *topic, const char *data)
+{
+    return 1;
+}
+
+uint8_t ESP8266_TCP_Publish_Batch(const char *uid, esp8266_pub_t *items, uint8_t count)
+{
+    return count;
+}
+
+uint8_t Log_Enabled(log_module_t mod, uint8_t level)
+{
+    return 0;
+}
+
+void Log_Write(log_module_t mod, uint8_t level, const char *fmt, ...)
+{
+}
+
+// ==================================
+// 基线：原 esp8266.c 的逐主题扫描（bemfa_topics.c 的开关回调）
+// ==================================
+
+static uint8_t base_parse_command(const char *buffer, const char *topic, char *msg_value)
+{
+    if (buffer == NULL || topic == NULL || msg_value == NULL)
+    {
+        return 0;
+    }
+
+    char temp_topic[64];
+    snprintf(temp_topic, sizeof(temp_topic), "topic=%s", topic);
+
+    if (strstr(buffer, temp_topic) == NULL)
+    {
+        bench_printf("Topic not found\r\n");
+        return 0;
+    }
+
+    const char *msg_start = strstr(buffer, "msg=");
+    if (msg_start == NULL)
+    {
+        bench_printf("msg parameter not found\r\n");
+        return 0;
+    }
+    msg_start += 4;
+
+    int i = 0;
+    while (msg_start[i] != '\0' && msg_start[i] != '&' && msg_start[i] != '\r' && msg_start[i] != '\n' && i < 31)
+    {
+        msg_value[i] = msg_start[i];
+        i++;
+    }
+    msg_value[i] = '\0';
+    return 1;
+}
+
+static uint8_t base_set_switch(int id, const char *msg)
+{
+    if (strcmp(msg, "on") == 0)
+    {
+        Param_Set((param_id_t)id, 1);
+        return 1;
+    }
+    else if (strcmp(msg, "off") == 0)
+    {
+        Param_Set((param_id_t)id, 0);
+        return 1;
+    }
+    return 0;
+}
+
+static uint8_t base_dispatch(const char *buffer)
+{
+    char msg_value[32] = {0};
+
+    bench_printf("Processing command: %s\r\n", buffer);
+    for (uint8_t i = 0; i < bemfa_topic_count; i++)
+    {
+        const bemfa_topic_t *t = &bemfa_topics[i];
+        if (base_parse_command(buffer, t->name, msg_value))
+        {
+            bench_printf("Found %s topic, msg_value: %s\r\n", t->name, msg_value);
+            base_set_switch(t->sw, msg_value);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ==================================
+// 驱动
+// ==================================
+
+#define UID "4af24e3731744508bd519435397e4ab5"
+
+typedef struct
+{
+    const char *name;
+    const char *frame;
+} bench_case_t;
+
+static const bench_case_t cases[] = {
+    {"first topic  mydht004 off", "cmd=2&uid=" UID "&topic=mydht004&msg=off"},
+    {"first topic  mydht004 on", "cmd=2&uid=" UID "&topic=mydht004&msg=on"},
+    {"second topic myMP25004 off", "cmd=2&uid=" UID "&topic=myMP25004&msg=off"},
+    {"last topic   myLUX004 on", "cmd=2&uid=" UID "&topic=myLUX004&msg=on"},
+    {"unknown command", "cmd=2&uid=" UID "&topic=myLUX004&msg=blink"},
+    {"unknown topic", "cmd=2&uid=" UID "&topic=myTEMP009&msg=on"},
+};
+
+#define CASE_COUNT (sizeof(cases) / sizeof(cases[0]))
+
+static uint16_t frame_len[CASE_COUNT];
+
+static double time_base(size_t c)
+{
+    uint64_t t0 = bench_now_ns();
+
+    for (unsigned long i = 0; i < BENCH_ITER; i++)
+    {
+        bench_sink += base_dispatch(cases[c].frame);
+    }
+    return (double)(bench_now_ns() - t0) / BENCH_ITER;
+}
+
+static double time_new(size_t c)
+{
+    uint64_t t0 = bench_now_ns();
+
+    for (unsigned long i = 0; i < BENCH_ITER; i++)
+    {
+        bench_sink += Downlink_Dispatch(cases[c].frame, frame_len[c]);
+    }
+    return (double)(bench_now_ns() - t0) / BENCH_ITER;
+}
+
+int main(void)
+{
+    double base_total = 0, new_total = 0;
+
+    // 处理结果一致：同一个开关参数被设为同一个值，或都未修改
+    for (size_t c = 0; c < CASE_COUNT; c++)
+    {
+        int base_id, base_value;
+
+        frame_len[c] = (uint16_t)strlen(cases[c].frame);
+        applied_id = -1;
+        applied_value = -1;
+        base_dispatch(cases[c].frame);
+        base_id = applied_id;
+        base_value = applied_value;
+
+        applied_id = -1;
+        applied_value = -1;
+        Downlink_Dispatch(cases[c].frame, frame_len[c]);
+        if (applied_id != base_id || applied_value != base_value)
+        {
+            printf("MISMATCH %s: param %d=%d vs %d=%d\n", cases[c].name, base_id, base_value, applied_id,
+                   applied_value);
+            return 1;
+        }
+    }
+
+    printf("downlink dispatch vs per-topic scan, %lu frames per case\n", BENCH_ITER);
+    printf("  %-28s %12s %12s %8s\n", "case", "scan", "dispatch", "speedup");
+    for (size_t c = 0; c < CASE_COUNT; c++)
+    {
+        double base_ns = time_base(c);
+        double new_ns = time_new(c);
+        base_total += base_ns;
+        new_total += new_ns;
+        bench_report(cases[c].name, base_ns, new_ns);
+    }
+    bench_report("all cases", base_total, new_total);
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file bench_strfmt.c
+ * @brief strfmt 与 snprintf/vsnprintf 的主机对比基准
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 每个用例对应固件中被替换的一处格式化（首页时钟、三个发布载荷、传感器页面），
+ * 先校验两种实现输出逐字节一致，再各自循环计时。主机上的绝对耗时与 Cortex-M3
+ * 不同，比值用于确认热路径确实变快；浮点格式在无FPU的目标上差距更大。
+ */
+
+#include "bench_common.h"
+#include "strfmt.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_ITER      2000000UL
+#define BENCH_SAMPLES   64          // 输入样本数，循环取用避免常量折叠
+
+typedef struct {
+    uint8_t hour, min, sec;
+    uint8_t temp_int, temp_deci, humi;
+    uint16_t lux;
+    float pm25;
+    uint8_t level;
+    float data;
+} sample_t;
+
+static sample_t samples[BENCH_SAMPLES];
+
+// ==================================
+// 基线：固件原先经过的 vsnprintf 路径（OLED_Printf 同样先进 vsnprintf）
+// ==================================
+
+static int base_printf(char *buf, size_t size, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(buf, size, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+static void base_clock(char *buf, const sample_t *s)
+{
+    base_printf(buf, 24, "%02d:%02d:%02d", s->hour, s->min, s->sec);
+}
+
+static void base_dht11(char *buf, const sample_t *s)
+{
+    base_printf(buf, 24, "on#%d.%d#%d", s->temp_int, s->temp_deci, s->humi);
+}
+
+static void base_lux(char *buf, const sample_t *s)
+{
+    base_printf(buf, 24, "#%d", s->lux);
+}
+
+static void base_pm25(char *buf, const sample_t *s)
+{
+    base_printf(buf, 24, "#%0.1f#%d", s->pm25, s->level);
+}
+
+static void base_pm25_line(char *buf, const sample_t *s)
+{
+    base_printf(buf, 24, "PM2.5: %.1f ug/m3", s->pm25);
+}
+
+static void base_data_line(char *buf, const sample_t *s)
+{
+    base_printf(buf, 24, "Data1: %.2f %s", s->data, "lux");
+}
+
+// ==================================
+// strfmt 实现（与固件调用处相同的写法）
+// ==================================
+
+static void new_clock(char *buf, const sample_t *s)
+{
+    fmt_buf_t f;
+    fmt_init(&f, buf, 24);
+    fmt_2d(&f, s->hour);
+    fmt_char(&f, ':');
+    fmt_2d(&f, s->min);
+    fmt_char(&f, ':');
+    fmt_2d(&f, s->sec);
+}
+
+static void new_dht11(char *buf, const sample_t *s)
+{
+    fmt_buf_t f;
+    fmt_init(&f, buf, 24);
+    fmt_str(&f, "on#");
+    fmt_u32(&f, s->temp_int, 0, ' ');
+    fmt_char(&f, '.');
+    fmt_u32(&f, s->temp_deci, 0, ' ');
+    fmt_char(&f, '#');
+    fmt_u32(&f, s->humi, 0, ' ');
+}
+
+static void new_lux(char *buf, const sample_t *s)
+{
+    fmt_buf_t f;
+    fmt_init(&f, buf, 24);
+    fmt_char(&f, '#');
+    fmt_u32(&f, s->lux, 0, ' ');
+}
+
+static void new_pm25(char *buf, const sample_t *s)
+{
+    fmt_buf_t f;
+    fmt_init(&f, buf, 24);
+    fmt_char(&f, '#');
+    fmt_fixed(&f, fmt_to_fixed(s->pm25, 1), 1, 0);
+    fmt_char(&f, '#');
+    fmt_u32(&f, s->level, 0, ' ');
+}
+
+static void new_pm25_line(char *buf, const sample_t *s)
+{
+    fmt_buf_t f;
+    fmt_init(&f, buf, 24);
+    fmt_str(&f, "PM2.5: ");
+    fmt_fixed(&f, fmt_to_fixed(s->pm25, 1), 1, 0);
+    fmt_str(&f, " ug/m3");
+}
+
+static void new_data_line(char *buf, const sample_t *s)
+{
+    fmt_buf_t f;
+    fmt_init(&f, buf, 24);
+    fmt_str(&f, "Data1: ");
+    fmt_fixed(&f, fmt_to_fixed(s->data, 2), 2, 0);
+    fmt_char(&f, ' ');
+    fmt_str(&f, "lux");
+}
+
+// ==================================
+// 驱动
+// ==================================
+
+typedef void (*format_fn)(char *buf, const sample_t *s);
+
+typedef struct {
+    const char *name;
+    format_fn base;
+    format_fn fast;
+} bench_case_t;
+
+static const bench_case_t cases[] = {
+    {"index clock  %02d:%02d:%02d", base_clock, new_clock},
+    {"publish dht11 on#%d.%d#%d", base_dht11, new_dht11},
+    {"publish lux  #%d", base_lux, new_lux},
+    {"publish pm25 #%0.1f#%d", base_pm25, new_pm25},
+    {"page  PM2.5: %.1f ug/m3", base_pm25_line, new_pm25_line},
+    {"page  Data1: %.2f %s", base_data_line, new_data_line},
+};
+
+#define CASE_COUNT (sizeof(cases) / sizeof(cases[0]))
+
+static void samples_init(void)
+{
+    srand(1234);
+    for (int i = 0; i < BENCH_SAMPLES; i++)
+    {
+        sample_t *s = &samples[i];
+        s->hour = (uint8_t)(rand() % 24);
+        s->min = (uint8_t)(rand() % 60);
+        s->sec = (uint8_t)(rand() % 60);
+        s->temp_int = (uint8_t)(rand() % 50);
+        s->temp_deci = (uint8_t)(rand() % 10);
+        s->humi = (uint8_t)(rand() % 100);
+        s->lux = (uint16_t)(rand() % 20000);
+        // 取 x.x5 以外的值，避免二进制舍入差异导致两种实现末位不同
+        s->pm25 = (float)(rand() % 5000) / 10.0f + 0.02f;
+        s->level = (uint8_t)(rand() % 6);
+        s->data = (float)(rand() % 100000) / 100.0f + 0.001f;
+    }
+}
+
+static double time_fn(format_fn fn)
+{
+    char buf[24];
+    uint64_t t0 = bench_now_ns();
+
+    for (unsigned long i = 0; i < BENCH_ITER; i++)
+    {
+        fn(buf, &samples[i & (BENCH_SAMPLES - 1)]);
+        bench_sink += (uint8_t)buf[1];
+    }
+    return (double)(bench_now_ns() - t0) / BENCH_ITER;
+}
+
+int main(void)
+{
+    int failed = 0;
+    double base_total = 0, fast_total = 0;
+
+    samples_init();
+
+    // 输出一致性
+    for (size_t c = 0; c < CASE_COUNT; c++)
+    {
+        for (int i = 0; i < BENCH_SAMPLES; i++)
+        {
+            char a[24], b[24];
+            cases[c].base(a, &samples[i]);
+            cases[c].fast(b, &samples[i]);
+            if (strcmp(a, b) != 0)
+            {
+                printf("MISMATCH %s: \"%s\" vs \"%s\"\n", cases[c].name, a, b);
+                failed = 1;
+                break;
+            }
+        }
+    }
+    if (failed)
+    {
+        return 1;
+    }
+
+    printf("strfmt vs vsnprintf, %lu iterations per case\n", BENCH_ITER);
+    printf("  %-28s %12s %12s %8s\n", "case", "vsnprintf", "strfmt", "speedup");
+    for (size_t c = 0; c < CASE_COUNT; c++)
+    {
+        double base_ns = time_fn(cases[c].base);
+        double fast_ns = time_fn(cases[c].fast);
+        base_total += base_ns;
+        fast_total += fast_ns;
+        bench_report(cases[c].name, base_ns, fast_ns);
+    }
+    bench_report("all cases", base_total, fast_total);
+    return 0;
+}
@@ -0,0 +1,1034 @@
+/**
+ * @file esp_emu.c
+ * @brief 脚本化 ESP8266 AT 固件模拟器实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "esp_emu.h"
+#include "sim.h"
+#include "sim_uart.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EMU_LINE_MAX        256     // 指令行缓冲
+#define EMU_DATA_MAX        2048    // 单次 AT+CIPSEND 及透传打包的最大长度
+#define EMU_PACK_US         20000   // 透传模式串口空闲多久后打包发出
+#define EMU_BOOT_US         300000  // 复位到输出 ready 的时间
+#define EMU_BOOT_BAUD       74880   // 复位时 ROM 日志的波特率
+#define EMU_DEFAULT_BAUD    115200
+
+typedef struct
+{
+    uint8_t open;
+    uint8_t dead;               // 静默失效：数据丢弃，不上报
+    uint32_t gen;               // 每次建立连接递增，上一连接的在途数据和关闭通知作废
+    const esp_emu_peer_t *peer;
+} emu_link_t;
+
+typedef struct
+{
+    uint32_t epoch;
+    uint16_t len;
+    uint8_t data[];
+} emu_out_t;
+
+typedef struct
+{
+    uint32_t epoch;
+    uint32_t gen;
+    uint8_t link;
+    uint16_t len;
+    uint8_t data[];
+} emu_seg_t;
+
+// ==================================
+// 静态变量
+// ==================================
+
+static esp_emu_cfg_t cfg;
+static const esp_emu_peer_t *emu_cloud = NULL;
+static const esp_emu_peer_t *emu_lan = NULL;
+static esp_emu_stats_t stats;
+
+static struct
+{
+    uint32_t epoch;             // 复位时递增，作废在途事件
+    uint32_t baud;
+    uint32_t next_baud;
+    uint16_t bad_left;
+    uint8_t echo;
+    uint8_t cipmode;
+    uint8_t mux;
+    uint8_t server;
+    uint8_t server_max;
+    uint8_t joined;
+    uint8_t has_ap;             // 已保存AP，复位或断开后自动重新加入
+    uint8_t passthrough;
+    uint8_t join_attempts;
+    uint64_t ap_back;           // AP 在此之前不可达
+    uint64_t busy_until;
+    uint64_t last_out;          // 输出按处理顺序排列
+
+    char line[EMU_LINE_MAX];
+    uint16_t line_len;
+
+    uint8_t send_active;
+    uint8_t send_link;
+    uint16_t send_len;
+    uint16_t send_got;
+    uint8_t send_buf[EMU_DATA_MAX];
+
+    uint8_t pack[EMU_DATA_MAX];
+    uint16_t pack_len;
+    uint32_t pack_gen;
+
+    emu_link_t links[ESP_EMU_LINKS];
+} emu;
+
+// ==================================
+// 串口输出
+// ==================================
+
+static void emu_uart_send(const void *data, uint16_t len)
+{
+    if (cfg.drop_percent != 0 && sim_rand() % 100 < cfg.drop_percent)
+    {
+        stats.dropped++;
+        sim_log("esp: dropped %u bytes\n", len);
+        return;
+    }
+    if (cfg.bad_baud != 0 && emu.baud == cfg.bad_baud && emu.bad_left > 0)
+    {
+        uint8_t junk[EMU_DATA_MAX];
+        uint16_t n = Sim_UART_Garble(junk, len < EMU_DATA_MAX ? len : EMU_DATA_MAX, emu.baud, emu.baud);
+        if (emu.bad_left != ESP_EMU_BAD_FOREVER)
+        {
+            emu.bad_left--;
+        }
+        stats.garbled++;
+        Sim_UART_Module_Send(junk, n, emu.baud);
+        return;
+    }
+    Sim_UART_Module_Send(data, len, emu.baud);
+}
+
+static void emu_out_event(void *arg)
+{
+    emu_out_t *o = arg;
+
+    if (o->epoch == emu.epoch)
+    {
+        emu_uart_send(o->data, o->len);
+    }
+    free(o);
+}
+
+/**
+ * @brief 在 delay 后输出，不早于之前已安排的输出
+ */
+static void emu_out(uint64_t delay, const void *data, uint16_t len)
+{
+    emu_out_t *o = malloc(sizeof(*o) + len);
+    uint64_t at = sim_time_us() + delay;
+
+    if (at < emu.last_out)
+    {
+        at = emu.last_out;
+    }
+    emu.last_out = at;
+    o->epoch = emu.epoch;
+    o->len = len;
+    memcpy(o->data, data, len);
+    sim_event_at(at, emu_out_event, o);
+}
+
+static void emu_say(uint64_t delay, const char *s)
+{
+    emu_out(delay, s, (uint16_t)strlen(s));
+}
+
+static uint64_t emu_latency(void)
+{
+    return cfg.cmd_latency_us + (cfg.cmd_jitter_us ? sim_rand_range(0, cfg.cmd_jitter_us) : 0);
+}
+
+// ==================================
+// 连接
+// ==================================
+
+static void emu_link_report_closed(uint64_t delay, uint8_t link)
+{
+    char buf[16];
+
+    if (emu.mux)
+    {
+        snprintf(buf, sizeof(buf), "%u,CLOSED\r\n", link);
+        emu_say(delay, buf);
+    }
+    else
+    {
+        emu_say(delay, "CLOSED\r\n");
+    }
+}
+
+static void emu_link_open(uint8_t link, const esp_emu_peer_t *peer)
+{
+    emu.links[link].open = 1;
+    emu.links[link].dead = 0;
+    emu.links[link].gen++;
+    emu.links[link].peer = peer;
+}
+
+typedef struct
+{
+    uint8_t link;
+    uint32_t gen;
+} emu_fin_t;
+
+static void emu_fin_event(void *arg)
+{
+    emu_fin_t *f = arg;
+    emu_link_t *l = &emu.links[f->link];
+
+    if (f->gen == l->gen && l->peer != NULL && l->peer->closed != NULL)
+    {
+        l->peer->closed(f->link);
+    }
+    free(f);
+}
+
+/**
+ * @brief 关闭连接，经网络延迟通知对端（此前发出的数据先到达）
+ */
+static void emu_link_close(uint8_t link)
+{
+    emu_link_t *l = &emu.links[link];
+    emu_fin_t *f;
+
+    if (!l->open)
+    {
+        return;
+    }
+    l->open = 0;
+    l->dead = 0;
+    f = malloc(sizeof(*f));
+    f->link = link;
+    f->gen = l->gen;
+    sim_event_after(cfg.net_delay_us, emu_fin_event, f);
+}
+
+static void emu_close_all(uint8_t report)
+{
+    for (uint8_t i = 0; i < ESP_EMU_LINKS; i++)
+    {
+        if (emu.links[i].open)
+        {
+            emu_link_close(i);
+            if (report)
+            {
+                emu_link_report_closed(0, i);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 数据段经网络延迟到达对端
+ */
+static void emu_up_event(void *arg)
+{
+    emu_seg_t *s = arg;
+    emu_link_t *l = &emu.links[s->link];
+
+    // 关闭前发出的数据照常到达，连接号被新连接占用后作废
+    if (s->epoch == emu.epoch && s->gen == l->gen && !l->dead && l->peer != NULL && l->peer->recv != NULL)
+    {
+        l->peer->recv(s->link, s->data, s->len);
+    }
+    free(s);
+}
+
+static void emu_send_up(uint8_t link, const uint8_t *data, uint16_t len)
+{
+    emu_seg_t *s;
+
+    if (!emu.links[link].open || emu.links[link].dead)
+    {
+        return;
+    }
+    s = malloc(sizeof(*s) + len);
+    s->epoch = emu.epoch;
+    s->gen = emu.links[link].gen;
+    s->link = link;
+    s->len = len;
+    memcpy(s->data, data, len);
+    stats.segments_up++;
+    stats.bytes_up += len;
+    sim_event_after(cfg.net_delay_us, emu_up_event, s);
+}
+
+// ==================================
+// 透传
+// ==================================
+
+static void emu_pack_flush(void)
+{
+    if (emu.pack_len > 0)
+    {
+        emu_send_up(0, emu.pack, emu.pack_len);
+        emu.pack_len = 0;
+    }
+}
+
+static void emu_pack_event(void *arg)
+{
+    if ((uint32_t)(uintptr_t)arg == emu.pack_gen)
+    {
+        emu_pack_flush();
+    }
+}
+
+static void emu_passthrough_rx(const uint8_t *data, uint16_t len)
+{
+    // 单独一段 "+++" 退出透传
+    if (len == 3 && memcmp(data, "+++", 3) == 0)
+    {
+        emu_pack_flush();
+        emu.passthrough = 0;
+        sim_log("esp: exit passthrough\n");
+        return;
+    }
+    for (uint16_t i = 0; i < len; i++)
+    {
+        if (emu.pack_len >= EMU_DATA_MAX)
+        {
+            emu_pack_flush();
+        }
+        emu.pack[emu.pack_len++] = data[i];
+    }
+    emu.pack_gen++;
+    sim_event_after(EMU_PACK_US, emu_pack_event, (void *)(uintptr_t)emu.pack_gen);
+}
+
+// ==================================
+// 指令
+// ==================================
+
+typedef struct
+{
+    uint32_t epoch;
+    uint8_t ok;
+} emu_join_t;
+
+static void emu_join_event(void *arg)
+{
+    emu_join_t *j = arg;
+
+    if (j->epoch == emu.epoch)
+    {
+        if (j->ok && sim_time_us() >= emu.ap_back)
+        {
+            emu.joined = 1;
+            emu.has_ap = 1;
+            emu_say(0, "WIFI CONNECTED\r\nWIFI GOT IP\r\n\r\nOK\r\n");
+        }
+        else
+        {
+            stats.errors++;
+            emu_say(0, "+CWJAP:3\r\n\r\nFAIL\r\n");
+        }
+    }
+    free(j);
+}
+
+static void emu_cmd_join(const char *args, uint64_t t)
+{
+    char ssid[64] = "", pwd[64] = "";
+    emu_join_t *j = malloc(sizeof(*j));
+
+    sscanf(args, "\"%63[^\"]\",\"%63[^\"]\"", ssid, pwd);
+    if (emu.joined)
+    {
+        emu.joined = 0;
+        emu_close_all(1);
+        emu_say(t, "WIFI DISCONNECT\r\n");
+    }
+    j->epoch = emu.epoch;
+    j->ok = strcmp(ssid, cfg.ssid) == 0 && strcmp(pwd, cfg.password) == 0 &&
+            emu.join_attempts >= cfg.join_failures;
+    emu.join_attempts++;
+    emu.busy_until = sim_time_us() + t + SIM_MS(cfg.join_ms);
+    sim_event_at(emu.busy_until, emu_join_event, j);
+}
+
+typedef struct
+{
+    uint32_t epoch;
+    uint8_t link;
+    uint8_t ok;
+} emu_connect_t;
+
+static void emu_connect_event(void *arg)
+{
+    emu_connect_t *c = arg;
+    char buf[24];
+
+    if (c->epoch == emu.epoch)
+    {
+        if (c->ok)
+        {
+            if (emu.mux)
+            {
+                snprintf(buf, sizeof(buf), "%u,CONNECT\r\n\r\nOK\r\n", c->link);
+                emu_say(0, buf);
+            }
+            else
+            {
+                emu_say(0, "CONNECT\r\n\r\nOK\r\n");
+            }
+        }
+        else
+        {
+            stats.errors++;
+            emu.links[c->link].open = 0;
+            emu_say(0, "\r\nERROR\r\nCLOSED\r\n");
+        }
+    }
+    free(c);
+}
+
+static void emu_cmd_connect(const char *args, uint64_t t)
+{
+    unsigned link = 0, port = 0;
+    char type[8] = "", host[64] = "";
+    emu_connect_t *c;
+    int n;
+
+    if (emu.mux)
+    {
+        n = sscanf(args, "%u,\"%7[^\"]\",\"%63[^\"]\",%u", &link, type, host, &port);
+        n = (n == 4);
+    }
+    else
+    {
+        n = sscanf(args, "\"%7[^\"]\",\"%63[^\"]\",%u", type, host, &port) == 3;
+    }
+    if (!n || link >= ESP_EMU_LINKS || strcmp(type, "TCP") != 0 || !emu.joined)
+    {
+        stats.errors++;
+        emu_say(t, "\r\nERROR\r\n");
+        return;
+    }
+    if (emu.links[link].open)
+    {
+        stats.errors++;
+        emu_say(t, "ALREADY CONNECTED\r\n\r\nERROR\r\n");
+        return;
+    }
+
+    c = malloc(sizeof(*c));
+    c->epoch = emu.epoch;
+    c->link = (uint8_t)link;
+    c->ok = emu_cloud != NULL && emu_cloud->connect((uint8_t)link, host, (uint16_t)port);
+    if (c->ok)
+    {
+        emu_link_open((uint8_t)link, emu_cloud);
+    }
+    emu.busy_until = sim_time_us() + t + SIM_MS(cfg.connect_ms);
+    sim_event_at(emu.busy_until, emu_connect_event, c);
+}
+
+static void emu_cmd_send(const char *args, uint64_t t)
+{
+    unsigned link = 0, len = 0;
+    int n;
+
+    if (args == NULL)
+    {
+        // 透传：单连接、CIPMODE=1
+        if (emu.mux || emu.cipmode != 1 || !emu.links[0].open)
+        {
+            stats.errors++;
+            emu_say(t, "\r\nERROR\r\n");
+            return;
+        }
+        emu.passthrough = 1;
+        emu.pack_len = 0;
+        emu_say(t, "\r\nOK\r\n\r\n>");
+        return;
+    }
+
+    n = emu.mux ? (sscanf(args, "%u,%u", &link, &len) == 2) : (sscanf(args, "%u", &len) == 1);
+    if (!n || link >= ESP_EMU_LINKS || !emu.links[link].open || len == 0 || len > EMU_DATA_MAX)
+    {
+        stats.errors++;
+        emu_say(t, "link is not valid\r\n\r\nERROR\r\n");
+        return;
+    }
+    emu.send_active = 1;
+    emu.send_link = (uint8_t)link;
+    emu.send_len = (uint16_t)len;
+    emu.send_got = 0;
+    emu_say(t, "\r\nOK\r\n> ");
+}
+
+static void emu_cmd_close(const char *args, uint64_t t)
+{
+    unsigned link = 0;
+
+    if (args != NULL && sscanf(args, "%u", &link) != 1)
+    {
+        link = ESP_EMU_LINKS;
+    }
+    if (link >= ESP_EMU_LINKS || !emu.links[link].open)
+    {
+        stats.errors++;
+        emu_say(t, "\r\nERROR\r\n");
+        return;
+    }
+    emu_link_close((uint8_t)link);
+    emu_link_report_closed(t, (uint8_t)link);
+    emu_say(t, "\r\nOK\r\n");
+}
+
+static void emu_baud_switch_event(void *arg)
+{
+    if ((uint32_t)(uintptr_t)arg == emu.epoch)
+    {
+        emu.baud = emu.next_baud;
+        emu.bad_left = cfg.bad_bursts;
+        stats.baud_switches++;
+        sim_log("esp: uart %u baud\n", emu.baud);
+    }
+}
+
+/**
+ * @brief OK 已排上线路后，等它按原速率发完再切换
+ */
+static void emu_baud_arm_event(void *arg)
+{
+    if ((uint32_t)(uintptr_t)arg == emu.epoch)
+    {
+        uint64_t wait = Sim_UART_Module_Pending() * Sim_UART_Byte_Us(emu.baud) + 100;
+        sim_event_after(wait, emu_baud_switch_event, arg);
+    }
+}
+
+static void emu_cmd_uart(const char *args, uint64_t t)
+{
+    unsigned long baud = 0;
+    unsigned bits = 0, stop = 0, parity = 0, flow = 0;
+
+    if (sscanf(args, "%lu,%u,%u,%u,%u", &baud, &bits, &stop, &parity, &flow) != 5 ||
+        baud < 110 || baud > 4608000 || bits != 8)
+    {
+        stats.errors++;
+        emu_say(t, "\r\nERROR\r\n");
+        return;
+    }
+    emu_say(t, "\r\nOK\r\n");
+    emu.next_baud = (uint32_t)baud;
+    sim_event_at(emu.last_out, emu_baud_arm_event, (void *)(uintptr_t)emu.epoch);
+}
+
+static void emu_reset_event(void *arg);
+
+static void emu_command(const char *line)
+{
+    uint64_t t = emu_latency();
+    const char *eq = strchr(line, '=');
+    const char *args = eq != NULL ? eq + 1 : NULL;
+    unsigned n = 0;
+
+    stats.commands++;
+    sim_log("esp: <- %s\n", line);
+    if (emu.echo)
+    {
+        emu_say(0, line);
+        emu_say(0, "\r\n");
+    }
+    if (sim_time_us() < emu.busy_until)
+    {
+        stats.busy++;
+        emu_say(t, "busy p...\r\n");
+        return;
+    }
+
+#define CMD_IS(s)       (strcmp(line, s) == 0)
+#define CMD_SET(s)      (strncmp(line, s "=", sizeof(s)) == 0)
+
+    if (CMD_IS("AT"))
+    {
+        emu_say(t, "\r\nOK\r\n");
+    }
+    else if (CMD_IS("ATE0") || CMD_IS("ATE1"))
+    {
+        emu.echo = (line[3] == '1');
+        emu_say(t, "\r\nOK\r\n");
+    }
+    else if (CMD_IS("AT+RST"))
+    {
+        emu_say(t, "\r\nOK\r\n");
+        sim_event_after(t + SIM_MS(10), emu_reset_event, (void *)(uintptr_t)emu.epoch);
+    }
+    else if (CMD_SET("AT+UART_CUR"))
+    {
+        emu_cmd_uart(args, t);
+    }
+    else if (CMD_SET("AT+CWMODE") || CMD_SET("AT+CWMODE_CUR") || CMD_SET("AT+CIPSTO") ||
+             CMD_SET("AT+CIPSERVERMAXCONN"))
+    {
+        if (CMD_SET("AT+CIPSERVERMAXCONN") && sscanf(args, "%u", &n) == 1 && n > 0 && n <= ESP_EMU_LINKS)
+        {
+            emu.server_max = (uint8_t)n;
+        }
+        emu_say(t, "\r\nOK\r\n");
+    }
+    else if (CMD_SET("AT+CWJAP") || CMD_SET("AT+CWJAP_CUR"))
+    {
+        emu_cmd_join(args, t);
+    }
+    else if (CMD_SET("AT+CIPMODE"))
+    {
+        n = (unsigned)atoi(args);
+        if (n > 1 || (n == 1 && emu.mux))
+        {
+            stats.errors++;
+            emu_say(t, "\r\nERROR\r\n");
+        }
+        else
+        {
+            emu.cipmode = (uint8_t)n;
+            emu_say(t, "\r\nOK\r\n");
+        }
+    }
+    else if (CMD_SET("AT+CIPMUX"))
+    {
+        uint8_t busy = emu.server;
+        n = (unsigned)atoi(args);
+        for (uint8_t i = 0; i < ESP_EMU_LINKS; i++)
+        {
+            busy |= emu.links[i].open;
+        }
+        if (n > 1 || (n != emu.mux && busy) || (n == 1 && emu.cipmode == 1))
+        {
+            stats.errors++;
+            emu_say(t, n != emu.mux && busy ? "link is builded\r\n\r\nERROR\r\n" : "\r\nERROR\r\n");
+        }
+        else
+        {
+            emu.mux = (uint8_t)n;
+            emu_say(t, "\r\nOK\r\n");
+        }
+    }
+    else if (CMD_SET("AT+CIPSERVER"))
+    {
+        n = (unsigned)atoi(args);
+        if (!emu.mux)
+        {
+            stats.errors++;
+            emu_say(t, "\r\nERROR\r\n");
+        }
+        else
+        {
+            emu.server = (uint8_t)(n == 1);
+            emu_say(t, "\r\nOK\r\n");
+        }
+    }
+    else if (CMD_SET("AT+CIPSTART"))
+    {
+        emu_cmd_connect(args, t);
+    }
+    else if (CMD_IS("AT+CIPSEND") || CMD_SET("AT+CIPSEND"))
+    {
+        emu_cmd_send(args, t);
+    }
+    else if (CMD_IS("AT+CIPCLOSE") || CMD_SET("AT+CIPCLOSE"))
+    {
+        emu_cmd_close(args, t);
+    }
+    else
+    {
+        stats.errors++;
+        emu_say(t, "\r\nERROR\r\n");
+    }
+#undef CMD_IS
+#undef CMD_SET
+}
+
+// ==================================
+// 串口输入
+// ==================================
+
+static void emu_send_complete(void)
+{
+    char buf[32];
+    uint8_t link = emu.send_link;
+
+    emu.send_active = 0;
+    snprintf(buf, sizeof(buf), "\r\nRecv %u bytes\r\n", emu.send_len);
+    emu_say(emu_latency(), buf);
+    if (!emu.links[link].open)
+    {
+        stats.errors++;
+        emu_say(0, "\r\nSEND FAIL\r\n");
+        return;
+    }
+    emu_send_up(link, emu.send_buf, emu.send_len);
+    emu_say(SIM_MS(1), "\r\nSEND OK\r\n");
+}
+
+static void emu_rx_bytes(const uint8_t *data, uint16_t len)
+{
+    uint16_t i = 0;
+
+    if (emu.passthrough)
+    {
+        emu_passthrough_rx(data, len);
+        return;
+    }
+    // 指令模式下单独的 "+++" 不是指令，忽略
+    if (len == 3 && memcmp(data, "+++", 3) == 0)
+    {
+        return;
+    }
+
+    while (i < len)
+    {
+        uint8_t c = data[i++];
+
+        if (emu.send_active)
+        {
+            emu.send_buf[emu.send_got++] = c;
+            if (emu.send_got >= emu.send_len)
+            {
+                emu_send_complete();
+            }
+            continue;
+        }
+        if (c == '\n')
+        {
+            if (emu.line_len > 0 && emu.line[emu.line_len - 1] == '\r')
+            {
+                emu.line_len--;
+            }
+            emu.line[emu.line_len] = '\0';
+            if (emu.line_len > 0)
+            {
+                if (strncmp(emu.line, "AT", 2) != 0)
+                {
+                    // 行首有乱码（如切换波特率期间收到的字节）
+                    stats.commands++;
+                    stats.errors++;
+                    emu_say(emu_latency(), "\r\nERROR\r\n");
+                }
+                else
+                {
+                    emu_command(emu.line);
+                }
+            }
+            emu.line_len = 0;
+            // 进入透传后同一段中的剩余字节属于透传数据
+            if (emu.passthrough && i < len)
+            {
+                emu_passthrough_rx(data + i, (uint16_t)(len - i));
+                return;
+            }
+            continue;
+        }
+        if (emu.line_len < EMU_LINE_MAX - 1)
+        {
+            emu.line[emu.line_len++] = (char)c;
+        }
+    }
+}
+
+/**
+ * @brief 串口线路回调：MCU 发出的一段到达模块
+ */
+static void emu_uart_rx(const uint8_t *data, uint16_t len, uint32_t baud)
+{
+    if (baud != emu.baud)
+    {
+        uint8_t junk[SIM_UART_TX_RING * 8];
+        uint16_t n = Sim_UART_Garble(junk, len, baud, emu.baud);
+        emu_rx_bytes(junk, n);
+        return;
+    }
+    emu_rx_bytes(data, len);
+}
+
+// ==================================
+// 对端数据
+// ==================================
+
+static void emu_down_event(void *arg)
+{
+    emu_seg_t *s = arg;
+    emu_link_t *l = &emu.links[s->link];
+    char head[24];
+
+    // 发送时的连接已关闭，连接号可能已被新连接占用
+    if (s->epoch != emu.epoch || s->gen != l->gen || !l->open || l->dead)
+    {
+        free(s);
+        return;
+    }
+    stats.segments_down++;
+    stats.bytes_down += s->len;
+    if (emu.passthrough && s->link == 0 && !emu.mux)
+    {
+        emu_out(0, s->data, s->len);
+    }
+    else
+    {
+        uint8_t *frame = malloc(sizeof(head) + s->len);
+        int n = emu.mux ? snprintf(head, sizeof(head), "\r\n+IPD,%u,%u:", s->link, s->len)
+                        : snprintf(head, sizeof(head), "\r\n+IPD,%u:", s->len);
+        memcpy(frame, head, (size_t)n);
+        memcpy(frame + n, s->data, s->len);
+        emu_out(0, frame, (uint16_t)(n + s->len));
+        free(frame);
+    }
+    free(s);
+}
+
+void Esp_Emu_Peer_Send(uint8_t link, const void *data, uint16_t len)
+{
+    emu_seg_t *s = malloc(sizeof(*s) + len);
+
+    s->epoch = emu.epoch;
+    s->gen = emu.links[link].gen;
+    s->link = link;
+    s->len = len;
+    memcpy(s->data, data, len);
+    sim_event_after(cfg.net_delay_us, emu_down_event, s);
+}
+
+typedef struct
+{
+    uint32_t epoch;
+    uint32_t gen;
+    uint8_t link;
+} emu_close_t;
+
+static void emu_peer_close_event(void *arg)
+{
+    emu_close_t *c = arg;
+    emu_link_t *l = &emu.links[c->link];
+
+    if (c->epoch == emu.epoch && c->gen == l->gen && l->open)
+    {
+        l->open = 0;
+        if (!l->dead)
+        {
+            emu_link_report_closed(0, c->link);
+        }
+        l->dead = 0;
+    }
+    free(c);
+}
+
+void Esp_Emu_Peer_Close(uint8_t link)
+{
+    emu_close_t *c = malloc(sizeof(*c));
+
+    c->epoch = emu.epoch;
+    c->gen = emu.links[link].gen;
+    c->link = link;
+    sim_event_after(cfg.net_delay_us, emu_peer_close_event, c);
+}
+
+int8_t Esp_Emu_Lan_Accept(void)
+{
+    char buf[16];
+
+    if (!emu.server || !emu.joined)
+    {
+        return -1;
+    }
+    for (uint8_t i = 0; i < emu.server_max; i++)
+    {
+        if (!emu.links[i].open)
+        {
+            emu_link_open(i, emu_lan);
+            snprintf(buf, sizeof(buf), "%u,CONNECT\r\n", i);
+            emu_say(0, buf);
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+// ==================================
+// 故障注入
+// ==================================
+
+static void emu_rejoin_event(void *arg)
+{
+    if ((uint32_t)(uintptr_t)arg == emu.epoch && emu.has_ap && !emu.joined)
+    {
+        emu.joined = 1;
+        emu_say(0, "WIFI CONNECTED\r\nWIFI GOT IP\r\n");
+    }
+}
+
+void Esp_Emu_WiFi_Drop(uint32_t down_ms)
+{
+    sim_log("esp: inject wifi drop %u ms\n", down_ms);
+    emu.ap_back = sim_time_us() + SIM_MS(down_ms);
+    if (emu.joined)
+    {
+        emu.joined = 0;
+        emu_say(0, "WIFI DISCONNECT\r\n");
+        emu_close_all(1);
+    }
+    sim_event_after(SIM_MS(down_ms), emu_rejoin_event, (void *)(uintptr_t)emu.epoch);
+}
+
+void Esp_Emu_Silent_Drop(void)
+{
+    sim_log("esp: inject silent link drop\n");
+    for (uint8_t i = 0; i < ESP_EMU_LINKS; i++)
+    {
+        if (emu.links[i].open && emu.links[i].peer == emu_cloud)
+        {
+            emu.links[i].dead = 1;
+        }
+    }
+}
+
+static void emu_boot(uint8_t power_on)
+{
+    emu.epoch++;
+    emu.baud = EMU_DEFAULT_BAUD;
+    emu.bad_left = cfg.bad_bursts;
+    emu.echo = 1;
+    emu.cipmode = 0;
+    emu.mux = 0;
+    emu.server = 0;
+    emu.server_max = ESP_EMU_LINKS;
+    emu.joined = 0;
+    emu.passthrough = 0;
+    emu.line_len = 0;
+    emu.send_active = 0;
+    emu.pack_len = 0;
+    emu.last_out = 0;
+    emu.busy_until = sim_time_us() + EMU_BOOT_US;
+
+    if (!power_on)
+    {
+        uint8_t junk[200];
+        uint16_t n = Sim_UART_Garble(junk, sizeof(junk), EMU_BOOT_BAUD, EMU_BOOT_BAUD);
+        Sim_UART_Module_Send(junk, n, EMU_BOOT_BAUD);
+        emu.last_out = sim_time_us() + EMU_BOOT_US;
+        emu_say(EMU_BOOT_US, "\r\nready\r\n");
+        if (emu.has_ap)
+        {
+            sim_event_after(EMU_BOOT_US + SIM_MS(cfg.join_ms), emu_rejoin_event, (void *)(uintptr_t)emu.epoch);
+        }
+    }
+}
+
+static void emu_reset_event(void *arg)
+{
+    if ((uint32_t)(uintptr_t)arg == emu.epoch)
+    {
+        Esp_Emu_Reset();
+    }
+}
+
+void Esp_Emu_Reset(void)
+{
+    sim_log("esp: inject module reset\n");
+    stats.resets++;
+    emu_close_all(0);
+    emu_boot(0);
+}
+
+// ==================================
+// 接口实现
+// ==================================
+
+void Esp_Emu_Init(const esp_emu_cfg_t *c)
+{
+    memset(&stats, 0, sizeof(stats));
+    memset(&emu.links, 0, sizeof(emu.links));
+    cfg = *c;
+    if (cfg.boot_baud == 0)
+    {
+        cfg.boot_baud = EMU_DEFAULT_BAUD;
+    }
+    if (cfg.cmd_latency_us == 0)
+    {
+        cfg.cmd_latency_us = 2000;
+    }
+    if (cfg.join_ms == 0)
+    {
+        cfg.join_ms = 2500;
+    }
+    if (cfg.connect_ms == 0)
+    {
+        cfg.connect_ms = 150;
+    }
+    if (cfg.net_delay_us == 0)
+    {
+        cfg.net_delay_us = 20000;
+    }
+    if (cfg.ssid == NULL)
+    {
+        cfg.ssid = "ElevatedNetwork.lt";
+    }
+    if (cfg.password == NULL)
+    {
+        cfg.password = "798798798";
+    }
+
+    emu.has_ap = cfg.boot_joined;
+    emu.join_attempts = 0;
+    emu.ap_back = 0;
+    emu_boot(1);
+    emu.busy_until = 0;
+    emu.baud = cfg.boot_baud;
+    emu.joined = cfg.boot_joined;
+    if (cfg.boot_passthrough && emu_cloud != NULL)
+    {
+        // MCU 单独复位前模块已在透传中
+        emu.echo = 0;
+        emu.cipmode = 1;
+        emu.passthrough = emu_cloud->connect(0, "bemfa.com", 8344);
+        if (emu.passthrough)
+        {
+            emu_link_open(0, emu_cloud);
+        }
+    }
+    Sim_UART_Init(EMU_DEFAULT_BAUD, emu_uart_rx);
+}
+
+void Esp_Emu_Set_Cloud(const esp_emu_peer_t *peer)
+{
+    emu_cloud = peer;
+}
+
+void Esp_Emu_Set_Lan(const esp_emu_peer_t *peer)
+{
+    emu_lan = peer;
+}
+
+uint32_t Esp_Emu_Baud(void)
+{
+    return emu.baud;
+}
+
+uint8_t Esp_Emu_Passthrough(void)
+{
+    return emu.passthrough;
+}
+
+void Esp_Emu_GetStats(esp_emu_stats_t *s)
+{
+    *s = stats;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file esp_emu.h
+ * @brief 脚本化 ESP8266 AT 固件模拟器
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 接在 sim_uart 的另一端，按 ESP8266 NonOS AT 1.7 的应答格式响应固件用到的指令：
+ * AT/ATE0/AT+UART_CUR/AT+CWMODE/AT+CWJAP/AT+CIPMODE/AT+CIPMUX/AT+CIPSERVER/
+ * AT+CIPSTO/AT+CIPSTART/AT+CIPSEND/AT+CIPCLOSE，透传模式（+++ 退出，串口数据
+ * 20ms 无新数据即打包发出）和多连接模式（+IPD,<连接号>,<长度>:<数据>）。
+ * 网络对端（云端服务器、局域网客户端）通过 esp_emu_peer_t 接入。
+ * 故障注入：指令应答延迟与丢失、WiFi 断开、链路关闭或静默失效、模块复位、
+ * 某一波特率下模块发送失真。
+ */
+
+#ifndef __ESP_EMU_H
+#define __ESP_EMU_H
+
+#include <stdint.h>
+
+#define ESP_EMU_LINKS       5
+#define ESP_EMU_BAD_FOREVER 0xFFFF
+
+/**
+ * @brief 场景参数（未设置的字段取默认值，见 Esp_Emu_Init）
+ */
+typedef struct
+{
+    uint32_t boot_baud;         // 开始时的模块波特率（模拟 MCU 单独复位时可高于 115200）
+    uint8_t boot_joined;        // 开始时已加入AP
+    uint8_t boot_passthrough;   // 开始时云端连接已建立并处于透传模式
+    uint32_t cmd_latency_us;    // 指令处理时间
+    uint32_t cmd_jitter_us;     // 处理时间随机增加量上限
+    uint32_t join_ms;           // 加入AP耗时
+    uint32_t connect_ms;        // 建立TCP耗时
+    uint32_t net_delay_us;      // 模块与对端之间的单程网络延迟
+    uint8_t drop_percent;       // 串口输出整段丢失的概率（%）
+    uint32_t bad_baud;          // 该速率下模块发送失真（0-无）
+    uint16_t bad_bursts;        // 每次切换到 bad_baud 后失真的输出段数，ESP_EMU_BAD_FOREVER-一直失真
+    uint8_t join_failures;      // 前几次加入AP失败
+    const char *ssid;
+    const char *password;
+} esp_emu_cfg_t;
+
+/**
+ * @brief 网络对端
+ */
+typedef struct
+{
+    uint8_t (*connect)(uint8_t link, const char *host, uint16_t port);  // 1-接受连接
+    void (*recv)(uint8_t link, const uint8_t *data, uint16_t len);      // 模块发来的一个TCP段
+    void (*closed)(uint8_t link);                                       // 模块关闭了连接
+} esp_emu_peer_t;
+
+/**
+ * @brief 运行计数
+ */
+typedef struct
+{
+    uint32_t commands;          // 处理的AT指令
+    uint32_t errors;            // 应答 ERROR/FAIL 的指令
+    uint32_t busy;              // 应答 busy 的指令
+    uint32_t dropped;           // 丢失的输出段
+    uint32_t garbled;           // 失真的输出段
+    uint32_t baud_switches;
+    uint32_t resets;
+    uint32_t segments_up;       // 发往对端的TCP段
+    uint32_t bytes_up;
+    uint32_t segments_down;     // 对端发来的TCP段
+    uint32_t bytes_down;
+} esp_emu_stats_t;
+
+/**
+ * @brief 按场景参数复位模块，接入串口线路
+ */
+void Esp_Emu_Init(const esp_emu_cfg_t *cfg);
+
+/**
+ * @brief 设置云端（主动连接）和局域网（服务器接入）的对端
+ */
+void Esp_Emu_Set_Cloud(const esp_emu_peer_t *peer);
+void Esp_Emu_Set_Lan(const esp_emu_peer_t *peer);
+
+/**
+ * @brief 对端发来数据（经网络延迟后到达模块）
+ */
+void Esp_Emu_Peer_Send(uint8_t link, const void *data, uint16_t len);
+
+/**
+ * @brief 对端关闭连接
+ */
+void Esp_Emu_Peer_Close(uint8_t link);
+
+/**
+ * @brief 局域网客户端接入服务器
+ * @return 分配的连接号，-1-服务器未开启或连接已满
+ */
+int8_t Esp_Emu_Lan_Accept(void);
+
+/**
+ * @brief 故障注入
+ */
+void Esp_Emu_WiFi_Drop(uint32_t down_ms);   // AP 消失，down_ms 后自动重新加入
+void Esp_Emu_Silent_Drop(void);             // 云端链路静默失效，不上报 CLOSED
+void Esp_Emu_Reset(void);                   // 模块复位：回到 115200、回显开启、连接全部断开
+
+uint32_t Esp_Emu_Baud(void);
+uint8_t Esp_Emu_Passthrough(void);
+void Esp_Emu_GetStats(esp_emu_stats_t *stats);
+
+#endif // __ESP_EMU_H
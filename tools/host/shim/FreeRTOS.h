@@ -0,0 +1,52 @@
+/**
+ * @file FreeRTOS.h
+ * @brief 主机构建用的 FreeRTOS 替身：类型与常量（实现见 sim_rtos.c）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 只覆盖固件WiFi协议栈用到的接口子集，语义与 FreeRTOS 10.5 一致：
+ * 节拍1ms，任务按优先级抢占（在接口调用处切换），临界区为空操作
+ * （同一时刻只有一个任务在运行）。
+ */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  pdTRUE
+#define pdFAIL                  pdFALSE
+#define errQUEUE_FULL           ((BaseType_t)0)
+#define errQUEUE_EMPTY          ((BaseType_t)0)
+
+#define configTICK_RATE_HZ      ((TickType_t)1000)
+#define configMAX_PRIORITIES    5
+#define configTIMER_TASK_PRIORITY 2
+#define configMINIMAL_STACK_SIZE 130
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS      ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(((TickType_t)(ms) * configTICK_RATE_HZ) / (TickType_t)1000U))
+
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+
+#define configASSERT(x)         do { if (!(x)) { sim_assert_failed(__FILE__, __LINE__); } } while (0)
+
+void sim_assert_failed(const char *file, int line);
+
+void *pvPortMalloc(size_t size);
+void vPortFree(void *p);
+size_t xPortGetFreeHeapSize(void);
+BaseType_t xPortIsInsideInterrupt(void);
+
+#endif // INC_FREERTOS_H
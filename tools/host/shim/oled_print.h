@@ -0,0 +1,14 @@
+/**
+ * @file oled_print.h
+ * @brief 主机构建用的替身（rtc_date.h 包含，WiFi协议栈不使用显示）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __OLED_PRINT_H
+#define __OLED_PRINT_H
+
+#include "stm32f10x.h"
+
+#endif
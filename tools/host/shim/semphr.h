@@ -0,0 +1,23 @@
+/**
+ * @file semphr.h
+ * @brief 主机构建用的 FreeRTOS 信号量接口替身（计数队列实现，无优先级继承）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#include "queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+
+#define xSemaphoreTake(s, t)            xQueueReceive((s), NULL, (t))
+#define xSemaphoreGive(s)               xQueueSend((s), NULL, 0)
+#define xSemaphoreGiveFromISR(s, w)     xQueueSendFromISR((s), NULL, (w))
+
+#endif // SEMAPHORE_H
@@ -0,0 +1,17 @@
+/**
+ * @file sim_trace.h
+ * @brief 固件源文件的强制包含头（-include）：printf 改为带虚拟时间戳的输出
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __SIM_TRACE_H
+#define __SIM_TRACE_H
+
+#include <stdio.h>
+
+int sim_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+#define printf sim_printf
+
+#endif // __SIM_TRACE_H
@@ -0,0 +1,36 @@
+/**
+ * @file stm32f10x.h
+ * @brief 主机构建用的器件头替身，只提供固件模块用到的类型和寄存器
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __STM32F10X_H
+#define __STM32F10X_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef int8_t   s8;
+typedef int16_t  s16;
+typedef int32_t  s32;
+
+// 连接管理用 SysTick->VAL 作随机种子
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type sim_systick;
+#define SysTick (&sim_systick)
+
+uint32_t RTC_GetCounter(void);
+
+#endif // __STM32F10X_H
@@ -0,0 +1,31 @@
+/**
+ * @file stm32f10x_flash.h
+ * @brief 主机构建用的 Flash 库替身（实现见 sim_board.c）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 主机在 0x08000000 映射一块与目标等大的内存作为片内 Flash，固件按绝对地址
+ * 读取参数页和缓存页的代码不用修改；擦除置 0xFF，编程只能把位从1写成0。
+ */
+
+#ifndef __STM32F10X_FLASH_H
+#define __STM32F10X_FLASH_H
+
+#include "stm32f10x.h"
+
+typedef enum
+{
+    FLASH_BUSY = 1,
+    FLASH_ERROR_PG,
+    FLASH_ERROR_WRP,
+    FLASH_COMPLETE,
+    FLASH_TIMEOUT
+} FLASH_Status;
+
+void FLASH_Unlock(void);
+void FLASH_Lock(void);
+FLASH_Status FLASH_ErasePage(uint32_t Page_Address);
+FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data);
+
+#endif // __STM32F10X_FLASH_H
@@ -0,0 +1,14 @@
+/**
+ * @file stm32f10x_tim.h
+ * @brief 主机构建用的外设库头替身（固件WiFi协议栈不访问该外设）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __STM32F10X_TIM_H
+#define __STM32F10X_TIM_H
+
+#include "stm32f10x.h"
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file task.h
+ * @brief 主机构建用的 FreeRTOS 任务接口替身
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef struct sim_thread *TaskHandle_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR()   0
+#define taskEXIT_CRITICAL_FROM_ISR(x)   ((void)(x))
+#define taskYIELD()                     vTaskDelay(0)
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint16_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *prev, TickType_t increment);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+BaseType_t xTaskGenericNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                                     BaseType_t *woken);
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value,
+                           TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
+
+#define xTaskNotify(t, v, a)                xTaskGenericNotify((t), (v), (a))
+#define xTaskNotifyFromISR(t, v, a, w)      xTaskGenericNotifyFromISR((t), (v), (a), (w))
+#define xTaskNotifyGive(t)                  xTaskGenericNotify((t), 0, eIncrement)
+#define vTaskNotifyGiveFromISR(t, w)        ((void)xTaskGenericNotifyFromISR((t), 0, eIncrement, (w)))
+
+#endif // INC_TASK_H
@@ -0,0 +1,31 @@
+/**
+ * @file timers.h
+ * @brief 主机构建用的 FreeRTOS 软件定时器接口替身（回调在定时器任务中执行）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#include "task.h"
+
+typedef struct tmrTimerControl *TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t timer);
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload, void *id,
+                           TimerCallbackFunction_t cb);
+BaseType_t xTimerStart(TimerHandle_t t, TickType_t ticks);
+BaseType_t xTimerStop(TimerHandle_t t, TickType_t ticks);
+BaseType_t xTimerChangePeriod(TimerHandle_t t, TickType_t period, TickType_t ticks);
+BaseType_t xTimerIsTimerActive(TimerHandle_t t);
+void *pvTimerGetTimerID(TimerHandle_t t);
+
+#define xTimerReset(t, w)                   xTimerStart((t), (w))
+#define xTimerStartFromISR(t, w)            xTimerStart((t), 0)
+#define xTimerStopFromISR(t, w)             xTimerStop((t), 0)
+#define xTimerResetFromISR(t, w)            xTimerStart((t), 0)
+#define xTimerChangePeriodFromISR(t, p, w)  xTimerChangePeriod((t), (p), 0)
+
+#endif // TIMERS_H
@@ -0,0 +1,75 @@
+/**
+ * @file sim.h
+ * @brief 主机仿真内核：虚拟时间、设备事件与任务调度
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 每个 FreeRTOS 任务对应一个线程，但同一时刻只有一个在运行（单核），
+ * 按优先级选择就绪任务，接口调用处发生抢占。全部任务阻塞时虚拟时间
+ * 直接跳到最近的设备事件或任务超时，因此几分钟的心跳、退避在毫秒内跑完，
+ * 且相同种子下每次运行结果完全相同。
+ * 设备事件（串口字节到达、模块应答等）在“中断上下文”中执行。
+ */
+
+#ifndef __SIM_H
+#define __SIM_H
+
+#include <stdint.h>
+
+#define SIM_NEVER           UINT64_MAX
+#define SIM_MS(ms)          ((uint64_t)(ms) * 1000ULL)
+#define SIM_S(s)            ((uint64_t)(s) * 1000000ULL)
+
+typedef void (*sim_event_fn)(void *arg);
+
+/**
+ * @brief 当前虚拟时间（微秒）
+ */
+uint64_t sim_time_us(void);
+
+/**
+ * @brief 在指定虚拟时刻执行设备事件（中断上下文）
+ * @note 同一时刻的事件按登记顺序执行
+ */
+void sim_event_at(uint64_t at_us, sim_event_fn fn, void *arg);
+void sim_event_after(uint64_t delay_us, sim_event_fn fn, void *arg);
+
+/**
+ * @brief 启动调度器，直到 sim_stop() 后返回
+ * @return sim_stop() 的参数；任务全部永久阻塞时返回 SIM_DEADLOCK
+ */
+#define SIM_DEADLOCK        99
+int sim_run(void);
+
+/**
+ * @brief 结束仿真（任务或事件中调用，调用的任务不再返回）
+ */
+void sim_stop(int code);
+
+/**
+ * @brief 实时模式：虚拟时间不快于挂钟时间（与外部进程交互时使用）
+ */
+void sim_set_realtime(uint8_t on);
+
+/**
+ * @brief 外部线程（如套接字桥）访问仿真状态前后调用
+ * @note 持锁期间可以登记事件；解锁时唤醒空闲等待，使事件及时执行
+ */
+void sim_lock(void);
+void sim_unlock(void);
+
+/**
+ * @brief 确定性伪随机数（xorshift32）
+ */
+void sim_srand(uint32_t seed);
+uint32_t sim_rand(void);
+uint32_t sim_rand_range(uint32_t lo, uint32_t hi);   // [lo, hi]
+
+/**
+ * @brief 带虚拟时间戳的输出，sim_verbose 为0时丢弃
+ */
+extern uint8_t sim_verbose;
+void sim_log(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#endif // __SIM_H
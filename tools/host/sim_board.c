@@ -0,0 +1,280 @@
+/**
+ * @file sim_board.c
+ * @brief 主机仿真的板级替身实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "sim_board.h"
+#include "sim.h"
+#include "stm32f10x_flash.h"
+#include "sensordata.h"
+#include "rtc_date.h"
+#include "debug.h"
+#include "sim_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+#define SIM_FLASH_PAGE      1024
+
+SysTick_Type sim_systick;
+
+// ==================================
+// 片内Flash
+// ==================================
+
+static uint8_t *sim_flash = NULL;
+static uint8_t sim_flash_locked = 1;
+
+static uint8_t *sim_flash_at(uint32_t addr, uint32_t len)
+{
+    if (sim_flash == NULL || addr < SIM_FLASH_BASE || addr + len > SIM_FLASH_BASE + SIM_FLASH_SIZE)
+    {
+        return NULL;
+    }
+    return sim_flash + (addr - SIM_FLASH_BASE);
+}
+
+void FLASH_Unlock(void)
+{
+    sim_flash_locked = 0;
+}
+
+void FLASH_Lock(void)
+{
+    sim_flash_locked = 1;
+}
+
+FLASH_Status FLASH_ErasePage(uint32_t Page_Address)
+{
+    uint8_t *p = sim_flash_at(Page_Address & ~(uint32_t)(SIM_FLASH_PAGE - 1), SIM_FLASH_PAGE);
+
+    if (p == NULL || sim_flash_locked)
+    {
+        return FLASH_ERROR_WRP;
+    }
+    memset(p, 0xFF, SIM_FLASH_PAGE);
+    return FLASH_COMPLETE;
+}
+
+FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data)
+{
+    uint8_t *p = sim_flash_at(Address, 2);
+    uint16_t old;
+
+    if (p == NULL || (Address & 1) != 0 || sim_flash_locked)
+    {
+        return FLASH_ERROR_WRP;
+    }
+    memcpy(&old, p, 2);
+    // 与 STM32F1 一致：只能对已擦除的半字编程（写0除外）
+    if (old != 0xFFFF && Data != 0)
+    {
+        return FLASH_ERROR_PG;
+    }
+    memcpy(p, &Data, 2);
+    return FLASH_COMPLETE;
+}
+
+// ==================================
+// 传感器
+// ==================================
+
+SensorData_TypeDef SensorData;
+uint16_t Sensordata_delaytime = 2;
+uint8_t DHT11_ON = 1;
+uint8_t Light_ON = 1;
+uint8_t PM25_ON = 1;
+uint8_t DHT11_ERR = 0;
+uint8_t Light_ERR = 0;
+uint8_t PM25_ERR = 0;
+
+static uint32_t sim_samples = 0;
+
+void SensorData_Wake(void)
+{
+}
+
+uint32_t SensorData_GetSampleCount(void)
+{
+    return sim_samples;
+}
+
+// ==================================
+// RTC
+// ==================================
+
+myRTC_data RTC_data;
+static uint8_t sim_rtc_ready = 0;
+static uint32_t sim_rtc_base = 0;       // 对时时的秒计数
+static uint64_t sim_rtc_base_us = 0;    // 对时时的虚拟时间
+
+uint8_t MyRTC_IsReady(void)
+{
+    return sim_rtc_ready;
+}
+
+uint32_t RTC_GetCounter(void)
+{
+    return sim_rtc_base + (uint32_t)((sim_time_us() - sim_rtc_base_us) / 1000000ULL);
+}
+
+uint8_t RTC_SetFromNetworkTime(const char *time_str)
+{
+    struct tm tm;
+    unsigned year, mon, day, hour, min, sec;
+
+    if (time_str == NULL ||
+        sscanf(time_str, "%u-%u-%u %u:%u:%u", &year, &mon, &day, &hour, &min, &sec) != 6 ||
+        year < 2000 || year > 2099 || mon < 1 || mon > 12 || day < 1 || day > 31 ||
+        hour > 23 || min > 59 || sec > 59)
+    {
+        return 0;
+    }
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = (int)year - 1900;
+    tm.tm_mon = (int)mon - 1;
+    tm.tm_mday = (int)day;
+    tm.tm_hour = (int)hour;
+    tm.tm_min = (int)min;
+    tm.tm_sec = (int)sec;
+    sim_rtc_base = (uint32_t)timegm(&tm);
+    sim_rtc_base_us = sim_time_us();
+    sim_rtc_ready = 1;
+    return 1;
+}
+
+// ==================================
+// USART1（日志），UART2 驱动
+// ==================================
+
+static uint32_t sim_debug_bytes = 0;
+
+int8_t Debug_TX_Writev(const uart2_iov_t *iov, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        sim_debug_bytes += iov[i].len;
+        if (sim_verbose)
+        {
+            sim_printf("%.*s", (int)iov[i].len, (const char *)iov[i].data); // 日志模块的文本行
+        }
+    }
+    return 0;
+}
+
+int8_t Debug_TX_Write(const void *data, uint16_t len)
+{
+    uart2_iov_t iov = {data, len};
+    return Debug_TX_Writev(&iov, 1);
+}
+
+uint16_t Debug_TX_Pending(void)
+{
+    return 0;
+}
+
+uint32_t Debug_TX_Drops(void)
+{
+    return 0;
+}
+
+uint32_t Debug_Line_Drops(void)
+{
+    return 0;
+}
+
+void Debug_SetRxCallback(void (*callback)(uint8_t byte))
+{
+}
+
+/**
+ * @brief AT 引擎默认端口引用的 UART2 驱动；主机上经 AT_Init_Port() 改用 sim_uart_port，
+ *        走到这里说明有代码绕过了端口
+ */
+static void sim_no_uart2(const char *fn)
+{
+    fprintf(stderr, "sim: %s called, UART2 driver is not available on host\n", fn);
+    abort();
+}
+
+int8_t UART2_TX_Writev(const uart2_iov_t *iov, uint8_t count)
+{
+    sim_no_uart2(__func__);
+    return -1;
+}
+
+uint16_t UART2_RX_Peek(const uint8_t **data)
+{
+    sim_no_uart2(__func__);
+    return 0;
+}
+
+void UART2_RX_Consume(uint16_t len)
+{
+    sim_no_uart2(__func__);
+}
+
+uint16_t UART2_RX_Overruns(void)
+{
+    sim_no_uart2(__func__);
+    return 0;
+}
+
+void UART2_RX_Flush(void)
+{
+    sim_no_uart2(__func__);
+}
+
+void UART2_SetRxCallback(void (*callback)(uint8_t event))
+{
+    sim_no_uart2(__func__);
+}
+
+void UART2_SetTxCallback(void (*callback)(void))
+{
+    sim_no_uart2(__func__);
+}
+
+void UART2_SetBaudrate(uint32_t baudrate)
+{
+    sim_no_uart2(__func__);
+}
+
+// ==================================
+// 初始化
+// ==================================
+
+int8_t Sim_Board_Init(void)
+{
+    if (sim_flash == NULL)
+    {
+        void *p = mmap((void *)SIM_FLASH_BASE, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (p == MAP_FAILED || p != (void *)SIM_FLASH_BASE)
+        {
+            fprintf(stderr, "sim: cannot map flash at 0x%08lx\n", SIM_FLASH_BASE);
+            return -1;
+        }
+        sim_flash = p;
+    }
+    memset(sim_flash, 0xFF, SIM_FLASH_SIZE);
+
+    SensorData.dht11_data.temp_int = 25;
+    SensorData.dht11_data.temp_deci = 3;
+    SensorData.dht11_data.humi_int = 60;
+    SensorData.light_data.lux = 320;
+    SensorData.pm25_data.pm25_value = 35.2f;
+    SensorData.pm25_data.level = 0;
+    sim_samples = 1;
+    sim_rtc_ready = 0;
+    return 0;
+}
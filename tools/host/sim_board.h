@@ -0,0 +1,23 @@
+/**
+ * @file sim_board.h
+ * @brief 主机仿真的板级替身：片内Flash、传感器读数、RTC、USART1
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __SIM_BOARD_H
+#define __SIM_BOARD_H
+
+#include <stdint.h>
+
+#define SIM_FLASH_BASE      0x08000000UL
+#define SIM_FLASH_SIZE      0x10000UL       // 64KB，与 STM32F103C8 相同
+
+/**
+ * @brief 映射片内Flash（全部擦除），设置一组固定的传感器读数
+ * @return 0-成功 -1-地址已被占用
+ */
+int8_t Sim_Board_Init(void);
+
+#endif // __SIM_BOARD_H
@@ -0,0 +1,1093 @@
+/**
+ * @file sim_rtos.c
+ * @brief 主机仿真内核与 FreeRTOS 接口实现（见 sim.h）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 全局一把锁：正在运行的任务线程始终持有，阻塞时在自己的条件变量上释放。
+ * 调度点（阻塞、让出、唤醒更高优先级任务）在 sim_schedule() 中完成：
+ * 先执行到期的设备事件，再选优先级最高、最早就绪的任务；没有就绪任务时
+ * 把虚拟时间推进到下一个事件或超时。
+ */
+
+#include "sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "timers.h"
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==================================
+// 内核数据
+// ==================================
+
+typedef enum
+{
+    SIM_READY = 0,
+    SIM_RUNNING,
+    SIM_BLOCKED,
+    SIM_DEAD
+} sim_state_t;
+
+struct sim_thread
+{
+    pthread_t th;
+    pthread_cond_t cv;
+    const char *name;
+    UBaseType_t prio;
+    sim_state_t state;
+    uint64_t ready_seq;         // 就绪先后，同优先级先就绪先运行
+    const void *wait_obj;       // 阻塞等待的对象，NULL-仅等超时
+    uint64_t wake_us;           // 超时时刻
+    uint8_t timed_out;
+    uint32_t notify_value;
+    uint8_t notify_pending;
+    TaskFunction_t fn;
+    void *arg;
+    struct sim_thread *next;
+};
+
+typedef struct sim_event
+{
+    uint64_t at;
+    uint64_t seq;
+    sim_event_fn fn;
+    void *arg;
+    struct sim_event *next;
+} sim_event_t;
+
+static pthread_mutex_t sim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_done_cv = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t sim_idle_cv;
+static struct sim_thread *sim_threads = NULL;
+static struct sim_thread *sim_current = NULL;
+static __thread struct sim_thread *sim_self = NULL;
+static sim_event_t *sim_events = NULL;
+static uint64_t sim_now = 0;
+static uint64_t sim_seq = 0;
+static uint8_t sim_isr = 0;
+static uint8_t sim_running = 0;
+static uint8_t sim_stopped = 0;
+static int sim_exit_code = 0;
+
+static uint8_t sim_realtime = 0;
+static uint64_t sim_rt_wall0, sim_rt_virt0;
+
+uint8_t sim_verbose = 0;
+
+static void sim_timer_init(void);
+
+// ==================================
+// 时间与事件
+// ==================================
+
+uint64_t sim_time_us(void)
+{
+    return sim_now;
+}
+
+void sim_event_at(uint64_t at_us, sim_event_fn fn, void *arg)
+{
+    sim_event_t *e = malloc(sizeof(*e));
+    sim_event_t **pp = &sim_events;
+
+    if (e == NULL)
+    {
+        abort();
+    }
+    e->at = at_us < sim_now ? sim_now : at_us;
+    e->seq = ++sim_seq;
+    e->fn = fn;
+    e->arg = arg;
+    while (*pp != NULL && (*pp)->at <= e->at)
+    {
+        pp = &(*pp)->next;
+    }
+    e->next = *pp;
+    *pp = e;
+}
+
+void sim_event_after(uint64_t delay_us, sim_event_fn fn, void *arg)
+{
+    sim_event_at(sim_now + delay_us, fn, arg);
+}
+
+static void sim_run_due_events(void)
+{
+    while (sim_events != NULL && sim_events->at <= sim_now && !sim_stopped)
+    {
+        sim_event_t *e = sim_events;
+        sim_events = e->next;
+        sim_isr = 1;
+        e->fn(e->arg);
+        sim_isr = 0;
+        free(e);
+    }
+}
+
+static uint64_t sim_wall_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+void sim_set_realtime(uint8_t on)
+{
+    sim_realtime = on;
+    sim_rt_wall0 = sim_wall_us();
+    sim_rt_virt0 = sim_now;
+}
+
+/**
+ * @brief 实时模式下把虚拟时间追到挂钟时间（只前进不后退）
+ */
+static void sim_realtime_sync(void)
+{
+    uint64_t t;
+
+    if (!sim_realtime)
+    {
+        return;
+    }
+    t = sim_rt_virt0 + (sim_wall_us() - sim_rt_wall0);
+    if (t > sim_now)
+    {
+        sim_now = t;
+    }
+}
+
+void sim_lock(void)
+{
+    pthread_mutex_lock(&sim_mutex);
+    sim_realtime_sync();
+}
+
+void sim_unlock(void)
+{
+    pthread_cond_broadcast(&sim_idle_cv);
+    pthread_mutex_unlock(&sim_mutex);
+}
+
+// ==================================
+// 调度
+// ==================================
+
+static struct sim_thread *sim_pick_ready(void)
+{
+    struct sim_thread *best = NULL;
+
+    for (struct sim_thread *t = sim_threads; t != NULL; t = t->next)
+    {
+        if (t->state != SIM_READY)
+        {
+            continue;
+        }
+        if (best == NULL || t->prio > best->prio || (t->prio == best->prio && t->ready_seq < best->ready_seq))
+        {
+            best = t;
+        }
+    }
+    return best;
+}
+
+static void sim_make_ready(struct sim_thread *t)
+{
+    t->state = SIM_READY;
+    t->ready_seq = ++sim_seq;
+}
+
+static void sim_report_deadlock(void)
+{
+    fprintf(stderr, "sim: deadlock at %.3f s, all tasks blocked forever:\n", sim_now / 1e6);
+    for (struct sim_thread *t = sim_threads; t != NULL; t = t->next)
+    {
+        if (t->state == SIM_BLOCKED)
+        {
+            fprintf(stderr, "  %-16s prio %lu waiting on %p\n", t->name, (unsigned long)t->prio, t->wait_obj);
+        }
+    }
+}
+
+/**
+ * @brief 没有就绪任务：推进虚拟时间到下一个事件或超时
+ * @return 0-再也不会有任务就绪
+ */
+static uint8_t sim_advance(void)
+{
+    uint64_t next = sim_events != NULL ? sim_events->at : SIM_NEVER;
+
+    for (struct sim_thread *t = sim_threads; t != NULL; t = t->next)
+    {
+        if (t->state == SIM_BLOCKED && t->wake_us < next)
+        {
+            next = t->wake_us;
+        }
+    }
+
+    if (sim_realtime)
+    {
+        // 等到挂钟追上下一个时刻，期间外部线程可以登记新事件
+        uint64_t wall = sim_rt_wall0 + (next - sim_rt_virt0);
+        if (next == SIM_NEVER)
+        {
+            pthread_cond_wait(&sim_idle_cv, &sim_mutex);
+        }
+        else if (wall > sim_wall_us())
+        {
+            struct timespec ts = {(time_t)(wall / 1000000ULL), (long)(wall % 1000000ULL) * 1000L};
+            pthread_cond_timedwait(&sim_idle_cv, &sim_mutex, &ts);
+        }
+        sim_realtime_sync();
+        if (next != SIM_NEVER && sim_now > next)
+        {
+            next = sim_now;
+        }
+        if (next == SIM_NEVER || next > sim_now)
+        {
+            return 1;
+        }
+    }
+    else if (next == SIM_NEVER)
+    {
+        return 0;
+    }
+
+    if (next > sim_now)
+    {
+        sim_now = next;
+    }
+    for (struct sim_thread *t = sim_threads; t != NULL; t = t->next)
+    {
+        if (t->state == SIM_BLOCKED && t->wake_us <= sim_now)
+        {
+            t->timed_out = 1;
+            sim_make_ready(t);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 调度点：调用前已设置好自身状态（就绪/阻塞/结束）
+ */
+static void sim_schedule(void)
+{
+    struct sim_thread *self = sim_self;
+    struct sim_thread *next;
+
+    for (;;)
+    {
+        if (sim_stopped)
+        {
+            sim_current = NULL;
+            pthread_cond_broadcast(&sim_done_cv);
+            if (self == NULL)
+            {
+                return;
+            }
+            for (;;)
+            {
+                pthread_cond_wait(&self->cv, &sim_mutex);
+            }
+        }
+        sim_run_due_events();
+        if (sim_stopped)
+        {
+            continue;
+        }
+        next = sim_pick_ready();
+        if (next != NULL)
+        {
+            break;
+        }
+        if (!sim_advance())
+        {
+            sim_report_deadlock();
+            sim_stop(SIM_DEADLOCK);
+        }
+    }
+
+    sim_current = next;
+    next->state = SIM_RUNNING;
+    if (next == self)
+    {
+        return;
+    }
+    pthread_cond_signal(&next->cv);
+    if (self == NULL || self->state == SIM_DEAD)
+    {
+        return;
+    }
+    while (sim_current != self)
+    {
+        pthread_cond_wait(&self->cv, &sim_mutex);
+    }
+}
+
+/**
+ * @brief 阻塞当前任务直到 obj 被唤醒或到达 deadline
+ * @return 1-被唤醒 0-超时
+ */
+static uint8_t sim_wait(const void *obj, uint64_t deadline)
+{
+    struct sim_thread *self = sim_self;
+
+    if (self == NULL || sim_isr)
+    {
+        fprintf(stderr, "sim: blocking call outside task context\n");
+        abort();
+    }
+    self->wait_obj = obj;
+    self->wake_us = deadline;
+    self->timed_out = 0;
+    self->state = SIM_BLOCKED;
+    sim_schedule();
+    self->wait_obj = NULL;
+    self->wake_us = SIM_NEVER;
+    return !self->timed_out;
+}
+
+/**
+ * @brief 唤醒等待 obj 的全部任务（各自重新检查条件）
+ */
+static uint8_t sim_signal(const void *obj)
+{
+    uint8_t woken = 0;
+
+    for (struct sim_thread *t = sim_threads; t != NULL; t = t->next)
+    {
+        if (t->state == SIM_BLOCKED && t->wait_obj == obj && obj != NULL)
+        {
+            sim_make_ready(t);
+            woken = 1;
+        }
+    }
+    return woken;
+}
+
+/**
+ * @brief 接口返回前：有更高优先级任务就绪则让出
+ */
+static void sim_yield_check(void)
+{
+    struct sim_thread *self = sim_self;
+
+    if (self == NULL || sim_isr)
+    {
+        return;
+    }
+    for (struct sim_thread *t = sim_threads; t != NULL; t = t->next)
+    {
+        if (t->state == SIM_READY && t->prio > self->prio)
+        {
+            sim_make_ready(self);
+            sim_schedule();
+            return;
+        }
+    }
+}
+
+static uint64_t sim_deadline(TickType_t ticks)
+{
+    if (ticks == portMAX_DELAY)
+    {
+        return SIM_NEVER;
+    }
+    // 与节拍中断对齐：第 ticks 个节拍边界唤醒
+    return (sim_now / 1000ULL + ticks) * 1000ULL;
+}
+
+static void *sim_thread_main(void *p)
+{
+    struct sim_thread *t = p;
+
+    pthread_mutex_lock(&sim_mutex);
+    while (sim_current != t)
+    {
+        pthread_cond_wait(&t->cv, &sim_mutex);
+    }
+    sim_self = t;
+    t->fn(t->arg);
+
+    // FreeRTOS 任务不允许返回，这里按删除自身处理
+    vTaskDelete(NULL);
+    return NULL;
+}
+
+int sim_run(void)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&sim_idle_cv, &attr);
+
+    sim_timer_init();
+
+    pthread_mutex_lock(&sim_mutex);
+    sim_running = 1;
+    if (sim_realtime)
+    {
+        sim_set_realtime(1);
+    }
+    sim_schedule();
+    while (!sim_stopped)
+    {
+        pthread_cond_wait(&sim_done_cv, &sim_mutex);
+    }
+    pthread_mutex_unlock(&sim_mutex);
+    return sim_exit_code;
+}
+
+void sim_stop(int code)
+{
+    if (sim_stopped)
+    {
+        return;
+    }
+    sim_stopped = 1;
+    sim_exit_code = code;
+    pthread_cond_broadcast(&sim_done_cv);
+    if (sim_self != NULL && !sim_isr)
+    {
+        sim_schedule(); // 停放调用任务
+    }
+}
+
+void sim_assert_failed(const char *file, int line)
+{
+    fprintf(stderr, "sim: assert failed %s:%d at %.3f s\n", file, line, sim_now / 1e6);
+    abort();
+}
+
+// ==================================
+// 输出与随机数
+// ==================================
+
+static uint32_t sim_rand_state = 0x12345678u;
+
+void sim_srand(uint32_t seed)
+{
+    sim_rand_state = seed != 0 ? seed : 0x12345678u;
+}
+
+uint32_t sim_rand(void)
+{
+    uint32_t x = sim_rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim_rand_state = x;
+    return x;
+}
+
+uint32_t sim_rand_range(uint32_t lo, uint32_t hi)
+{
+    return hi <= lo ? lo : lo + sim_rand() % (hi - lo + 1);
+}
+
+void sim_log(const char *fmt, ...)
+{
+    va_list ap;
+
+    if (!sim_verbose)
+    {
+        return;
+    }
+    printf("[%10.3f] ", sim_now / 1e6);
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+/**
+ * @brief 固件 printf 的去处（sim_trace.h 重定向），行首加虚拟时间戳
+ */
+int sim_printf(const char *fmt, ...)
+{
+    static uint8_t line_start = 1;
+    char buf[512];
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (!sim_verbose)
+    {
+        return n;
+    }
+    for (char *p = buf; *p != '\0'; p++)
+    {
+        if (*p == '\r')
+        {
+            continue;
+        }
+        if (line_start)
+        {
+            printf("[%10.3f] ", sim_now / 1e6);
+            line_start = 0;
+        }
+        putchar(*p);
+        if (*p == '\n')
+        {
+            line_start = 1;
+        }
+    }
+    return n;
+}
+
+// ==================================
+// 任务
+// ==================================
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint16_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle)
+{
+    struct sim_thread *t = calloc(1, sizeof(*t));
+    uint8_t outside = (sim_self == NULL && !sim_isr);
+
+    if (t == NULL)
+    {
+        return pdFAIL;
+    }
+    if (outside)
+    {
+        pthread_mutex_lock(&sim_mutex);
+    }
+    pthread_cond_init(&t->cv, NULL);
+    t->name = name;
+    t->prio = prio;
+    t->fn = fn;
+    t->arg = arg;
+    t->wake_us = SIM_NEVER;
+    sim_make_ready(t);
+    t->next = sim_threads;
+    sim_threads = t;
+    if (handle != NULL)
+    {
+        *handle = t;
+    }
+    if (pthread_create(&t->th, NULL, sim_thread_main, t) != 0)
+    {
+        abort();
+    }
+    pthread_detach(t->th);
+    if (outside)
+    {
+        pthread_mutex_unlock(&sim_mutex);
+    }
+    else
+    {
+        sim_yield_check();
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    struct sim_thread *t = task != NULL ? task : sim_self;
+
+    t->state = SIM_DEAD;
+    if (t == sim_self)
+    {
+        sim_schedule();
+        pthread_mutex_unlock(&sim_mutex);
+        pthread_exit(NULL);
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (ticks == 0)
+    {
+        sim_make_ready(sim_self);
+        sim_schedule();
+        return;
+    }
+    sim_wait(NULL, sim_deadline(ticks));
+}
+
+void vTaskDelayUntil(TickType_t *prev, TickType_t increment)
+{
+    uint64_t target = (uint64_t)(*prev + increment) * 1000ULL;
+
+    *prev += increment;
+    if (target > sim_now)
+    {
+        sim_wait(NULL, target);
+    }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(sim_now / 1000ULL);
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return xTaskGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return sim_self;
+}
+
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    return pdFALSE;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    return 0; // 主机线程栈与目标无关，不统计
+}
+
+BaseType_t xPortIsInsideInterrupt(void)
+{
+    return sim_isr;
+}
+
+void *pvPortMalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void vPortFree(void *p)
+{
+    free(p);
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return 8192;
+}
+
+// ==================================
+// 任务通知
+// ==================================
+
+static BaseType_t sim_notify(TaskHandle_t t, uint32_t value, eNotifyAction action)
+{
+    BaseType_t ret = pdPASS;
+
+    switch (action)
+    {
+    case eSetBits:
+        t->notify_value |= value;
+        break;
+    case eIncrement:
+        t->notify_value++;
+        break;
+    case eSetValueWithOverwrite:
+        t->notify_value = value;
+        break;
+    case eSetValueWithoutOverwrite:
+        if (t->notify_pending)
+        {
+            ret = pdFAIL;
+        }
+        else
+        {
+            t->notify_value = value;
+        }
+        break;
+    default:
+        break;
+    }
+    t->notify_pending = 1;
+    sim_signal(t);
+    return ret;
+}
+
+BaseType_t xTaskGenericNotify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+    BaseType_t ret = sim_notify(task, value, action);
+    sim_yield_check();
+    return ret;
+}
+
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                                     BaseType_t *woken)
+{
+    BaseType_t ret = sim_notify(task, value, action);
+    if (woken != NULL)
+    {
+        *woken = pdTRUE;
+    }
+    return ret;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value,
+                           TickType_t ticks)
+{
+    struct sim_thread *self = sim_self;
+    uint64_t deadline = sim_deadline(ticks);
+
+    if (!self->notify_pending)
+    {
+        self->notify_value &= ~clear_on_entry;
+        while (!self->notify_pending && ticks != 0)
+        {
+            if (!sim_wait(self, deadline))
+            {
+                break;
+            }
+        }
+    }
+    if (value != NULL)
+    {
+        *value = self->notify_value;
+    }
+    if (!self->notify_pending)
+    {
+        return pdFALSE;
+    }
+    self->notify_value &= ~clear_on_exit;
+    self->notify_pending = 0;
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    struct sim_thread *self = sim_self;
+    uint64_t deadline = sim_deadline(ticks);
+    uint32_t ret;
+
+    while (self->notify_value == 0 && ticks != 0)
+    {
+        if (!sim_wait(self, deadline))
+        {
+            break;
+        }
+    }
+    ret = self->notify_value;
+    if (ret != 0)
+    {
+        self->notify_value = clear_on_exit ? 0 : ret - 1;
+    }
+    self->notify_pending = 0;
+    return ret;
+}
+
+// ==================================
+// 队列与信号量
+// ==================================
+
+struct QueueDefinition
+{
+    uint8_t *buf;
+    UBaseType_t len;
+    UBaseType_t item;
+    UBaseType_t count;
+    UBaseType_t head;
+};
+
+static QueueHandle_t sim_queue_create(UBaseType_t length, UBaseType_t item_size, UBaseType_t count)
+{
+    QueueHandle_t q = calloc(1, sizeof(*q));
+
+    if (q == NULL)
+    {
+        return NULL;
+    }
+    q->buf = item_size ? calloc(length, item_size) : NULL;
+    q->len = length;
+    q->item = item_size;
+    q->count = count;
+    return q;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    return sim_queue_create(length, item_size, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return sim_queue_create(1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return sim_queue_create(1, 0, 0);
+}
+
+static void sim_queue_put(QueueHandle_t q, const void *item)
+{
+    if (q->item != 0)
+    {
+        memcpy(q->buf + ((q->head + q->count) % q->len) * q->item, item, q->item);
+    }
+    q->count++;
+    sim_signal(q);
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks)
+{
+    uint64_t deadline = sim_deadline(ticks);
+
+    while (q->count >= q->len)
+    {
+        if (ticks == 0 || sim_isr || !sim_wait(q, deadline))
+        {
+            if (q->count >= q->len)
+            {
+                return errQUEUE_FULL;
+            }
+        }
+    }
+    sim_queue_put(q, item);
+    sim_yield_check();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken)
+{
+    if (q->count >= q->len)
+    {
+        return errQUEUE_FULL;
+    }
+    sim_queue_put(q, item);
+    if (woken != NULL)
+    {
+        *woken = pdTRUE;
+    }
+    return pdPASS;
+}
+
+static BaseType_t sim_queue_get(QueueHandle_t q, void *item, TickType_t ticks, uint8_t remove)
+{
+    uint64_t deadline = sim_deadline(ticks);
+
+    while (q->count == 0)
+    {
+        if (ticks == 0 || sim_isr || !sim_wait(q, deadline))
+        {
+            if (q->count == 0)
+            {
+                return errQUEUE_EMPTY;
+            }
+        }
+    }
+    if (q->item != 0 && item != NULL)
+    {
+        memcpy(item, q->buf + q->head * q->item, q->item);
+    }
+    if (remove)
+    {
+        q->head = (q->head + 1) % q->len;
+        q->count--;
+        sim_signal(q);
+        sim_yield_check();
+    }
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks)
+{
+    return sim_queue_get(q, item, ticks, 1);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void *item, TickType_t ticks)
+{
+    return sim_queue_get(q, item, ticks, 0);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+    return q->count;
+}
+
+// ==================================
+// 事件组
+// ==================================
+
+struct EventGroupDef_t
+{
+    EventBits_t bits;
+};
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    return calloc(1, sizeof(struct EventGroupDef_t));
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits)
+{
+    EventBits_t ret;
+
+    g->bits |= bits;
+    ret = g->bits;
+    sim_signal(g);
+    sim_yield_check();
+    return ret;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t g, EventBits_t bits, BaseType_t *woken)
+{
+    g->bits |= bits;
+    sim_signal(g);
+    if (woken != NULL)
+    {
+        *woken = pdTRUE;
+    }
+    return pdPASS;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits)
+{
+    EventBits_t ret = g->bits;
+    g->bits &= ~bits;
+    return ret;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g)
+{
+    return g->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clear_on_exit,
+                                BaseType_t wait_all, TickType_t ticks)
+{
+    uint64_t deadline = sim_deadline(ticks);
+    uint8_t waited = 1;
+
+    for (;;)
+    {
+        EventBits_t cur = g->bits;
+        uint8_t ok = wait_all ? ((cur & bits) == bits) : ((cur & bits) != 0);
+        if (ok)
+        {
+            if (clear_on_exit)
+            {
+                g->bits &= ~bits;
+            }
+            return cur;
+        }
+        if (ticks == 0 || !waited)
+        {
+            return cur;
+        }
+        waited = sim_wait(g, deadline);
+    }
+}
+
+// ==================================
+// 软件定时器
+// ==================================
+
+struct tmrTimerControl
+{
+    const char *name;
+    TickType_t period;
+    UBaseType_t auto_reload;
+    void *id;
+    TimerCallbackFunction_t cb;
+    uint8_t active;
+    uint64_t expiry;
+    struct tmrTimerControl *next;
+};
+
+static struct tmrTimerControl *sim_timers = NULL;
+static const char sim_timer_obj = 0;    // 定时器任务等待的对象
+
+static void sim_timer_task(void *arg)
+{
+    for (;;)
+    {
+        struct tmrTimerControl *due = NULL;
+
+        for (struct tmrTimerControl *t = sim_timers; t != NULL; t = t->next)
+        {
+            if (t->active && (due == NULL || t->expiry < due->expiry))
+            {
+                due = t;
+            }
+        }
+        if (due == NULL || due->expiry > sim_now)
+        {
+            sim_wait(&sim_timer_obj, due != NULL ? due->expiry : SIM_NEVER);
+            continue;
+        }
+        if (due->auto_reload)
+        {
+            due->expiry += (uint64_t)due->period * 1000ULL;
+        }
+        else
+        {
+            due->active = 0;
+        }
+        due->cb(due);
+    }
+}
+
+static void sim_timer_init(void)
+{
+    xTaskCreate(sim_timer_task, "Tmr Svc", 256, NULL, configTIMER_TASK_PRIORITY, NULL);
+}
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload, void *id,
+                           TimerCallbackFunction_t cb)
+{
+    struct tmrTimerControl *t = calloc(1, sizeof(*t));
+
+    if (t == NULL)
+    {
+        return NULL;
+    }
+    t->name = name;
+    t->period = period;
+    t->auto_reload = auto_reload;
+    t->id = id;
+    t->cb = cb;
+    t->next = sim_timers;
+    sim_timers = t;
+    return t;
+}
+
+BaseType_t xTimerStart(TimerHandle_t t, TickType_t ticks)
+{
+    t->active = 1;
+    t->expiry = sim_deadline(t->period);
+    sim_signal(&sim_timer_obj);
+    sim_yield_check();
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t t, TickType_t ticks)
+{
+    t->active = 0;
+    sim_signal(&sim_timer_obj);
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t t, TickType_t period, TickType_t ticks)
+{
+    t->period = period;
+    return xTimerStart(t, ticks);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t t)
+{
+    return t->active;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t t)
+{
+    return t->id;
+}
@@ -0,0 +1,378 @@
+/**
+ * @file sim_uart.c
+ * @brief 主机串口线路模型实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "sim_uart.h"
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_UART_CHUNK      16      // 接收侧每次事件到达的字节数（不影响回调时机）
+
+typedef struct sim_burst
+{
+    uint8_t *data;
+    uint16_t len;
+    uint16_t pos;
+    uint32_t baud;
+    struct sim_burst *next;
+} sim_burst_t;
+
+// ==================================
+// 静态变量
+// ==================================
+
+static uint32_t uart_baud = 115200;
+static sim_uart_sink_t uart_module_rx = NULL;
+static sim_uart_stats_t uart_stats;
+static uint32_t uart_epoch = 0;             // MCU 复位时递增，作废在途事件
+
+static uint8_t rx_ring[SIM_UART_RX_RING];
+static uint32_t rx_written = 0, rx_read = 0;
+static uint16_t rx_overruns = 0;
+static void (*rx_callback)(uint8_t event) = NULL;
+static sim_burst_t *rx_bursts = NULL;       // 线路上排队的模块输出
+static uint8_t rx_active = 0;
+static uint32_t rx_idle_mark = 0;           // 空闲检测：最后一批字节到达时的写计数
+
+static uint8_t tx_ring[SIM_UART_TX_RING];
+static uint16_t tx_head = 0, tx_tail = 0;   // 自由计数
+static uint16_t tx_busy = 0;                // 正在线路上的字节数
+static void (*tx_callback)(void) = NULL;
+
+// ==================================
+// 线路时间与乱码
+// ==================================
+
+uint64_t Sim_UART_Byte_Us(uint32_t baud)
+{
+    uint64_t us = 10000000ULL / baud;
+    return us > 0 ? us : 1;
+}
+
+uint16_t Sim_UART_Garble(uint8_t *out, uint16_t len, uint32_t from_baud, uint32_t to_baud)
+{
+    uint64_t n = (uint64_t)len * to_baud / from_baud;
+
+    if (n == 0)
+    {
+        n = 1;
+    }
+    if (n > len * 8U)
+    {
+        n = len * 8U;
+    }
+    for (uint16_t i = 0; i < n; i++)
+    {
+        // 帧错误多表现为高位置1的字节，不会是换行或 '>'
+        out[i] = (uint8_t)(0x80 | (sim_rand() & 0x7F));
+    }
+    return (uint16_t)n;
+}
+
+// ==================================
+// 模块 -> MCU
+// ==================================
+
+static void rx_deliver(const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint32_t before = rx_written % SIM_UART_RX_RING;
+        rx_ring[before] = data[i];
+        rx_written++;
+
+        // DMA 半满/满中断
+        if (rx_callback != NULL)
+        {
+            uint32_t after = rx_written % SIM_UART_RX_RING;
+            if (after == SIM_UART_RX_RING / 2)
+            {
+                rx_callback(UART2_RX_EVT_HALF);
+            }
+            else if (after == 0)
+            {
+                rx_callback(UART2_RX_EVT_FULL);
+            }
+        }
+    }
+    uart_stats.rx_bytes += len;
+}
+
+static void rx_idle_event(void *arg)
+{
+    if ((uint32_t)(uintptr_t)arg != uart_epoch)
+    {
+        return;
+    }
+    // 期间有新字节到达则不是空闲
+    if (!rx_active && rx_written == rx_idle_mark && rx_callback != NULL)
+    {
+        rx_callback(UART2_RX_EVT_IDLE);
+    }
+}
+
+static void rx_chunk_event(void *arg);
+
+static void rx_schedule(void)
+{
+    sim_burst_t *b = rx_bursts;
+    uint16_t n;
+
+    if (b == NULL)
+    {
+        rx_active = 0;
+        rx_idle_mark = rx_written;
+        sim_event_after(Sim_UART_Byte_Us(uart_baud), rx_idle_event, (void *)(uintptr_t)uart_epoch);
+        return;
+    }
+    rx_active = 1;
+    n = (uint16_t)(b->len - b->pos);
+    if (n > SIM_UART_CHUNK)
+    {
+        n = SIM_UART_CHUNK;
+    }
+    sim_event_after(Sim_UART_Byte_Us(b->baud) * n, rx_chunk_event, (void *)(uintptr_t)uart_epoch);
+}
+
+static void rx_chunk_event(void *arg)
+{
+    sim_burst_t *b = rx_bursts;
+    uint16_t n;
+
+    if ((uint32_t)(uintptr_t)arg != uart_epoch || b == NULL)
+    {
+        return;
+    }
+    n = (uint16_t)(b->len - b->pos);
+    if (n > SIM_UART_CHUNK)
+    {
+        n = SIM_UART_CHUNK;
+    }
+
+    if (rx_callback == NULL)
+    {
+        uart_stats.rx_dropped += n;
+    }
+    else if (b->baud != uart_baud)
+    {
+        uint8_t junk[SIM_UART_CHUNK * 8];
+        uint16_t m = Sim_UART_Garble(junk, n, b->baud, uart_baud);
+        uart_stats.rx_garbled += m;
+        rx_deliver(junk, m);
+    }
+    else
+    {
+        rx_deliver(b->data + b->pos, n);
+    }
+
+    b->pos += n;
+    if (b->pos >= b->len)
+    {
+        rx_bursts = b->next;
+        free(b->data);
+        free(b);
+    }
+    rx_schedule();
+}
+
+void Sim_UART_Module_Send(const void *data, uint16_t len, uint32_t baud)
+{
+    sim_burst_t *b, **pp = &rx_bursts;
+
+    if (len == 0)
+    {
+        return;
+    }
+    b = calloc(1, sizeof(*b));
+    b->data = malloc(len);
+    memcpy(b->data, data, len);
+    b->len = len;
+    b->baud = baud;
+    while (*pp != NULL)
+    {
+        pp = &(*pp)->next;
+    }
+    *pp = b;
+    if (!rx_active)
+    {
+        rx_schedule();
+    }
+}
+
+uint32_t Sim_UART_Module_Pending(void)
+{
+    uint32_t n = 0;
+
+    for (sim_burst_t *b = rx_bursts; b != NULL; b = b->next)
+    {
+        n += (uint32_t)(b->len - b->pos);
+    }
+    return n;
+}
+
+// ==================================
+// MCU -> 模块
+// ==================================
+
+static void tx_start(void);
+
+static void tx_done_event(void *arg)
+{
+    uint8_t buf[SIM_UART_TX_RING];
+    uint16_t n = tx_busy;
+
+    if ((uint32_t)(uintptr_t)arg != uart_epoch)
+    {
+        return;
+    }
+    for (uint16_t i = 0; i < n; i++)
+    {
+        buf[i] = tx_ring[(uint16_t)(tx_tail + i) % SIM_UART_TX_RING];
+    }
+    tx_tail = (uint16_t)(tx_tail + n);
+    tx_busy = 0;
+    uart_stats.tx_bytes += n;
+    if (uart_module_rx != NULL)
+    {
+        uart_module_rx(buf, n, uart_baud);
+    }
+
+    if (tx_head != tx_tail)
+    {
+        tx_start();
+    }
+    else if (tx_callback != NULL)
+    {
+        tx_callback();
+    }
+}
+
+static void tx_start(void)
+{
+    tx_busy = (uint16_t)(tx_head - tx_tail);
+    sim_event_after(Sim_UART_Byte_Us(uart_baud) * tx_busy, tx_done_event, (void *)(uintptr_t)uart_epoch);
+}
+
+// ==================================
+// at_port_t 实现
+// ==================================
+
+static int8_t port_writev(const uart2_iov_t *iov, uint8_t count)
+{
+    uint32_t total = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        total += iov[i].len;
+    }
+    if (total > (uint32_t)(SIM_UART_TX_RING - (uint16_t)(tx_head - tx_tail)))
+    {
+        return -1;
+    }
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const uint8_t *p = iov[i].data;
+        for (uint16_t j = 0; j < iov[i].len; j++)
+        {
+            tx_ring[tx_head % SIM_UART_TX_RING] = p[j];
+            tx_head++;
+        }
+    }
+    if (tx_busy == 0 && total > 0)
+    {
+        tx_start();
+    }
+    return 0;
+}
+
+static uint16_t port_rx_peek(const uint8_t **data)
+{
+    uint32_t pending = rx_written - rx_read;
+    uint32_t tail = rx_read % SIM_UART_RX_RING;
+
+    if (pending > SIM_UART_RX_RING)
+    {
+        rx_read = rx_written;
+        rx_overruns++;
+        return 0;
+    }
+    *data = &rx_ring[tail];
+    if (pending > SIM_UART_RX_RING - tail)
+    {
+        pending = SIM_UART_RX_RING - tail;
+    }
+    return (uint16_t)pending;
+}
+
+static void port_rx_consume(uint16_t len)
+{
+    rx_read += len;
+}
+
+static uint16_t port_rx_overruns(void)
+{
+    return rx_overruns;
+}
+
+static void port_rx_flush(void)
+{
+    rx_read = rx_written;
+}
+
+static void port_set_rx_callback(void (*callback)(uint8_t event))
+{
+    rx_callback = callback;
+}
+
+static void port_set_tx_callback(void (*callback)(void))
+{
+    tx_callback = callback;
+}
+
+static void port_set_baudrate(uint32_t baudrate)
+{
+    uart_baud = baudrate;
+}
+
+const at_port_t sim_uart_port = {
+    port_writev, port_rx_peek, port_rx_consume, port_rx_overruns,
+    port_rx_flush, port_set_rx_callback, port_set_tx_callback, port_set_baudrate,
+};
+
+// ==================================
+// 控制
+// ==================================
+
+void Sim_UART_Init(uint32_t baud, sim_uart_sink_t module_rx)
+{
+    while (rx_bursts != NULL)
+    {
+        sim_burst_t *b = rx_bursts;
+        rx_bursts = b->next;
+        free(b->data);
+        free(b);
+    }
+    uart_epoch++;
+    uart_baud = baud;
+    uart_module_rx = module_rx;
+    rx_active = 0;
+    rx_read = rx_written;
+    tx_tail = tx_head;
+    tx_busy = 0;
+    memset(&uart_stats, 0, sizeof(uart_stats));
+}
+
+uint32_t Sim_UART_Baud(void)
+{
+    return uart_baud;
+}
+
+void Sim_UART_GetStats(sim_uart_stats_t *stats)
+{
+    *stats = uart_stats;
+}
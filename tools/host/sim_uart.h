@@ -0,0 +1,75 @@
+/**
+ * @file sim_uart.h
+ * @brief 主机串口线路模型：实现 at_port_t，另一端接模块模拟器
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 与 uart2.c 的行为一致：接收为512字节环形缓冲区，跨过半满/满边界和
+ * 线路空闲（一个字节时间无新数据）时回调；发送缓冲区256字节，发空时回调。
+ * 字节按 10bit/波特率 的线路时间到达。两端波特率不一致时，接收方看到
+ * 长度按速率比例缩放的乱码（与真实的帧错误一样不含换行）。
+ */
+
+#ifndef __SIM_UART_H
+#define __SIM_UART_H
+
+#include "at_engine.h"
+
+#define SIM_UART_RX_RING    512
+#define SIM_UART_TX_RING    256
+
+/**
+ * @brief 模块侧接收函数：MCU 发出的一段数据整段到达模块时调用（中断上下文）
+ * @param baud MCU 发送时的波特率
+ */
+typedef void (*sim_uart_sink_t)(const uint8_t *data, uint16_t len, uint32_t baud);
+
+/**
+ * @brief 线路计数
+ */
+typedef struct
+{
+    uint32_t tx_bytes;          // MCU -> 模块
+    uint32_t rx_bytes;          // 模块 -> MCU
+    uint32_t rx_garbled;        // 因波特率不一致变成乱码的字节
+    uint32_t rx_dropped;        // MCU 接收未开启时丢失的字节
+} sim_uart_stats_t;
+
+extern const at_port_t sim_uart_port;
+
+/**
+ * @brief 复位线路（MCU 复位），设置MCU侧初始波特率
+ */
+void Sim_UART_Init(uint32_t baud, sim_uart_sink_t module_rx);
+
+/**
+ * @brief MCU 当前波特率
+ */
+uint32_t Sim_UART_Baud(void);
+
+/**
+ * @brief 模块发出一段数据，按顺序排在线路上发送（紧接的两段之间没有空闲）
+ * @param baud 模块发送时的波特率
+ */
+void Sim_UART_Module_Send(const void *data, uint16_t len, uint32_t baud);
+
+/**
+ * @brief 线路上尚未到达MCU的字节数
+ */
+uint32_t Sim_UART_Module_Pending(void);
+
+/**
+ * @brief 按速率比例生成乱码
+ * @return 乱码长度
+ */
+uint16_t Sim_UART_Garble(uint8_t *out, uint16_t len, uint32_t from_baud, uint32_t to_baud);
+
+/**
+ * @brief 一个字节的线路时间（微秒）
+ */
+uint64_t Sim_UART_Byte_Us(uint32_t baud);
+
+void Sim_UART_GetStats(sim_uart_stats_t *stats);
+
+#endif // __SIM_UART_H
@@ -0,0 +1,1141 @@
+/**
+ * @file sim_wifi.c
+ * @brief ESP8266 连接栈的主机场景测试
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ *
+ * 固件 User/WIFI 原样编译，经 AT 端口（sim_uart_port）接到 AT 模拟器，
+ * 模拟器的云端连接接到巴法云替身，全部运行在虚拟时间上。
+ * 应用任务与 main.c 的 ESP8266_Main_Task 相同，循环体都是固件的 WiFi_Task_Step，
+ * 模拟器只通过钩子记录链路变化和发布耗时。场景在指定时刻注入故障，
+ * 结束后检查连接状态和计数，并输出发布延迟、吞吐量和重连时间。
+ * 每个场景在单独的子进程中运行，固件的静态变量互不影响。
+ * 以 -DESP8266_LAN_SERVER=1 编译为 sim_wifi_lan：云端会话改为多连接模式，
+ * 场景中的局域网客户端向 lan_server 发HTTP请求并检查应答。
+ *
+ *   sim_wifi              运行全部场景，有失败时返回1
+ *   sim_wifi [-v] 名称...  运行指定场景，-v 打印固件日志和模拟器事件
+ *   sim_wifi -l           列出场景
+ *   sim_wifi_lan -p 端口   按挂钟时间运行，在 127.0.0.1:端口 上把局域网连接桥接到模拟器，
+ *                         可用 curl 等本机HTTP客户端访问
+ */
+
+#include "sim.h"
+#include "sim_board.h"
+#include "sim_uart.h"
+#include "esp_emu.h"
+#include "bemfa_emu.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "esp8266.h"
+#include "at_engine.h"
+#include "conn_mgr.h"
+#include "outbox.h"
+#include "bemfa_client.h"
+#include "bemfa_topics.h"
+#include "param.h"
+#include "sensordata.h"
+#include "wifi_task.h"
+#if ESP8266_LAN_SERVER
+#include "lan_server.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#endif
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define APP_LAT_MAX         512     // 记录的发布延迟样本数
+#define APP_OUTAGE_MAX      16      // 记录的断线次数
+#define APP_TP_WINDOW_S     20      // 吞吐量测量窗口
+
+typedef enum
+{
+    APP_MODE_NORMAL = 0,            // main.c 的发布循环（WiFi_Task_Step）
+    APP_MODE_THROUGHPUT,            // 上线后连续批量发布，测量吞吐量
+} app_mode_t;
+
+/**
+ * @brief 一个场景
+ */
+typedef struct scenario
+{
+    const char *name;
+    const char *desc;
+    uint32_t duration_s;
+    uint32_t seed;
+    app_mode_t mode;
+    esp_emu_cfg_t esp;
+    bemfa_emu_cfg_t cloud;
+    void (*setup)(void);                        // 安排故障注入
+    void (*check)(const struct scenario *s);    // 结束后检查，用 expect() 记录失败
+} scenario_t;
+
+/**
+ * @brief 应用任务记录的指标
+ */
+typedef struct
+{
+    uint64_t first_up_us;           // 首次上线时刻，0-未上线
+    uint32_t cycles;                // 实时发布周期数
+    uint32_t items_ok;              // 实时发布成功的主题
+    uint32_t items_failed;
+    uint32_t lat_count;
+    uint32_t lat_us[APP_LAT_MAX];   // 每个发布周期的耗时
+    uint8_t up;
+    uint32_t outages;
+    uint64_t detect_us[APP_OUTAGE_MAX]; // 注入故障到判定掉线
+    uint64_t recover_us[APP_OUTAGE_MAX];// 注入故障到重新上线
+    uint64_t inject_us;             // 最近一次注入故障的时刻
+    uint32_t tp_items;              // 吞吐量窗口内成功发布的主题
+    uint32_t tp_bytes;              // 其帧字节数
+    uint64_t tp_elapsed_us;
+} app_metrics_t;
+
+static const scenario_t *current;
+static app_metrics_t app;
+static uint8_t check_failed;
+
+// ==================================
+// 检查与报告
+// ==================================
+
+static void expect(int cond, const char *fmt, ...)
+{
+    va_list ap;
+
+    if (cond)
+    {
+        return;
+    }
+    check_failed = 1;
+    printf("    FAIL: ");
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static uint32_t pct(const uint32_t *sorted, uint32_t n, uint32_t p)
+{
+    return n == 0 ? 0 : sorted[(n - 1) * p / 100];
+}
+
+static void report(void)
+{
+    conn_stats_t cs;
+    bemfa_client_stats_t bs;
+    bemfa_emu_stats_t es;
+    esp_emu_stats_t ms;
+    sim_uart_stats_t us;
+    uint32_t lat[APP_LAT_MAX];
+
+    Conn_GetStats(&cs);
+    Bemfa_Client_GetStats(&bs);
+    Bemfa_Emu_GetStats(&es);
+    Esp_Emu_GetStats(&ms);
+    Sim_UART_GetStats(&us);
+
+    memcpy(lat, app.lat_us, app.lat_count * sizeof(lat[0]));
+    qsort(lat, app.lat_count, sizeof(lat[0]), cmp_u32);
+
+    printf("    state %s, baud %u, first online %.2f s, sim %.0f s\n", Conn_State_Name(cs.state),
+           (unsigned)cs.baudrate, app.first_up_us / 1e6, sim_time_us() / 1e6);
+    if (current->mode == APP_MODE_THROUGHPUT)
+    {
+        double secs = app.tp_elapsed_us / 1e6;
+        printf("    throughput %.1f msg/s, %.0f B/s (%u msgs in %.1f s)\n", secs > 0 ? app.tp_items / secs : 0.0,
+               secs > 0 ? app.tp_bytes / secs : 0.0, (unsigned)app.tp_items, secs);
+    }
+    else
+    {
+        printf("    publish cycles %u, topics ok %u failed %u, latency p50 %.1f p95 %.1f max %.1f ms\n",
+               (unsigned)app.cycles, (unsigned)app.items_ok, (unsigned)app.items_failed,
+               pct(lat, app.lat_count, 50) / 1e3, pct(lat, app.lat_count, 95) / 1e3,
+               pct(lat, app.lat_count, 100) / 1e3);
+    }
+    for (uint32_t i = 0; i < app.outages && i < APP_OUTAGE_MAX; i++)
+    {
+        if (app.recover_us[i] != 0)
+        {
+            printf("    outage %u: detected after %.2f s, online again after %.2f s\n", (unsigned)i + 1,
+                   app.detect_us[i] / 1e6, app.recover_us[i] / 1e6);
+        }
+        else
+        {
+            printf("    outage %u: detected after %.2f s, not recovered\n", (unsigned)i + 1, app.detect_us[i] / 1e6);
+        }
+    }
+    printf("    conn: joins %u/%u fail, tcp %u/%u fail, drops %u, hb fail %u, baud fail %u fallback %u, time %u\n",
+           cs.wifi_joins, cs.wifi_failures, cs.tcp_connects, cs.tcp_failures, cs.link_drops, cs.heartbeat_failures,
+           cs.baud_failures, cs.baud_fallbacks, cs.time_syncs);
+    printf("    client: responses %u stale %u unmatched %u pushes %u | outbox %u\n", bs.responses, bs.stale,
+           bs.unmatched, bs.pushes, Outbox_Count());
+    printf("    server: connects %u publishes %u pings %u subs %u bad %u, segs split %u merged %u dropped %u\n",
+           (unsigned)es.connects, (unsigned)es.publishes, (unsigned)es.pings, (unsigned)es.subscribes,
+           (unsigned)es.bad_frames, (unsigned)es.segments_split, (unsigned)es.segments_merged,
+           (unsigned)es.segments_dropped);
+    printf("    module: cmds %u err %u busy %u, out dropped %u garbled %u, resets %u | uart tx %u rx %u garbled %u\n",
+           (unsigned)ms.commands, (unsigned)ms.errors, (unsigned)ms.busy, (unsigned)ms.dropped, (unsigned)ms.garbled,
+           (unsigned)ms.resets, (unsigned)us.tx_bytes, (unsigned)us.rx_bytes, (unsigned)us.rx_garbled);
+}
+
+// ==================================
+// 应用任务（与 main.c 的 ESP8266_Main_Task 相同）
+// ==================================
+
+static void app_track_link(void)
+{
+    uint8_t up = Conn_Is_Up();
+
+    if (up && !app.up)
+    {
+        if (app.first_up_us == 0)
+        {
+            app.first_up_us = sim_time_us();
+        }
+        else if (app.outages > 0 && app.outages <= APP_OUTAGE_MAX)
+        {
+            app.recover_us[app.outages - 1] = sim_time_us() - app.inject_us;
+        }
+    }
+    else if (!up && app.up)
+    {
+        if (app.outages < APP_OUTAGE_MAX)
+        {
+            app.detect_us[app.outages] = sim_time_us() - app.inject_us;
+        }
+        app.outages++;
+    }
+    app.up = up;
+}
+
+static void app_throughput(void)
+{
+    static const char *const topics[] = {"mydht004", "myMP25004", "myLUX004"};
+    static const char *const msgs[] = {"on#25.3#60", "#35.2#1", "#320"};
+    esp8266_pub_t items[3];
+    uint64_t t0 = sim_time_us();
+
+    while (sim_time_us() - t0 < SIM_S(APP_TP_WINDOW_S))
+    {
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            items[i].topic = topics[i];
+            items[i].msg = msgs[i];
+        }
+        ESP8266_TCP_Publish_Batch(BEMFA_UID, items, 3);
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            if (items[i].result == AT_RES_OK)
+            {
+                app.tp_items++;
+                // cmd=2&uid=<uid>&topic=<topic>&msg=<msg>\r\n
+                app.tp_bytes += (uint32_t)(22 + strlen(BEMFA_UID) + strlen(topics[i]) + strlen(msgs[i]));
+            }
+        }
+    }
+    app.tp_elapsed_us = sim_time_us() - t0;
+}
+
+// 发布延迟和各主题结果，钩在 WiFi_Task_Step 的实时发布前后
+static uint64_t app_pub_t0;
+
+static void app_publish_begin(void)
+{
+    app_pub_t0 = sim_time_us();
+}
+
+static void app_publish_end(const outbox_entry_t *snap, uint8_t failed)
+{
+    if (app.lat_count < APP_LAT_MAX)
+    {
+        app.lat_us[app.lat_count++] = (uint32_t)(sim_time_us() - app_pub_t0);
+    }
+    app.cycles++;
+    for (uint8_t bit = 1; bit != 0; bit <<= 1)
+    {
+        if (snap->flags & bit)
+        {
+            if (failed & bit)
+            {
+                app.items_failed++;
+            }
+            else
+            {
+                app.items_ok++;
+            }
+        }
+    }
+}
+
+static const wifi_task_hooks_t app_hooks = {
+    .polled = app_track_link,
+    .publish_begin = app_publish_begin,
+    .publish_end = app_publish_end,
+};
+
+/**
+ * @brief 与 main.c 的 ESP8266_Main_Task 相同：循环体是固件的 WiFi_Task_Step
+ */
+static void App_Task(void *pvParameters)
+{
+    Outbox_Init(&publish_delaytime);
+    AT_Init_Port(&sim_uart_port); // 代替 UART2_DMA_RX_Init，ESP8266_Receive_Start 中的 AT_Init 随后不再重复初始化
+
+    vTaskDelay(pdMS_TO_TICKS(2000));
+
+    static conn_config_t conn_cfg = {
+        .ssid = "ElevatedNetwork.lt",
+        .password = "798798798",
+        .host = "bemfa.com",
+        .port = "8344",
+        .uid = BEMFA_UID,
+    };
+    WiFi_Task_SetHooks(&app_hooks);
+    WiFi_Task_Init(&conn_cfg);
+
+    while (1)
+    {
+        if (current->mode == APP_MODE_THROUGHPUT && Conn_Is_Up() && app.tp_elapsed_us == 0)
+        {
+            // 代替常规发布：连续批量发布一个窗口
+            app_throughput();
+            continue;
+        }
+        WiFi_Task_Step();
+        vTaskDelay(pdMS_TO_TICKS(WIFI_TASK_PERIOD_MS));
+    }
+}
+
+// ==================================
+// 故障注入
+// ==================================
+
+static void inject_wifi_drop(void *arg)
+{
+    app.inject_us = sim_time_us();
+    Esp_Emu_WiFi_Drop((uint32_t)(uintptr_t)arg);
+}
+
+static void inject_server_close(void *arg)
+{
+    app.inject_us = sim_time_us();
+    Bemfa_Emu_Close();
+}
+
+static void inject_silent_drop(void *arg)
+{
+    app.inject_us = sim_time_us();
+    Esp_Emu_Silent_Drop();
+}
+
+static void inject_module_reset(void *arg)
+{
+    app.inject_us = sim_time_us();
+    Esp_Emu_Reset();
+}
+
+static void inject_push(void *arg)
+{
+    Bemfa_Emu_Push("mydht004", (const char *)arg);
+}
+
+#if ESP8266_LAN_SERVER
+// ==================================
+// 局域网客户端
+// ==================================
+
+#define LAN_RESP_MAX        2048
+
+/**
+ * @brief 一次HTTP请求：在指定时刻接入服务器，发出请求，收集应答直到连接关闭
+ */
+typedef struct
+{
+    uint64_t at_us;
+    const char *request;
+    int8_t link;                // -1-未能接入
+    uint8_t closed;
+    uint16_t len;
+    char resp[LAN_RESP_MAX + 1];
+} lan_req_t;
+
+static lan_req_t *lan_by_link[ESP_EMU_LINKS];   // 连接号 -> 场景中的请求
+static int lan_fd[ESP_EMU_LINKS];               // 连接号 -> 桥接的套接字（-p），-1-无
+
+static uint8_t lan_peer_connect(uint8_t link, const char *host, uint16_t port)
+{
+    return 0; // 局域网对端只接入，不被连接
+}
+
+static void lan_peer_recv(uint8_t link, const uint8_t *data, uint16_t len)
+{
+    lan_req_t *r = lan_by_link[link];
+
+    if (lan_fd[link] >= 0)
+    {
+        send(lan_fd[link], data, len, MSG_NOSIGNAL);
+        return;
+    }
+    if (r != NULL)
+    {
+        uint16_t n = (uint16_t)(LAN_RESP_MAX - r->len < len ? LAN_RESP_MAX - r->len : len);
+        memcpy(r->resp + r->len, data, n);
+        r->len += n;
+        r->resp[r->len] = '\0';
+    }
+}
+
+static void lan_peer_closed(uint8_t link)
+{
+    if (lan_by_link[link] != NULL)
+    {
+        lan_by_link[link]->closed = 1;
+        lan_by_link[link] = NULL;
+    }
+    if (lan_fd[link] >= 0)
+    {
+        // 套接字由桥接线程关闭
+        shutdown(lan_fd[link], SHUT_RDWR);
+        lan_fd[link] = -1;
+    }
+}
+
+static const esp_emu_peer_t lan_peer = {lan_peer_connect, lan_peer_recv, lan_peer_closed};
+
+static void lan_request_event(void *arg)
+{
+    lan_req_t *r = arg;
+
+    r->link = Esp_Emu_Lan_Accept();
+    if (r->link < 0)
+    {
+        return;
+    }
+    lan_by_link[r->link] = r;
+    Esp_Emu_Peer_Send((uint8_t)r->link, r->request, (uint16_t)strlen(r->request));
+}
+
+static void lan_schedule(lan_req_t *reqs, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        reqs[i].link = -1;
+        sim_event_at(reqs[i].at_us, lan_request_event, &reqs[i]);
+    }
+}
+
+/**
+ * @brief 应答完整：状态行、Content-Length 与实际正文长度一致、正文是一个JSON对象、连接已关闭
+ */
+static void check_http(const lan_req_t *r, const char *status)
+{
+    const char *body, *cl;
+    unsigned long n;
+
+    expect(r->link >= 0, "request at %.3f s not accepted", r->at_us / 1e6);
+    expect(r->closed, "request at %.3f s: connection not closed", r->at_us / 1e6);
+    if (r->len == 0)
+    {
+        expect(0, "request at %.3f s: no response", r->at_us / 1e6);
+        return;
+    }
+    expect(strncmp(r->resp, status, strlen(status)) == 0, "request at %.3f s: status \"%.*s\", expected \"%s\"",
+           r->at_us / 1e6, (int)strcspn(r->resp, "\r"), r->resp, status);
+    body = strstr(r->resp, "\r\n\r\n");
+    cl = strstr(r->resp, "Content-Length: ");
+    if (body == NULL || cl == NULL || cl > body)
+    {
+        expect(0, "request at %.3f s: no header end or Content-Length", r->at_us / 1e6);
+        return;
+    }
+    body += 4;
+    n = strtoul(cl + 16, NULL, 10);
+    expect(n == (unsigned long)(r->len - (body - r->resp)), "request at %.3f s: Content-Length %lu, body %u bytes",
+           r->at_us / 1e6, n, (unsigned)(r->len - (body - r->resp)));
+    expect(body[0] == '{' && r->resp[r->len - 1] == '}', "request at %.3f s: body is not a JSON object: %s",
+           r->at_us / 1e6, body);
+}
+#endif
+
+// ==================================
+// 场景
+// ==================================
+
+static void check_online(const scenario_t *s)
+{
+    expect(Conn_Is_Up(), "not online at the end");
+    expect(app.first_up_us != 0 && app.first_up_us < SIM_S(20), "first online at %.2f s", app.first_up_us / 1e6);
+}
+
+static void check_recovered(uint32_t max_s)
+{
+    expect(app.outages >= 1, "outage was not detected");
+    for (uint32_t i = 0; i < app.outages && i < APP_OUTAGE_MAX; i++)
+    {
+        expect(app.recover_us[i] != 0 && app.recover_us[i] <= SIM_S(max_s), "outage %u: recovery %.2f s > %u s",
+               (unsigned)i + 1, app.recover_us[i] / 1e6, (unsigned)max_s);
+    }
+}
+
+static void check_baseline(const scenario_t *s)
+{
+    bemfa_emu_stats_t es;
+    conn_stats_t cs;
+
+    Bemfa_Emu_GetStats(&es);
+    Conn_GetStats(&cs);
+    check_online(s);
+    expect(app.cycles >= s->duration_s / 15 - 1, "only %u publish cycles", (unsigned)app.cycles);
+    expect(app.items_failed == 0, "%u topics failed", (unsigned)app.items_failed);
+    expect(cs.time_syncs == 1, "%u network time syncs, expected 1", cs.time_syncs);
+    expect(cs.baudrate == CONN_BAUD_MAX, "baud %u, expected %u", (unsigned)cs.baudrate, CONN_BAUD_MAX);
+    expect(es.subscribes >= 1, "no subscribe");
+    expect(es.bad_frames == 0, "server saw %u bad frames", (unsigned)es.bad_frames);
+    expect(app.outages == 0, "%u unexpected outages", (unsigned)app.outages);
+}
+
+static void check_lossy(const scenario_t *s)
+{
+    check_online(s);
+    expect(app.items_ok * 10 >= (app.items_ok + app.items_failed) * 8, "only %u of %u topics published live",
+           (unsigned)app.items_ok, (unsigned)(app.items_ok + app.items_failed));
+    expect(Outbox_Count() <= 1, "%u records still waiting in the outbox", Outbox_Count());
+}
+
+static void check_reconnect_fast(const scenario_t *s)
+{
+    check_online(s);
+    check_recovered(30);
+}
+
+static void check_reconnect_slow(const scenario_t *s)
+{
+    check_online(s);
+    check_recovered(150);
+}
+
+static void check_split(const scenario_t *s)
+{
+    bemfa_client_stats_t bs;
+    bemfa_emu_stats_t es;
+
+    Bemfa_Client_GetStats(&bs);
+    Bemfa_Emu_GetStats(&es);
+    check_online(s);
+    expect(es.segments_split > 0 && es.segments_merged > 0, "no split/merged segments were produced");
+    expect(app.items_failed == 0, "%u topics failed", (unsigned)app.items_failed);
+    expect(bs.unmatched == 0, "%u unmatched responses", bs.unmatched);
+    expect(app.outages == 0, "%u unexpected outages", (unsigned)app.outages);
+}
+
+static void check_downlink(const scenario_t *s)
+{
+    bemfa_client_stats_t bs;
+    const char *status = Bemfa_Emu_Last_Msg(BEMFA_STATUS_TOPIC);
+    const char *dht = Bemfa_Emu_Last_Msg("mydht004");
+
+    Bemfa_Client_GetStats(&bs);
+    check_online(s);
+    expect(bs.pushes == 2, "%u pushes received", bs.pushes);
+    expect(DHT11_ON == 0, "DHT11 switch not applied");
+    expect(Param_Get(PARAM_DHT11_ON) == 0, "DHT11 parameter not updated");
+    // get 的参数报告发布在状态主题上，读数主题的内容不被覆盖
+    expect(status != NULL && strncmp(status, "param#", 6) == 0, "no param report on %s", BEMFA_STATUS_TOPIC);
+    expect(dht == NULL || strncmp(dht, "param#", 6) != 0, "param report overwrote mydht004");
+}
+
+static void check_throughput(const scenario_t *s)
+{
+    check_online(s);
+    expect(app.tp_elapsed_us != 0, "throughput window did not run");
+    expect(app.tp_items >= APP_TP_WINDOW_S * 20, "only %u msgs in %u s", (unsigned)app.tp_items, APP_TP_WINDOW_S);
+}
+
+/**
+ * @brief 921600 验证失败后不再尝试，停在 460800
+ */
+static void check_baud_verify(const scenario_t *s)
+{
+    conn_stats_t cs;
+
+    Conn_GetStats(&cs);
+    check_online(s);
+    expect(cs.baud_failures >= 1, "no baud verify failure");
+    expect(cs.baudrate == 460800, "baud %u, expected 460800", (unsigned)cs.baudrate);
+    expect(Esp_Emu_Baud() == cs.baudrate, "module at %u baud, MCU at %u", (unsigned)Esp_Emu_Baud(),
+           (unsigned)cs.baudrate);
+    expect(app.items_failed == 0, "%u topics failed", (unsigned)app.items_failed);
+    expect(app.outages == 0, "%u unexpected outages", (unsigned)app.outages);
+}
+
+/**
+ * @brief MCU 复位时模块停在高速率（并处于透传模式），应找回模块并重新协商到上限
+ */
+static void check_baud_stuck(const scenario_t *s)
+{
+    conn_stats_t cs;
+
+    Conn_GetStats(&cs);
+    check_online(s);
+    expect(cs.baudrate == CONN_BAUD_MAX, "baud %u, expected %u", (unsigned)cs.baudrate, CONN_BAUD_MAX);
+    expect(Esp_Emu_Baud() == cs.baudrate, "module at %u baud, MCU at %u", (unsigned)Esp_Emu_Baud(),
+           (unsigned)cs.baudrate);
+    expect(app.outages == 0, "%u unexpected outages", (unsigned)app.outages);
+}
+
+/**
+ * @brief 运行中模块复位回到 115200：失去应答后回退、重新协商并重新上线
+ */
+static void check_module_reset(const scenario_t *s)
+{
+    conn_stats_t cs;
+    esp_emu_stats_t ms;
+
+    Conn_GetStats(&cs);
+    Esp_Emu_GetStats(&ms);
+    check_online(s);
+    check_recovered(30);
+    expect(ms.resets >= 1, "module was not reset");
+    expect(cs.baud_fallbacks >= 1, "no baud fallback after the module reset");
+    expect(cs.baudrate == CONN_BAUD_MAX, "baud %u, expected %u", (unsigned)cs.baudrate, CONN_BAUD_MAX);
+    expect(Esp_Emu_Baud() == cs.baudrate, "module at %u baud, MCU at %u", (unsigned)Esp_Emu_Baud(),
+           (unsigned)cs.baudrate);
+}
+
+static void setup_wifi_drop(void)
+{
+    sim_event_at(SIM_S(60), inject_wifi_drop, (void *)(uintptr_t)10000);
+}
+
+static void setup_server_close(void)
+{
+    sim_event_at(SIM_S(60), inject_server_close, NULL);
+}
+
+static void setup_silent_drop(void)
+{
+    sim_event_at(SIM_S(60), inject_silent_drop, NULL);
+}
+
+static void setup_module_reset(void)
+{
+    sim_event_at(SIM_S(60), inject_module_reset, NULL);
+}
+
+static void setup_downlink(void)
+{
+    sim_event_at(SIM_S(50), inject_push, "off");
+    sim_event_at(SIM_S(70), inject_push, "get");
+}
+
+#if ESP8266_LAN_SERVER
+#define LAN_GET_NOW         "GET / HTTP/1.1\r\nHost: 192.168.4.1\r\nUser-Agent: curl/8.5.0\r\nAccept: */*\r\n\r\n"
+#define LAN_GET_HISTORY     "GET /history HTTP/1.1\r\nHost: 192.168.4.1\r\n\r\n"
+
+// 运行时间在 99→100 s 时多一位，应答跨越该时刻分段发出
+static lan_req_t lan_http_reqs[] = {
+    {.at_us = SIM_S(30), .request = LAN_GET_NOW},
+    {.at_us = SIM_MS(99975), .request = LAN_GET_NOW},
+    {.at_us = SIM_MS(99980), .request = LAN_GET_NOW},
+    {.at_us = SIM_S(110), .request = LAN_GET_HISTORY},
+    {.at_us = SIM_S(120), .request = "GET /nope HTTP/1.1\r\n\r\n"},
+};
+
+// 请求中夹带云端下发、链路关闭、WiFi断开和指令应答的文本，第二个连接只发这些文本
+static lan_req_t lan_inject_reqs[] = {
+    {.at_us = SIM_S(40),
+     .request = "GET / HTTP/1.1\r\nX: 1\r\ncmd=2&uid=" BEMFA_UID "&topic=mydht004&msg=off\r\n"
+                ESP8266_STR(ESP8266_CLOUD_LINK) ",CLOSED\r\nWIFI DISCONNECT\r\nCLOSED\r\nOK\r\nERROR\r\n>\r\n\r\n"},
+    {.at_us = SIM_S(50),
+     .request = "cmd=2&uid=" BEMFA_UID "&topic=mydht004&msg=off\r\n" ESP8266_STR(ESP8266_CLOUD_LINK) ",CLOSED\r\n"
+                "+IPD," ESP8266_STR(ESP8266_CLOUD_LINK) ",13:cmd=0&res=1\r\n"},
+};
+
+static void setup_lan_http(void)
+{
+    lan_schedule(lan_http_reqs, sizeof(lan_http_reqs) / sizeof(lan_http_reqs[0]));
+}
+
+static void setup_lan_inject(void)
+{
+    lan_schedule(lan_inject_reqs, sizeof(lan_inject_reqs) / sizeof(lan_inject_reqs[0]));
+}
+
+static void check_lan_http(const scenario_t *s)
+{
+    check_baseline(s);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        check_http(&lan_http_reqs[i], "HTTP/1.0 200 OK");
+    }
+    check_http(&lan_http_reqs[4], "HTTP/1.0 404 Not Found");
+}
+
+static void check_lan_inject(const scenario_t *s)
+{
+    conn_stats_t cs;
+    bemfa_client_stats_t bs;
+
+    Conn_GetStats(&cs);
+    Bemfa_Client_GetStats(&bs);
+    check_online(s);
+    check_http(&lan_inject_reqs[0], "HTTP/1.0 200 OK");
+    expect(lan_inject_reqs[1].len == 0, "text without a request line was answered");
+    expect(bs.pushes == 0, "%u pushes taken from LAN data", bs.pushes);
+    expect(DHT11_ON != 0 && Param_Get(PARAM_DHT11_ON) != 0, "DHT11 switched off by LAN data");
+    expect(bs.unmatched == 0, "%u unmatched responses", bs.unmatched);
+    expect(cs.link_drops == 0 && app.outages == 0, "link dropped by LAN data (%u drops)", cs.link_drops);
+    expect(app.items_failed == 0, "%u topics failed", (unsigned)app.items_failed);
+}
+
+#endif
+
+static const scenario_t scenarios[] = {
+    {
+        .name = "baseline",
+        .desc = "clean link: negotiate baud, join, subscribe, time sync, publish every 15 s",
+        .duration_s = 180,
+        .seed = 1,
+        .check = check_baseline,
+    },
+    {
+        .name = "latency",
+        .desc = "slow module and network with jitter, 5% of server replies lost",
+        .duration_s = 300,
+        .seed = 2,
+        .esp = {.cmd_jitter_us = 30000, .net_delay_us = 80000},
+        .cloud = {.reply_us = 20000, .reply_jitter_us = 100000, .drop_percent = 5},
+        .check = check_lossy,
+    },
+    {
+        .name = "uart_loss",
+        .desc = "3% of module output bursts lost on the UART",
+        .duration_s = 300,
+        .seed = 3,
+        .esp = {.drop_percent = 3},
+        .check = check_lossy,
+    },
+    {
+        .name = "wifi_drop",
+        .desc = "access point gone for 10 s at t=60 s",
+        .duration_s = 180,
+        .seed = 4,
+        .setup = setup_wifi_drop,
+        .check = check_reconnect_fast,
+    },
+    {
+        .name = "server_close",
+        .desc = "server closes the TCP connection at t=60 s",
+        .duration_s = 180,
+        .seed = 5,
+        .setup = setup_server_close,
+        .check = check_reconnect_fast,
+    },
+    {
+        .name = "silent_drop",
+        .desc = "TCP link dies at t=60 s without CLOSED, found by publish/heartbeat failures",
+        .duration_s = 300,
+        .seed = 6,
+        .setup = setup_silent_drop,
+        .check = check_reconnect_slow,
+    },
+    {
+        .name = "split_merge",
+        .desc = "server replies split across segments and merged into one segment",
+        .duration_s = 180,
+        .seed = 7,
+        .cloud = {.coalesce_us = 30000, .split_percent = 50, .split_gap_us = 3000},
+        .check = check_split,
+    },
+    {
+        .name = "downlink",
+        .desc = "server pushes mydht004=off at t=50 s and get at t=70 s",
+        .duration_s = 90,
+        .seed = 8,
+        .setup = setup_downlink,
+        .check = check_downlink,
+    },
+    {
+        .name = "throughput",
+        .desc = "back-to-back pipelined publish batches for 20 s on a 2 ms network",
+        .duration_s = 60,
+        .seed = 9,
+        .mode = APP_MODE_THROUGHPUT,
+        .esp = {.net_delay_us = 2000},
+        .cloud = {.reply_us = 1000},
+        .check = check_throughput,
+    },
+    {
+        .name = "baud_verify",
+        .desc = "module output garbled for the first bursts after switching to 921600",
+        .duration_s = 90,
+        .seed = 10,
+        .esp = {.bad_baud = 921600, .bad_bursts = 12},
+        .check = check_baud_verify,
+    },
+    {
+        .name = "baud_bad",
+        .desc = "module output always garbled at 921600, module left there by the failed verify",
+        .duration_s = 120,
+        .seed = 11,
+        .esp = {.bad_baud = 921600, .bad_bursts = ESP_EMU_BAD_FOREVER},
+        .check = check_baud_verify,
+    },
+    {
+        .name = "baud_stuck",
+        .desc = "MCU reset with the module still at 921600 in passthrough mode",
+        .duration_s = 90,
+        .seed = 12,
+        .esp = {.boot_baud = 921600, .boot_joined = 1, .boot_passthrough = 1},
+        .check = check_baud_stuck,
+    },
+    {
+        .name = "baud_stuck_mid",
+        .desc = "MCU reset with the module still at 460800 in command mode",
+        .duration_s = 90,
+        .seed = 13,
+        .esp = {.boot_baud = 460800, .boot_joined = 1},
+        .check = check_baud_stuck,
+    },
+    {
+        .name = "module_reset",
+        .desc = "module resets to 115200 at t=60 s while the MCU runs at 921600",
+        .duration_s = 180,
+        .seed = 14,
+        .setup = setup_module_reset,
+        .check = check_module_reset,
+    },
+#if ESP8266_LAN_SERVER
+    {
+        .name = "lan_http",
+        .desc = "cloud session in multi-link mode, LAN clients fetch /, /history and a missing path",
+        .duration_s = 180,
+        .seed = 21,
+        .setup = setup_lan_http,
+        .check = check_lan_http,
+    },
+    {
+        .name = "lan_inject",
+        .desc = "LAN client sends cmd=, 4,CLOSED, WIFI DISCONNECT and OK lines inside its data",
+        .duration_s = 90,
+        .seed = 22,
+        .setup = setup_lan_inject,
+        .check = check_lan_inject,
+    },
+    {
+        .name = "lan_downlink",
+        .desc = "multi-link mode with server replies split and merged, push mydht004=off at t=50 s and get at t=70 s",
+        .duration_s = 90,
+        .seed = 23,
+        .cloud = {.coalesce_us = 30000, .split_percent = 50, .split_gap_us = 3000},
+        .setup = setup_downlink,
+        .check = check_downlink,
+    },
+#endif
+};
+
+#define SCENARIO_COUNT (sizeof(scenarios) / sizeof(scenarios[0]))
+
+// ==================================
+// 驱动
+// ==================================
+
+static void stop_event(void *arg)
+{
+    sim_stop(0);
+}
+
+/**
+ * @brief 按场景参数初始化板级替身、模拟器和应用任务
+ * @return 0-成功
+ */
+static int boot_scenario(const scenario_t *s)
+{
+    bemfa_emu_cfg_t cloud = s->cloud;
+
+    current = s;
+    memset(&app, 0, sizeof(app));
+    check_failed = 0;
+
+    if (Sim_Board_Init() != 0)
+    {
+        return 1;
+    }
+    sim_srand(s->seed);
+    if (cloud.uid == NULL)
+    {
+        cloud.uid = BEMFA_UID;
+    }
+    Bemfa_Emu_Init(&cloud);
+    Esp_Emu_Init(&s->esp);
+#if ESP8266_LAN_SERVER
+    for (uint8_t i = 0; i < ESP_EMU_LINKS; i++)
+    {
+        lan_by_link[i] = NULL;
+        lan_fd[i] = -1;
+    }
+    Esp_Emu_Set_Lan(&lan_peer);
+#endif
+    Param_Init();
+
+    xTaskCreate(App_Task, "ESP8266_Main", 384, NULL, 2, NULL);
+    return 0;
+}
+
+/**
+ * @brief 在当前（子）进程中运行一个场景
+ * @return 0-通过 1-失败
+ */
+static int run_scenario(const scenario_t *s)
+{
+    int code;
+
+    if (boot_scenario(s) != 0)
+    {
+        return 1;
+    }
+    if (s->setup != NULL)
+    {
+        s->setup();
+    }
+    sim_event_at(SIM_S(s->duration_s), stop_event, NULL);
+
+    code = sim_run();
+    printf("%-13s %s\n", s->name, s->desc);
+    expect(code == 0, "simulation stopped with code %d", code);
+    s->check(s);
+    report();
+    printf("%-13s %s\n\n", s->name, check_failed ? "FAIL" : "ok");
+    fflush(stdout);
+    return check_failed;
+}
+
+static int run_forked(const scenario_t *s)
+{
+    int status;
+    pid_t pid;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        return 1;
+    }
+    if (pid == 0)
+    {
+        _exit(run_scenario(s));
+    }
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status))
+    {
+        printf("%-13s crashed\n\n", s->name);
+        return 1;
+    }
+    return WEXITSTATUS(status);
+}
+
+#if ESP8266_LAN_SERVER
+// ==================================
+// 实时桥接（-p）
+// ==================================
+
+/**
+ * @brief 接入本机TCP连接并转发数据：每个连接对应模块的一个局域网连接号
+ */
+static void *serve_thread(void *arg)
+{
+    int listen_fd = (int)(intptr_t)arg;
+    int fd_link[ESP_EMU_LINKS];
+    struct pollfd pfd[ESP_EMU_LINKS + 1];
+    uint8_t buf[1024];
+
+    for (uint8_t i = 0; i < ESP_EMU_LINKS; i++)
+    {
+        fd_link[i] = -1;
+    }
+    while (1)
+    {
+        nfds_t n = 0;
+        int link_of[ESP_EMU_LINKS + 1];
+
+        pfd[n].fd = listen_fd;
+        pfd[n].events = POLLIN;
+        link_of[n++] = -1;
+        sim_lock();
+        for (uint8_t i = 0; i < ESP_EMU_LINKS; i++)
+        {
+            // 模块已关闭连接（lan_peer_closed）
+            if (fd_link[i] >= 0 && lan_fd[i] != fd_link[i])
+            {
+                close(fd_link[i]);
+                fd_link[i] = -1;
+            }
+            if (fd_link[i] >= 0)
+            {
+                pfd[n].fd = fd_link[i];
+                pfd[n].events = POLLIN;
+                link_of[n++] = i;
+            }
+        }
+        sim_unlock();
+
+        if (poll(pfd, n, 100) <= 0)
+        {
+            continue;
+        }
+        for (nfds_t k = 0; k < n; k++)
+        {
+            if (!(pfd[k].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                continue;
+            }
+            if (link_of[k] < 0)
+            {
+                int fd = accept(listen_fd, NULL, NULL);
+                int8_t link;
+
+                if (fd < 0)
+                {
+                    continue;
+                }
+                sim_lock();
+                link = Esp_Emu_Lan_Accept();
+                if (link >= 0)
+                {
+                    lan_fd[link] = fd;
+                    fd_link[link] = fd;
+                }
+                sim_unlock();
+                if (link < 0)
+                {
+                    // 服务器未开启（尚未连上云端）或连接已满
+                    close(fd);
+                }
+                continue;
+            }
+
+            ssize_t got = recv(pfd[k].fd, buf, sizeof(buf), 0);
+            uint8_t link = (uint8_t)link_of[k];
+            sim_lock();
+            if (lan_fd[link] == pfd[k].fd)
+            {
+                if (got > 0)
+                {
+                    Esp_Emu_Peer_Send(link, buf, (uint16_t)got);
+                }
+                else
+                {
+                    Esp_Emu_Peer_Close(link);
+                    lan_fd[link] = -1;
+                }
+            }
+            sim_unlock();
+            if (got <= 0)
+            {
+                // 同一轮中该连接号可能已分配给新接入的连接
+                close(pfd[k].fd);
+                if (fd_link[link] == pfd[k].fd)
+                {
+                    fd_link[link] = -1;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 按挂钟时间运行 baseline 场景的环境（不结束），本机客户端经桥接访问局域网服务器
+ */
+static int run_serve(uint16_t port)
+{
+    struct sockaddr_in addr;
+    pthread_t thread;
+    int one = 1;
+    int fd;
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 4) != 0)
+    {
+        perror("listen");
+        return 1;
+    }
+    if (boot_scenario(&scenarios[0]) != 0)
+    {
+        return 1;
+    }
+    printf("serving http://127.0.0.1:%u/ and /history once the module is online (about 10 s), Ctrl+C to stop\n",
+           (unsigned)port);
+    sim_set_realtime(1);
+    pthread_create(&thread, NULL, serve_thread, (void *)(intptr_t)fd);
+    return sim_run();
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    uint32_t failed = 0, ran = 0;
+    int argi = 1;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if (argi < argc && strcmp(argv[argi], "-l") == 0)
+    {
+        for (size_t i = 0; i < SCENARIO_COUNT; i++)
+        {
+            printf("%-13s %s\n", scenarios[i].name, scenarios[i].desc);
+        }
+        return 0;
+    }
+    if (argi < argc && strcmp(argv[argi], "-v") == 0)
+    {
+        sim_verbose = 1;
+        argi++;
+    }
+#if ESP8266_LAN_SERVER
+    if (argi + 1 < argc && strcmp(argv[argi], "-p") == 0)
+    {
+        return run_serve((uint16_t)atoi(argv[argi + 1]));
+    }
+#endif
+
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        uint8_t selected = (argi >= argc);
+        for (int a = argi; a < argc; a++)
+        {
+            selected |= (strcmp(argv[a], scenarios[i].name) == 0);
+        }
+        if (selected)
+        {
+            failed += (uint32_t)run_forked(&scenarios[i]);
+            ran++;
+        }
+    }
+    if (ran == 0)
+    {
+        fprintf(stderr, "no such scenario (use -l)\n");
+        return 2;
+    }
+    printf("%u of %u scenarios passed\n", (unsigned)(ran - failed), (unsigned)ran);
+    return failed != 0;
+}
@@ -0,0 +1,532 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file tlm_decode.py
+@brief USART1 二进制遥测流解码（帧格式见 User/SensorData/telemetry.h）
+@author flowkite-0689
+@version v1.0
+@date 2026.10.19
+
+遥测帧与文本日志共用 USART1：在字节流中按同步字节 00 5A 重新对齐，校验 CRC16
+（CCITT-FALSE，覆盖通道号到负载末尾），按全局帧序号统计丢帧，各通道写入一个 CSV，
+帧以外的字节作为文本日志写入 log.txt。
+固件以 LOG_DEFERRED=1 编译时，日志帧（00 A5，格式见 User/System/log.c）只带格式串地址
+和原始参数；用 -e 指定同一次编译的 .axf，按地址从映像中取出格式串，还原成文本行写入
+log.txt。不指定时只统计日志帧个数。
+
+  tlm_decode.py capture.bin -o out/                     解码抓包文件
+  tlm_decode.py capture.bin -e Objects/project.axf -o out/
+                                                        同时还原延迟格式化的日志
+  tlm_decode.py /dev/ttyUSB0 -b 921600 -s 2:100 -s 4:1000 -o out/
+                                                        打开串口，订阅通道2(100ms)和4(1s)，Ctrl+C 结束
+  tlm_decode.py --self-test                             用合成数据检查解码器
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+import tempfile
+
+SYNC = b"\x00\x5a"
+LOG_SYNC = b"\x00\xa5"          # LOG_DEFERRED 的日志帧，不含长度字段，需格式串才能确定帧长
+HEADER = struct.Struct("<BBBBBI")  # 同步2字节、通道号、负载长度、帧序号、时间戳
+HEADER_LEN = HEADER.size        # 9
+CRC_LEN = 2
+
+# 通道号 -> (名称, 负载格式, CSV 列名, 换算)
+CHANNELS = {
+    1: ("raw", struct.Struct("<HH"), ["light_adc", "pm25_adc"], None),
+    2: ("values", struct.Struct("<hHHBB"), ["temp_c", "lux", "pm25", "humi", "pm25_level"],
+        lambda v: (v[0] / 10.0, v[1], v[2] / 10.0, v[3], v[4])),
+    3: ("motion", struct.Struct("<6h"), ["ax", "ay", "az", "gx", "gy", "gz"], None),
+    4: ("stats", struct.Struct("<IIIHH"), ["samples", "log_drops", "tx_drops", "heap_free", "uart2_overruns"],
+        None),
+}
+
+
+# 日志帧：同步2字节、模块<<4|级别、参数个数、格式串地址；与 log.h / log.c 一致
+LOG_HEADER = struct.Struct("<BBBBI")
+LOG_MODULES = ("sys", "menu", "wifi", "sensor", "oled")
+LOG_LEVEL_CHARS = "-EWID"
+LOG_ARGS_MAX = 6
+LOG_FLAG_CHARS = "-+ #0123456789.*"
+
+
+def crc16_ccitt_false(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE（多项式0x1021，初值0xFFFF），与 Telemetry_CRC16 相同"""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def encode_frame(ch, seq, ts, payload):
+    """按固件的 Telemetry_Send 组帧（用于自检）"""
+    head = HEADER.pack(0x00, 0x5A, ch, len(payload), seq & 0xFF, ts & 0xFFFFFFFF)
+    crc = crc16_ccitt_false(head[2:] + payload)
+    return head + payload + struct.pack("<H", crc)
+
+
+class NeedMore(Exception):
+    """日志帧尚未收全"""
+
+
+class FirmwareImage:
+    """固件映像中已分配地址的段，按地址取以 NUL 结尾的格式串"""
+
+    def __init__(self, segments):
+        self.segments = [(addr, bytes(data)) for addr, data in segments]
+
+    @classmethod
+    def from_elf(cls, path):
+        """读取 32 位小端 ELF（Keil 的 .axf）中占用地址空间且有内容的段"""
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError("%s: not a 32-bit little-endian ELF file" % path)
+        (shoff,) = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        segments = []
+        for k in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<6I", data, shoff + k * shentsize)
+            if sh_type == 1 and flags & 0x2 and size:     # SHT_PROGBITS，SHF_ALLOC
+                segments.append((addr, data[offset:offset + size]))
+        return cls(segments)
+
+    def string_at(self, addr):
+        for base, data in self.segments:
+            if base <= addr < base + len(data):
+                end = data.find(b"\x00", addr - base)
+                if end < 0:
+                    return None
+                return data[addr - base:end].decode("latin-1")
+        return None
+
+
+def _take_u32(data, off):
+    if off + 4 > len(data):
+        raise NeedMore()
+    return struct.unpack_from("<I", data, off)[0], off + 4
+
+
+def format_log(fmt, argc, data, off):
+    """
+    按 log.c 中 Log_Write_Deferred 的规则从帧中取出参数并格式化
+    @return (文本, 帧结束偏移)；参数未收全时抛出 NeedMore，与格式串不符时抛出 ValueError
+    """
+    out = []
+    n = 0
+    i = 0
+    while i < len(fmt):
+        c = fmt[i]
+        i += 1
+        if c != "%" or n >= argc:
+            out.append(c)
+            continue
+        spec = ""
+        in_prec = False
+        start = i - 1
+        while i < len(fmt) and fmt[i] in LOG_FLAG_CHARS and n < argc:
+            ch = fmt[i]
+            i += 1
+            if ch == ".":
+                in_prec = True
+                spec += ch
+            elif ch == "*":
+                # 宽度/精度由参数给出，帧中各占4字节
+                v, off = _take_u32(data, off)
+                v = v - (1 << 32) if v & 0x80000000 else v
+                n += 1
+                if in_prec and v < 0:
+                    spec = spec[:-1]            # 负精度等同于未指定
+                    in_prec = False
+                else:
+                    spec += str(v)
+            else:
+                spec += ch
+        if n >= argc:
+            # '*' 取到了参数个数上限，固件不再取后面的参数，其余原样输出
+            out.append(fmt[start:i])
+            continue
+        while i < len(fmt) and fmt[i] in "lh":
+            i += 1
+        if i >= len(fmt):
+            out.append(fmt[start:])
+            break
+        conv = fmt[i]
+        i += 1
+        if conv == "%":
+            out.append("%")
+            continue
+        if conv == "s":
+            if off >= len(data):
+                raise NeedMore()
+            length = data[off]
+            if off + 1 + length > len(data):
+                raise NeedMore()
+            out.append(("%" + spec + "s") % bytes(data[off + 1:off + 1 + length]).decode("latin-1"))
+            off += 1 + length
+        elif conv in "feg":
+            v, off = _take_u32(data, off)
+            out.append(("%" + spec + conv) % struct.unpack("<f", struct.pack("<I", v))[0])
+        else:
+            v, off = _take_u32(data, off)
+            if conv in "di":
+                out.append(("%" + spec + "d") % (v - (1 << 32) if v & 0x80000000 else v))
+            elif conv in "uxXo":
+                out.append(("%" + spec + conv) % v)
+            elif conv == "c":
+                out.append(("%" + spec + "c") % chr(v & 0xFF))
+            elif conv == "p":
+                out.append("0x%08x" % v)
+            else:
+                out.append(fmt[start:i])
+        n += 1
+    if n != argc:
+        raise ValueError("format takes %d arguments, frame has %d" % (n, argc))
+    return "".join(out), off
+
+
+class Decoder:
+    """增量解码：feed() 喂入任意切分的字节，完整帧交给 on_frame，其余字节交给 on_text"""
+
+    def __init__(self, on_frame, on_text=None, image=None):
+        self.on_frame = on_frame
+        self.on_text = on_text
+        self.image = image          # FirmwareImage，None 时日志帧只计数
+        self.buf = bytearray()
+        self.last_seq = None
+        self.frames = {ch: 0 for ch in CHANNELS}
+        self.crc_errors = 0
+        self.bad_headers = 0    # 长度与通道不符，按误同步处理
+        self.lost = 0           # 按帧序号推算的丢帧数
+        self.log_frames = 0
+        self.skipped = 0        # 未能归入帧的非文本字节
+
+    def _text(self, data):
+        if not data:
+            return
+        text = bytes(b for b in data if b in (9, 10, 13) or 32 <= b < 127 or b >= 0x80)
+        self.skipped += len(data) - len(text)
+        if self.on_text is not None and text:
+            self.on_text(text)
+
+    def _next_sync(self):
+        i = self.buf.find(SYNC)
+        if self.image is not None:
+            j = self.buf.find(LOG_SYNC)
+            if j >= 0 and (i < 0 or j < i):
+                return j
+        return i
+
+    def _log_frame(self):
+        """
+        缓冲区开头的日志帧还原为文本行
+        @return None-未收全 False-不是有效日志帧 True-已处理
+        """
+        if len(self.buf) < LOG_HEADER.size:
+            return None
+        _, _, mod_level, argc, addr = LOG_HEADER.unpack_from(self.buf)
+        mod, level = mod_level >> 4, mod_level & 0x0F
+        if mod >= len(LOG_MODULES) or not 1 <= level < len(LOG_LEVEL_CHARS) or argc > LOG_ARGS_MAX:
+            return False
+        fmt = self.image.string_at(addr)
+        if fmt is None:
+            return False
+        try:
+            text, end = format_log(fmt, argc, self.buf, LOG_HEADER.size)
+        except NeedMore:
+            return None
+        except (ValueError, TypeError, OverflowError):
+            return False
+        del self.buf[:end]
+        self.log_frames += 1
+        if self.on_text is not None:
+            self.on_text(("%s/%s: %s\r\n" % (LOG_LEVEL_CHARS[level], LOG_MODULES[mod], text)).encode("latin-1"))
+        return True
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            i = self._next_sync()
+            if i < 0:
+                # 末尾的 0x00 可能是下一帧同步字节的前半
+                keep = 1 if self.buf.endswith(b"\x00") else 0
+                self.log_frames += self.buf.count(LOG_SYNC, 0, len(self.buf) - keep)
+                self._text(self.buf[:len(self.buf) - keep])
+                del self.buf[:len(self.buf) - keep]
+                return
+            self.log_frames += self.buf.count(LOG_SYNC, 0, i)
+            self._text(self.buf[:i])
+            del self.buf[:i]
+            if len(self.buf) >= 2 and self.buf[1] == LOG_SYNC[1]:
+                done = self._log_frame()
+                if done is None:
+                    return
+                if not done:
+                    self.bad_headers += 1
+                    self.skipped += 1
+                    del self.buf[:1]
+                continue
+            if len(self.buf) < HEADER_LEN:
+                return
+            _, _, ch, length, seq, ts = HEADER.unpack_from(self.buf)
+            spec = CHANNELS.get(ch)
+            if spec is None or spec[1].size != length:
+                self.bad_headers += 1
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            total = HEADER_LEN + length + CRC_LEN
+            if len(self.buf) < total:
+                return
+            frame = bytes(self.buf[:total])
+            (crc,) = struct.unpack_from("<H", frame, HEADER_LEN + length)
+            if crc16_ccitt_false(frame[2:HEADER_LEN + length]) != crc:
+                # 可能是误同步或传输错误，从下一个字节重新对齐
+                self.crc_errors += 1
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            del self.buf[:total]
+            if self.last_seq is not None:
+                self.lost += (seq - self.last_seq - 1) & 0xFF
+            self.last_seq = seq
+            self.frames[ch] += 1
+            values = spec[1].unpack_from(frame, HEADER_LEN)
+            if spec[3] is not None:
+                values = spec[3](values)
+            self.on_frame(ch, seq, ts, values)
+
+    def summary(self):
+        parts = ["%s %d" % (CHANNELS[ch][0], n) for ch, n in self.frames.items() if n]
+        return ("frames: %s | lost %d (seq gaps), crc errors %d, bad headers %d, log frames %d, skipped %d bytes"
+                % (", ".join(parts) or "none", self.lost, self.crc_errors, self.bad_headers, self.log_frames,
+                   self.skipped))
+
+
+class CsvSink:
+    """每个通道一个 CSV：ts_ms, seq, 各字段"""
+
+    def __init__(self, out_dir):
+        os.makedirs(out_dir, exist_ok=True)
+        self.out_dir = out_dir
+        self.files = {}
+        self.writers = {}
+        self.log = open(os.path.join(out_dir, "log.txt"), "wb")
+
+    def frame(self, ch, seq, ts, values):
+        w = self.writers.get(ch)
+        if w is None:
+            name, _, cols, _ = CHANNELS[ch]
+            f = open(os.path.join(self.out_dir, name + ".csv"), "w", newline="")
+            w = csv.writer(f)
+            w.writerow(["ts_ms", "seq"] + cols)
+            self.files[ch] = f
+            self.writers[ch] = w
+        w.writerow([ts, seq] + list(values))
+
+    def text(self, data):
+        self.log.write(data)
+
+    def close(self):
+        for f in self.files.values():
+            f.close()
+        self.log.close()
+
+
+def parse_subscription(s):
+    ch, _, period = s.partition(":")
+    return int(ch), int(period or "0")
+
+
+def run_serial(path, baud, subs, decoder):
+    try:
+        import serial  # pyserial
+    except ImportError:
+        sys.exit("reading a serial port needs pyserial (pip install pyserial)")
+    port = serial.Serial(path, baud, timeout=0.2)
+    for ch, period in subs:
+        port.write(("tlm %d %d\n" % (ch, period)).encode())
+    try:
+        while True:
+            decoder.feed(port.read(4096))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for ch, _ in subs:
+            port.write(("tlm %d 0\n" % ch).encode())
+        port.close()
+
+
+def run_file(path, decoder):
+    with (sys.stdin.buffer if path == "-" else open(path, "rb")) as f:
+        while True:
+            chunk = f.read(65536)
+            if not chunk:
+                break
+            decoder.feed(chunk)
+
+
+def encode_log(mod, level, addr, args):
+    """按 Log_Write_Deferred 组日志帧（用于自检）：args 为 int、float 或 bytes（%s）"""
+    body = b""
+    for a in args:
+        if isinstance(a, bytes):
+            body += bytes([len(a)]) + a
+        elif isinstance(a, float):
+            body += struct.pack("<f", a)
+        else:
+            body += struct.pack("<I", a & 0xFFFFFFFF)
+    return LOG_HEADER.pack(0x00, 0xA5, (mod << 4) | level, len(args), addr) + body
+
+
+def write_test_elf(path, addr, data):
+    """只有一个 PROGBITS 段的最小 ELF32（用于自检 FirmwareImage.from_elf）"""
+    shoff = 52 + len(data)
+    ehdr = struct.pack("<4sBBBB8xHHIIIIIHHHHHH", b"\x7fELF", 1, 1, 1, 0, 2, 40, 1, 0, 0, shoff, 0, 52, 0, 0,
+                       40, 2, 0)
+    null = bytes(40)
+    text = struct.pack("<10I", 0, 1, 0x2, addr, 52, len(data), 0, 0, 4, 0)
+    with open(path, "wb") as f:
+        f.write(ehdr + data + null + text)
+
+
+def self_test_log():
+    base = 0x08001000
+    fmts = [
+        "AT: rx overrun %u",
+        "Conn: %s -> %s",
+        "Downlink: unknown topic %.*s",
+        "temp %5.1f%% rh %d",
+        "x=%-4d|%c|%08lX",
+        "%d %d %d %d %d %d %d",
+    ]
+    strings = b""
+    addr = {}
+    for fmt in fmts:
+        addr[fmt] = base + len(strings)
+        strings += fmt.encode() + b"\x00"
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "fw.axf")
+        write_test_elf(path, base, strings)
+        image = FirmwareImage.from_elf(path)
+
+    cases = [
+        (encode_log(2, 2, addr[fmts[0]], [5]), b"W/wifi: AT: rx overrun 5"),
+        (encode_log(2, 3, addr[fmts[1]], [b"uart", b"wifi down"]), b"I/wifi: Conn: uart -> wifi down"),
+        (encode_log(2, 2, addr[fmts[2]], [4, b"myXY"]), b"W/wifi: Downlink: unknown topic myXY"),
+        (encode_log(3, 4, addr[fmts[3]], [25.25, -3]), b"D/sensor: temp  25.2% rh -3"),
+        (encode_log(0, 1, addr[fmts[4]], [-7, ord("k"), 0xBEEF]), b"E/sys: x=-7  |k|0000BEEF"),
+        # 超过 LOG_ARGS_MAX 的参数固件不取，原样输出
+        (encode_log(1, 3, addr[fmts[5]], [1, 2, 3, 4, 5, 6]), b"I/menu: 1 2 3 4 5 6 %d"),
+    ]
+    stream = b"I/sys: boot\r\n"
+    for frame, _ in cases:
+        stream += frame + b"tail\r\n"
+    stream += encode_log(2, 3, base + len(strings) + 64, [1])    # 地址不在映像中，按误同步跳过
+
+    text = bytearray()
+    dec = Decoder(lambda *a: None, text.extend, image)
+    for k in range(0, len(stream), 5):
+        dec.feed(stream[k:k + 5])
+    for _, line in cases:
+        assert line + b"\r\ntail\r\n" in text, "%r not in %r" % (line, bytes(text))
+    assert dec.log_frames == len(cases), dec.summary()
+    assert dec.bad_headers == 1, dec.summary()
+
+
+def self_test():
+    # CRC-16/CCITT-FALSE 的标准校验值
+    assert crc16_ccitt_false(b"123456789") == 0x29B1
+
+    frames = []
+    stream = bytearray(b"I/sys: boot\r\n")
+    seq = 0
+    for i in range(200):
+        ch = (2, 1, 4, 3)[i % 4]
+        name, st, cols, _ = CHANNELS[ch]
+        if ch == 2:
+            payload = st.pack(253 - i, 320 + i, 352, 60, 1)
+        elif ch == 4:
+            payload = st.pack(i, 0, i * 3, 4096, 0)
+        else:
+            payload = st.pack(*[(i * k) & 0x7FFF for k in range(len(cols))])
+        frame = encode_frame(ch, seq, 1000 + i * 10, payload)
+        seq += 1
+        if i % 37 == 5:
+            frame = b""                         # 发送缓冲区满，整帧丢弃
+        elif i % 53 == 7:
+            frame = bytearray(frame)
+            frame[HEADER_LEN] ^= 0x40           # 负载出错，CRC 不符
+        else:
+            frames.append((ch, (seq - 1) & 0xFF))
+        stream += frame
+        if i % 11 == 0:
+            stream += b"W/wifi: publish failed (-2)\r\n"
+        if i % 29 == 0:
+            stream += b"\x00\xa5\x23\x01\x00\x10\x00\x08\x05\x00\x00\x00"  # 延迟格式化日志帧
+
+    got = []
+    text = bytearray()
+    dec = Decoder(lambda ch, s, ts, v: got.append((ch, s)), text.extend)
+    for k in range(0, len(stream), 7):          # 任意切分
+        dec.feed(stream[k:k + 7])
+
+    assert got == frames, "decoded %d of %d frames" % (len(got), len(frames))
+    assert dec.crc_errors == sum(1 for i in range(200) if i % 53 == 7 and i % 37 != 5)
+    dropped = sum(1 for i in range(200) if i % 37 == 5)
+    corrupted = dec.crc_errors
+    assert dec.lost == dropped + corrupted, dec.summary()
+    assert text.count(b"publish failed") == sum(1 for i in range(200) if i % 11 == 0)
+    assert dec.log_frames == sum(1 for i in range(200) if i % 29 == 0), dec.summary()
+
+    # 同一数据流带上映像：日志帧还原为文本，遥测帧结果不变
+    image = FirmwareImage([(0x08001000, b"AT: rx overrun %u\x00")])
+    got_img = []
+    text_img = bytearray()
+    dec_img = Decoder(lambda ch, s, ts, v: got_img.append((ch, s)), text_img.extend, image)
+    for k in range(0, len(stream), 7):
+        dec_img.feed(stream[k:k + 7])
+    assert got_img == frames and dec_img.lost == dec.lost, dec_img.summary()
+    assert text_img.count(b"I/wifi: AT: rx overrun 5\r\n") == dec.log_frames, dec_img.summary()
+
+    self_test_log()
+    print("self-test ok:", dec.summary())
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode the USART1 telemetry stream into per-channel CSV files.")
+    ap.add_argument("source", nargs="?", help="capture file, '-' for stdin, or a serial port")
+    ap.add_argument("-o", "--out", default="tlm_out", help="output directory (default: tlm_out)")
+    ap.add_argument("-b", "--baud", type=int, default=115200, help="serial baud rate (DEBUG_BAUDRATE)")
+    ap.add_argument("-s", "--subscribe", action="append", type=parse_subscription, default=[],
+                    metavar="CH:MS", help="subscribe a channel on a serial port, e.g. 2:100")
+    ap.add_argument("-e", "--elf", help="firmware .axf of the same build, to expand LOG_DEFERRED log frames")
+    ap.add_argument("--self-test", action="store_true", help="check the decoder on synthetic data")
+    args = ap.parse_args()
+
+    if args.self_test:
+        self_test()
+        return
+    if args.source is None:
+        ap.error("source is required")
+
+    image = FirmwareImage.from_elf(args.elf) if args.elf else None
+    sink = CsvSink(args.out)
+    dec = Decoder(sink.frame, sink.text, image)
+    try:
+        if args.source.startswith("/dev/") or args.source.upper().startswith("COM"):
+            run_serial(args.source, args.baud, args.subscribe, dec)
+        else:
+            run_file(args.source, dec)
+    finally:
+        sink.close()
+    print(dec.summary())
+
+
+if __name__ == "__main__":
+    main()